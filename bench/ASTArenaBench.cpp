@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+
+// Parses a generated crate into an Arena and reports how many nodes it holds,
+// the arena bytes they take, how many heap allocations the parse makes (arena
+// chunks included), and how long building and tearing down the tree take.
+// Teardown grows with the "dtors" column, the nodes Reset() destroys one by
+// one.
+// Heap allocations are counted by replacing the global operator new.
+// Usage: ASTArenaBench [bytes] [iterations]
+namespace {
+    size_t heap_allocations = 0;
+    size_t heap_bytes = 0;
+}
+
+void *operator new(const size_t size) {
+    heap_allocations++;
+    heap_bytes += size;
+    if (void *memory = std::malloc(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 16u * 1024 * 1024;
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 3;
+    const std::string text = GenerateBenchCorpus(bytes);
+    const Lexer lexer;
+    TokenArray tokens;
+    uint32_t offset = 0;
+    LineTable lines;
+    Token token;
+    while (lexer.NextParserToken(text, offset, lines, token)) {
+        tokens.push_back(token);
+    }
+
+    std::printf("%zu bytes, %zu tokens\n", text.size(), tokens.size());
+    std::printf("%10s %12s %12s %12s %12s %12s %10s %12s\n", "parse ms", "nodes", "dtors", "used MiB",
+                "arena MiB", "heap allocs", "heap MiB", "teardown ms");
+    for (int i = 0; i < iterations; i++) {
+        Arena arena;
+        Parser parser(arena, TokenArray(tokens), text);
+        const size_t allocations_before = heap_allocations;
+        const size_t bytes_before = heap_bytes;
+        BenchTimer timer;
+        parser.ParseCrate();
+        const double parse_seconds = timer.Seconds();
+        const size_t allocations = heap_allocations - allocations_before;
+        const size_t allocated = heap_bytes - bytes_before;
+        const size_t nodes = arena.object_count();
+        const size_t destructors = arena.destructor_count();
+        const size_t node_bytes = arena.bytes_allocated();
+        const size_t arena_bytes = arena.bytes_reserved();
+
+        timer.Reset();
+        arena.Reset();
+        const double teardown_seconds = timer.Seconds();
+        std::printf("%10.1f %12zu %12zu %12.1f %12.1f %12zu %10.1f %12.1f\n", parse_seconds * 1e3, nodes,
+                    destructors, node_bytes / 1048576.0, arena_bytes / 1048576.0, allocations, allocated / 1048576.0,
+                    teardown_seconds * 1e3);
+    }
+}
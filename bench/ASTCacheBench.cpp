@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/ASTCache.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Front end of a generated crate cold (lex, parse, the four semantic passes)
+// against loading the same crate from the AST cache, plus the cost of writing
+// the entry and its size. The entry is written to a scratch directory under
+// the system temp directory and removed afterwards.
+// Usage: ASTCacheBench [bytes]
+int main(int argc, char *argv[]) {
+    ScopeManager scope_manager;
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 4u * 1024 * 1024;
+    const std::string text = GenerateBenchCorpus(bytes);
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RCompilerASTCacheBench";
+    const ASTCache cache(directory.string());
+
+    BenchTimer timer;
+    Arena cold_arena;
+    const Lexer lexer;
+    CrateNode *crate = Parser(cold_arena, lexer, text).ParseCrate();
+    const double parse_seconds = timer.Seconds();
+    timer.Reset();
+    SymbolCollector symbol_collector(scope_manager);
+    SemanticChecker semantic_checker(scope_manager);
+    symbol_collector.Visit(crate);
+    semantic_checker.Visit(crate);
+    const double semantic_seconds = timer.Seconds();
+
+    timer.Reset();
+    if (!cache.Store(text, crate, scope_manager)) {
+        std::printf("could not write the cache entry under %s\n", directory.c_str());
+        return 1;
+    }
+    const double store_seconds = timer.Seconds();
+    uintmax_t entry_bytes = 0;
+    for (const auto &entry: std::filesystem::directory_iterator(directory)) {
+        entry_bytes += entry.file_size();
+    }
+
+    timer.Reset();
+    Arena warm_arena;
+    const CrateNode *loaded = cache.Load(text, warm_arena, scope_manager);
+    const double load_seconds = timer.Seconds();
+    std::filesystem::remove_all(directory);
+    if (loaded == nullptr || loaded->items_.size() != crate->items_.size()) {
+        std::printf("cache entry did not load back\n");
+        return 1;
+    }
+
+    const double cold_seconds = parse_seconds + semantic_seconds;
+    std::printf("%zu bytes source, %zu AST nodes, %.1f MiB cache entry\n", text.size(), cold_arena.object_count(),
+                static_cast<double>(entry_bytes) / (1024.0 * 1024.0));
+    std::printf("%-34s %10.1f ms\n", "cold: lex + parse", parse_seconds * 1e3);
+    std::printf("%-34s %10.1f ms\n", "cold: semantic passes", semantic_seconds * 1e3);
+    std::printf("%-34s %10.1f ms\n", "cold total", cold_seconds * 1e3);
+    std::printf("%-34s %10.1f ms\n", "store entry", store_seconds * 1e3);
+    std::printf("%-34s %10.1f ms   (%.1fx faster than cold)\n", "warm: load entry", load_seconds * 1e3,
+                cold_seconds / load_seconds);
+}
@@ -0,0 +1,64 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// Helpers shared by the micro-benchmarks under bench/.
+
+class BenchTimer {
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+public:
+    void Reset() {
+        start_ = std::chrono::steady_clock::now();
+    }
+
+    [[nodiscard]] double Seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+};
+
+inline std::string ReadBenchFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+// Generates a well-formed R program of roughly `bytes` bytes, shaped like the
+// machine-generated crates we compile: many small functions with comments,
+// arithmetic, control flow and string literals.
+inline std::string GenerateBenchCorpus(size_t bytes) {
+    std::string text;
+    text.reserve(bytes + 1024);
+    uint32_t count = 0;
+    while (text.size() < bytes) {
+        const std::string id = std::to_string(count++);
+        text += "// generated helper number " + id + "\n";
+        text += "fn helper_function_" + id + "(alpha_value: i32, beta_value: i32) -> i32 {\n";
+        text += "    /* accumulate a few values */\n";
+        text += "    let mut result_value: i32 = alpha_value + beta_value * 3 - (alpha_value / 2);\n";
+        text += "    let mask_value: u32 = 0x1F_u32;\n";
+        text += "    if (result_value > 10) {\n";
+        text += "        result_value = result_value - 1;\n";
+        text += "    } else {\n";
+        text += "        result_value += beta_value % 7 + 1;\n";
+        text += "    }\n";
+        text += "    while (result_value < 100) {\n";
+        text += "        result_value = result_value * 2 + 1; // grow\n";
+        text += "    }\n";
+        text += "    println(\"helper " + id + " done\");\n";
+        text += "    return result_value;\n";
+        text += "}\n\n";
+    }
+    text += "fn main() {\n    let total: i32 = helper_function_0(1, 2);\n    printlnInt(total);\n    exit(0);\n}\n";
+    return text;
+}
+
+inline void PrintThroughput(const char *label, size_t bytes, double seconds) {
+    std::printf("%-28s %10zu bytes %10.3f ms %10.2f MB/s\n", label, bytes, seconds * 1e3,
+                static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds);
+}
+#endif //BENCHUTIL_H
@@ -0,0 +1,142 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "InstSelection/ASMModule.h"
+#include "InstSelection/InstSelector.h"
+#include "InstSelection/RegAllocator.h"
+#include "IR/IRBuilder.h"
+#include "IR/IRProgram.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Stress test for programs whose expressions or blocks nest far deeper than
+// hand-written code: each case is compiled from lexing to register
+// allocation on the main thread, under whatever stack limit the shell gives
+// it (8 MB by default). Every case runs in a child process, because the
+// passes keep their state in globals and a stack overflow must not take the
+// other cases down with it. Exits non-zero if any case fails.
+// Usage: DeepNestingBench [scale-percent]
+ScopeManager scope_manager;
+IRManager ir_manager;
+std::shared_ptr<IRProgram> ir_program;
+std::shared_ptr<ASMModule> asm_module;
+
+namespace {
+    std::string Program(const std::string &body) {
+        return "fn main() {\n    let mut x: i32 = 0;\n" + body + "\n    printlnInt(x);\n    exit(0);\n}\n";
+    }
+
+    // 1 op 1 op ... with `terms` operands, the operators taken in turn from
+    // `ops`: one left-deep chain of the loosest operator among them.
+    std::string Chain(const size_t terms, const std::vector<std::string> &ops, const std::string &operand) {
+        std::string chain = operand;
+        for (size_t i = 1; i < terms; i++) {
+            chain += ops[i % ops.size()];
+            chain += operand;
+        }
+        return chain;
+    }
+
+    std::string Nested(const size_t depth, const std::string &open, const std::string &inner,
+                       const std::string &close) {
+        std::string body;
+        body.reserve(depth * (open.size() + close.size()) + inner.size());
+        for (size_t i = 0; i < depth; i++) {
+            body += open;
+        }
+        body += inner;
+        for (size_t i = 0; i < depth; i++) {
+            body += close;
+        }
+        return body;
+    }
+
+    void Compile(const std::string &text) {
+        BenchTimer timer;
+        Arena arena;
+        const Lexer lexer;
+        CrateNode *crate = Parser(arena, lexer, text).ParseCrate();
+        const double parse_seconds = timer.Seconds();
+        timer.Reset();
+        SymbolCollector symbol_collector(scope_manager);
+        SemanticChecker semantic_checker(scope_manager);
+        symbol_collector.Visit(crate);
+        semantic_checker.Visit(crate);
+        const double semantic_seconds = timer.Seconds();
+        timer.Reset();
+        ir_program = std::make_shared<IRProgram>();
+        IRBuilder ir_builder(scope_manager, ir_manager);
+        ir_builder.Visit(crate);
+        const double ir_seconds = timer.Seconds();
+        timer.Reset();
+        asm_module = std::make_shared<ASMModule>();
+        InstSelector inst_selector;
+        ir_program->accept(&inst_selector);
+        RegAllocator().run(asm_module);
+        const double backend_seconds = timer.Seconds();
+        std::printf(" %10.1f %10.1f %10.1f %10.1f\n", parse_seconds * 1e3, semantic_seconds * 1e3,
+                    ir_seconds * 1e3, backend_seconds * 1e3);
+    }
+
+    // Compiles `text` in a child process; false if it did not finish cleanly.
+    bool Run(const char *name, const std::string &text) {
+        std::printf("%-34s %8zu KiB", name, text.size() / 1024);
+        std::fflush(stdout);
+        const pid_t child = fork();
+        if (child == 0) {
+            try {
+                Compile(text);
+            } catch (std::exception &error) {
+                std::printf("  %s\n", error.what());
+                std::fflush(stdout);
+                _exit(1);
+            }
+            std::fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (WIFSIGNALED(status)) {
+            std::printf("  killed by signal %d\n", WTERMSIG(status));
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t percent = argc > 1 ? std::stoul(argv[1]) : 100;
+    const size_t terms = 1000000 * percent / 100;
+    const size_t depth = 10000 * percent / 100;
+    rlimit stack{};
+    getrlimit(RLIMIT_STACK, &stack);
+    if (stack.rlim_cur == RLIM_INFINITY) {
+        std::printf("stack limit: unlimited\n");
+    } else {
+        std::printf("stack limit: %llu KiB\n", static_cast<unsigned long long>(stack.rlim_cur / 1024));
+    }
+    std::printf("%-34s %12s %10s %10s %10s %10s\n", "case", "source", "parse ms", "sema ms", "IR ms", "backend ms");
+
+    bool ok = true;
+    ok &= Run((std::to_string(terms) + "-term 1 + 1 + ...").c_str(),
+              Program("    x = " + Chain(terms, {" + "}, "1") + ";"));
+    ok &= Run((std::to_string(terms) + "-term 1 - 1 * 1 - ...").c_str(),
+              Program("    x = " + Chain(terms, {" - ", " * "}, "1") + ";"));
+    // Every || link becomes two basic blocks and a result slot at the head of
+    // the entry block, which the back end does not handle in linear time, so
+    // this chain is a hundredth as long.
+    ok &= Run((std::to_string(terms / 100) + "-term x < 1 || x < 1 ...").c_str(),
+              Program("    let b: bool = " + Chain(terms / 100, {" || "}, "x < 1") + ";"));
+    ok &= Run((std::to_string(depth) + " nested blocks").c_str(), Program(Nested(depth, "{ ", "x = x + 1;", " }")));
+    ok &= Run((std::to_string(depth) + " nested loops").c_str(),
+              Program(Nested(depth, "loop { ", "x = x + 1;", " break; }")));
+    ok &= Run((std::to_string(depth) + " nested parentheses").c_str(),
+              Program("    x = " + Nested(depth, "(", "1", ")") + ";"));
+    return ok ? 0 : 1;
+}
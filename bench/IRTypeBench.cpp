@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "IR/IRManager.h"
+#include "Semantic/TypeContext.h"
+
+// Cost of IRManager::GetIRType on the kinds of type IRBuilder lowers for
+// every expression: primitives, structs with many fields, large (nested)
+// arrays and references to them. "legacy" is the lookup as it was before
+// lowerings were cached: a new IRArrayType or IRPointerType for every array
+// or reference, and a walk over every registered type for the rest.
+// Usage: IRTypeBench [structs] [fields] [rounds]
+namespace {
+    std::shared_ptr<IRType> LegacyGetIRType(const IRManager &manager, const std::shared_ptr<Type> &type) {
+        if (auto array_type = std::dynamic_pointer_cast<ArrayType>(type)) {
+            auto ir_base_type = LegacyGetIRType(manager, array_type->base_);
+            return std::make_shared<IRArrayType>(ir_base_type, array_type->length_);
+        }
+        if (auto reference_type = std::dynamic_pointer_cast<ReferenceType>(type)) {
+            auto ir_base_type = LegacyGetIRType(manager, reference_type->type_);
+            return std::make_shared<IRPointerType>(ir_base_type);
+        }
+        for (auto &it: manager.type_map_) {
+            if (it.first->equal(type)) {
+                return it.second;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename Lower>
+    void Run(const char *label, const std::vector<std::shared_ptr<Type> > &queries, const int rounds, Lower lower) {
+        double best = 1e30;
+        uint64_t bytes = 0;
+        for (int round = 0; round < rounds; round++) {
+            bytes = 0;
+            BenchTimer timer;
+            for (const auto &type: queries) {
+                bytes += lower(type)->size;
+            }
+            best = std::min(best, timer.Seconds());
+        }
+        std::printf("%-8s %10.3f ms %9.1f ns/lookup  (checksum %llu)\n", label, best * 1e3,
+                    best * 1e9 / static_cast<double>(queries.size()), static_cast<unsigned long long>(bytes));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const uint32_t struct_count = argc > 1 ? std::stoul(argv[1]) : 200;
+    const uint32_t field_count = argc > 2 ? std::stoul(argv[2]) : 64;
+    const int rounds = argc > 3 ? std::stoi(argv[3]) : 5;
+    TypeContext &types = GlobalTypeContext();
+    IRManager manager;
+    const auto i32_type = types.Primitive("i32");
+    const auto bool_type = types.Primitive("bool");
+    manager.SetIRType(i32_type, std::make_shared<IRIntegerType>(32));
+    manager.SetIRType(bool_type, std::make_shared<IRIntegerType>(1));
+
+    // Each struct holds primitives, large arrays, references and the previous
+    // struct; the arrays' lengths vary so they are distinct types.
+    std::vector<std::shared_ptr<Type> > queries;
+    std::shared_ptr<Type> previous;
+    for (uint32_t s = 0; s < struct_count; s++) {
+        std::vector<StructMember> members;
+        std::vector<std::shared_ptr<Type> > derived;
+        for (uint32_t f = 0; f < field_count; f++) {
+            std::shared_ptr<Type> member;
+            switch (f % 4) {
+                case 0:
+                    member = f % 8 == 0 ? i32_type : bool_type;
+                    break;
+                case 1:
+                    member = types.Array(i32_type, 1024 + s);
+                    break;
+                case 2:
+                    member = types.Array(types.Array(i32_type, 64), 64 + f);
+                    break;
+                default: // StructType::equal recurses into members, so one struct field only
+                    member = f == 3 && previous ? previous : types.Reference(types.Array(i32_type, 4096));
+                    break;
+            }
+            members.push_back(StructMember{"field_" + std::to_string(f), member});
+            derived.push_back(member);
+        }
+        auto struct_type = std::make_shared<StructType>("S" + std::to_string(s), members);
+        manager.AddType(struct_type);
+        queries.push_back(struct_type);
+        queries.push_back(types.Reference(struct_type, true));
+        queries.push_back(types.Array(struct_type, 16));
+        queries.insert(queries.end(), derived.begin(), derived.end());
+        queries.push_back(types.Reference(derived[1]));
+        previous = struct_type;
+    }
+    std::printf("%u structs of %u fields, %zu lookups per round, %zu registered types\n", struct_count, field_count,
+                queries.size(), manager.type_map_.size());
+
+    Run("legacy", queries, rounds, [&](const std::shared_ptr<Type> &type) { return LegacyGetIRType(manager, type); });
+    Run("cached", queries, rounds, [&](const std::shared_ptr<Type> &type) { return manager.GetIRType(type); });
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BenchUtil.h"
+#include "Lexer/Keyword.h"
+#include "Lexer/Lexer.h"
+
+// Keyword classification on identifier-heavy input: the perfect-hash lookup
+// against a linear scan over the keyword list (what trying one rule per
+// keyword amounts to), then whole-lexer throughput on the same text.
+// Usage: KeywordBench [identifier-count] [iterations]
+namespace {
+    TokenType ClassifyLinear(const std::string_view word) {
+        for (const auto &rule: keyword::keyword_rules) {
+            if (rule.spelling == word) {
+                return rule.type;
+            }
+        }
+        return TokenType::Identifier;
+    }
+
+    // Half keywords, half near-miss identifiers (keyword prefixes, extensions
+    // and case variants), separated by single spaces.
+    std::string GenerateIdentifierText(const size_t count) {
+        static const char *near_misses[] = {
+            "a", "asm", "breaker", "con", "constant", "els", "enumerate", "fnord", "form", "iff",
+            "implement", "inn", "lets", "looped", "matcher", "model", "mover", "mutable", "refs",
+            "returns", "selfish", "SELF", "structs", "superb", "traits", "truest", "types", "unsafely",
+            "user", "whereas", "whiles", "dynamic", "abstracted", "becomes", "done", "finally",
+            "overrides", "static", "value_1", "result_value",
+        };
+        std::mt19937 rng(42);
+        std::string text;
+        for (size_t i = 0; i < count; i++) {
+            if (rng() % 2 == 0) {
+                const auto &rule = keyword::keyword_rules[rng() % std::size(keyword::keyword_rules)];
+                text += rule.spelling;
+            } else {
+                text += near_misses[rng() % std::size(near_misses)];
+            }
+            text += ' ';
+        }
+        return text;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 10;
+    const std::string text = GenerateIdentifierText(count);
+
+    std::vector<std::string_view> words;
+    for (size_t begin = 0; begin < text.size();) {
+        const size_t end = text.find(' ', begin);
+        words.push_back(std::string_view(text).substr(begin, end - begin));
+        begin = end + 1;
+    }
+
+    size_t keywords = 0;
+    for (const auto word: words) {
+        if (keyword::Classify(word) != ClassifyLinear(word)) {
+            std::printf("mismatch on \"%.*s\"\n", static_cast<int>(word.size()), word.data());
+            return 1;
+        }
+        keywords += keyword::Classify(word) != TokenType::Identifier;
+    }
+    std::printf("seed %u, %zu identifiers, %zu keywords\n", keyword::Seed, words.size(), keywords);
+
+    const auto run = [&](const char *label, TokenType (*classify)(std::string_view)) {
+        size_t sink = 0;
+        BenchTimer timer;
+        for (int i = 0; i < iterations; i++) {
+            for (const auto word: words) {
+                sink += static_cast<size_t>(classify(word));
+            }
+        }
+        const double seconds = timer.Seconds();
+        std::printf("%-28s %10.2f ns/identifier (%zu)\n", label,
+                    seconds * 1e9 / static_cast<double>(words.size() * iterations), sink);
+    };
+    run("perfect hash", [](const std::string_view word) { return keyword::Classify(word); });
+    run("linear scan", ClassifyLinear);
+
+    const Lexer lexer;
+    size_t sink = 0;
+    BenchTimer timer;
+    for (int i = 0; i < iterations; i++) {
+        uint32_t offset = 0;
+        while (offset < text.size()) {
+            const Token token = lexer.GetNextToken(text, offset);
+            sink += static_cast<size_t>(token.type);
+        }
+    }
+    PrintThroughput("lex identifiers", text.size() * iterations, timer.Seconds());
+    std::printf("%-28s %10zu\n", "checksum", sink);
+}
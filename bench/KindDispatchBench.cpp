@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "IR/IRType.h"
+#include "InstSelection/ASMInstruction.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+
+// Cost of identifying a node's class: the RTTI casts the passes used to make
+// against the kind tags behind isa<>/dyn_cast<>. AST nodes come from parsing a
+// generated crate and are classified by the same kind of if-cascade the passes
+// run; IR types and ASM instructions are mixed vectors of shared_ptrs, checked
+// the old way with std::dynamic_pointer_cast.
+// Usage: KindDispatchBench [bytes] [rounds]
+namespace {
+    struct RttiCast {
+        template<typename T>
+        static T *As(ASTNode *node) {
+            return dynamic_cast<T *>(node);
+        }
+    };
+
+    struct KindCast {
+        template<typename T>
+        static T *As(ASTNode *node) {
+            return dyn_cast<T>(node);
+        }
+    };
+
+    template<typename Cast>
+    int Classify(ASTNode *node) {
+        if (Cast::template As<LetStatementNode>(node)) return 0;
+        if (Cast::template As<ExpressionStatementNode>(node)) return 1;
+        if (Cast::template As<VisItemStatementNode>(node)) return 2;
+        if (Cast::template As<PathInExpressionNode>(node)) return 3;
+        if (Cast::template As<FunctionCallExpressionNode>(node)) return 4;
+        if (Cast::template As<LiteralExpressionNode>(node)) return 5;
+        if (Cast::template As<ExpressionWithBlockNode>(node)) return 6;
+        if (Cast::template As<ArrayTypeNode>(node)) return 7;
+        if (Cast::template As<ReferenceTypeNode>(node)) return 8;
+        if (Cast::template As<TypeNoBoundsNode>(node)) return 9;
+        if (Cast::template As<PatternWithoutRangeNode>(node)) return 10;
+        return 11;
+    }
+
+    int ClassifySwitch(const ASTNode *node) {
+        switch (node->kind()) {
+            case ASTKind::LetStatement: return 0;
+            case ASTKind::ExpressionStatement: return 1;
+            case ASTKind::VisItemStatement: return 2;
+            case ASTKind::PathInExpression: return 3;
+            case ASTKind::FunctionCallExpression: return 4;
+            case ASTKind::ArrayType: return 7;
+            case ASTKind::ReferenceType: return 8;
+            default:
+                if (isa<LiteralExpressionNode>(node)) return 5;
+                if (isa<ExpressionWithBlockNode>(node)) return 6;
+                if (isa<TypeNoBoundsNode>(node)) return 9;
+                if (isa<PatternWithoutRangeNode>(node)) return 10;
+                return 11;
+        }
+    }
+
+    void CollectExpression(ExpressionNode *expression, std::vector<ASTNode *> &nodes) {
+        if (expression == nullptr) {
+            return;
+        }
+        nodes.push_back(expression);
+        if (auto assignment = dyn_cast<AssignmentExpressionNode>(expression)) {
+            nodes.push_back(assignment->lhs_);
+            nodes.push_back(assignment->rhs_);
+        }
+    }
+
+    // Function signatures, statements and the expressions they hold.
+    std::vector<ASTNode *> CollectNodes(const CrateNode *crate) {
+        std::vector<ASTNode *> nodes;
+        for (VisItemNode *item: crate->items_) {
+            auto function = dyn_cast<FunctionNode>(item);
+            if (function == nullptr || function->block_expression_->statements_ == nullptr) {
+                continue;
+            }
+            nodes.push_back(function);
+            if (function->function_parameters_) {
+                for (FunctionParamNode *param: function->function_parameters_->function_params_) {
+                    nodes.push_back(param->pattern_no_top_alt_node_);
+                    nodes.push_back(param->type_);
+                }
+            }
+            if (function->type_) {
+                nodes.push_back(function->type_);
+            }
+            for (StatementNode *statement: function->block_expression_->statements_->statements_) {
+                nodes.push_back(statement);
+                if (auto let = dyn_cast<LetStatementNode>(statement)) {
+                    nodes.push_back(let->pattern_no_top_alt_);
+                    nodes.push_back(let->type_);
+                    CollectExpression(let->expression_, nodes);
+                } else if (auto expression = dyn_cast<ExpressionStatementNode>(statement)) {
+                    CollectExpression(expression->expression_, nodes);
+                }
+            }
+        }
+        return nodes;
+    }
+
+    template<typename Body>
+    void Measure(const char *label, const size_t checks, const int rounds, Body body) {
+        uint64_t sink = 0;
+        BenchTimer timer;
+        for (int round = 0; round < rounds; round++) {
+            sink += body();
+        }
+        const double seconds = timer.Seconds();
+        std::printf("%-44s %8.2f ns/check   (checksum %llu)\n", label, seconds * 1e9 / (checks * rounds),
+                    static_cast<unsigned long long>(sink));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 4u * 1024 * 1024;
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    const std::string text = GenerateBenchCorpus(bytes);
+    const Lexer lexer;
+    Arena arena;
+    Parser parser(arena, lexer, text);
+    const CrateNode *crate = parser.ParseCrate();
+    std::vector<ASTNode *> nodes = CollectNodes(crate);
+    nodes.erase(std::remove(nodes.begin(), nodes.end(), nullptr), nodes.end());
+    std::printf("%zu AST nodes, %d rounds\n", nodes.size(), rounds);
+    Measure("AST if-cascade, dynamic_cast", nodes.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (ASTNode *node: nodes) sum += Classify<RttiCast>(node);
+        return sum;
+    });
+    Measure("AST if-cascade, dyn_cast", nodes.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (ASTNode *node: nodes) sum += Classify<KindCast>(node);
+        return sum;
+    });
+    Measure("AST switch on kind()", nodes.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const ASTNode *node: nodes) sum += ClassifySwitch(node);
+        return sum;
+    });
+
+    // The IR type mix of a typical function body: mostly integers and
+    // pointers, some aggregates.
+    const auto i32 = std::make_shared<IRIntegerType>(32);
+    const auto pointer = std::make_shared<IRPointerType>(i32);
+    const auto array = std::make_shared<IRArrayType>(i32, 8);
+    const auto structure = std::make_shared<IRStructType>("Point", std::vector<std::shared_ptr<IRType>>{i32, i32});
+    const std::shared_ptr<IRType> pattern[] = {i32, i32, pointer, i32, array, pointer, structure, i32};
+    std::vector<std::shared_ptr<IRType>> types;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        types.push_back(pattern[i % std::size(pattern)]);
+    }
+    std::printf("\n%zu IR types\n", types.size());
+    Measure("IRType aggregate test, dynamic_pointer_cast", types.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const auto &type: types) {
+            if (auto struct_type = std::dynamic_pointer_cast<IRStructType>(type)) {
+                sum += struct_type->members.size();
+            } else if (auto array_type = std::dynamic_pointer_cast<IRArrayType>(type)) {
+                sum += array_type->length;
+            }
+        }
+        return sum;
+    });
+    Measure("IRType aggregate test, dyn_cast", types.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const auto &type: types) {
+            if (auto struct_type = dyn_cast<IRStructType>(type)) {
+                sum += struct_type->members.size();
+            } else if (auto array_type = dyn_cast<IRArrayType>(type)) {
+                sum += array_type->length;
+            }
+        }
+        return sum;
+    });
+
+    std::vector<std::shared_ptr<ASMInstruction>> instructions;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (i % 8 == 0) {
+            instructions.push_back(std::make_shared<ASMCallInstruction>(nullptr));
+        } else if (i % 8 == 1) {
+            instructions.push_back(std::make_shared<ASMRetInstruction>());
+        } else {
+            instructions.push_back(std::make_shared<ASMAddInstruction>(nullptr, nullptr, nullptr));
+        }
+    }
+    std::printf("\n%zu ASM instructions\n", instructions.size());
+    Measure("ASM call test, dynamic_pointer_cast", instructions.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const auto &instruction: instructions) {
+            if (instruction->opcode == ASMOpcode::JAL && std::dynamic_pointer_cast<ASMCallInstruction>(instruction)) {
+                sum++;
+            }
+        }
+        return sum;
+    });
+    Measure("ASM call test, isa", instructions.size(), rounds, [&] {
+        uint64_t sum = 0;
+        for (const auto &instruction: instructions) {
+            if (instruction->opcode == ASMOpcode::JAL && isa<ASMCallInstruction>(instruction)) {
+                sum++;
+            }
+        }
+        return sum;
+    });
+}
@@ -0,0 +1,36 @@
+#include <cctype>
+#include <iostream>
+#include <string>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+
+// Lexer throughput in MB/s.
+// Usage: LexerBench [file.rx | corpus-bytes] [iterations]
+int main(int argc, char *argv[]) {
+    std::string text;
+    if (argc > 1 && std::isdigit(static_cast<unsigned char>(argv[1][0]))) {
+        text = GenerateBenchCorpus(std::stoul(argv[1]));
+    } else if (argc > 1) {
+        text = ReadBenchFile(argv[1]);
+    } else {
+        text = GenerateBenchCorpus(64 * 1024);
+    }
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    BenchTimer timer;
+    const Lexer lexer;
+    std::printf("dfa construction %.3f ms\n", timer.Seconds() * 1e3);
+
+    size_t token_count = 0;
+    timer.Reset();
+    for (int i = 0; i < iterations; i++) {
+        uint32_t offset = 0;
+        while (offset < text.size()) {
+            Token token = lexer.GetNextToken(text, offset);
+            token_count += token.type != TokenType::WhiteSpace;
+        }
+    }
+    const double seconds = timer.Seconds();
+    PrintThroughput("lex", text.size() * iterations, seconds);
+    std::cout << token_count / iterations << " tokens per iteration\n";
+}
@@ -0,0 +1,28 @@
+#include <cstdio>
+#include <string>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+
+// Lexing time for inputs from 10 KB up to `max-bytes` (default 100 MB),
+// growing 10x per step. Linear scanning keeps ns/byte flat across the rows.
+// Usage: LexerScalingBench [max-bytes]
+int main(int argc, char *argv[]) {
+    const size_t max_bytes = argc > 1 ? std::stoul(argv[1]) : 100u * 1024 * 1024;
+    const Lexer lexer;
+    std::printf("%12s %12s %12s %10s %12s\n", "bytes", "tokens", "ms", "ns/byte", "checksum");
+    for (size_t bytes = 10 * 1024; bytes <= max_bytes; bytes *= 10) {
+        const std::string text = GenerateBenchCorpus(bytes);
+        size_t token_count = 0;
+        size_t sink = 0;
+        BenchTimer timer;
+        uint32_t offset = 0;
+        while (offset < text.size()) {
+            const Token token = lexer.GetNextToken(text, offset);
+            sink += token.length;
+            token_count++;
+        }
+        const double seconds = timer.Seconds();
+        std::printf("%12zu %12zu %12.3f %10.2f %12zu\n", text.size(), token_count, seconds * 1e3,
+                    seconds * 1e9 / static_cast<double>(text.size()), sink);
+    }
+}
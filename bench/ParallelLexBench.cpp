@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Lexer/ParallelLexer.h"
+
+// Chunked parallel lexing with 1-16 threads against sequential lexing of the
+// same corpus. Every run is checked token-for-token (type, offset, length, row,
+// column).
+// Usage: ParallelLexBench [corpus-bytes] [iterations]
+namespace {
+    bool SameTokens(const TokenArray &a, const TokenArray &b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].type != b[i].type || a[i].offset() != b[i].offset() || a[i].length != b[i].length ||
+                a[i].pos.GetRow() != b[i].pos.GetRow() || a[i].pos.GetColumn() != b[i].pos.GetColumn()) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 64u * 1024 * 1024;
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 3;
+    // Mix in CRLF line endings so row bookkeeping across chunks is exercised.
+    const std::string corpus = GenerateBenchCorpus(bytes);
+    std::string text;
+    text.reserve(corpus.size() + corpus.size() / 32);
+    for (size_t i = 0; i < corpus.size(); i++) {
+        if (corpus[i] == '\n' && i % 3 == 0) {
+            text += '\r';
+        }
+        text += corpus[i];
+    }
+    const Lexer lexer;
+    std::printf("%zu bytes, %u hardware threads\n", text.size(), std::thread::hardware_concurrency());
+
+    TokenArray expected;
+    BenchTimer timer;
+    uint32_t offset = 0;
+    LineTable lines;
+    Token token;
+    while (lexer.NextParserToken(text, offset, lines, token)) {
+        expected.push_back(token);
+    }
+    const double sequential = timer.Seconds();
+    PrintThroughput("sequential", text.size(), sequential);
+
+    for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u}) {
+        timer.Reset();
+        const std::vector<uint32_t> points = lexer.FindSplitPoints(text, threads - 1);
+        const double split = timer.Seconds();
+
+        TokenArray tokens;
+        timer.Reset();
+        for (int i = 0; i < iterations; i++) {
+            LineTable parallel_lines;
+            tokens = ParallelLexer(lexer, threads).Lex(text, parallel_lines);
+        }
+        const double seconds = timer.Seconds() / iterations;
+        if (!SameTokens(tokens, expected)) {
+            std::printf("%u threads: tokens differ from sequential lexing\n", threads);
+            return 1;
+        }
+        const std::string label = std::to_string(threads) + " threads (" + std::to_string(points.size() + 1) +
+                                  " chunks)";
+        PrintThroughput(label.c_str(), text.size(), seconds);
+        std::printf("%28s split pre-pass %.3f ms, speedup %.2fx\n", "", split * 1e3, sequential / seconds);
+    }
+}
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/ParallelParser.h"
+#include "Parser/Parser.h"
+
+// Parse time of a generated crate for growing thread counts, against the
+// sequential parser on the same tokens. Tokens are lexed once up front; each
+// run parses a fresh copy into a fresh arena.
+// Usage: ParallelParseBench [bytes] [max-threads]
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 16u * 1024 * 1024;
+    const uint32_t max_threads = argc > 2 ? std::stoul(argv[2])
+                                          : std::max(8u, std::thread::hardware_concurrency());
+    const std::string text = GenerateBenchCorpus(bytes);
+    const Lexer lexer;
+    TokenArray tokens;
+    uint32_t offset = 0;
+    LineTable lines;
+    Token token;
+    while (lexer.NextParserToken(text, offset, lines, token)) {
+        tokens.push_back(token);
+    }
+
+    BenchTimer timer;
+    const size_t item_count = ParallelParser::FindItemStarts(tokens).size();
+    const double scan_seconds = timer.Seconds();
+    std::printf("%zu bytes, %zu tokens, %zu items, %u hardware threads, item scan %.1f ms\n", text.size(),
+                tokens.size(), item_count, std::thread::hardware_concurrency(), scan_seconds * 1e3);
+
+    // Best of `repeats`, so page faults of the first arena do not count.
+    constexpr int repeats = 3;
+    double sequential_seconds = 1e9;
+    for (int i = 0; i < repeats; i++) {
+        Arena arena;
+        TokenArray copy(tokens);
+        timer.Reset();
+        Parser(arena, std::move(copy), text).ParseCrate();
+        sequential_seconds = std::min(sequential_seconds, timer.Seconds());
+    }
+    std::printf("%10s %12s %10s\n", "threads", "parse ms", "speedup");
+    std::printf("%10s %12.1f %10.2f\n", "sequential", sequential_seconds * 1e3, 1.0);
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+        double seconds = 1e9;
+        for (int i = 0; i < repeats; i++) {
+            Arena arena;
+            TokenArray copy(tokens);
+            timer.Reset();
+            const CrateNode *crate = ParallelParser(threads).ParseCrate(arena, std::move(copy), text);
+            seconds = std::min(seconds, timer.Seconds());
+            if (crate->items_.size() != item_count) {
+                std::printf("item count mismatch: %zu\n", crate->items_.size());
+                return 1;
+            }
+        }
+        std::printf("%10u %12.1f %10.2f\n", threads, seconds * 1e3, sequential_seconds / seconds);
+    }
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/ParallelSemanticChecker.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Semantic checking of the generated corpus with SemanticChecker on one
+// thread and with ParallelSemanticChecker on increasing thread counts. Only
+// the checker is timed; each run collects symbols for a fresh parse first.
+// A second corpus with an error in one of its last functions shows that the
+// parallel check reports the same error. A third declares an impl, a struct
+// and a constant in every body and calls the methods of each impl from the
+// functions before and after it, and reads an array and a bool constant
+// declared after it, once as it is and once with a method defined twice;
+// every thread count must agree with the sequential check, which would not
+// hold if a worker registered an impl another worker uses, or if the
+// constants were declared before the bodies only in parallel.
+// Exits with 1 if any parallel check disagrees with the sequential one.
+// Usage: ParallelSemaBench [bytes] [max-threads] [rounds]
+namespace {
+    struct Outcome {
+        double best = 1e30;
+        std::string error; // empty if the check passed
+    };
+
+    template<typename Check>
+    Outcome Run(const std::string &text, const int rounds, Check check) {
+        Outcome outcome;
+        for (int round = 0; round < rounds; round++) {
+            Arena arena;
+            const Lexer lexer;
+            CrateNode *crate = Parser(arena, lexer, text).ParseCrate();
+            ScopeManager scope_manager;
+            try {
+                SymbolCollector(scope_manager).Visit(crate);
+            } catch (SemanticError &error) {
+                outcome.error = error.description() + " at row " + std::to_string(error.position().GetRow());
+                return outcome;
+            }
+            BenchTimer timer;
+            try {
+                check(scope_manager, crate);
+            } catch (SemanticError &error) {
+                outcome.error = error.description() + " at row " + std::to_string(error.position().GetRow());
+                return outcome;
+            }
+            outcome.best = std::min(outcome.best, timer.Seconds());
+        }
+        return outcome;
+    }
+
+    void Print(const char *label, const Outcome &outcome, const bool matches) {
+        if (outcome.error.empty()) {
+            std::printf("%-12s %10.3f ms", label, outcome.best * 1e3);
+        } else {
+            std::printf("%-12s %s", label, outcome.error.c_str());
+        }
+        std::printf("%s\n", matches ? "" : "   (differs from sequential)");
+    }
+
+    // Whether every thread count agreed with the sequential check.
+    bool Compare(const std::string &text, const uint32_t max_threads, const int rounds) {
+        const Outcome sequential = Run(text, rounds, [](ScopeManager &scope_manager, CrateNode *crate) {
+            SemanticChecker(scope_manager).Visit(crate);
+        });
+        Print("sequential", sequential, true);
+        bool agree = true;
+        for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+            const std::string label = std::to_string(threads) + " threads";
+            const Outcome parallel = Run(text, rounds, [&](ScopeManager &scope_manager, CrateNode *crate) {
+                ParallelSemanticChecker(scope_manager, threads).Check(crate);
+            });
+            const bool matches = parallel.error == sequential.error;
+            Print(label.c_str(), parallel, matches);
+            agree = agree && matches;
+        }
+        return agree;
+    }
+
+    std::string GenerateNestedItemCorpus(const uint32_t functions) {
+        std::string text = "struct Shared {\n    value: i32,\n}\n\n";
+        for (uint32_t i = 0; i < functions; i++) {
+            const std::string id = std::to_string(i);
+            text += "fn nested_" + id + "(base: i32) -> i32 {\n";
+            text += "    struct Local" + id + " {\n        inner: i32,\n    }\n";
+            text += "    const STEP_" + id + ": i32 = " + id + " % 5 + 1;\n";
+            text += "    impl Shared {\n";
+            text += "        fn method_" + id + "(&self) -> i32 {\n";
+            text += "            self.value + " + id + "\n";
+            text += "        }\n";
+            text += "    }\n";
+            text += "    let local: Local" + id + " = Local" + id + " { inner: base * STEP_" + id + " };\n";
+            text += "    let shared: Shared = Shared { value: local.inner };\n";
+            text += "    let mut result: i32 = shared.method_" + id + "();\n";
+            if (i > 0) {
+                text += "    result += shared.method_" + std::to_string(i - 1) + "();\n";
+            }
+            if (i + 1 < functions) {
+                text += "    result += shared.method_" + std::to_string(i + 1) + "();\n";
+            }
+            text += "    let table: [i32; 2] = TABLE_" + id + ";\n";
+            text += "    let flag: bool = FLAG_" + id + ";\n";
+            text += "    if (flag) {\n        result += table[1];\n    }\n";
+            text += "    result\n";
+            text += "}\n\n";
+            text += "const TABLE_" + id + ": [i32; 2] = [" + id + ", 1];\n";
+            text += "const FLAG_" + id + ": bool = " + (i % 2 == 0 ? "true" : "false") + ";\n\n";
+        }
+        text += "fn main() {\n    printlnInt(nested_0(1));\n    exit(0);\n}\n";
+        return text;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 4u * 1024 * 1024;
+    const uint32_t max_threads = argc > 2 ? std::stoul(argv[2]) : 8;
+    const int rounds = argc > 3 ? std::stoi(argv[3]) : 3;
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+    std::string text = GenerateBenchCorpus(bytes);
+    std::printf("%zu bytes\n", text.size());
+    bool agree = Compare(text, max_threads, rounds);
+
+    // `helper_function_0` is the first function; break the last few.
+    const size_t last = text.rfind("fn helper_function_", text.rfind("fn helper_function_") - 1);
+    text.insert(text.find('{', last) + 1, "\n    let broken: i32 = true;");
+    std::printf("\nwith a type error near the end\n");
+    agree = Compare(text, max_threads, 1) && agree;
+
+    std::string nested = GenerateNestedItemCorpus(256);
+    std::printf("\nwith items declared in every body, %zu bytes\n", nested.size());
+    agree = Compare(nested, max_threads, rounds) && agree;
+
+    // Defines `method_1` again in the last body, after bodies that call it.
+    nested.insert(nested.rfind("    impl Shared {\n") + 18,
+                  "        fn method_1(&self) -> i32 {\n            0\n        }\n");
+    std::printf("\nwith a method defined twice\n");
+    agree = Compare(nested, max_threads, 1) && agree;
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstdio>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+
+// Counts the C++ exceptions thrown while parsing every file of a testcase
+// directory, and times the parse. Throws and rethrows are counted by
+// interposing __cxa_throw and __cxa_rethrow, so speculative parses that
+// backtrack by throwing show up alongside the final error of rejected files.
+// Usage: ParseThrowBench [dir] [iterations]
+namespace {
+    uint64_t throw_count = 0;
+    uint64_t rethrow_count = 0;
+}
+
+void __cxxabiv1::__cxa_throw(void *thrown, std::type_info *type, void (*destructor)(void *)) {
+    using Throw = void (*)(void *, std::type_info *, void (*)(void *));
+    static const auto real = reinterpret_cast<Throw>(dlsym(RTLD_NEXT, "__cxa_throw"));
+    throw_count++;
+    real(thrown, type, destructor);
+    __builtin_unreachable();
+}
+
+void __cxxabiv1::__cxa_rethrow() {
+    using Rethrow = void (*)();
+    static const auto real = reinterpret_cast<Rethrow>(dlsym(RTLD_NEXT, "__cxa_rethrow"));
+    rethrow_count++;
+    real();
+    __builtin_unreachable();
+}
+
+int main(int argc, char *argv[]) {
+    const std::string dir = argc > 1 ? argv[1] : "testcases/Parser";
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 50;
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry: std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() == ".rx") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    const Lexer lexer;
+    uint64_t total_throws = 0;
+    uint64_t total_rethrows = 0;
+    double total_seconds = 0;
+    std::printf("%-24s %10s %10s %10s %12s\n", "file", "tokens", "throws", "rethrows", "parse us");
+    for (const auto &path: paths) {
+        const std::string text = ReadBenchFile(path.string());
+        TokenArray tokens;
+        try {
+            uint32_t offset = 0;
+            LineTable lines;
+            Token token;
+            while (lexer.NextParserToken(text, offset, lines, token)) {
+                tokens.push_back(token);
+            }
+        } catch (const LexError &) {
+            std::printf("%-24s %10s\n", path.filename().c_str(), "lex error");
+            continue;
+        }
+
+        bool rejected = false;
+        throw_count = 0;
+        rethrow_count = 0;
+        BenchTimer timer;
+        for (int i = 0; i < iterations; i++) {
+            Arena arena;
+            Parser parser(arena, TokenArray(tokens), text);
+            try {
+                parser.ParseCrate();
+            } catch (const ParseError &) {
+                rejected = true;
+            }
+        }
+        const double seconds = timer.Seconds() / iterations;
+        const uint64_t throws = throw_count / iterations;
+        const uint64_t rethrows = rethrow_count / iterations;
+        total_throws += throws;
+        total_rethrows += rethrows;
+        total_seconds += seconds;
+        std::printf("%-24s %10zu %10llu %10llu %12.1f%s\n", path.filename().c_str(), tokens.size(),
+                    static_cast<unsigned long long>(throws), static_cast<unsigned long long>(rethrows),
+                    seconds * 1e6, rejected ? "  (rejected)" : "");
+    }
+    std::printf("%-24s %10s %10llu %10llu %12.1f\n", "total", "", static_cast<unsigned long long>(total_throws),
+                static_cast<unsigned long long>(total_rethrows), total_seconds * 1e6);
+}
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Lexer/ScanKernels.h"
+
+// Scalar vs. SSE2 vs. AVX2 scan kernels on a comment-heavy corpus: each
+// kernel on its own, then the whole lexer with that kernel set active.
+// Usage: ScanBench [corpus-bytes] [iterations]
+namespace {
+    constexpr scan::Isa isas[] = {scan::Isa::Scalar, scan::Isa::SSE2, scan::Isa::AVX2};
+
+    // Deeply indented code where long comments and long identifiers make up
+    // most of the bytes, like the output of our code generators.
+    std::string GenerateCommentCorpus(const size_t bytes) {
+        std::string text;
+        text.reserve(bytes + 1024);
+        uint32_t count = 0;
+        while (text.size() < bytes) {
+            const std::string id = std::to_string(count++);
+            text += "/* ------------------------------------------------------------------\n";
+            text += " * generated block " + id + ": the values below are derived from the\n";
+            text += " * configuration table and must not be edited by hand.\n";
+            text += " * ------------------------------------------------------------------ */\n";
+            text += "fn generated_configuration_accessor_" + id + "(configuration_table_index: i32) -> i32 {\n";
+            text += "                // look up the entry, falling back to the default when absent\n";
+            text += "                let resolved_configuration_value: i32 = configuration_table_index * 2;\n";
+            text += "                                                                        \n";
+            text += "                return resolved_configuration_value; // done with block " + id + "\n";
+            text += "}\n\n";
+        }
+        return text;
+    }
+
+    // Every kernel must agree with the scalar one at every start offset.
+    bool CrossCheck(const scan::Kernels &kernels) {
+        const scan::Kernels &scalar = scan::Select(scan::Isa::Scalar);
+        std::mt19937 rng(7);
+        const char alphabet[] = " \t\r\n/*_azAZ09@[`{\x80\xff";
+        std::string text(4096, ' ');
+        // Long runs of one class with occasional bytes from the whole alphabet.
+        for (size_t i = 0; i < text.size(); i++) {
+            text[i] = rng() % 4 == 0 ? alphabet[rng() % (sizeof(alphabet) - 1)] : i / 64 % 2 ? 'a' : ' ';
+        }
+        const char *end = text.data() + text.size();
+        for (const char *begin = text.data(); begin <= end; begin++) {
+            if (kernels.skip_whitespace(begin, end) != scalar.skip_whitespace(begin, end) ||
+                kernels.find_line_end(begin, end) != scalar.find_line_end(begin, end) ||
+                kernels.find_comment_delimiter(begin, end) != scalar.find_comment_delimiter(begin, end) ||
+                kernels.skip_identifier(begin, end) != scalar.skip_identifier(begin, end)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Calls `kernel` from every position where its run starts (the byte after
+    // the previous run ended), so each call covers one whitespace run, one
+    // identifier, or the gap to the next newline / comment delimiter.
+    double TimeKernel(const char *(*kernel)(const char *, const char *), const std::string &text,
+                      const int iterations, size_t &sink) {
+        const char *end = text.data() + text.size();
+        std::vector<const char *> starts;
+        for (const char *cur = text.data(); cur < end; cur++) {
+            starts.push_back(cur);
+            cur = kernel(cur, end);
+        }
+        BenchTimer timer;
+        for (int i = 0; i < iterations; i++) {
+            for (const char *start: starts) {
+                sink += kernel(start, end) - start;
+            }
+        }
+        return timer.Seconds();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 16u * 1024 * 1024;
+    const int iterations = argc > 2 ? std::stoi(argv[2]) : 5;
+    const std::string text = GenerateCommentCorpus(bytes);
+    const size_t total = text.size() * iterations;
+    std::printf("active kernels: %s\n", scan::IsaName(scan::Active().isa));
+
+    size_t sink = 0;
+    for (const scan::Isa isa: isas) {
+        if (!scan::Supported(isa)) {
+            std::printf("%s not supported\n", scan::IsaName(isa));
+            continue;
+        }
+        const scan::Kernels &kernels = scan::Select(isa);
+        if (!CrossCheck(kernels)) {
+            std::printf("%s kernels disagree with scalar\n", scan::IsaName(isa));
+            return 1;
+        }
+        const std::string name = scan::IsaName(isa);
+        PrintThroughput((name + " skip_whitespace").c_str(), total,
+                        TimeKernel(kernels.skip_whitespace, text, iterations, sink));
+        PrintThroughput((name + " find_line_end").c_str(), total,
+                        TimeKernel(kernels.find_line_end, text, iterations, sink));
+        PrintThroughput((name + " find_comment_delimiter").c_str(), total,
+                        TimeKernel(kernels.find_comment_delimiter, text, iterations, sink));
+        PrintThroughput((name + " skip_identifier").c_str(), total,
+                        TimeKernel(kernels.skip_identifier, text, iterations, sink));
+
+        scan::SetActive(isa);
+        const Lexer lexer;
+        BenchTimer timer;
+        for (int i = 0; i < iterations; i++) {
+            uint32_t offset = 0;
+            while (offset < text.size()) {
+                Token token = lexer.GetNextToken(text, offset);
+                sink += token.length;
+            }
+        }
+        PrintThroughput((name + " lex").c_str(), total, timer.Seconds());
+    }
+    std::printf("(%zu)\n", sink);
+}
@@ -0,0 +1,92 @@
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <string>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "IR/IRBuilder.h"
+#include "IR/IRProgram.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Name resolution under deep scope nesting: a function whose body is blocks
+// nested `depth` deep, each declaring a local from its parent's and reading
+// the function's first local and the global constant. When every lookup
+// walked the scope chain outwards, resolving those names (and every `i32`)
+// cost time proportional to the depth, so the passes were quadratic in it;
+// with per-name binding stacks each lookup is a single hash probe. Every
+// depth is checked and lowered to IR in a child process, since the passes
+// keep their state in globals.
+// Usage: ScopeNestingBench [max-depth] [lookups-per-block]
+ScopeManager scope_manager;
+IRManager ir_manager;
+std::shared_ptr<IRProgram> ir_program;
+
+namespace {
+    std::string NestedScopes(const size_t depth, const size_t lookups) {
+        std::string text = "const LIMIT: i32 = 7;\n\nfn main() {\n    let mut x: i32 = 0;\n    let v0: i32 = 1;\n";
+        for (size_t i = 1; i <= depth; i++) {
+            const std::string id = std::to_string(i);
+            text += "{ let v" + id + ": i32 = v" + std::to_string(i - 1) + " + LIMIT;";
+            for (size_t j = 0; j < lookups; j++) {
+                text += " x = x + v" + id + ";";
+            }
+            text += "\n";
+        }
+        text += std::string(depth, '}');
+        text += "\n    printlnInt(x);\n    exit(0);\n}\n";
+        return text;
+    }
+
+    void Compile(const std::string &text) {
+        Arena arena;
+        const Lexer lexer;
+        CrateNode *crate = Parser(arena, lexer, text).ParseCrate();
+        BenchTimer timer;
+        SymbolCollector(scope_manager).Visit(crate);
+        SemanticChecker(scope_manager).Visit(crate);
+        const double semantic_seconds = timer.Seconds();
+        timer.Reset();
+        ir_program = std::make_shared<IRProgram>();
+        IRBuilder(scope_manager, ir_manager).Visit(crate);
+        const double ir_seconds = timer.Seconds();
+        std::printf(" %10.1f %10.1f\n", semantic_seconds * 1e3, ir_seconds * 1e3);
+    }
+
+    bool Run(const size_t depth, const size_t lookups) {
+        const std::string text = NestedScopes(depth, lookups);
+        std::printf("%8zu %10zu KiB", depth, text.size() / 1024);
+        std::fflush(stdout);
+        const pid_t child = fork();
+        if (child == 0) {
+            try {
+                Compile(text);
+            } catch (std::exception &error) {
+                std::printf("  %s\n", error.what());
+                std::fflush(stdout);
+                _exit(1);
+            }
+            std::fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (WIFSIGNALED(status)) {
+            std::printf("  killed by signal %d\n", WTERMSIG(status));
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t max_depth = argc > 1 ? std::stoul(argv[1]) : 10000;
+    const size_t lookups = argc > 2 ? std::stoul(argv[2]) : 4;
+    std::printf("%8s %14s %10s %10s\n", "depth", "source", "sema ms", "IR ms");
+    bool ok = true;
+    for (size_t depth = max_depth / 8; depth <= max_depth; depth *= 2) {
+        ok &= Run(depth, lookups);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Time of each semantic pass on the generated corpus, or on a file: the item
+// pass (SymbolCollector, which also evaluates the item constants and resolves
+// the signatures) and the body walk (SemanticChecker). The node count is how
+// many nodes the parser built, abandoned alternatives included; the item pass
+// should reach only a small part of them.
+// Usage: SemanticPassBench [bytes | file] [rounds]
+
+int main(int argc, char *argv[]) {
+    const std::string arg = argc > 1 ? argv[1] : "";
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 5;
+    const bool is_size = !arg.empty() && arg.find_first_not_of("0123456789") == std::string::npos;
+    const std::string text = arg.empty() || is_size
+                                 ? GenerateBenchCorpus(is_size ? std::stoul(arg) : 4u * 1024 * 1024)
+                                 : ReadBenchFile(arg);
+
+    double items = 1e30, check = 1e30;
+    size_t nodes = 0;
+    for (int round = 0; round < rounds; round++) {
+        Arena arena;
+        const Lexer lexer;
+        CrateNode *crate = Parser(arena, lexer, text).ParseCrate();
+        nodes = arena.object_count();
+        ScopeManager scope_manager;
+        BenchTimer timer;
+        SymbolCollector(scope_manager).Visit(crate);
+        items = std::min(items, timer.Seconds());
+        timer.Reset();
+        SemanticChecker(scope_manager).Visit(crate);
+        check = std::min(check, timer.Seconds());
+    }
+    std::printf("%zu bytes, %zu nodes\n", text.size(), nodes);
+    std::printf("%-10s %10.3f ms\n", "items", items * 1e3);
+    std::printf("%-10s %10.3f ms\n", "bodies", check * 1e3);
+    std::printf("%-10s %10.3f ms\n", "total", (items + check) * 1e3);
+}
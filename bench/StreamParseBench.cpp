@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+
+// Lex-then-parse against streaming (pull tokens while parsing) for growing
+// inputs. The streaming column's peak token buffer stays flat as input grows.
+// Usage: StreamParseBench [max-bytes]
+int main(int argc, char *argv[]) {
+    const size_t max_bytes = argc > 1 ? std::stoul(argv[1]) : 10u * 1024 * 1024;
+    const Lexer lexer;
+    std::printf("%12s %12s %12s %14s %12s %14s\n", "bytes", "tokens", "batch ms", "batch buffer",
+                "stream ms", "stream buffer");
+    for (size_t bytes = 10 * 1024; bytes <= max_bytes; bytes *= 10) {
+        const std::string text = GenerateBenchCorpus(bytes);
+
+        BenchTimer timer;
+        TokenArray tokens;
+        uint32_t offset = 0;
+        LineTable lines;
+        Token token;
+        while (lexer.NextParserToken(text, offset, lines, token)) {
+            tokens.push_back(token);
+        }
+        const size_t token_count = tokens.size();
+        Arena batch_arena;
+        Parser batch(batch_arena, std::move(tokens), text);
+        batch.ParseCrate();
+        const double batch_seconds = timer.Seconds();
+
+        timer.Reset();
+        Arena stream_arena;
+        Parser stream(stream_arena, lexer, text);
+        stream.ParseCrate();
+        const double stream_seconds = timer.Seconds();
+
+        std::printf("%12zu %12zu %12.3f %14u %12.3f %14u\n", text.size(), token_count, batch_seconds * 1e3,
+                    batch.peak_token_window(), stream_seconds * 1e3, stream.peak_token_window());
+    }
+}
@@ -0,0 +1,152 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+
+// Token records in the old array-of-structs layout (a 24-byte Token with a
+// 4-byte type) against TokenArray, which keeps a byte per type apart from
+// 16-byte spans and 4-byte atoms. Two workloads:
+//  - "scan": the parser's inner loop reduced to its essence, a type test per
+//    token (the bracket-depth walk of ParallelParser::FindItemStarts) over
+//    both layouts;
+//  - "parse": a full Parser::ParseCrate over TokenArray.
+// Cache misses and instructions are read with perf_event_open, the counters
+// `perf stat -e cache-misses,L1-dcache-load-misses` reports; where the kernel
+// refuses (perf_event_paranoid, containers) the columns print n/a.
+// Usage: TokenLayoutBench [bytes] [rounds]
+namespace {
+    struct LegacyToken {
+        enum class Type : uint32_t {} type{};
+        uint32_t length = 0;
+        Position pos{};
+        uint32_t atom = 0;
+    };
+
+    class Counter {
+        int fd_ = -1;
+
+    public:
+        Counter(const uint32_t type, const uint64_t config) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        ~Counter() {
+            if (fd_ >= 0) close(fd_);
+        }
+
+        void Start() const {
+            if (fd_ < 0) return;
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+
+        // -1 when the counter could not be opened.
+        [[nodiscard]] long long Stop() const {
+            if (fd_ < 0) return -1;
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            return read(fd_, &value, sizeof(value)) == sizeof(value) ? value : -1;
+        }
+    };
+
+    struct Counters {
+        Counter cache_misses{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        Counter l1_misses{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                                               PERF_COUNT_HW_CACHE_RESULT_MISS << 16};
+        Counter instructions{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+
+        template<typename Work>
+        void Measure(const char *label, const size_t tokens, Work work) {
+            cache_misses.Start();
+            l1_misses.Start();
+            instructions.Start();
+            BenchTimer timer;
+            work();
+            const double seconds = timer.Seconds();
+            const long long l1 = l1_misses.Stop();
+            const long long llc = cache_misses.Stop();
+            const long long executed = instructions.Stop();
+            std::printf("%-14s %10.3f ms %14s %14s %14s\n", label, seconds * 1e3, Format(llc, tokens).c_str(),
+                        Format(l1, tokens).c_str(), Format(executed, tokens).c_str());
+        }
+
+        static std::string Format(const long long count, const size_t tokens) {
+            if (count < 0) return "n/a";
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(count) / tokens);
+            return buffer;
+        }
+    };
+
+    template<typename TypeAt>
+    int32_t BracketDepth(const size_t count, TypeAt type_at) {
+        int32_t depth = 0;
+        int32_t deepest = 0;
+        for (size_t i = 0; i < count; i++) {
+            switch (type_at(i)) {
+                case TokenType::LParen:
+                case TokenType::LBracket:
+                case TokenType::LBrace:
+                    depth++;
+                    if (depth > deepest) deepest = depth;
+                    break;
+                case TokenType::RParen:
+                case TokenType::RBracket:
+                case TokenType::RBrace:
+                    depth--;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return deepest;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 64u * 1024 * 1024;
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 3;
+    const std::string text = GenerateBenchCorpus(bytes);
+    const Lexer lexer;
+    TokenArray tokens;
+    std::vector<LegacyToken> legacy;
+    uint32_t offset = 0;
+    LineTable lines;
+    Token token;
+    while (lexer.NextParserToken(text, offset, lines, token)) {
+        tokens.push_back(token);
+        legacy.push_back(LegacyToken{static_cast<LegacyToken::Type>(token.type), token.length, token.pos, token.atom});
+    }
+    const size_t count = tokens.size();
+
+    std::printf("%zu bytes, %zu tokens; %zu bytes/token array-of-structs, %zu bytes/token split\n", text.size(),
+                count, sizeof(LegacyToken), sizeof(TokenType) + sizeof(TokenSpan) + sizeof(Atom));
+    std::printf("%-14s %13s %14s %14s %14s\n", "", "time", "LLC miss/tok", "L1D miss/tok", "instr/tok");
+    Counters counters;
+    volatile int32_t sink = 0; // keeps the scans from being optimized out
+    for (int round = 0; round < rounds; round++) {
+        counters.Measure("scan legacy", count, [&] {
+            sink += BracketDepth(count, [&](const size_t i) { return static_cast<TokenType>(legacy[i].type); });
+        });
+        counters.Measure("scan split", count, [&] {
+            sink += BracketDepth(count, [&](const size_t i) { return tokens.type(i); });
+        });
+        Arena arena;
+        Parser parser(arena, TokenArray(tokens), text);
+        counters.Measure("parse split", count, [&] { parser.ParseCrate(); });
+    }
+}
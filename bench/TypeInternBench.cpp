@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/SemanticChecker.h"
+#include "Semantic/SymbolCollector.h"
+
+// Semantic checking of a crate dense in array and reference types, with the
+// TypeContext's count of types asked for against types actually built;
+// before interning every request allocated a fresh object. The second part
+// compares the function signatures of the crate pairwise, once with a
+// re-implementation of the old recursive structural equality and once with
+// Type::equal.
+// Usage: TypeInternBench [bytes] [rounds]
+namespace {
+    std::string GenerateTypedCorpus(const size_t bytes) {
+        std::string text;
+        text.reserve(bytes + 1024);
+        uint32_t count = 0;
+        while (text.size() < bytes) {
+            const std::string id = std::to_string(count++);
+            const std::string width = std::to_string(4 + count % 8);
+            const std::string row = "[i32; " + width + "]";
+            text += "fn typed_" + id + "(grid: &mut [" + row + "; 8], line: &" + row + ", flags: [bool; 4]) -> i32 {\n";
+            text += "    let copy: [" + row + "; 8] = *grid;\n";
+            text += "    let local: " + row + " = [0; " + width + "];\n";
+            text += "    let again: &" + row + " = line;\n";
+            text += "    let other: &" + row + " = &local;\n";
+            text += "    let rows: [&" + row + "; 2] = [again, other];\n";
+            text += "    grid[1][2] = copy[3][1] + again[2] + other[3] + rows[1][0];\n";
+            text += "    if (flags[0]) {\n";
+            text += "        return local[1];\n";
+            text += "    }\n";
+            text += "    return line[0];\n";
+            text += "}\n\n";
+        }
+        text += "fn main() {\n    exit(0);\n}\n";
+        return text;
+    }
+
+    // Type::equal as it was before the types were interned.
+    bool StructuralEqual(const std::shared_ptr<Type> &lhs, const std::shared_ptr<Type> &rhs) {
+        if (!rhs || lhs->getKind() != rhs->getKind()) return false;
+        switch (lhs->getKind()) {
+            case TypeKind::Primitive:
+                return static_cast<const PrimitiveType &>(*lhs).name_ == static_cast<const PrimitiveType &>(*rhs).name_;
+            case TypeKind::Array: {
+                const auto &a = static_cast<const ArrayType &>(*lhs);
+                const auto &b = static_cast<const ArrayType &>(*rhs);
+                return a.length_ == b.length_ && StructuralEqual(a.base_, b.base_);
+            }
+            case TypeKind::Reference: {
+                const auto &a = static_cast<const ReferenceType &>(*lhs);
+                const auto &b = static_cast<const ReferenceType &>(*rhs);
+                if (a.is_mut_ != b.is_mut_ && a.is_mut_) return false;
+                return StructuralEqual(a.type_, b.type_);
+            }
+            case TypeKind::Function: {
+                const auto &a = static_cast<const FunctionType &>(*lhs);
+                const auto &b = static_cast<const FunctionType &>(*rhs);
+                if (!StructuralEqual(a.ret_, b.ret_) || a.params_.size() != b.params_.size()) return false;
+                for (size_t i = 0; i < a.params_.size(); i++) {
+                    if (!StructuralEqual(a.params_[i], b.params_[i])) return false;
+                }
+                return true;
+            }
+            default:
+                return lhs->equal(rhs);
+        }
+    }
+
+    template<typename Equal>
+    void Compare(const char *label, const std::vector<std::shared_ptr<Type> > &types, const int rounds, Equal equal) {
+        double best = 1e30;
+        size_t matches = 0;
+        for (int round = 0; round < rounds; round++) {
+            matches = 0;
+            BenchTimer timer;
+            for (size_t i = 0; i < types.size(); i++) {
+                matches += equal(types[i], types[(i + 8) % types.size()]);
+                matches += equal(types[i], types[i]);
+            }
+            best = std::min(best, timer.Seconds());
+        }
+        const double compares = 2.0 * static_cast<double>(types.size());
+        std::printf("%-12s %10.3f ms %8.2f ns/compare %10zu equal\n", label, best * 1e3, best * 1e9 / compares,
+                    matches);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 4u * 1024 * 1024;
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 5;
+    const std::string text = GenerateTypedCorpus(bytes);
+    ScopeManager scope_manager;
+    const size_t builtin_requests = GlobalTypeContext().requests();
+
+    Arena arena;
+    const Lexer lexer;
+    CrateNode *crate = Parser(arena, lexer, text).ParseCrate();
+    BenchTimer timer;
+    SymbolCollector(scope_manager).Visit(crate);
+    SemanticChecker(scope_manager).Visit(crate);
+    const double seconds = timer.Seconds();
+
+    const size_t requests = GlobalTypeContext().requests() - builtin_requests;
+    std::printf("%zu bytes, %zu items\n", text.size(), crate->items_.size());
+    std::printf("semantic check %10.3f ms\n", seconds * 1e3);
+    std::printf("types requested %9zu (one allocation each without interning)\n", requests);
+    std::printf("types built     %9zu\n", GlobalTypeContext().size());
+
+    std::vector<std::shared_ptr<Type> > signatures;
+    for (const auto &[atom, symbol]: scope_manager.root->symbols()) {
+        if (symbol.type_ && symbol.type_->getKind() == TypeKind::Function) {
+            signatures.push_back(symbol.type_);
+        }
+    }
+    std::printf("%zu function signatures compared pairwise\n", signatures.size());
+    Compare("structural", signatures, rounds, StructuralEqual);
+    Compare("interned", signatures, rounds,
+            [](const std::shared_ptr<Type> &lhs, const std::shared_ptr<Type> &rhs) { return lhs->equal(rhs); });
+}
@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BenchUtil.h"
+#include "Lexer/Lexer.h"
+#include "Parser/Parser.h"
+#include "Semantic/RecursiveASTVisitor.h"
+
+// Cost of walking a parsed crate with RecursiveASTVisitor, the base of the
+// semantic passes and IRBuilder. "default" is a pass that overrides nothing,
+// so it times accept() dispatch and the default visits alone; "counting"
+// overrides the visit() of every node class, the way a pass overrides the
+// ones it handles, and counts the nodes reached. Pass a small size to keep
+// the tree in cache and measure dispatch alone; on a large crate the walk
+// waits on memory.
+// Usage: VisitorBench [bytes] [rounds]
+namespace {
+    class DefaultWalker final : public RecursiveASTVisitor {
+    };
+
+    class NodeCounter final : public RecursiveASTVisitor {
+    public:
+        size_t count = 0;
+
+#define AST_KIND(Kind) \
+        void visit(Kind##Node *node) override { \
+            count++; \
+            RecursiveASTVisitor::visit(node); \
+        }
+        AST_KIND(PathIndentSegment)
+        AST_KIND(Crate)
+        AST_KIND(VisItem)
+        AST_KIND(Function)
+        AST_KIND(Struct)
+        AST_KIND(Enumeration)
+        AST_KIND(ConstantItem)
+        AST_KIND(AssociatedItem)
+        AST_KIND(Trait)
+        AST_KIND(Implementation)
+        AST_KIND(InherentImpl)
+        AST_KIND(TraitImpl)
+        AST_KIND(FunctionParameters)
+        AST_KIND(SelfParam)
+        AST_KIND(ShortHandSelf)
+        AST_KIND(TypedSelf)
+        AST_KIND(FunctionParam)
+        AST_KIND(FunctionParamPattern)
+        AST_KIND(StructField)
+        AST_KIND(EnumVariant)
+        AST_KIND(EnumVariantStruct)
+        AST_KIND(EnumVariantDiscriminant)
+        AST_KIND(Expression)
+        AST_KIND(ExpressionWithBlock)
+        AST_KIND(BlockExpression)
+        AST_KIND(LoopExpression)
+        AST_KIND(InfiniteLoopExpression)
+        AST_KIND(PredicateLoopExpression)
+        AST_KIND(IfExpression)
+        AST_KIND(MatchExpression)
+        AST_KIND(ExpressionWithoutBlock)
+        AST_KIND(ContinueExpression)
+        AST_KIND(TupleExpression)
+        AST_KIND(UnderscoreExpression)
+        AST_KIND(JumpExpression)
+        AST_KIND(AssignmentExpression)
+        AST_KIND(LogicOrExpression)
+        AST_KIND(LogicAndExpression)
+        AST_KIND(ComparisonExpression)
+        AST_KIND(BitwiseOrExpression)
+        AST_KIND(BitwiseXorExpression)
+        AST_KIND(BitwiseAndExpression)
+        AST_KIND(ShiftExpression)
+        AST_KIND(AddMinusExpression)
+        AST_KIND(MulDivModExpression)
+        AST_KIND(TypeCastExpression)
+        AST_KIND(UnaryExpression)
+        AST_KIND(FunctionCallExpression)
+        AST_KIND(ArrayIndexExpression)
+        AST_KIND(MemberAccessExpression)
+        AST_KIND(GroupedExpression)
+        AST_KIND(StructExpression)
+        AST_KIND(PathExpression)
+        AST_KIND(PathInExpression)
+        AST_KIND(LiteralExpression)
+        AST_KIND(CharLiteral)
+        AST_KIND(StringLiteral)
+        AST_KIND(IntLiteral)
+        AST_KIND(BoolLiteral)
+        AST_KIND(CStringLiteral)
+        AST_KIND(ArrayLiteral)
+        AST_KIND(StructExprFields)
+        AST_KIND(StructExprField)
+        AST_KIND(StructBase)
+        AST_KIND(Conditions)
+        AST_KIND(LetChain)
+        AST_KIND(LetChainCondition)
+        AST_KIND(Statements)
+        AST_KIND(MatchArms)
+        AST_KIND(MatchArm)
+        AST_KIND(Statement)
+        AST_KIND(EmptyStatement)
+        AST_KIND(LetStatement)
+        AST_KIND(ExpressionStatement)
+        AST_KIND(VisItemStatement)
+        AST_KIND(Pattern)
+        AST_KIND(PatternNoTopAlt)
+        AST_KIND(PatternWithoutRange)
+        AST_KIND(LiteralPattern)
+        AST_KIND(IdentifierPattern)
+        AST_KIND(WildcardPattern)
+        AST_KIND(RestPattern)
+        AST_KIND(GroupedPattern)
+        AST_KIND(SlicePattern)
+        AST_KIND(PathPattern)
+        AST_KIND(Type)
+        AST_KIND(TypeNoBounds)
+        AST_KIND(ParenthesizedType)
+        AST_KIND(TypePath)
+        AST_KIND(UnitType)
+        AST_KIND(ArrayType)
+        AST_KIND(SliceType)
+        AST_KIND(ReferenceType)
+        AST_KIND(TypePathSegment)
+#undef AST_KIND
+    };
+
+    template<typename Walker>
+    double Time(ASTNode *crate, const int rounds) {
+        double best = 1e30;
+        for (int i = 0; i < rounds; i++) {
+            Walker walker;
+            BenchTimer timer;
+            walker.Visit(crate);
+            const double seconds = timer.Seconds();
+            if (seconds < best) best = seconds;
+        }
+        return best;
+    }
+
+    void Report(const char *label, const size_t nodes, const double seconds) {
+        std::printf("%-10s %12zu nodes %10.3f ms %8.2f ns/node\n", label, nodes, seconds * 1e3,
+                    seconds * 1e9 / static_cast<double>(nodes));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t bytes = argc > 1 ? std::stoul(argv[1]) : 16u * 1024 * 1024;
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 5;
+    const std::string text = GenerateBenchCorpus(bytes);
+    const Lexer lexer;
+    TokenArray tokens;
+    uint32_t offset = 0;
+    LineTable lines;
+    Token token;
+    while (lexer.NextParserToken(text, offset, lines, token)) {
+        tokens.push_back(token);
+    }
+    Arena arena;
+    Parser parser(arena, std::move(tokens), text);
+    ASTNode *crate = parser.ParseCrate();
+
+    std::printf("%zu bytes\n", text.size());
+    NodeCounter counter;
+    counter.Visit(crate);
+    Report("default", counter.count, Time<DefaultWalker>(crate, rounds));
+    Report("counting", counter.count, Time<NodeCounter>(crate, rounds));
+}
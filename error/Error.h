@@ -19,6 +19,19 @@ private:
     std::string message;
 };
 
+class InputError : public std::exception {
+public:
+    explicit InputError(std::string msg) : message(std::move(msg)) {
+    }
+
+    [[nodiscard]] const char *what() const noexcept override {
+        return message.c_str();
+    }
+
+private:
+    std::string message;
+};
+
 class ParseError : public std::exception {
 public:
     explicit ParseError(std::string msg, Position pos) : message(std::move(msg)), pos(pos) {
@@ -45,6 +58,16 @@ public:
         return message.c_str();
     }
 
+    // Row 0 when the error was raised without a position.
+    [[nodiscard]] Position position() const {
+        return pos;
+    }
+
+    // The message alone; what() also prints the row.
+    [[nodiscard]] const std::string &description() const {
+        return message;
+    }
+
 private:
     Position pos;
     std::string message;
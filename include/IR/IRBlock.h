@@ -14,17 +14,18 @@ class IRBasicBlock : public IRNode {
 public:
     std::string label;
 	std::string true_label;
+	Atom true_atom;
     std::vector<std::shared_ptr<IRInstruction>> instructions;
 	std::map<std::string, uint32_t> last_variable_index;
 
     explicit IRBasicBlock(const std::string& label)
         : label(label) {
-	    if (ir_manager.label_count.find(label) == ir_manager.label_count.end()) {
-		    ir_manager.label_count[label] = 0;
-	    } else {
-		    ir_manager.label_count[label]++;
+	    auto [it, inserted] = ir_manager.label_count.try_emplace(GlobalInterner().Intern(label), 0);
+	    if (!inserted) {
+		    it->second++;
 	    }
-    	true_label = label + "." + std::to_string(ir_manager.label_count[label]);
+    	true_label = label + "." + std::to_string(it->second);
+    	true_atom = GlobalInterner().Intern(true_label);
     }
 
     void accept(IRVisitor *visitor) override { visitor->visit(this); }
@@ -18,11 +18,14 @@ class IRVisitor;
 class IRLiteral;
 
 /**************** ENUM TYPES ****************/
-enum class OpType {
+// Also the kind tag behind classof(): each instruction class that groups
+// several opcodes covers a contiguous range.
+enum class OpType : uint8_t {
     Ret, CondBr, UncondBr,
-    Add, Sub, Mul, SDiv, Srem, Shl, AShr, And, Or, Xor,
+    Add, Sub, Mul, SDiv, UDiv, Srem, Urem, Shl, AShr, And, Or, Xor,
     Alloca, Load, Store, GetElementPtr,
-    ICmp, CallWithRet, CallWithoutRet, Phi, Select, UDiv, Urem
+    CallWithRet, CallWithoutRet,
+    ICmp, Phi, Select, Zext, StructDef, GlobalVarDef, ConstVarDef, Unreachable
 };
 
 /**************** BASE CLASS ****************/
@@ -32,6 +35,8 @@ protected:
 public:
     IRInstruction() = default;
 
+	[[nodiscard]] OpType GetOpType() const { return op_type; }
+
 	void print() override {}
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
 };
@@ -41,7 +46,13 @@ class UnreachableInstruction: public IRInstruction {
 		std::cout << "\tunreachable";
 	}
 	public:
+	UnreachableInstruction() {
+		op_type = OpType::Unreachable;
+	}
+
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Unreachable; }
 };
 
 class BinaryOpInstruction : public IRInstruction {
@@ -56,6 +67,10 @@ public:
             : result(result), type(type), op1(op1), op2(op2) {
         this->op_type = op_type;
     }
+
+	static bool classof(const IRInstruction *inst) {
+		return inst->GetOpType() >= OpType::Add && inst->GetOpType() <= OpType::Xor;
+	}
 };
 
 class ControlInstruction : public IRInstruction {
@@ -63,6 +78,10 @@ public:
     explicit ControlInstruction(OpType op_type) {
         this->op_type = op_type;
     }
+
+	static bool classof(const IRInstruction *inst) {
+		return inst->GetOpType() >= OpType::Ret && inst->GetOpType() <= OpType::UncondBr;
+	}
 };
 
 class MemoryInstruction : public IRInstruction {
@@ -70,6 +89,10 @@ public:
     explicit MemoryInstruction(OpType op_type) {
         this->op_type = op_type;
     }
+
+	static bool classof(const IRInstruction *inst) {
+		return inst->GetOpType() >= OpType::Alloca && inst->GetOpType() <= OpType::GetElementPtr;
+	}
 };
 
 /**************** DERIVED CLASS ****************/
@@ -108,6 +131,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Add; }
 };
 
 class SubInstruction : public BinaryOpInstruction {
@@ -135,6 +160,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Sub; }
 };
 
 class MulInstruction : public BinaryOpInstruction {
@@ -154,6 +181,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Mul; }
 };
 
 class SDivInstruction : public BinaryOpInstruction {
@@ -173,6 +202,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::SDiv; }
 };
 
 class UDivInstruction : public BinaryOpInstruction {
@@ -192,6 +223,8 @@ public:
 		op2->print();
 	}
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::UDiv; }
 };
 
 
@@ -212,6 +245,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Srem; }
 };
 
 class UremInstruction : public BinaryOpInstruction {
@@ -231,6 +266,8 @@ public:
 		op2->print();
 	}
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Urem; }
 };
 
 class ShlInstruction : public BinaryOpInstruction {
@@ -250,6 +287,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Shl; }
 };
 
 class AShrInstruction : public BinaryOpInstruction {
@@ -269,6 +308,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::AShr; }
 };
 
 class AndInstruction : public BinaryOpInstruction {
@@ -288,6 +329,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::And; }
 };
 
 class OrInstruction : public BinaryOpInstruction {
@@ -307,6 +350,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Or; }
 };
 
 class XorInstruction : public BinaryOpInstruction {
@@ -326,6 +371,8 @@ public:
     	op2->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Xor; }
 };
 
 class RetInstruction : public ControlInstruction {
@@ -347,6 +394,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Ret; }
 };
 
 
@@ -367,6 +416,8 @@ public:
     	std::cout << ", label %" << if_true << ", label %" << if_false;
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::CondBr; }
 };
 
 class UnconditionalBrInstruction : public ControlInstruction {
@@ -380,6 +431,8 @@ public:
 	    std::cout << "\tbr label %" << label;
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::UncondBr; }
 };
 
 class ZextInstruction : public IRInstruction {
@@ -395,6 +448,7 @@ public:
 		this->type1 = type1;
 		this->op = op;
 		this->type2 = type2;
+		op_type = OpType::Zext;
 	}
 
 	void print() override {
@@ -408,6 +462,8 @@ public:
 		type2->print();
 	}
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Zext; }
 };
 
 class AllocaInstruction : public MemoryInstruction {
@@ -427,6 +483,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Alloca; }
 };
 
 class LoadInstruction : public MemoryInstruction {
@@ -452,6 +510,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Load; }
 };
 
 class StoreInstruction : public MemoryInstruction {
@@ -485,6 +545,8 @@ public:
     	ptr->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Store; }
 };
 
 class GetElementPtrInstruction : public MemoryInstruction {
@@ -532,6 +594,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::GetElementPtr; }
 };
 
 enum class ConditionType {
@@ -584,11 +648,17 @@ public:
 
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::ICmp; }
 };
 
 class CallExpression : public IRInstruction {
 public:
     CallExpression() = default;
+
+	static bool classof(const IRInstruction *inst) {
+		return inst->GetOpType() >= OpType::CallWithRet && inst->GetOpType() <= OpType::CallWithoutRet;
+	}
 };
 
 class CallWithRetInstruction : public CallExpression {
@@ -630,6 +700,8 @@ public:
     	std::cout << ")";
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::CallWithRet; }
 };
 
 class CallWithoutRetInstruction : public CallExpression {
@@ -658,6 +730,8 @@ public:
     	std::cout << ")";
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::CallWithoutRet; }
 };
 
 class PhiInstruction : public IRInstruction {
@@ -688,6 +762,8 @@ public:
     	}
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Phi; }
 };
 
 class SelectInstruction : public IRInstruction {
@@ -707,6 +783,8 @@ public:
         op_type = OpType::Select;
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::Select; }
 };
 
 class StructDefInstruction : public IRInstruction {
@@ -715,7 +793,9 @@ public:
     std::vector<std::shared_ptr<IRType>> args;
 
     StructDefInstruction(const std::shared_ptr<IRStructType>& struct_type, const std::vector<std::shared_ptr<IRType>> &args) :
-        struct_type(struct_type), args(args) {}
+        struct_type(struct_type), args(args) {
+        op_type = OpType::StructDef;
+    }
 
 	void print() override {
 	    struct_type->print();
@@ -729,6 +809,8 @@ public:
     	std::cout << "}";
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::StructDef; }
 };
 
 class GlobalVarDefInstruction : public IRInstruction {
@@ -737,8 +819,12 @@ public:
     std::shared_ptr<IRLiteral> value;
 
     GlobalVarDefInstruction(const std::shared_ptr<GlobalVar>& global_var, const std::shared_ptr<IRLiteral>& value) :
-        global_var(global_var), value(value) {}
+        global_var(global_var), value(value) {
+        op_type = OpType::GlobalVarDef;
+    }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::GlobalVarDef; }
 };
 
 class ConstVarDefInstruction : public IRInstruction {
@@ -747,7 +833,9 @@ public:
     std::shared_ptr<IRLiteral> value;
 
     ConstVarDefInstruction(const std::shared_ptr<ConstVar>& const_var, const std::shared_ptr<IRLiteral>& value) :
-        const_var(const_var), value(value) {}
+        const_var(const_var), value(value) {
+        op_type = OpType::ConstVarDef;
+    }
 
 	void print() override {
 	    const_var->print();
@@ -755,5 +843,7 @@ public:
     	value->print();
     }
 	void accept(IRVisitor *visitor) override { visitor->visit(this); }
+
+	static bool classof(const IRInstruction *inst) { return inst->GetOpType() == OpType::ConstVarDef; }
 };
 #endif //IRINSTRUCTION_H
\ No newline at end of file
@@ -1,67 +1,153 @@
-#ifndef RCOMPILER_IRBUIDER_H
-#define RCOMPILER_IRBUIDER_H
-#include <map>
-#include <memory>
-#include <vector>
-
-#include "IR/IRType.h"
-#include "Semantic/Type.h"
-
-class IRBasicBlock;
-class IRVar;
-class IRFunction;
-
-class IRManager {
-public:
-	std::map<std::shared_ptr<Type>, std::shared_ptr<IRType>, std::owner_less<std::shared_ptr<Type>>> type_map_;
-	std::map<std::string, uint32_t> variable_use_count;
-	std::map<std::string, std::shared_ptr<IRFunction>> function_map_;
-	std::map<std::string, uint32_t> label_count;
-	std::shared_ptr<IRBasicBlock> current_loop_condition = nullptr;
-	std::shared_ptr<IRBasicBlock> current_loop_combine;
-
-	std::shared_ptr<IRType> GetIRType(const std::shared_ptr<Type>& type) {
-		auto array_type = std::dynamic_pointer_cast<ArrayType>(type);
-		if (array_type) {
-			auto ir_base_type = GetIRType(array_type->base_);
-			return std::make_shared<IRArrayType>(ir_base_type, array_type->length_);
-		}
-		auto reference_type = std::dynamic_pointer_cast<ReferenceType>(type);
-		if (reference_type) {
-			auto ir_base_type = GetIRType(reference_type->type_);
-			return std::make_shared<IRPointerType>(ir_base_type);
-		}
-
-		for (auto& it: type_map_) {
-			if (it.first -> equal(type)) {
-				return it.second;
-			}
-		}
-	  	return nullptr;
-	}
-
-	void AddType(const std::shared_ptr<Type>& type) {
-		auto struct_type = std::dynamic_pointer_cast<StructType>(type);
-		if (struct_type) {
-			AddStructType(struct_type);
-		}
-		// TODO: handle other kinds of types (array/pointer/function/primitive) if needed
-	}
-
-	void AddStructType(const std::shared_ptr<StructType>& type) {
-		std::vector<std::shared_ptr<IRType>> member_types;
-		for (auto& it: type->members_) {
-			auto ir_type = GetIRType(it.type_);
-			if (!ir_type) {
-				// add the member's type (not the struct itself) and then get it
-				AddType(it.type_);
-				ir_type = GetIRType(it.type_);
-			}
-			member_types.emplace_back(ir_type);
-		}
-		auto struct_type = std::make_shared<IRStructType>(type->name_, member_types);
-		type_map_[type] = struct_type;
-	}
-
-};
+#ifndef RCOMPILER_IRBUIDER_H
+#define RCOMPILER_IRBUIDER_H
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "IR/IRType.h"
+#include "Semantic/Type.h"
+#include "StringInterner.h"
+
+class IRBasicBlock;
+class IRVar;
+class IRFunction;
+
+class IRManager {
+	struct ArrayKey {
+		const IRType *base;
+		uint32_t length;
+
+		bool operator==(const ArrayKey &other) const {
+			return base == other.base && length == other.length;
+		}
+	};
+
+	struct ArrayKeyHash {
+		size_t operator()(const ArrayKey &key) const {
+			return std::hash<const IRType *>()(key.base) * 31 + key.length;
+		}
+	};
+
+	// Tags the lowerings cached on semantic types, so a fresh manager never
+	// picks up another's. Zero is never handed out.
+	static uint64_t NextGeneration() {
+		static uint64_t generation = 0;
+		return ++generation;
+	}
+
+	uint64_t generation_ = NextGeneration();
+	std::unordered_map<const IRType *, std::shared_ptr<IRPointerType>> pointer_types_;
+	std::unordered_map<ArrayKey, std::shared_ptr<IRArrayType>, ArrayKeyHash> array_types_;
+
+	void Cache(Type &type, const std::shared_ptr<IRType> &ir_type) const {
+		type.ir_type_ = ir_type;
+		type.ir_generation_ = generation_;
+	}
+
+public:
+	std::map<std::shared_ptr<Type>, std::shared_ptr<IRType>, std::owner_less<std::shared_ptr<Type>>> type_map_;
+	std::unordered_map<Atom, uint32_t> variable_use_count;
+	std::unordered_map<Atom, std::shared_ptr<IRFunction>> function_map_;
+	std::unordered_map<Atom, uint32_t> label_count;
+	std::shared_ptr<IRBasicBlock> current_loop_condition = nullptr;
+	std::shared_ptr<IRBasicBlock> current_loop_combine;
+
+	// Pointer and array types are uniqued: one object per pointee, and per
+	// element type and length.
+	std::shared_ptr<IRPointerType> PointerTo(const std::shared_ptr<IRType> &base) {
+		auto &slot = pointer_types_[base.get()];
+		if (!slot) {
+			slot = std::make_shared<IRPointerType>(base);
+		}
+		return slot;
+	}
+
+	std::shared_ptr<IRArrayType> ArrayOf(const std::shared_ptr<IRType> &base, const uint32_t length) {
+		auto &slot = array_types_[ArrayKey{base.get(), length}];
+		if (!slot) {
+			slot = std::make_shared<IRArrayType>(base, length);
+		}
+		return slot;
+	}
+
+	// Records the lowering of a primitive or struct type.
+	void SetIRType(const std::shared_ptr<Type> &type, const std::shared_ptr<IRType> &ir_type) {
+		type_map_[type] = ir_type;
+		Cache(*type, ir_type);
+	}
+
+	// Constant time once a type has been lowered: the result is cached on
+	// the semantic type itself. Semantic types other than structs are
+	// interned, so the only type equal to a registered one is that type; a
+	// struct can also be an unregistered twin of a registered one, which is
+	// looked up by structural equality and not cached. Nothing built on a
+	// type that is not registered yet is cached or uniqued: a struct the
+	// builder has not reached may be registered later, and the lowering
+	// must pick it up then.
+	std::shared_ptr<IRType> GetIRType(const std::shared_ptr<Type>& type) {
+		if (!type) {
+			return nullptr;
+		}
+		if (type->ir_generation_ == generation_) {
+			return type->ir_type_;
+		}
+		std::shared_ptr<IRType> ir_type;
+		switch (type->getKind()) {
+			case TypeKind::Array: {
+				const auto *array_type = static_cast<const ArrayType *>(type.get());
+				auto ir_base_type = GetIRType(array_type->base_);
+				if (!ir_base_type) {
+					return std::make_shared<IRArrayType>(ir_base_type, array_type->length_);
+				}
+				ir_type = ArrayOf(ir_base_type, array_type->length_);
+				break;
+			}
+			case TypeKind::Reference: {
+				auto ir_base_type = GetIRType(static_cast<const ReferenceType *>(type.get())->type_);
+				if (!ir_base_type) {
+					return std::make_shared<IRPointerType>(ir_base_type);
+				}
+				ir_type = PointerTo(ir_base_type);
+				break;
+			}
+			case TypeKind::Struct:
+				for (auto& it: type_map_) {
+					if (it.first -> equal(type)) {
+						return it.second;
+					}
+				}
+				return nullptr;
+			default:
+				// Not registered (yet); SetIRType caches what it registers.
+				return nullptr;
+		}
+		Cache(*type, ir_type);
+		return ir_type;
+	}
+
+	void AddType(const std::shared_ptr<Type>& type) {
+		auto struct_type = std::dynamic_pointer_cast<StructType>(type);
+		if (struct_type) {
+			AddStructType(struct_type);
+		}
+		// TODO: handle other kinds of types (array/pointer/function/primitive) if needed
+	}
+
+	void AddStructType(const std::shared_ptr<StructType>& type) {
+		std::vector<std::shared_ptr<IRType>> member_types;
+		for (auto& it: type->members_) {
+			auto ir_type = GetIRType(it.type_);
+			if (!ir_type) {
+				// add the member's type (not the struct itself) and then get it
+				AddType(it.type_);
+				ir_type = GetIRType(it.type_);
+			}
+			member_types.emplace_back(ir_type);
+		}
+		auto struct_type = std::make_shared<IRStructType>(type->name_, member_types);
+		SetIRType(type, struct_type);
+	}
+
+};
 #endif //RCOMPILER_IRBUIDER_H
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <cstdint>
 
+#include "Casting.h"
 #include "IRNode.h"
 
 enum class TypeID {
@@ -45,6 +46,8 @@ class IRVoidType: public IRType {
 public:
     IRVoidType() : IRType(TypeID::voidType, 4) {}
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::voidType; }
+
     [[nodiscard]] std::string toString() const override {
        return "void";
     }
@@ -64,6 +67,8 @@ public:
     	this->is_signed = is_signed;
     }
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::integerType; }
+
     [[nodiscard]] std::string toString() const override {
         return "integer";
     }
@@ -81,6 +86,8 @@ public:
         baseType = base;
     }
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::pointerType; }
+
     [[nodiscard]] std::string toString() const override {
         return baseType->toString() + "*";
     }
@@ -101,6 +108,8 @@ public:
         length = len;
     }
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::arrayType; }
+
 	void print() override {
 	    std::cout << "[" << length << " x ";
     	baseType->print();
@@ -132,6 +141,8 @@ public:
     	calculateSize();
     }
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::structType; }
+
     void print() override {
 	    std::cout << "%struct." << name;
     }
@@ -154,6 +165,8 @@ public:
         this->parameters = parameters;
     }
 
+    static bool classof(const IRType *type) { return type->GetTypeId() == TypeID::functionType; }
+
     [[nodiscard]] std::string toString() const override {
         return name;
     }
@@ -21,24 +21,30 @@ public:
 	std::string name;
 	std::string scoped_name;
 	std::string true_name;
+	Atom true_atom = StringInterner::InvalidAtom;
 	std::shared_ptr<IRType> type;
 	VarType var_type;
 
 	IRVar(const std::string& name_, VarType var_type_, const std::shared_ptr<IRType> &type_, bool change_name = true) {
 		name = name_;
+		const Atom name_atom = GlobalInterner().Intern(name);
+		uint32_t *use_count;
 		if (change_name) {
 			scoped_name = name + "." + std::to_string(scope_manager.current_scope->scope_index);
-			if (ir_manager.variable_use_count.find(scoped_name) == ir_manager.variable_use_count.end()) {
-				scope_manager.ir_declare(name);
-				ir_manager.variable_use_count[scoped_name] = 0;
+			auto [it, inserted] = ir_manager.variable_use_count.try_emplace(GlobalInterner().Intern(scoped_name), 0);
+			if (inserted) {
+				scope_manager.ir_declare(name_atom);
 			} else {
-				ir_manager.variable_use_count[scoped_name]++;
+				it->second++;
 			}
+			use_count = &it->second;
 		} else {
-			uint32_t sym = scope_manager.ir_lookup(name);
+			uint32_t sym = scope_manager.ir_lookup(name_atom);
 			scoped_name = name + "." + std::to_string(sym);
+			use_count = &ir_manager.variable_use_count[GlobalInterner().Intern(scoped_name)];
 		}
-		true_name = scoped_name + '.' + std::to_string(ir_manager.variable_use_count[scoped_name]);
+		true_name = scoped_name + '.' + std::to_string(*use_count);
+		true_atom = GlobalInterner().Intern(true_name);
 		var_type = var_type_;
 		type = type_;
 	}
@@ -1,12 +1,14 @@
 #ifndef ASMINSTRUCTION_H
 #define ASMINSTRUCTION_H
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <utility>
 
 #include "ASMNode.h"
 #include "ASMOperand.h"
+#include "Casting.h"
 
 enum class ASMOpcode {
 	ADD, SUB,
@@ -28,11 +30,61 @@ enum class ASMOpcode {
 	BEQ, BNE, BLT, BGE, BLTU, BGEU,
 };
 
+// Identifies the concrete instruction class; opcode alone does not, since
+// pseudo-instructions such as la or call reuse the opcode they expand to.
+enum class ASMKind : uint8_t {
+	La,
+	Add,
+	Sub,
+	Mul,
+	Div,
+	Divu,
+	Rem,
+	Remu,
+	And,
+	Or,
+	Xor,
+	Srl,
+	Sra,
+	Sll,
+	Slt,
+	Sltu,
+	Addi,
+	Andi,
+	Ori,
+	Xori,
+	Slli,
+	Srli,
+	Srai,
+	Slti,
+	Sltiu,
+	Lw,
+	Sw,
+	Jal,
+	Jalr,
+	Ret,
+	Prologue,
+	Epilogue,
+	Call,
+	Lui,
+	Auipc,
+	Beq,
+	Bne,
+	Blt,
+	Bge,
+	Bltu,
+	Bgeu,
+	Seqz,
+	Snez,
+};
+
 class ASMInstruction : public ASMNode {
 public:
 	ASMOpcode opcode;
 
-	explicit ASMInstruction(ASMOpcode opcode) : opcode(opcode) {}
+	ASMInstruction(ASMOpcode opcode, ASMKind kind) : opcode(opcode), kind_(kind) {}
+
+	[[nodiscard]] ASMKind kind() const { return kind_; }
 
 	virtual bool has_rd() const { return false; }
 	virtual bool has_rs1() const { return false; }
@@ -55,6 +107,9 @@ public:
 	void print() override = 0;
 
 	~ASMInstruction() override = default;
+
+private:
+	ASMKind kind_;
 };
 
 class ASMLaInstruction final : public ASMInstruction {
@@ -63,7 +118,7 @@ public:
 	std::string symbol;
 
 	ASMLaInstruction(const std::shared_ptr<ASMOperand>& rd, std::string  symbol)
-		: ASMInstruction(ASMOpcode::ADDI), rd(rd), symbol(std::move(symbol)) {}
+		: ASMInstruction(ASMOpcode::ADDI, ASMKind::La), rd(rd), symbol(std::move(symbol)) {}
 
 	bool has_rd() const override { return true; }
 	std::shared_ptr<ASMOperand>& get_rd() override { return rd; }
@@ -73,6 +128,8 @@ public:
 		rd->print();
 		std::cout << ", " << symbol;
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::La; }
 };
 
 class ASMAddInstruction final : public ASMInstruction {
@@ -84,7 +141,7 @@ public:
 	ASMAddInstruction(const std::shared_ptr<ASMOperand>& rd,
 	               const std::shared_ptr<ASMOperand>& rs1,
 	               const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::ADD), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::ADD, ASMKind::Add), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -101,6 +158,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Add; }
 };
 
 class ASMSubInstruction final : public ASMInstruction {
@@ -112,7 +171,7 @@ public:
 	ASMSubInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SUB), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SUB, ASMKind::Sub), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -129,6 +188,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sub; }
 };
 
 class ASMMulInstruction final : public ASMInstruction {
@@ -140,7 +201,7 @@ public:
 	ASMMulInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::MUL), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::MUL, ASMKind::Mul), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -157,6 +218,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Mul; }
 };
 
 class ASMDivInstruction final : public ASMInstruction {
@@ -168,7 +231,7 @@ public:
 	ASMDivInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::DIV), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::DIV, ASMKind::Div), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -185,6 +248,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Div; }
 };
 
 class ASMDivuInstruction final : public ASMInstruction {
@@ -196,7 +261,7 @@ public:
 	ASMDivuInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::DIVU), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::DIVU, ASMKind::Divu), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -213,6 +278,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Divu; }
 };
 
 class ASMRemInstruction final : public ASMInstruction {
@@ -224,7 +291,7 @@ public:
 	ASMRemInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::REM), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::REM, ASMKind::Rem), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -241,6 +308,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Rem; }
 };
 
 class ASMRemuInstruction final : public ASMInstruction {
@@ -252,7 +321,7 @@ public:
 	ASMRemuInstruction(const std::shared_ptr<ASMOperand>& rd,
 					const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::REMU), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::REMU, ASMKind::Remu), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -269,6 +338,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Remu; }
 };
 
 class ASMAndInstruction final : public ASMInstruction {
@@ -280,7 +351,7 @@ public:
 	ASMAndInstruction(const std::shared_ptr<ASMOperand>& rd,
 	               const std::shared_ptr<ASMOperand>& rs1,
 	               const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::AND), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::AND, ASMKind::And), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -297,6 +368,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::And; }
 };
 
 class ASMOrInstruction final : public ASMInstruction {
@@ -308,7 +381,7 @@ public:
 	ASMOrInstruction(const std::shared_ptr<ASMOperand>& rd,
 	              const std::shared_ptr<ASMOperand>& rs1,
 	              const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::OR), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::OR, ASMKind::Or), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -325,6 +398,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Or; }
 };
 
 class ASMXorInstruction final : public ASMInstruction {
@@ -336,7 +411,7 @@ public:
 	ASMXorInstruction(const std::shared_ptr<ASMOperand>& rd,
 	               const std::shared_ptr<ASMOperand>& rs1,
 	               const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::XOR), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::XOR, ASMKind::Xor), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -353,6 +428,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Xor; }
 };
 
 class ASMSrlInstruction final : public ASMInstruction {
@@ -364,7 +441,7 @@ public:
 	ASMSrlInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SRL), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SRL, ASMKind::Srl), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -381,6 +458,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Srl; }
 };
 
 class ASMSraInstruction final : public ASMInstruction {
@@ -392,7 +471,7 @@ public:
 	ASMSraInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SRA), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SRA, ASMKind::Sra), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -409,6 +488,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sra; }
 };
 
 class ASMSllInstruction final : public ASMInstruction {
@@ -420,7 +501,7 @@ public:
 	ASMSllInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SLL), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SLL, ASMKind::Sll), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -437,6 +518,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sll; }
 };
 
 class ASMSltInstruction final : public ASMInstruction {
@@ -448,7 +531,7 @@ public:
 	ASMSltInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SLT), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SLT, ASMKind::Slt), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -465,6 +548,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Slt; }
 };
 
 class ASMSltuInstruction final : public ASMInstruction {
@@ -476,7 +561,7 @@ public:
 	ASMSltuInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2)
-		: ASMInstruction(ASMOpcode::SLTU), rd(rd), rs1(rs1), rs2(rs2) {}
+		: ASMInstruction(ASMOpcode::SLTU, ASMKind::Sltu), rd(rd), rs1(rs1), rs2(rs2) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -493,6 +578,8 @@ public:
 		std::cout << ", ";
 		rs2->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sltu; }
 };
 
 class ASMAddiInstruction final: public ASMInstruction {
@@ -504,7 +591,7 @@ public:
 	ASMAddiInstruction(const std::shared_ptr<ASMOperand>& rd,
 				   const std::shared_ptr<ASMOperand>& rs1,
 				   const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::ADDI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::ADDI, ASMKind::Addi), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -519,6 +606,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Addi; }
 };
 
 class ASMAndiInstruction final : public ASMInstruction {
@@ -530,7 +619,7 @@ public:
 	ASMAndiInstruction(const std::shared_ptr<ASMOperand>& rd,
 	               const std::shared_ptr<ASMOperand>& rs1,
 	               const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::ANDI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::ANDI, ASMKind::Andi), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -545,6 +634,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Andi; }
 };
 
 class ASMOriInstruction final : public ASMInstruction {
@@ -556,7 +647,7 @@ public:
 	ASMOriInstruction(const std::shared_ptr<ASMOperand>& rd,
 	              const std::shared_ptr<ASMOperand>& rs1,
 	              const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::ORI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::ORI, ASMKind::Ori), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -571,6 +662,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Ori; }
 };
 
 class ASMXoriInstruction final : public ASMInstruction {
@@ -582,7 +675,7 @@ public:
 	ASMXoriInstruction(const std::shared_ptr<ASMOperand>& rd,
 	               const std::shared_ptr<ASMOperand>& rs1,
 	               const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::XORI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::XORI, ASMKind::Xori), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -597,6 +690,8 @@ public:
 
 		std::cout << ", ";
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Xori; }
 };
 
 class ASMSlliInstruction final : public ASMInstruction {
@@ -608,7 +703,7 @@ public:
 	ASMSlliInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SLLI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SLLI, ASMKind::Slli), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -623,6 +718,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Slli; }
 };
 
 class ASMSrliInstruction final : public ASMInstruction {
@@ -634,7 +731,7 @@ public:
 	ASMSrliInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SRLI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SRLI, ASMKind::Srli), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -649,6 +746,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Srli; }
 };
 
 class ASMSraiInstruction final : public ASMInstruction {
@@ -660,7 +759,7 @@ public:
 	ASMSraiInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SRAI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SRAI, ASMKind::Srai), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -675,6 +774,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Srai; }
 };
 
 class ASMSltiInstruction final : public ASMInstruction {
@@ -686,7 +787,7 @@ public:
 	ASMSltiInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SLTI), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SLTI, ASMKind::Slti), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -701,6 +802,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Slti; }
 };
 
 class ASMSltiuInstruction final : public ASMInstruction {
@@ -712,7 +815,7 @@ public:
 	ASMSltiuInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SLTIU), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SLTIU, ASMKind::Sltiu), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -727,6 +830,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sltiu; }
 };
 
 class ASMLwInstruction final : public ASMInstruction {
@@ -738,7 +843,7 @@ public:
 	ASMLwInstruction(const std::shared_ptr<ASMOperand>& rd,
 	              const std::shared_ptr<ASMOperand>& rs1,
 	              const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::LW), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::LW, ASMKind::Lw), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -754,6 +859,8 @@ public:
 		rs1->print();
 		std::cout << ")";
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Lw; }
 };
 
 class ASMSwInstruction final : public ASMInstruction {
@@ -765,7 +872,7 @@ public:
 	ASMSwInstruction(const std::shared_ptr<ASMOperand>& rs2,
 	              const std::shared_ptr<ASMOperand>& rs1,
 	              const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::SW), rs2(rs2), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::SW, ASMKind::Sw), rs2(rs2), rs1(rs1), imm(imm) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -782,6 +889,8 @@ public:
 		std::cout << ")";
 
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Sw; }
 };
 
 class ASMJalInstruction final : public ASMInstruction {
@@ -791,7 +900,7 @@ public:
 
 	ASMJalInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::JAL), rd(rd), label(label) {}
+		: ASMInstruction(ASMOpcode::JAL, ASMKind::Jal), rd(rd), label(label) {}
 
 	bool has_rd() const override { return true; }
 	std::shared_ptr<ASMOperand>& get_rd() override { return rd; }
@@ -802,6 +911,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Jal; }
 };
 
 class ASMJalrInstruction final : public ASMInstruction {
@@ -813,7 +924,7 @@ public:
 	ASMJalrInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                 const std::shared_ptr<ASMOperand>& rs1,
 	                 const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::JALR), rd(rd), rs1(rs1), imm(imm) {}
+		: ASMInstruction(ASMOpcode::JALR, ASMKind::Jalr), rd(rd), rs1(rs1), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -829,22 +940,26 @@ public:
 		rs1->print();
 		std::cout << ")";
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Jalr; }
 };
 
 class ASMRetInstruction final : public ASMInstruction {
 public:
-	ASMRetInstruction() : ASMInstruction(ASMOpcode::JALR) {}
+	ASMRetInstruction() : ASMInstruction(ASMOpcode::JALR, ASMKind::Ret) {}
 
 	void print() override {
 		std::cout << "\tret";
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Ret; }
 };
 
 class ASMPrologueInstruction final : public ASMInstruction {
     uint32_t *stack_size_ptr;
 public:
     explicit ASMPrologueInstruction(uint32_t *sz_ptr)
-        : ASMInstruction(ASMOpcode::ADDI), stack_size_ptr(sz_ptr) {}
+        : ASMInstruction(ASMOpcode::ADDI, ASMKind::Prologue), stack_size_ptr(sz_ptr) {}
     
     void print() override {
         uint32_t size = *stack_size_ptr;
@@ -857,13 +972,15 @@ public:
         // addi s0, sp, size
         std::cout << "\taddi s0, sp, " << size; 
     }
+
+    static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Prologue; }
 };
 
 class ASMEpilogueInstruction final : public ASMInstruction {
     uint32_t *stack_size_ptr;
 public:
     explicit ASMEpilogueInstruction(uint32_t *sz_ptr)
-        : ASMInstruction(ASMOpcode::ADDI), stack_size_ptr(sz_ptr) {}
+        : ASMInstruction(ASMOpcode::ADDI, ASMKind::Epilogue), stack_size_ptr(sz_ptr) {}
     
     void print() override {
         uint32_t size = *stack_size_ptr;
@@ -874,6 +991,8 @@ public:
         // addi sp, sp, size
         std::cout << "\taddi sp, sp, " << size; 
     }
+
+    static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Epilogue; }
 };
 
 class ASMCallInstruction final : public ASMInstruction {
@@ -881,12 +1000,14 @@ public:
 	std::shared_ptr<ASMOperand> label;
 
 	explicit ASMCallInstruction(const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::JAL), label(label) {}
+		: ASMInstruction(ASMOpcode::JAL, ASMKind::Call), label(label) {}
 
 	void print() override {
 		std::cout << "\tcall ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Call; }
 };
 
 class ASMLuiInstruction final : public ASMInstruction {
@@ -896,7 +1017,7 @@ public:
 
 	ASMLuiInstruction(const std::shared_ptr<ASMOperand>& rd,
 	              const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::LUI), rd(rd), imm(imm) {}
+		: ASMInstruction(ASMOpcode::LUI, ASMKind::Lui), rd(rd), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	std::shared_ptr<ASMOperand>& get_rd() override { return rd; }
@@ -907,6 +1028,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Lui; }
 };
 
 class ASMAuipcInstruction final : public ASMInstruction {
@@ -916,7 +1039,7 @@ public:
 
 	ASMAuipcInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& imm)
-		: ASMInstruction(ASMOpcode::AUIPC), rd(rd), imm(imm) {}
+		: ASMInstruction(ASMOpcode::AUIPC, ASMKind::Auipc), rd(rd), imm(imm) {}
 
 	bool has_rd() const override { return true; }
 	std::shared_ptr<ASMOperand>& get_rd() override { return rd; }
@@ -927,6 +1050,8 @@ public:
 		std::cout << ", ";
 		imm->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Auipc; }
 };
 
 class ASMBeqInstruction final : public ASMInstruction {
@@ -938,7 +1063,7 @@ public:
 	ASMBeqInstruction(const std::shared_ptr<ASMOperand>& rs1,
 	                const std::shared_ptr<ASMOperand>& rs2,
 	                const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BEQ), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BEQ, ASMKind::Beq), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -954,6 +1079,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Beq; }
 };
 
 class ASMBneInstruction final : public ASMInstruction {
@@ -965,7 +1092,7 @@ public:
 	ASMBneInstruction(const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2,
 					const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BNE), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BNE, ASMKind::Bne), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -980,6 +1107,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Bne; }
 };
 
 class ASMBltInstruction final : public ASMInstruction {
@@ -991,7 +1120,7 @@ public:
 	ASMBltInstruction(const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2,
 					const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BLT), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BLT, ASMKind::Blt), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -1006,6 +1135,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Blt; }
 };
 
 class ASMBgeInstruction final : public ASMInstruction {
@@ -1017,7 +1148,7 @@ public:
 	ASMBgeInstruction(const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2,
 					const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BGE), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BGE, ASMKind::Bge), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -1032,6 +1163,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Bge; }
 };
 
 class ASMBltuInstruction final : public ASMInstruction {
@@ -1043,7 +1176,7 @@ public:
 	ASMBltuInstruction(const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2,
 					const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BLTU), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BLTU, ASMKind::Bltu), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -1058,6 +1191,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Bltu; }
 };
 
 class ASMBgeuInstruction final : public ASMInstruction {
@@ -1069,7 +1204,7 @@ public:
 	ASMBgeuInstruction(const std::shared_ptr<ASMOperand>& rs1,
 					const std::shared_ptr<ASMOperand>& rs2,
 					const std::shared_ptr<ASMOperand>& label)
-		: ASMInstruction(ASMOpcode::BGEU), rs1(rs1), rs2(rs2), label(label) {}
+		: ASMInstruction(ASMOpcode::BGEU, ASMKind::Bgeu), rs1(rs1), rs2(rs2), label(label) {}
 
 	bool has_rs1() const override { return true; }
 	bool has_rs2() const override { return true; }
@@ -1084,6 +1219,8 @@ public:
 		std::cout << ", ";
 		label->print();
 	}
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Bgeu; }
 };
 
 class ASMSeqzInstruction final : public ASMInstruction {
@@ -1093,7 +1230,7 @@ public:
 
 	ASMSeqzInstruction(const std::shared_ptr<ASMOperand>& rd,
 	                const std::shared_ptr<ASMOperand>& rs)
-		: ASMInstruction(ASMOpcode::SLTIU), rd(rd), rs(rs) {}
+		: ASMInstruction(ASMOpcode::SLTIU, ASMKind::Seqz), rd(rd), rs(rs) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -1107,6 +1244,8 @@ public:
 		rs->print();
 	}
 	// set rd = 1 iff rs == 0
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Seqz; }
 };
 
 class ASMSnezInstruction final : public ASMInstruction {
@@ -1116,7 +1255,7 @@ public:
 
 	ASMSnezInstruction(const std::shared_ptr<ASMOperand>& rd,
 					 const std::shared_ptr<ASMOperand>& rs)
-		: ASMInstruction(ASMOpcode::SLTU), rd(rd), rs(rs) {}
+		: ASMInstruction(ASMOpcode::SLTU, ASMKind::Snez), rd(rd), rs(rs) {}
 
 	bool has_rd() const override { return true; }
 	bool has_rs1() const override { return true; }
@@ -1130,6 +1269,8 @@ public:
 		rs->print();
 	}
 	// set rd = 1 iff rs != 0
+
+	static bool classof(const ASMInstruction *inst) { return inst->kind() == ASMKind::Snez; }
 };
 
 #endif //ASMINSTRUCTION_H
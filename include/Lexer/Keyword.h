@@ -0,0 +1,137 @@
+#ifndef KEYWORD_H
+#define KEYWORD_H
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "TokenType.h"
+
+// Keyword classification for an already-scanned identifier span. Keywords are
+// placed in a table by a perfect hash whose seed is searched at compile time,
+// so classifying an identifier costs one hash, one load and one compare.
+namespace keyword {
+    struct KeywordRule {
+        std::string_view spelling;
+        TokenType type;
+    };
+
+    // Words the lexer turns into keyword tokens. Reserved words that have a
+    // TokenType but no rule here (see reserved_identifiers) are still lexed as
+    // identifiers.
+    constexpr KeywordRule keyword_rules[] = {
+        {"as", TokenType::As}, {"break", TokenType::Break}, {"const", TokenType::Const},
+        {"continue", TokenType::Continue}, {"crate", TokenType::Crate}, {"else", TokenType::Else},
+        {"enum", TokenType::Enum}, {"false", TokenType::False}, {"fn", TokenType::Fn},
+        {"for", TokenType::For}, {"if", TokenType::If}, {"impl", TokenType::Impl},
+        {"in", TokenType::In}, {"let", TokenType::Let}, {"loop", TokenType::Loop},
+        {"match", TokenType::Match}, {"mod", TokenType::Mod}, {"move", TokenType::Move},
+        {"mut", TokenType::Mut}, {"ref", TokenType::Ref}, {"return", TokenType::Return},
+        {"self", TokenType::Self}, {"Self", TokenType::SELF}, {"struct", TokenType::Struct},
+        {"super", TokenType::Super}, {"trait", TokenType::Trait}, {"true", TokenType::True},
+        {"type", TokenType::Type}, {"unsafe", TokenType::Unsafe}, {"use", TokenType::Use},
+        {"where", TokenType::Where}, {"while", TokenType::While}, {"dyn", TokenType::Dyn},
+        {"abstract", TokenType::Abstract}, {"become", TokenType::Become}, {"do", TokenType::Do},
+        {"final", TokenType::Final}, {"override", TokenType::Override},
+    };
+
+    constexpr TokenType reserved_identifiers[] = {
+        TokenType::Static, TokenType::Box, TokenType::Macro, TokenType::Priv, TokenType::Typeof,
+        TokenType::Unsized, TokenType::Virtual, TokenType::Yield, TokenType::Try,
+    };
+
+    // Every TokenType between As and Try has exactly one rule, or is listed as
+    // a reserved word that stays an identifier.
+    constexpr bool VerifyCoverage() {
+        for (int t = static_cast<int>(TokenType::As); t <= static_cast<int>(TokenType::Try); t++) {
+            int count = 0;
+            for (const auto &rule: keyword_rules) {
+                count += static_cast<int>(rule.type) == t;
+            }
+            for (const TokenType reserved: reserved_identifiers) {
+                count += static_cast<int>(reserved) == t;
+            }
+            if (count != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(VerifyCoverage(), "keyword_rules is out of sync with TokenType");
+
+    constexpr uint32_t TableBits = 7;
+    constexpr uint32_t TableSize = 1u << TableBits;
+    constexpr size_t MaxKeywordLength = 8;
+
+    // Mixes the length and the first two and last two characters, which are
+    // enough to tell every keyword apart ("type"/"true" differ only at [1],
+    // "where"/"while" only at [3]). Callers guarantee word.size() >= 2.
+    constexpr uint32_t Hash(const std::string_view word, const uint32_t seed) {
+        uint32_t h = seed ^ static_cast<uint32_t>(word.size());
+        h = (h ^ static_cast<unsigned char>(word[0])) * 0x9E3779B1u;
+        h = (h ^ static_cast<unsigned char>(word[1])) * 0x85EBCA77u;
+        h = (h ^ static_cast<unsigned char>(word[word.size() - 2])) * 0xC2B2AE3Du;
+        h = (h ^ static_cast<unsigned char>(word[word.size() - 1])) * 0x27D4EB2Fu;
+        return h >> (32 - TableBits);
+    }
+
+    constexpr bool IsPerfect(const uint32_t seed) {
+        bool used[TableSize] = {};
+        for (const auto &rule: keyword_rules) {
+            const uint32_t slot = Hash(rule.spelling, seed);
+            if (used[slot]) {
+                return false;
+            }
+            used[slot] = true;
+        }
+        return true;
+    }
+
+    constexpr uint32_t FindSeed() {
+        uint32_t seed = 0;
+        while (!IsPerfect(seed)) {
+            seed++;
+        }
+        return seed;
+    }
+
+    constexpr uint32_t Seed = FindSeed();
+
+    constexpr std::array<KeywordRule, TableSize> BuildTable() {
+        std::array<KeywordRule, TableSize> table{};
+        for (auto &slot: table) {
+            slot = KeywordRule{std::string_view{}, TokenType::Identifier};
+        }
+        for (const auto &rule: keyword_rules) {
+            table[Hash(rule.spelling, Seed)] = rule;
+        }
+        return table;
+    }
+
+    constexpr std::array<KeywordRule, TableSize> table = BuildTable();
+
+    // Returns the keyword type of `word`, or TokenType::Identifier.
+    constexpr TokenType Classify(const std::string_view word) {
+        if (word.size() < 2 || word.size() > MaxKeywordLength) {
+            return TokenType::Identifier;
+        }
+        const KeywordRule &slot = table[Hash(word, Seed)];
+        return slot.spelling == word ? slot.type : TokenType::Identifier;
+    }
+
+    constexpr bool VerifyTable() {
+        for (const auto &rule: keyword_rules) {
+            if (rule.spelling.size() < 2 || rule.spelling.size() > MaxKeywordLength ||
+                Classify(rule.spelling) != rule.type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(VerifyTable(), "every keyword must classify to its own TokenType");
+    static_assert(Classify("Static") == TokenType::Identifier && Classify("static") == TokenType::Identifier,
+                  "static is not a keyword token");
+    static_assert(Classify("selfish") == TokenType::Identifier && Classify("ty") == TokenType::Identifier,
+                  "keyword prefixes and extensions stay identifiers");
+}
+#endif //KEYWORD_H
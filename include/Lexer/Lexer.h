@@ -1,19 +1,73 @@
 #ifndef LEXER_H
 #define LEXER_H
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <regex>
-#include <utility>
+#include "LineTable.h"
 #include "Token.h"
 
+// Single-pass scanner. Punctuation is recognized by a byte-indexed DFA that is
+// built once in the constructor; identifiers are scanned directly and then
+// classified as keywords by a compile-time perfect hash (Keyword.h). Literals
+// and comments (whose grammar is not regular or needs a priority rule between
+// two candidates) are handed to small hand-written sub-scanners. Whitespace,
+// comment and identifier runs go through the vectorized kernels in
+// ScanKernels.h.
 class Lexer {
-    std::vector<std::pair<TokenType, std::regex> > letter_rules;
-    std::vector<std::pair<TokenType, std::regex> > non_letter_rules;
-    std::vector<std::pair<TokenType, std::regex> > string_rules;
+    using State = uint16_t;
+    static constexpr State DeadState = 0;
+    static constexpr State StartState = 1;
+
+    std::vector<std::array<State, 256> > transitions_;
+    std::vector<TokenType> accepts_;
+
+    State NewState();
+
+    void AddLiteral(const std::string &literal, TokenType type);
+
+    [[nodiscard]] uint32_t RunDFA(const char *begin, const char *end, TokenType &type) const;
+
+    static uint32_t ScanWhiteSpace(const char *begin, const char *end);
+
+    static uint32_t ScanIdentifier(const char *begin, const char *end);
+
+    static uint32_t ScanLineComment(const char *begin, const char *end);
+
+    static uint32_t ScanBlockComment(const char *begin, const char *end);
+
+    static uint32_t ScanStringBody(const char *begin, const char *end);
+
+    static uint32_t ScanString(const char *begin, const char *end, TokenType &type);
+
+    static uint32_t ScanChar(const char *begin, const char *end);
+
+    static uint32_t ScanInteger(const char *begin, const char *end, TokenType &type);
+
+    static uint32_t SkipForSplit(const char *begin, const char *end);
 
 public:
     Lexer();
 
-    [[nodiscard]] Token GetNextToken(std::string &str) const;
+    // Scans one token starting at `offset` in the immutable `source` buffer and
+    // advances `offset` past it; the remaining input is never copied. With
+    // `intern` unset, identifiers keep InvalidAtom and are interned later by
+    // the parser.
+    [[nodiscard]] Token GetNextToken(std::string_view source, uint32_t &offset, bool intern = true) const;
+
+    // Scans forward to the next token the parser consumes, skipping whitespace
+    // and comments, and stamps it with its row, column and offset. Line breaks
+    // are recorded in `lines` as they are passed; only whitespace, block
+    // comment and string tokens can contain them, so no other bytes are looked
+    // at twice. Returns false once `source` is exhausted.
+    bool NextParserToken(std::string_view source, uint32_t &offset, LineTable &lines, Token &token,
+                         bool intern = true) const;
+
+    // Up to `count` ascending offsets, each just after a '\n' and at a token
+    // boundary (outside strings, chars and comments), spaced roughly evenly.
+    // Lexing each [split, next split) range on its own yields the same tokens
+    // as lexing the whole source. Stops early at the first lexing error.
+    [[nodiscard]] std::vector<uint32_t> FindSplitPoints(std::string_view source, uint32_t count) const;
 };
 #endif //LEXER_H
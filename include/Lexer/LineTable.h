@@ -0,0 +1,55 @@
+#ifndef LINETABLE_H
+#define LINETABLE_H
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Position.h"
+
+// Byte offsets at which each source line starts, appended by the lexer as it
+// passes line breaks ("\n", "\r\n" or a lone "\r"). Positions of tokens at the
+// lexer's frontier come straight from the last entry; any other offset is
+// resolved with a binary search when a diagnostic needs it.
+class LineTable {
+    std::vector<uint32_t> starts_;
+
+    void ScanLong(std::string_view source, uint32_t offset, uint32_t length);
+
+public:
+    explicit LineTable(const uint32_t first_line_start = 0) : starts_{first_line_start} {
+    }
+
+    // Records the line breaks inside source[offset, offset + length). Most
+    // whitespace tokens are a few bytes, which a plain loop handles faster
+    // than a call into the vector kernels.
+    void Scan(const std::string_view source, const uint32_t offset, const uint32_t length) {
+        if (length >= 32) {
+            ScanLong(source, offset, length);
+            return;
+        }
+        const uint32_t end = offset + length;
+        for (uint32_t i = offset; i < end; i++) {
+            if (source[i] == '\n' || (source[i] == '\r' && (i + 1 == source.size() || source[i + 1] != '\n'))) {
+                starts_.push_back(i + 1);
+            }
+        }
+    }
+
+    // Position of `offset`, which must not precede the last recorded line start.
+    [[nodiscard]] Position FrontierPosition(const uint32_t offset) const {
+        return {static_cast<uint32_t>(starts_.size()), offset - starts_.back() + 1, offset};
+    }
+
+    [[nodiscard]] Position PositionOf(uint32_t offset) const;
+
+    // Text of 1-based `row` without its line break.
+    [[nodiscard]] std::string_view LineText(std::string_view source, uint32_t row) const;
+
+    [[nodiscard]] uint32_t line_count() const {
+        return static_cast<uint32_t>(starts_.size());
+    }
+
+    // Appends the lines of a table that starts where this one ends (the first
+    // entry of `next` repeats this table's last one).
+    void Append(const LineTable &next);
+};
+#endif //LINETABLE_H
@@ -0,0 +1,25 @@
+#ifndef PARALLELLEXER_H
+#define PARALLELLEXER_H
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Lexer.h"
+
+// Lexes a large source on several threads. Lexer::FindSplitPoints cuts the
+// source at newlines that lie between tokens; each chunk is lexed on its own
+// thread, and the token arrays and line tables are concatenated in order with
+// rows shifted by the number of lines in the chunks before. The result is the
+// same sequence Lexer::NextParserToken produces, except identifier atoms are
+// left for the parser to intern.
+class ParallelLexer {
+    const Lexer &lexer_;
+    uint32_t threads_;
+
+public:
+    ParallelLexer(const Lexer &lexer, uint32_t threads);
+
+    // Fills `lines` for the whole source. Rethrows the first error in source
+    // order.
+    [[nodiscard]] TokenArray Lex(std::string_view source, LineTable &lines) const;
+};
+#endif //PARALLELLEXER_H
@@ -0,0 +1,37 @@
+#ifndef SCANKERNELS_H
+#define SCANKERNELS_H
+
+// Byte-run search primitives used by the Lexer's hot loops. Each kernel
+// returns a pointer into [begin, end), or `end` when the run reaches it.
+// SSE2 and AVX2 versions process 16 / 32 bytes per step; the best one the CPU
+// supports is picked once at startup via CPUID, with a scalar fallback.
+namespace scan {
+    enum class Isa {
+        Scalar, SSE2, AVX2
+    };
+
+    struct Kernels {
+        Isa isa;
+        // First byte that is not ' ', '\t', '\r' or '\n'.
+        const char *(*skip_whitespace)(const char *begin, const char *end);
+        // First '\n' or '\r'.
+        const char *(*find_line_end)(const char *begin, const char *end);
+        // First '/' or '*', i.e. the next possible "/*" or "*/" in a block comment.
+        const char *(*find_comment_delimiter)(const char *begin, const char *end);
+        // First byte outside [A-Za-z0-9_].
+        const char *(*skip_identifier)(const char *begin, const char *end);
+    };
+
+    [[nodiscard]] bool Supported(Isa isa);
+
+    // Kernels for `isa`; it must be Supported().
+    [[nodiscard]] const Kernels &Select(Isa isa);
+
+    // The kernels the Lexer uses. Defaults to the widest supported ISA.
+    [[nodiscard]] const Kernels &Active();
+
+    void SetActive(Isa isa);
+
+    [[nodiscard]] const char *IsaName(Isa isa);
+}
+#endif //SCANKERNELS_H
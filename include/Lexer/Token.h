@@ -1,21 +1,104 @@
 #ifndef TOKEN_H
 #define TOKEN_H
-#include <string>
+#include <cstdint>
+#include <string_view>
+#include <vector>
 #include "TokenType.h"
 #include "Position.h"
+#include "StringInterner.h"
 
-
+// A token is a slice of the source buffer rather than an owned string; the
+// buffer must outlive every token taken from it.
 struct Token {
-    std::string token{};
     TokenType type{};
-    Position pos{};
+    uint32_t length = 0;
+    Position pos{}; // the offset is always set; row and column once the token is stamped
+    Atom atom = StringInterner::InvalidAtom; // set for identifiers only
 
-    Token() = default;
+    [[nodiscard]] uint32_t offset() const {
+        return pos.GetOffset();
+    }
 
-    explicit Token(const std::string &, const TokenType &);
+    [[nodiscard]] std::string_view text(const std::string_view source) const {
+        return source.substr(pos.GetOffset(), length);
+    }
 
     void putPosValue(const Position &pos) {
         this->pos = pos;
     }
 };
+
+// Everything about a token but its type and atom: 16 bytes.
+struct TokenSpan {
+    Position pos{};
+    uint32_t length = 0;
+
+    [[nodiscard]] std::string_view text(const std::string_view source) const {
+        return source.substr(pos.GetOffset(), length);
+    }
+};
+static_assert(sizeof(TokenSpan) == 16);
+
+// A token sequence in struct-of-arrays form. The parser tests the type of
+// nearly every token it looks at and reads the span only of those it
+// accepts, so the types are kept one byte each in an array of their own and
+// a run of type checks stays within a few cache lines. Identifier atoms are
+// read only when a path segment is built, so they get an array of their own
+// too.
+class TokenArray {
+    std::vector<TokenType> types_;
+    std::vector<TokenSpan> spans_;
+    std::vector<Atom> atoms_;
+
+    friend class TokenStream;
+
+public:
+    TokenArray() = default;
+
+    void push_back(const Token &token) {
+        types_.push_back(token.type);
+        spans_.push_back(TokenSpan{token.pos, token.length});
+        atoms_.push_back(token.atom);
+    }
+
+    void reserve(const size_t count) {
+        types_.reserve(count);
+        spans_.reserve(count);
+        atoms_.reserve(count);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return types_.size();
+    }
+
+    [[nodiscard]] bool empty() const {
+        return types_.empty();
+    }
+
+    [[nodiscard]] TokenType type(const size_t index) const {
+        return types_[index];
+    }
+
+    [[nodiscard]] const TokenSpan &span(const size_t index) const {
+        return spans_[index];
+    }
+
+    [[nodiscard]] Atom atom(const size_t index) const {
+        return atoms_[index];
+    }
+
+    // The token reassembled; for code that wants every field at once.
+    [[nodiscard]] Token operator[](const size_t index) const {
+        return Token{types_[index], spans_[index].length, spans_[index].pos, atoms_[index]};
+    }
+
+    // Copy of the tokens [begin, end).
+    [[nodiscard]] TokenArray Slice(const size_t begin, const size_t end) const {
+        TokenArray slice;
+        slice.types_.assign(types_.begin() + begin, types_.begin() + end);
+        slice.spans_.assign(spans_.begin() + begin, spans_.begin() + end);
+        slice.atoms_.assign(atoms_.begin() + begin, atoms_.begin() + end);
+        return slice;
+    }
+};
 #endif //TOKEN_H
@@ -1,7 +1,8 @@
 #ifndef TOKENTYPE_H
 #define TOKENTYPE_H
+#include <cstdint>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     LineComment,
     BlockComment,
     WhiteSpace,
@@ -0,0 +1,36 @@
+#ifndef PARALLELPARSER_H
+#define PARALLELPARSER_H
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Arena.h"
+#include "Lexer/Token.h"
+#include "Semantic/ASTNode.h"
+
+// Parses the top-level items of a crate on several threads.
+//
+// FindItemStarts cuts the token sequence at item boundaries by bracket depth.
+// Runs of consecutive items are handed out as batches to worker threads, each
+// with a Parser over a copy of the batch's tokens and an Arena of its own;
+// atoms are interned afterwards on the calling thread in source order, so
+// they get the numbers a sequential parse would give them. The item lists
+// are concatenated in source order and the worker arenas adopted by `arena`.
+//
+// If the boundaries cannot be found or any batch fails to parse, the whole
+// crate is parsed again sequentially. Diagnostics are therefore exactly those
+// of Parser::ParseCrate.
+class ParallelParser {
+    uint32_t threads_;
+
+public:
+    explicit ParallelParser(uint32_t threads);
+
+    // Throws ParseError if the tokens do not form a crate.
+    CrateNode *ParseCrate(Arena &arena, TokenArray &&tokens, std::string_view source) const;
+
+    // Index of the first token of every top-level item, or an empty vector if
+    // the tokens are not a plain sequence of fn, const, struct, enum, impl
+    // and trait items with balanced brackets.
+    static std::vector<uint32_t> FindItemStarts(const TokenArray &tokens);
+};
+#endif //PARALLELPARSER_H
@@ -1,112 +1,214 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <cstddef>
+#include <string_view>
 #include <vector>
-#include <memory> // Required for std::shared_ptr
+#include "Arena.h"
+#include "Parser/TokenStream.h"
 #include "Semantic/ASTNode.h"
 
+// Recursive-descent parser with backtracking.
+//
+// Parse* methods never throw. A method that cannot match returns nullptr after
+// recording why in failure_, with parseIndex left where it stopped; a caller
+// trying alternatives resets parseIndex and tries the next one, otherwise it
+// returns nullptr in turn. Only ParseCrate turns the last recorded failure into
+// a ParseError, so backtracking costs a branch instead of a stack unwind.
+//
+// Nodes are allocated in the caller's Arena and linked by plain pointers; the
+// arena owns the whole tree, so it must outlive every use of the crate. Nodes
+// built by an alternative that is later abandoned stay in the arena until it
+// is reset.
 class Parser {
-    std::vector<Token> tokens;
+    struct Failure {
+        const char *message = "";
+        std::string_view detail; // appended to message; points at a string literal
+        Position pos;
+    };
+
+    Arena &arena_;
+    TokenStream tokens;
+    std::string_view source_;
     uint32_t parseIndex = 0;
+    Failure failure_;
+    std::vector<PathIndentSegmentNode *> *deferred_atoms_ = nullptr;
+
+    // The last expression parsed successfully from `start`, with the state it
+    // left behind. Statements try an expression without a block, then with one,
+    // then as a tail expression, all from the same token; without these every
+    // level of nested blocks would parse its contents again, twice per level.
+    // One entry per kind is enough, because the inner levels finish before the
+    // outer level asks again.
+    struct ExpressionMemo {
+        uint32_t start = UINT32_MAX;
+        uint32_t end = 0;
+        ExpressionNode *node = nullptr;
+        Failure failure;
+    };
+    ExpressionMemo with_block_memo_;
+    ExpressionMemo without_block_memo_;
+
+    // Item statements made so far, including those of attempts that were
+    // backtracked over, so a function or constant that sees the count move
+    // may contain items (see FunctionNode::has_nested_items_).
+    uint32_t item_statements_ = 0;
+
+    // Replays `memo` if it was recorded at parseIndex.
+    [[nodiscard]] ExpressionNode *Recall(const ExpressionMemo &memo) {
+        if (memo.start != parseIndex) {
+            return nullptr;
+        }
+        parseIndex = memo.end;
+        failure_ = memo.failure;
+        return memo.node;
+    }
+
+    ExpressionNode *Remember(ExpressionMemo &memo, const uint32_t start, ExpressionNode *node) {
+        if (node != nullptr) {
+            memo = ExpressionMemo{start, parseIndex, node, failure_};
+        }
+        return node;
+    }
+
+    // Always returns nullptr, so a failing Parse* method can `return Fail(...)`.
+    std::nullptr_t Fail(const char *message, Position pos, std::string_view detail = {}) {
+        failure_ = Failure{message, detail, pos};
+        return nullptr;
+    }
 
-    void ConsumeString(const std::string &);
+    [[nodiscard]] bool ConsumeString(std::string_view);
+
+    [[nodiscard]] std::string_view TokenText(const uint32_t index) {
+        return tokens.span(index).text(source_);
+    }
 
 public:
-    Parser() = default;
+    // Takes ownership of the token stream; `source` is the buffer the tokens
+    // were lexed from and must stay alive while parsing.
+    Parser(Arena &arena, TokenArray &&tokens, const std::string_view source)
+        : arena_(arena), tokens(std::move(tokens)), source_(source) {
+    }
+
+    // Streaming mode: tokens are scanned from `source` by `lexer` as parsing
+    // reaches them, and dropped after each top-level item.
+    Parser(Arena &arena, const Lexer &lexer, const std::string_view source)
+        : arena_(arena), tokens(lexer, source), source_(source) {
+    }
+
+    [[nodiscard]] uint32_t peak_token_window() const {
+        return tokens.peak_window();
+    }
 
-    explicit Parser(const std::vector<Token> &tokens) {
-        this->tokens = tokens;
+    // Path segments whose token carries no atom are built with InvalidAtom and
+    // appended to `segments` instead of being interned, so a parser running
+    // off the main thread never touches GlobalInterner. The caller interns
+    // them afterwards in the order they were appended.
+    void DeferInterning(std::vector<PathIndentSegmentNode *> &segments) {
+        deferred_atoms_ = &segments;
     }
 
+    // How tightly the binary operators and `as` bind, loosest first.
+    enum class Precedence : uint8_t {
+        None,
+        Assignment,
+        LogicalOr,
+        LogicalAnd,
+        Comparison,
+        BitwiseOr,
+        BitwiseXor,
+        BitwiseAnd,
+        Shift,
+        AddMinus,
+        MulDivMod,
+        TypeCast,
+    };
+
     /****************  Items  ****************/
-    std::shared_ptr<CrateNode> ParseCrate();
-    std::shared_ptr<VisItemNode> ParseVisItem();
-    std::shared_ptr<FunctionNode> ParseFunction();
-    std::shared_ptr<StructNode> ParseStruct();
-    std::shared_ptr<StructFieldNode> ParseStructFieldNode();
-    std::shared_ptr<EnumerationNode> ParseEnumeration();
-    std::shared_ptr<EnumVariantNode> ParseEnumVariant();
-    std::shared_ptr<EnumVariantStructNode> ParseEnumVariantStruct();
-    std::shared_ptr<EnumVariantDiscriminantNode> ParseEnumVariantDiscriminant();
-    std::shared_ptr<ConstantItemNode> ParseConstantItem();
-    std::shared_ptr<AssociatedItemNode> ParseAssociatedItem();
-    std::shared_ptr<TraitNode> ParseTrait();
-    std::shared_ptr<ImplementationNode> ParseImplementation();
-    std::shared_ptr<InherentImplNode> ParseInherentImpl();
-    std::shared_ptr<TraitImplNode> ParseTraitImpl();
-    std::shared_ptr<TypeNode> ParseFunctionReturnType();
-    std::shared_ptr<FunctionParametersNode> ParseFunctionParameters();
-    std::shared_ptr<FunctionParamNode> ParseFunctionParam();
-    std::shared_ptr<FunctionParamPatternNode> ParseFunctionParamPattern();
-    std::shared_ptr<SelfParamNode> ParseSelfParamNode();
+    // Throws ParseError if the tokens do not form a crate.
+    CrateNode *ParseCrate();
+    // Appends items until the tokens run out; false if one does not parse.
+    [[nodiscard]] bool ParseItems(std::vector<VisItemNode *> &items);
+    VisItemNode *ParseVisItem();
+    FunctionNode *ParseFunction();
+    StructNode *ParseStruct();
+    StructFieldNode *ParseStructFieldNode();
+    EnumerationNode *ParseEnumeration();
+    EnumVariantNode *ParseEnumVariant();
+    EnumVariantStructNode *ParseEnumVariantStruct();
+    EnumVariantDiscriminantNode *ParseEnumVariantDiscriminant();
+    ConstantItemNode *ParseConstantItem();
+    AssociatedItemNode *ParseAssociatedItem();
+    TraitNode *ParseTrait();
+    ImplementationNode *ParseImplementation();
+    InherentImplNode *ParseInherentImpl();
+    TraitImplNode *ParseTraitImpl();
+    TypeNode *ParseFunctionReturnType();
+    FunctionParametersNode *ParseFunctionParameters();
+    FunctionParamNode *ParseFunctionParam();
+    FunctionParamPatternNode *ParseFunctionParamPattern();
+    SelfParamNode *ParseSelfParamNode();
 
     /****************  Expression  ****************/
-    std::shared_ptr<ExpressionNode> ParseExpression();
-    std::shared_ptr<ExpressionNode> ParseExpressionWithBlock();
-    std::shared_ptr<BlockExpressionNode> ParseBlockExpression();
-    std::shared_ptr<BlockExpressionNode> ParseConstBlockExpression();
-    std::shared_ptr<InfiniteLoopExpressionNode> ParseInfiniteLoopExpression();
-    std::shared_ptr<PredicateLoopExpressionNode> ParsePredicateLoopExpression();
-    std::shared_ptr<IfExpressionNode> ParseIfExpression();
-    std::shared_ptr<MatchExpressionNode> ParseMatchExpression();
-    std::shared_ptr<ExpressionNode> ParseExpressionWithoutBlock();
-    std::shared_ptr<ExpressionNode> ParseTupleExpression();
-    std::shared_ptr<ExpressionNode> ParseJumpExpression();
-    std::shared_ptr<ExpressionNode> ParseAssignmentExpression();
-    std::shared_ptr<ExpressionNode> ParseLogicalOrExpression();
-    std::shared_ptr<ExpressionNode> ParseLogicalAndExpression();
-    std::shared_ptr<ExpressionNode> ParseComparisonExpression();
-    std::shared_ptr<ExpressionNode> ParseBitwiseOrExpression();
-    std::shared_ptr<ExpressionNode> ParseBitwiseXorExpression();
-    std::shared_ptr<ExpressionNode> ParseBitwiseAndExpression();
-    std::shared_ptr<ExpressionNode> ParseShiftExpression();
-    std::shared_ptr<ExpressionNode> ParseAddMinusExpression();
-    std::shared_ptr<ExpressionNode> ParseMulDivModExpression();
-    std::shared_ptr<ExpressionNode> ParseTypeCastExpression();
-    std::shared_ptr<ExpressionNode> ParseUnaryExpression();
-    std::shared_ptr<ExpressionNode> ParseCallExpression();
-    std::shared_ptr<ExpressionNode> ParsePrimaryExpression();
-    std::shared_ptr<StructExpressionNode> ParseStructExpression();
-    std::shared_ptr<StructExprFieldsNode> ParseStructExprFields();
-    std::shared_ptr<StructExprFieldNode> ParseStructExprField();
-    std::shared_ptr<StructBaseNode> ParseStructBase();
-    std::shared_ptr<ExpressionNode> ParseLiteral();
-    std::shared_ptr<PathExpressionNode> ParsePathExpression();
-    std::shared_ptr<PathInExpressionNode> ParsePathInExpression();
-    std::shared_ptr<StatementsNode> ParseStatements();
-    std::shared_ptr<ConditionsNode> ParseConditions();
-    std::shared_ptr<MatchArmsNode> ParseMatchArms();
-    std::shared_ptr<MatchArmNode> ParseMatchArm();
-    std::shared_ptr<LetChainNode> ParseLetChain();
-    std::shared_ptr<LetChainConditionNode> ParseLetChainCondition();
+    ExpressionNode *ParseExpression();
+    ExpressionNode *ParseExpressionWithBlock();
+    ExpressionNode *ParseExpressionWithBlockUncached();
+    BlockExpressionNode *ParseBlockExpression();
+    BlockExpressionNode *ParseConstBlockExpression();
+    InfiniteLoopExpressionNode *ParseInfiniteLoopExpression();
+    PredicateLoopExpressionNode *ParsePredicateLoopExpression();
+    IfExpressionNode *ParseIfExpression();
+    MatchExpressionNode *ParseMatchExpression();
+    ExpressionNode *ParseExpressionWithoutBlock();
+    ExpressionNode *ParseExpressionWithoutBlockUncached();
+    ExpressionNode *ParseTupleExpression();
+    ExpressionNode *ParseJumpExpression();
+    ExpressionNode *ParseAssignmentExpression();
+    ExpressionNode *ParseOperatorExpression(Precedence min_precedence);
+    ExpressionNode *ParseUnaryExpression();
+    ExpressionNode *ParseCallExpression();
+    ExpressionNode *ParsePrimaryExpression();
+    StructExpressionNode *ParseStructExpression();
+    StructExprFieldsNode *ParseStructExprFields();
+    StructExprFieldNode *ParseStructExprField();
+    StructBaseNode *ParseStructBase();
+    ExpressionNode *ParseLiteral();
+    PathExpressionNode *ParsePathExpression();
+    PathInExpressionNode *ParsePathInExpression();
+    StatementsNode *ParseStatements();
+    ConditionsNode *ParseConditions();
+    MatchArmsNode *ParseMatchArms();
+    MatchArmNode *ParseMatchArm();
+    LetChainNode *ParseLetChain();
+    LetChainConditionNode *ParseLetChainCondition();
 
     /****************  Statement  ****************/
-    std::shared_ptr<StatementNode> ParseStatement();
-    std::shared_ptr<LetStatementNode> ParseLetStatement();
-    std::shared_ptr<ExpressionStatementNode> ParseExpressionStatement();
+    StatementNode *ParseStatement();
+    LetStatementNode *ParseLetStatement();
+    ExpressionStatementNode *ParseExpressionStatement();
 
     /****************  Patterns  ****************/
-    std::shared_ptr<PatternNode> ParsePattern();
-    std::shared_ptr<PatternNoTopAltNode> ParsePatternNoTopAlt();
-    std::shared_ptr<PatternWithoutRangeNode> ParsePatternWithoutRange();
-    std::shared_ptr<LiteralPatternNode> ParseLiteralPattern();
-    std::shared_ptr<IdentifierPatternNode> ParseIdentifierPattern();
-    std::shared_ptr<SlicePatternNode> ParseSlicePattern();
-    std::shared_ptr<PathPatternNode> ParsePathPattern();
+    PatternNode *ParsePattern();
+    PatternNoTopAltNode *ParsePatternNoTopAlt();
+    PatternWithoutRangeNode *ParsePatternWithoutRange();
+    LiteralPatternNode *ParseLiteralPattern();
+    IdentifierPatternNode *ParseIdentifierPattern();
+    SlicePatternNode *ParseSlicePattern();
+    PathPatternNode *ParsePathPattern();
 
     /****************  Types  ****************/
-    std::shared_ptr<TypeNode> ParseType();
-    std::shared_ptr<TypeNoBoundsNode> ParseTypeNoBounds();
-    std::shared_ptr<ParenthesizedTypeNode> ParseParenthesizedType();
-    std::shared_ptr<TypePathNode> ParseTypePath();
-    std::shared_ptr<TypePathSegmentNode> ParseTypePathSegment();
-    std::shared_ptr<UnitTypeNode> ParseUnitType();
-    std::shared_ptr<ArrayTypeNode> ParseArrayType();
-    std::shared_ptr<SliceTypeNode> ParseSliceType();
-    std::shared_ptr<ReferenceTypeNode> ParseReferenceType();
+    TypeNode *ParseType();
+    TypeNoBoundsNode *ParseTypeNoBounds();
+    ParenthesizedTypeNode *ParseParenthesizedType();
+    TypePathNode *ParseTypePath();
+    TypePathSegmentNode *ParseTypePathSegment();
+    UnitTypeNode *ParseUnitType();
+    ArrayTypeNode *ParseArrayType();
+    SliceTypeNode *ParseSliceType();
+    ReferenceTypeNode *ParseReferenceType();
 
     /****************  Paths  ****************/
-    std::shared_ptr<PathIndentSegmentNode> ParsePathIndentSegment();
+    PathIndentSegmentNode *ParsePathIndentSegment();
 };
 
 #endif //PARSER_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Lexer/Lexer.h"
+
+// The parser's view of the token sequence, addressed by absolute index.
+//
+// Tokens live in a power-of-two ring buffer. In streaming mode the buffer is
+// filled by pulling from a Lexer only when the parser looks at an index that
+// has not been scanned yet, so lexing and parsing interleave. The parser never
+// looks more than two tokens ahead of parseIndex, but it backtracks to the
+// start of any construct it is speculatively parsing; so instead of a fixed
+// lookahead window, the parser calls Release() after each top-level item and
+// everything before that point is dropped. Token memory is therefore bounded
+// by the largest item, not by the size of the file.
+//
+// Reading past the last token yields a TokenType::None sentinel positioned on
+// the last row.
+//
+// Like TokenArray, the ring is split into a byte per token type and separate
+// arrays of spans and atoms, so the parser's type tests touch only the first.
+class TokenStream {
+    const Lexer *lexer_ = nullptr;
+    std::string_view source_;
+    uint32_t lex_offset_ = 0;
+    LineTable lines_;
+
+    std::vector<TokenType> types_;
+    std::vector<TokenSpan> spans_;
+    std::vector<Atom> atoms_;
+    uint32_t mask_ = 0;
+    uint32_t base_ = 0; // oldest retained index
+    uint32_t end_ = 0; // one past the newest scanned index
+    TokenSpan sentinel_;
+    uint32_t peak_window_ = 0;
+
+    void Grow();
+
+    // Scans until `index` is buffered; false if the input ends first.
+    bool Fill(uint32_t index);
+
+public:
+    TokenStream() = default;
+
+    // Batch mode: every token has already been scanned.
+    explicit TokenStream(TokenArray &&tokens);
+
+    // Streaming mode: tokens are pulled from `lexer` on demand.
+    TokenStream(const Lexer &lexer, std::string_view source);
+
+    TokenType type(const uint32_t index) {
+        if (index < end_ || Fill(index)) {
+            return types_[index & mask_];
+        }
+        return TokenType::None;
+    }
+
+    const TokenSpan &span(const uint32_t index) {
+        if (index < end_ || Fill(index)) {
+            return spans_[index & mask_];
+        }
+        return sentinel_;
+    }
+
+    // InvalidAtom past the end, for tokens other than identifiers, and for
+    // identifiers the lexer was told not to intern.
+    Atom atom(const uint32_t index) {
+        if (index < end_ || Fill(index)) {
+            return atoms_[index & mask_];
+        }
+        return StringInterner::InvalidAtom;
+    }
+
+    const Position &pos(const uint32_t index) {
+        return span(index).pos;
+    }
+
+    bool AtEnd(const uint32_t index) {
+        return index >= end_ && !Fill(index);
+    }
+
+    // Drops every token before `index`; the parser will not backtrack past it.
+    void Release(uint32_t index);
+
+    // Scans the rest of the input without buffering it. In streaming mode the
+    // parser calls this before reporting a failure, so a LexError further on
+    // wins over the ParseError, as it does when the whole input is lexed
+    // first.
+    void Drain();
+
+    // Largest number of tokens buffered at once.
+    [[nodiscard]] uint32_t peak_window() const {
+        return peak_window_;
+    }
+};
+#endif //TOKENSTREAM_H
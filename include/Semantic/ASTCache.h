@@ -0,0 +1,59 @@
+#ifndef ASTCACHE_H
+#define ASTCACHE_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Arena.h"
+#include "Semantic/ASTNode.h"
+#include "Semantic/ScopeManager.h"
+
+// On-disk cache of the semantically checked crate, so an unchanged source
+// skips the lexer, the parser and both semantic passes (SymbolCollector's
+// item pass and SemanticChecker).
+//
+// An entry is one file per source in `directory`, named by a hash of the
+// source text. It holds the CrateNode tree with every annotation the passes
+// left on it, the scope tree and every Type reachable from either, plus the
+// interned strings in atom order, so a load restores the exact state the IR
+// builder would have seen after a cold run. Shared Types and cycles between
+// them (a struct whose method returns the struct) keep their identity.
+//
+// The header records FormatVersion, SemanticsVersion and a stamp of the
+// compiler executable (size and modification time), so rebuilding the
+// compiler invalidates every entry. A missing, stale or damaged entry is a
+// miss, never an error.
+//
+// Only a crate that passed the check is stored, and a hit skips the check, so
+// an entry must mean the same whichever options wrote or reads it. No option
+// changes what the check accepts: --sema-threads gives the sequential result
+// (ParallelSemaBench compares the two), and the lexer and parser options
+// build the same crate.
+class ASTCache {
+    std::string directory_;
+
+    [[nodiscard]] std::string EntryPath(uint64_t source_hash) const;
+
+public:
+    // Bump whenever the layout of an entry or of a cached class changes.
+    static constexpr uint32_t FormatVersion = 5;
+
+    // Bump whenever the semantic check accepts a different set of programs,
+    // so that an entry never stands for a check the compiler no longer makes.
+    // An option that makes the check accept a different set must become part
+    // of the header instead of being ignored here.
+    static constexpr uint32_t SemanticsVersion = 3;
+
+    explicit ASTCache(std::string directory);
+
+    // On a hit, rebuilds the crate into `arena` and the scope tree into
+    // `scope_manager`, interns the cached strings and returns the crate;
+    // returns nullptr on a miss and leaves both untouched.
+    CrateNode *Load(std::string_view source, Arena &arena, ScopeManager &scope_manager) const;
+
+    // Writes the entry for `source`. Call after the semantic passes succeed
+    // and before IR generation. Returns false if the entry could not be written.
+    bool Store(std::string_view source, CrateNode *crate, const ScopeManager &scope_manager) const;
+
+    static uint64_t HashBytes(std::string_view bytes);
+};
+#endif //ASTCACHE_H
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <memory> // Required for std::shared_ptr
+#include "Casting.h"
 #include "Position.h"
 #include "Lexer/TokenType.h"
 #include "Lexer/Token.h"
@@ -108,6 +109,106 @@ class ArrayTypeNode;
 class SliceTypeNode;
 class ReferenceTypeNode;
 
+// Identifies the concrete class of an AST node without RTTI. Enumerators are
+// listed in a preorder walk of the class hierarchy, so every class with
+// subclasses covers a contiguous range that its classof() tests.
+enum class ASTKind : uint8_t {
+    PathIndentSegment,
+    Crate,
+    VisItem,
+        Function,
+        Struct,
+        Enumeration,
+        ConstantItem,
+        AssociatedItem,
+        Trait,
+        Implementation,
+            InherentImpl,
+            TraitImpl,
+    FunctionParameters,
+    SelfParam,
+        ShortHandSelf,
+        TypedSelf,
+    FunctionParam,
+    FunctionParamPattern,
+    StructField,
+    EnumVariant,
+    EnumVariantStruct,
+    EnumVariantDiscriminant,
+    Expression,
+        ExpressionWithBlock,
+            BlockExpression,
+            LoopExpression,
+                InfiniteLoopExpression,
+                PredicateLoopExpression,
+            IfExpression,
+            MatchExpression,
+        ExpressionWithoutBlock,
+            ContinueExpression,
+            TupleExpression,
+            UnderscoreExpression,
+            JumpExpression,
+            AssignmentExpression,
+            LogicOrExpression,
+            LogicAndExpression,
+            ComparisonExpression,
+            BitwiseOrExpression,
+            BitwiseXorExpression,
+            BitwiseAndExpression,
+            ShiftExpression,
+            AddMinusExpression,
+            MulDivModExpression,
+            TypeCastExpression,
+            UnaryExpression,
+            FunctionCallExpression,
+            ArrayIndexExpression,
+            MemberAccessExpression,
+            GroupedExpression,
+            StructExpression,
+            PathExpression,
+                PathInExpression,
+            LiteralExpression,
+                CharLiteral,
+                StringLiteral,
+                IntLiteral,
+                BoolLiteral,
+                CStringLiteral,
+                ArrayLiteral,
+    StructExprFields,
+    StructExprField,
+    StructBase,
+    Conditions,
+    LetChain,
+    LetChainCondition,
+    Statements,
+    MatchArms,
+    MatchArm,
+    Statement,
+        EmptyStatement,
+        LetStatement,
+        ExpressionStatement,
+        VisItemStatement,
+    Pattern,
+    PatternNoTopAlt,
+        PatternWithoutRange,
+            LiteralPattern,
+            IdentifierPattern,
+            WildcardPattern,
+            RestPattern,
+            GroupedPattern,
+            SlicePattern,
+            PathPattern,
+    Type,
+        TypeNoBounds,
+            ParenthesizedType,
+            TypePath,
+            UnitType,
+            ArrayType,
+            SliceType,
+            ReferenceType,
+    TypePathSegment,
+};
+
 // Assuming 'Type' class is defined elsewhere and has a proper definition
 class Type;
 
@@ -115,12 +216,19 @@ class ASTNode {
 public:
     Position pos_;
 
-    explicit ASTNode(const Position pos) : pos_(pos) {
+    ASTNode(const ASTKind kind, const Position pos) : pos_(pos), kind_(kind) {
+    }
+
+    [[nodiscard]] ASTKind kind() const {
+        return kind_;
     }
 
     virtual ~ASTNode() = default;
 
     virtual void accept(ASTVisitor *visitor) = 0;
+
+private:
+    ASTKind kind_;
 };
 
 /****************  Path (Naive Version) ****************/
@@ -128,15 +236,23 @@ class PathIndentSegmentNode : public ASTNode {
 public:
     TokenType type_;
     std::string identifier_;
+    Atom atom_;
 
     PathIndentSegmentNode(Position pos, TokenType type, std::string identifier)
-        : ASTNode(pos), type_(type), identifier_(std::move(identifier)) {
+        : ASTNode(ASTKind::PathIndentSegment, pos), type_(type), identifier_(std::move(identifier)),
+          atom_(GlobalInterner().Intern(identifier_)) {
+    }
+
+    PathIndentSegmentNode(Position pos, TokenType type, std::string identifier, Atom atom)
+        : ASTNode(ASTKind::PathIndentSegment, pos), type_(type), identifier_(std::move(identifier)), atom_(atom) {
     }
 
     ~PathIndentSegmentNode() override = default;
 
     [[nodiscard]] std::string toString() const { return identifier_; }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::PathIndentSegment; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -144,24 +260,30 @@ public:
 class CrateNode : public ASTNode {
 public:
 	uint32_t scope_index = 0;
-    std::vector<std::shared_ptr<VisItemNode> > items_;
+    std::vector<VisItemNode *> items_;
 
-    CrateNode(Position pos, std::vector<std::shared_ptr<VisItemNode> > items)
-        : ASTNode(pos), items_(std::move(items)) {
+    CrateNode(Position pos, std::vector<VisItemNode *> items)
+        : ASTNode(ASTKind::Crate, pos), items_(std::move(items)) {
     }
 
     ~CrateNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Crate; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class VisItemNode : public ASTNode {
 public:
-    explicit VisItemNode(Position pos) : ASTNode(pos) {
+    VisItemNode(ASTKind kind, Position pos) : ASTNode(kind, pos) {
     }
 
     ~VisItemNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::VisItem && node->kind() <= ASTKind::TraitImpl;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -169,17 +291,21 @@ class FunctionNode : public VisItemNode {
 public:
     bool is_const_;
     std::string identifier_;
-    std::shared_ptr<FunctionParametersNode> function_parameters_;
-    std::shared_ptr<TypeNode> type_;
-    std::shared_ptr<BlockExpressionNode> block_expression_;
+    FunctionParametersNode *function_parameters_ = nullptr;
+    TypeNode *type_ = nullptr;
+    BlockExpressionNode *block_expression_ = nullptr;
+    // Whether the body may declare items in some block; set by the parser,
+    // which may also set it for a body that turned out not to, never the
+    // other way round. SymbolCollector walks only such bodies.
+    bool has_nested_items_ = false;
 	std::shared_ptr<IRVar> struct_ret_var;
 	bool is_struct_type = false;
 
     FunctionNode(Position pos, bool is_const, std::string identifier,
-                 std::shared_ptr<FunctionParametersNode> function_parameters,
-                 std::shared_ptr<TypeNode> type,
-                 std::shared_ptr<BlockExpressionNode> block_expression)
-        : VisItemNode(pos), is_const_(is_const), identifier_(std::move(identifier)),
+                 FunctionParametersNode *function_parameters,
+                 TypeNode *type,
+                 BlockExpressionNode *block_expression)
+        : VisItemNode(ASTKind::Function, pos), is_const_(is_const), identifier_(std::move(identifier)),
           function_parameters_(std::move(function_parameters)),
           type_(std::move(type)),
           block_expression_(std::move(block_expression)) {
@@ -187,32 +313,40 @@ public:
 
     ~FunctionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Function; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class SelfParamNode;
 class FunctionParametersNode : public ASTNode {
 public:
-    std::shared_ptr<SelfParamNode> self_param_node_;
-    std::vector<std::shared_ptr<FunctionParamNode> > function_params_;
+    SelfParamNode *self_param_node_ = nullptr;
+    std::vector<FunctionParamNode *> function_params_;
 
-    FunctionParametersNode(Position pos, const std::shared_ptr<SelfParamNode>& self_param_node,
-        std::vector<std::shared_ptr<FunctionParamNode> > function_params)
-        : ASTNode(pos), function_params_(std::move(function_params)) {
+    FunctionParametersNode(Position pos, SelfParamNode *self_param_node,
+        std::vector<FunctionParamNode *> function_params)
+        : ASTNode(ASTKind::FunctionParameters, pos), function_params_(std::move(function_params)) {
         self_param_node_ = self_param_node;
     }
 
     ~FunctionParametersNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::FunctionParameters; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class SelfParamNode : public ASTNode {
 public:
-    explicit SelfParamNode(Position pos): ASTNode(pos) {}
+    SelfParamNode(ASTKind kind, Position pos): ASTNode(kind, pos) {}
 
     ~SelfParamNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::SelfParam && node->kind() <= ASTKind::TypedSelf;
+    }
+
     void accept(ASTVisitor* visitor) override {visitor -> visit(this);}
 };
 
@@ -221,152 +355,172 @@ public:
     bool have_and_ = false;
     bool is_mut_ = false;
 
-    ShortHandSelfNode(Position pos, bool have_and, bool is_mut): SelfParamNode(pos) {
+    ShortHandSelfNode(Position pos, bool have_and, bool is_mut): SelfParamNode(ASTKind::ShortHandSelf, pos) {
         have_and_ = have_and;
         is_mut_ = is_mut;
     }
 
     ~ShortHandSelfNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ShortHandSelf; }
+
     void accept(ASTVisitor *visitor) override {visitor -> visit(this);}
 };
 
 class TypedSelfNode : public SelfParamNode {
 public:
     bool is_mut_;
-    std::shared_ptr<TypeNode> type_node_;
+    TypeNode *type_node_ = nullptr;
 
-    TypedSelfNode(Position pos, bool is_mut, const std::shared_ptr<TypeNode>& type_node):
-        SelfParamNode(pos) {
+    TypedSelfNode(Position pos, bool is_mut, TypeNode *type_node):
+        SelfParamNode(ASTKind::TypedSelf, pos) {
         is_mut_ = is_mut;
         type_node_ = type_node;
     }
 
     ~TypedSelfNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TypedSelf; }
+
     void accept(ASTVisitor *visitor) override {visitor -> visit(this);}
 };
 
 class FunctionParamNode : public ASTNode {
 public:
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_node_;
-    std::shared_ptr<TypeNode> type_;
+    PatternNoTopAltNode *pattern_no_top_alt_node_ = nullptr;
+    TypeNode *type_ = nullptr;
     bool is_DotDotDot_;
 
-    FunctionParamNode(Position pos, std::shared_ptr<PatternNoTopAltNode> function_param_pattern,
-                      std::shared_ptr<TypeNode> type, bool is_DotDotDot)
-        : ASTNode(pos), pattern_no_top_alt_node_(std::move(function_param_pattern)),
+    FunctionParamNode(Position pos, PatternNoTopAltNode *function_param_pattern,
+                      TypeNode *type, bool is_DotDotDot)
+        : ASTNode(ASTKind::FunctionParam, pos), pattern_no_top_alt_node_(std::move(function_param_pattern)),
           type_(std::move(type)), is_DotDotDot_(is_DotDotDot) {
     }
 
     ~FunctionParamNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::FunctionParam; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class FunctionParamPatternNode : public ASTNode {
 public:
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_;
-    std::shared_ptr<TypeNode> type_;
+    PatternNoTopAltNode *pattern_no_top_alt_ = nullptr;
+    TypeNode *type_ = nullptr;
     bool is_DotDotDot_;
 
-    FunctionParamPatternNode(Position pos, std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt,
-                             std::shared_ptr<TypeNode> type, bool is_DotDotDot)
-        : ASTNode(pos), pattern_no_top_alt_(std::move(pattern_no_top_alt)),
+    FunctionParamPatternNode(Position pos, PatternNoTopAltNode *pattern_no_top_alt,
+                             TypeNode *type, bool is_DotDotDot)
+        : ASTNode(ASTKind::FunctionParamPattern, pos), pattern_no_top_alt_(std::move(pattern_no_top_alt)),
           type_(std::move(type)), is_DotDotDot_(is_DotDotDot) {
     }
 
     ~FunctionParamPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::FunctionParamPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructNode : public VisItemNode {
 public:
     std::string identifier_;
-    std::vector<std::shared_ptr<StructFieldNode> > struct_field_nodes_;
+    std::vector<StructFieldNode *> struct_field_nodes_;
 
     StructNode(Position pos, std::string identifier,
-               std::vector<std::shared_ptr<StructFieldNode> > struct_field_nodes)
-        : VisItemNode(pos), identifier_(std::move(identifier)), struct_field_nodes_(std::move(struct_field_nodes)) {
+               std::vector<StructFieldNode *> struct_field_nodes)
+        : VisItemNode(ASTKind::Struct, pos), identifier_(std::move(identifier)), struct_field_nodes_(std::move(struct_field_nodes)) {
     }
 
     ~StructNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Struct; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructFieldNode : public ASTNode {
 public:
     std::string identifier_;
-    std::shared_ptr<TypeNode> type_node_;
+    TypeNode *type_node_ = nullptr;
 
-    StructFieldNode(Position pos, std::string identifier, std::shared_ptr<TypeNode> type_node)
-        : ASTNode(pos), identifier_(std::move(identifier)), type_node_(std::move(type_node)) {
+    StructFieldNode(Position pos, std::string identifier, TypeNode *type_node)
+        : ASTNode(ASTKind::StructField, pos), identifier_(std::move(identifier)), type_node_(std::move(type_node)) {
     }
 
     ~StructFieldNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StructField; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class EnumerationNode : public VisItemNode {
 public:
     std::string identifier_;
-    std::vector<std::shared_ptr<EnumVariantNode> > enum_variant_nodes_;
+    std::vector<EnumVariantNode *> enum_variant_nodes_;
 
     EnumerationNode(Position pos, std::string identifier,
-                    std::vector<std::shared_ptr<EnumVariantNode> > enum_variant_nodes)
-        : VisItemNode(pos), identifier_(std::move(identifier)), enum_variant_nodes_(std::move(enum_variant_nodes)) {
+                    std::vector<EnumVariantNode *> enum_variant_nodes)
+        : VisItemNode(ASTKind::Enumeration, pos), identifier_(std::move(identifier)), enum_variant_nodes_(std::move(enum_variant_nodes)) {
     }
 
     ~EnumerationNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Enumeration; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class EnumVariantNode : public ASTNode {
 public:
     std::string identifier_;
-    std::shared_ptr<EnumVariantStructNode> enum_variant_struct_node_;
-    std::shared_ptr<EnumVariantDiscriminantNode> enum_variant_discriminant_node_;
+    EnumVariantStructNode *enum_variant_struct_node_ = nullptr;
+    EnumVariantDiscriminantNode *enum_variant_discriminant_node_ = nullptr;
 
     EnumVariantNode(Position pos, std::string identifier,
-                    std::shared_ptr<EnumVariantStructNode> enum_variant_struct_node,
-                    std::shared_ptr<EnumVariantDiscriminantNode> enum_variant_discriminant_node)
-        : ASTNode(pos), identifier_(std::move(identifier)),
+                    EnumVariantStructNode *enum_variant_struct_node,
+                    EnumVariantDiscriminantNode *enum_variant_discriminant_node)
+        : ASTNode(ASTKind::EnumVariant, pos), identifier_(std::move(identifier)),
           enum_variant_struct_node_(std::move(enum_variant_struct_node)),
           enum_variant_discriminant_node_(std::move(enum_variant_discriminant_node)) {
     }
 
     ~EnumVariantNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::EnumVariant; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class EnumVariantStructNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<StructFieldNode> > struct_field_nodes_;
+    std::vector<StructFieldNode *> struct_field_nodes_;
 
-    EnumVariantStructNode(Position pos, std::vector<std::shared_ptr<StructFieldNode> > struct_field_nodes)
-        : ASTNode(pos), struct_field_nodes_(std::move(struct_field_nodes)) {
+    EnumVariantStructNode(Position pos, std::vector<StructFieldNode *> struct_field_nodes)
+        : ASTNode(ASTKind::EnumVariantStruct, pos), struct_field_nodes_(std::move(struct_field_nodes)) {
     }
 
     ~EnumVariantStructNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::EnumVariantStruct; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class EnumVariantDiscriminantNode : public ASTNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_node_;
+    ExpressionNode *expression_node_ = nullptr;
 
-    EnumVariantDiscriminantNode(Position pos, std::shared_ptr<ExpressionNode> expression_node)
-        : ASTNode(pos), expression_node_(std::move(expression_node)) {
+    EnumVariantDiscriminantNode(Position pos, ExpressionNode *expression_node)
+        : ASTNode(ASTKind::EnumVariantDiscriminant, pos), expression_node_(std::move(expression_node)) {
     }
 
     ~EnumVariantDiscriminantNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::EnumVariantDiscriminant; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -374,93 +528,109 @@ class ConstantItemNode : public VisItemNode {
 public:
     std::string identifier_;
     bool is_underscore_;
-    std::shared_ptr<TypeNode> type_node_;
-    std::shared_ptr<ExpressionNode> expression_node_;
+    TypeNode *type_node_ = nullptr;
+    ExpressionNode *expression_node_ = nullptr;
+    // As FunctionNode::has_nested_items_, for the blocks of the expression.
+    bool has_nested_items_ = false;
 
     ConstantItemNode(Position pos, std::string identifier, bool is_underscore,
-                     std::shared_ptr<TypeNode> type_node, std::shared_ptr<ExpressionNode> expression_node)
-        : VisItemNode(pos), identifier_(std::move(identifier)), is_underscore_(is_underscore),
+                     TypeNode *type_node, ExpressionNode *expression_node)
+        : VisItemNode(ASTKind::ConstantItem, pos), identifier_(std::move(identifier)), is_underscore_(is_underscore),
           type_node_(std::move(type_node)), expression_node_(std::move(expression_node)) {
     }
 
     ~ConstantItemNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ConstantItem; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class AssociatedItemNode : public VisItemNode {
 public:
-    std::shared_ptr<ConstantItemNode> constant_item_node_;
-    std::shared_ptr<FunctionNode> function_node_;
+    ConstantItemNode *constant_item_node_ = nullptr;
+    FunctionNode *function_node_ = nullptr;
 
-    AssociatedItemNode(Position pos, std::shared_ptr<ConstantItemNode> constant_item_node,
-                       std::shared_ptr<FunctionNode> function_node)
-        : VisItemNode(pos), constant_item_node_(std::move(constant_item_node)),
+    AssociatedItemNode(Position pos, ConstantItemNode *constant_item_node,
+                       FunctionNode *function_node)
+        : VisItemNode(ASTKind::AssociatedItem, pos), constant_item_node_(std::move(constant_item_node)),
           function_node_(std::move(function_node)) {
     }
 
     ~AssociatedItemNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::AssociatedItem; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TraitNode : public VisItemNode {
 public:
     std::string identifier_;
-    std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes_;
+    std::vector<AssociatedItemNode *> associated_item_nodes_;
 
     TraitNode(Position pos, std::string identifier,
-              std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes)
-        : VisItemNode(pos), identifier_(std::move(identifier)),
+              std::vector<AssociatedItemNode *> associated_item_nodes)
+        : VisItemNode(ASTKind::Trait, pos), identifier_(std::move(identifier)),
           associated_item_nodes_(std::move(associated_item_nodes)) {
     }
 
     ~TraitNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Trait; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ImplementationNode : public VisItemNode {
 public:
-    explicit ImplementationNode(Position pos) : VisItemNode(pos) {
+    ImplementationNode(ASTKind kind, Position pos) : VisItemNode(kind, pos) {
     }
 
     ~ImplementationNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::Implementation && node->kind() <= ASTKind::TraitImpl;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class InherentImplNode : public ImplementationNode {
 public:
 	uint32_t scope_index = 0;
-    std::shared_ptr<TypeNode> type_node_;
-    std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes_;
+    TypeNode *type_node_ = nullptr;
+    std::vector<AssociatedItemNode *> associated_item_nodes_;
 
-    InherentImplNode(Position pos, std::shared_ptr<TypeNode> type_node,
-                     std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes)
-        : ImplementationNode(pos), type_node_(std::move(type_node)),
+    InherentImplNode(Position pos, TypeNode *type_node,
+                     std::vector<AssociatedItemNode *> associated_item_nodes)
+        : ImplementationNode(ASTKind::InherentImpl, pos), type_node_(std::move(type_node)),
           associated_item_nodes_(std::move(associated_item_nodes)) {
     }
 
     ~InherentImplNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::InherentImpl; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TraitImplNode : public ImplementationNode {
 public:
     std::string identifier_;
-    std::shared_ptr<TypeNode> type_node_;
-    std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes_;
+    TypeNode *type_node_ = nullptr;
+    std::vector<AssociatedItemNode *> associated_item_nodes_;
 
-    TraitImplNode(Position pos, std::string identifier, std::shared_ptr<TypeNode> type_node,
-                  std::vector<std::shared_ptr<AssociatedItemNode> > associated_item_nodes)
-        : ImplementationNode(pos), identifier_(std::move(identifier)), type_node_(std::move(type_node)),
+    TraitImplNode(Position pos, std::string identifier, TypeNode *type_node,
+                  std::vector<AssociatedItemNode *> associated_item_nodes)
+        : ImplementationNode(ASTKind::TraitImpl, pos), identifier_(std::move(identifier)), type_node_(std::move(type_node)),
           associated_item_nodes_(std::move(associated_item_nodes)) {
     }
 
     ~TraitImplNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TraitImpl; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -473,22 +643,30 @@ public:
     bool is_compiler_known_ = false;
 	std::shared_ptr<LocalVar> result_var = nullptr;
     ConstValue value = 0;
-    ExpressionNode(Position pos, bool is_assignable)
-        : ASTNode(pos), is_assignable_(is_assignable), is_mutable_(false) {
+    ExpressionNode(ASTKind kind, Position pos, bool is_assignable)
+        : ASTNode(kind, pos), is_assignable_(is_assignable), is_mutable_(false) {
     }
 
     ~ExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::Expression && node->kind() <= ASTKind::ArrayLiteral;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ExpressionWithBlockNode : public ExpressionNode {
 public:
-    explicit ExpressionWithBlockNode(Position pos) : ExpressionNode(pos, false) {
+    ExpressionWithBlockNode(ASTKind kind, Position pos) : ExpressionNode(kind, pos, false) {
     }
 
     ~ExpressionWithBlockNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::ExpressionWithBlock && node->kind() <= ASTKind::MatchExpression;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -497,68 +675,78 @@ public:
 	uint32_t scope_index = 0;
     bool is_const_;
 	bool is_function_direct_block = false;
-    std::shared_ptr<StatementsNode> statements_;
+    StatementsNode *statements_ = nullptr;
 
-    BlockExpressionNode(Position pos, bool is_const, std::shared_ptr<StatementsNode> statements)
-        : ExpressionWithBlockNode(pos), is_const_(is_const), statements_(std::move(statements)) {
+    BlockExpressionNode(Position pos, bool is_const, StatementsNode *statements)
+        : ExpressionWithBlockNode(ASTKind::BlockExpression, pos), is_const_(is_const), statements_(std::move(statements)) {
     }
 
     ~BlockExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::BlockExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LoopExpressionNode : public ExpressionWithBlockNode {
 public:
-    explicit LoopExpressionNode(Position pos) : ExpressionWithBlockNode(pos) {
+    LoopExpressionNode(ASTKind kind, Position pos) : ExpressionWithBlockNode(kind, pos) {
     };
 
     ~LoopExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::LoopExpression && node->kind() <= ASTKind::PredicateLoopExpression;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class InfiniteLoopExpressionNode : public LoopExpressionNode {
 public:
-    std::shared_ptr<BlockExpressionNode> block_expression_;
+    BlockExpressionNode *block_expression_ = nullptr;
 
-    InfiniteLoopExpressionNode(Position pos, std::shared_ptr<BlockExpressionNode> block_expression)
-        : LoopExpressionNode(pos), block_expression_(std::move(block_expression)) {
+    InfiniteLoopExpressionNode(Position pos, BlockExpressionNode *block_expression)
+        : LoopExpressionNode(ASTKind::InfiniteLoopExpression, pos), block_expression_(std::move(block_expression)) {
     }
 
     ~InfiniteLoopExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::InfiniteLoopExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PredicateLoopExpressionNode : public LoopExpressionNode {
 public:
-    std::shared_ptr<ConditionsNode> conditions_;
-    std::shared_ptr<BlockExpressionNode> block_expression_;
+    ConditionsNode *conditions_ = nullptr;
+    BlockExpressionNode *block_expression_ = nullptr;
 
-    PredicateLoopExpressionNode(Position pos, std::shared_ptr<ConditionsNode> conditions,
-                                std::shared_ptr<BlockExpressionNode> block_expression)
-        : LoopExpressionNode(pos), conditions_(std::move(conditions)),
+    PredicateLoopExpressionNode(Position pos, ConditionsNode *conditions,
+                                BlockExpressionNode *block_expression)
+        : LoopExpressionNode(ASTKind::PredicateLoopExpression, pos), conditions_(std::move(conditions)),
           block_expression_(std::move(block_expression)) {
     }
 
     ~PredicateLoopExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::PredicateLoopExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class IfExpressionNode : public ExpressionWithBlockNode {
 public:
-    std::shared_ptr<ConditionsNode> conditions_;
-    std::shared_ptr<BlockExpressionNode> true_block_expression_;
-    std::shared_ptr<BlockExpressionNode> false_block_expression_;
-    std::shared_ptr<IfExpressionNode> if_expression_;
+    ConditionsNode *conditions_ = nullptr;
+    BlockExpressionNode *true_block_expression_ = nullptr;
+    BlockExpressionNode *false_block_expression_ = nullptr;
+    IfExpressionNode *if_expression_ = nullptr;
 
-    IfExpressionNode(Position pos, std::shared_ptr<ConditionsNode> conditions,
-                     std::shared_ptr<BlockExpressionNode> true_block_expression,
-                     std::shared_ptr<BlockExpressionNode> false_block_expression,
-                     std::shared_ptr<IfExpressionNode> if_expression)
-        : ExpressionWithBlockNode(pos), conditions_(std::move(conditions)),
+    IfExpressionNode(Position pos, ConditionsNode *conditions,
+                     BlockExpressionNode *true_block_expression,
+                     BlockExpressionNode *false_block_expression,
+                     IfExpressionNode *if_expression)
+        : ExpressionWithBlockNode(ASTKind::IfExpression, pos), conditions_(std::move(conditions)),
           true_block_expression_(std::move(true_block_expression)),
           false_block_expression_(std::move(false_block_expression)),
           if_expression_(std::move(if_expression)) {
@@ -566,331 +754,379 @@ public:
 
     ~IfExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::IfExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class MatchExpressionNode : public ExpressionWithBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_;
-    std::shared_ptr<MatchArmsNode> match_arms_;
+    ExpressionNode *expression_ = nullptr;
+    MatchArmsNode *match_arms_ = nullptr;
 
-    MatchExpressionNode(Position pos, std::shared_ptr<ExpressionNode> expression,
-                        std::shared_ptr<MatchArmsNode> match_arms_node)
-        : ExpressionWithBlockNode(pos), expression_(std::move(expression)),
+    MatchExpressionNode(Position pos, ExpressionNode *expression,
+                        MatchArmsNode *match_arms_node)
+        : ExpressionWithBlockNode(ASTKind::MatchExpression, pos), expression_(std::move(expression)),
           match_arms_(std::move(match_arms_node)) {
     }
 
     ~MatchExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::MatchExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 /****************  Expression Without Block  ****************/
 class ExpressionWithoutBlockNode : public ExpressionNode {
 public:
-    ExpressionWithoutBlockNode(Position pos, bool is_assignable) : ExpressionNode(pos, is_assignable) {
+    ExpressionWithoutBlockNode(ASTKind kind, Position pos, bool is_assignable) : ExpressionNode(kind, pos, is_assignable) {
     }
 
     ~ExpressionWithoutBlockNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::ExpressionWithoutBlock && node->kind() <= ASTKind::ArrayLiteral;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ContinueExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    explicit ContinueExpressionNode(Position pos) : ExpressionWithoutBlockNode(pos, false) {
+    explicit ContinueExpressionNode(Position pos) : ExpressionWithoutBlockNode(ASTKind::ContinueExpression, pos, false) {
     }
 
     ~ContinueExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ContinueExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TupleExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::vector<std::shared_ptr<ExpressionNode> > expressions_;
+    std::vector<ExpressionNode *> expressions_;
 
-    TupleExpressionNode(Position pos, std::vector<std::shared_ptr<ExpressionNode> > expressions)
-        : ExpressionWithoutBlockNode(pos, false), expressions_(std::move(expressions)) {
+    TupleExpressionNode(Position pos, std::vector<ExpressionNode *> expressions)
+        : ExpressionWithoutBlockNode(ASTKind::TupleExpression, pos, false), expressions_(std::move(expressions)) {
     }
 
     ~TupleExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TupleExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class UnderscoreExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    explicit UnderscoreExpressionNode(Position pos) : ExpressionWithoutBlockNode(pos, true) {
+    explicit UnderscoreExpressionNode(Position pos) : ExpressionWithoutBlockNode(ASTKind::UnderscoreExpression, pos, true) {
     }
 
     ~UnderscoreExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::UnderscoreExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class JumpExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
 
-    JumpExpressionNode(Position pos, TokenType type, std::shared_ptr<ExpressionNode> assignment_expression)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), expression_(std::move(assignment_expression)) {
+    JumpExpressionNode(Position pos, TokenType type, ExpressionNode *assignment_expression)
+        : ExpressionWithoutBlockNode(ASTKind::JumpExpression, pos, false), type_(type), expression_(std::move(assignment_expression)) {
     }
 
     ~JumpExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::JumpExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class AssignmentExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
     AssignmentExpressionNode(Position pos, TokenType type,
-                             std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+                             ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::AssignmentExpression, pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~AssignmentExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::AssignmentExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LogicOrExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    LogicOrExpressionNode(Position pos, std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    LogicOrExpressionNode(Position pos, ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::LogicOrExpression, pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~LogicOrExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LogicOrExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LogicAndExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    LogicAndExpressionNode(Position pos, std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    LogicAndExpressionNode(Position pos, ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::LogicAndExpression, pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~LogicAndExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LogicAndExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ComparisonExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    ComparisonExpressionNode(Position pos, TokenType type, std::shared_ptr<ExpressionNode> lhs,
-                             std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    ComparisonExpressionNode(Position pos, TokenType type, ExpressionNode *lhs,
+                             ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::ComparisonExpression, pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~ComparisonExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ComparisonExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class BitwiseOrExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    BitwiseOrExpressionNode(Position pos, std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    BitwiseOrExpressionNode(Position pos, ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::BitwiseOrExpression, pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~BitwiseOrExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::BitwiseOrExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class BitwiseXorExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    BitwiseXorExpressionNode(Position pos, std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    BitwiseXorExpressionNode(Position pos, ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::BitwiseXorExpression, pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~BitwiseXorExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::BitwiseXorExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class BitwiseAndExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    BitwiseAndExpressionNode(Position pos, std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    BitwiseAndExpressionNode(Position pos, ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::BitwiseAndExpression, pos, false), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~BitwiseAndExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::BitwiseAndExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ShiftExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
     ShiftExpressionNode(Position pos, TokenType type,
-                        std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+                        ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::ShiftExpression, pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~ShiftExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ShiftExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class AddMinusExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
     AddMinusExpressionNode(Position pos, TokenType type,
-                           std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+                           ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::AddMinusExpression, pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~AddMinusExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::AddMinusExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class MulDivModExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
     MulDivModExpressionNode(Position pos, TokenType type,
-                            std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : ExpressionWithoutBlockNode(pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+                            ExpressionNode *lhs, ExpressionNode *rhs)
+        : ExpressionWithoutBlockNode(ASTKind::MulDivModExpression, pos, false), type_(type), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~MulDivModExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::MulDivModExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TypeCastExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<TypeNode> type_;
-    std::shared_ptr<ExpressionNode> expression_;
+    TypeNode *type_ = nullptr;
+    ExpressionNode *expression_ = nullptr;
 
-    TypeCastExpressionNode(Position pos, std::shared_ptr<TypeNode> type, std::shared_ptr<ExpressionNode> expression)
-        : ExpressionWithoutBlockNode(pos, false), type_(std::move(type)), expression_(std::move(expression)) {
+    TypeCastExpressionNode(Position pos, TypeNode *type, ExpressionNode *expression)
+        : ExpressionWithoutBlockNode(ASTKind::TypeCastExpression, pos, false), type_(std::move(type)), expression_(std::move(expression)) {
     }
 
     ~TypeCastExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TypeCastExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class UnaryExpressionNode : public ExpressionWithoutBlockNode {
 public:
     TokenType type_;
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
 
     UnaryExpressionNode(Position pos, TokenType type,
-                        std::shared_ptr<ExpressionNode> expression, bool is_assignable)
-        : ExpressionWithoutBlockNode(pos, is_assignable), type_(type), expression_(std::move(expression)) {
+                        ExpressionNode *expression, bool is_assignable)
+        : ExpressionWithoutBlockNode(ASTKind::UnaryExpression, pos, is_assignable), type_(type), expression_(std::move(expression)) {
     }
 
     ~UnaryExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::UnaryExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class FunctionCallExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> callee_;
-    std::vector<std::shared_ptr<ExpressionNode> > params_;
+    ExpressionNode *callee_ = nullptr;
+    std::vector<ExpressionNode *> params_;
 
-    FunctionCallExpressionNode(Position pos, std::shared_ptr<ExpressionNode> callee,
-                               std::vector<std::shared_ptr<ExpressionNode> > params)
-        : ExpressionWithoutBlockNode(pos, false), callee_(std::move(callee)), params_(std::move(params)) {
+    FunctionCallExpressionNode(Position pos, ExpressionNode *callee,
+                               std::vector<ExpressionNode *> params)
+        : ExpressionWithoutBlockNode(ASTKind::FunctionCallExpression, pos, false), callee_(std::move(callee)), params_(std::move(params)) {
     }
 
     ~FunctionCallExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::FunctionCallExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ArrayIndexExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> base_;
-    std::shared_ptr<ExpressionNode> index_;
+    ExpressionNode *base_ = nullptr;
+    ExpressionNode *index_ = nullptr;
 	uint32_t auto_deref_count = 0;
 
-    ArrayIndexExpressionNode(Position pos, std::shared_ptr<ExpressionNode> base,
-                             std::shared_ptr<ExpressionNode> index)
-        : ExpressionWithoutBlockNode(pos, true), base_(std::move(base)), index_(std::move(index)) {
+    ArrayIndexExpressionNode(Position pos, ExpressionNode *base,
+                             ExpressionNode *index)
+        : ExpressionWithoutBlockNode(ASTKind::ArrayIndexExpression, pos, true), base_(std::move(base)), index_(std::move(index)) {
     }
 
     ~ArrayIndexExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ArrayIndexExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class MemberAccessExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> base_;
-    Token member_;
+    ExpressionNode *base_ = nullptr;
+    std::string member_;
     uint32_t auto_deref_count = 0;
 
-    MemberAccessExpressionNode(Position pos, std::shared_ptr<ExpressionNode> base, Token member)
-        : ExpressionWithoutBlockNode(pos, true), base_(std::move(base)), member_(std::move(member)) {
+    MemberAccessExpressionNode(Position pos, ExpressionNode *base, std::string member)
+        : ExpressionWithoutBlockNode(ASTKind::MemberAccessExpression, pos, true), base_(std::move(base)), member_(std::move(member)) {
     }
 
     ~MemberAccessExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::MemberAccessExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class GroupedExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
 
-    GroupedExpressionNode(Position pos, std::shared_ptr<ExpressionNode> expression)
-        : ExpressionWithoutBlockNode(pos, false), expression_(std::move(expression)) {
+    GroupedExpressionNode(Position pos, ExpressionNode *expression)
+        : ExpressionWithoutBlockNode(ASTKind::GroupedExpression, pos, false), expression_(std::move(expression)) {
     }
 
     ~GroupedExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::GroupedExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    std::shared_ptr<PathInExpressionNode> path_in_expression_node_;
-    std::shared_ptr<StructExprFieldsNode> struct_expr_fields_node_;
-    std::shared_ptr<StructBaseNode> struct_base_node_;
+    PathInExpressionNode *path_in_expression_node_ = nullptr;
+    StructExprFieldsNode *struct_expr_fields_node_ = nullptr;
+    StructBaseNode *struct_base_node_ = nullptr;
 
-    StructExpressionNode(Position pos, std::shared_ptr<PathInExpressionNode> path_in_expression_node,
-                         std::shared_ptr<StructExprFieldsNode> struct_expr_fields_node,
-                         std::shared_ptr<StructBaseNode> struct_base_node)
-        : ExpressionWithoutBlockNode(pos, false),
+    StructExpressionNode(Position pos, PathInExpressionNode *path_in_expression_node,
+                         StructExprFieldsNode *struct_expr_fields_node,
+                         StructBaseNode *struct_base_node)
+        : ExpressionWithoutBlockNode(ASTKind::StructExpression, pos, false),
           path_in_expression_node_(std::move(path_in_expression_node)),
           struct_expr_fields_node_(std::move(struct_expr_fields_node)),
           struct_base_node_(std::move(struct_base_node)) {
@@ -898,85 +1134,103 @@ public:
 
     ~StructExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StructExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructExprFieldsNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<StructExprFieldNode> > struct_expr_field_nodes_;
-    std::shared_ptr<StructBaseNode> struct_base_node_;
+    std::vector<StructExprFieldNode *> struct_expr_field_nodes_;
+    StructBaseNode *struct_base_node_ = nullptr;
 
-    StructExprFieldsNode(Position pos, std::vector<std::shared_ptr<StructExprFieldNode> > struct_expr_field_nodes,
-                         std::shared_ptr<StructBaseNode> struct_base)
-        : ASTNode(pos), struct_expr_field_nodes_(std::move(struct_expr_field_nodes)),
+    StructExprFieldsNode(Position pos, std::vector<StructExprFieldNode *> struct_expr_field_nodes,
+                         StructBaseNode *struct_base)
+        : ASTNode(ASTKind::StructExprFields, pos), struct_expr_field_nodes_(std::move(struct_expr_field_nodes)),
           struct_base_node_(std::move(struct_base)) {
     }
 
     ~StructExprFieldsNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StructExprFields; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructExprFieldNode : public ASTNode {
 public:
     std::string identifier_;
-    std::shared_ptr<ExpressionNode> expression_node_;
+    ExpressionNode *expression_node_ = nullptr;
 
     StructExprFieldNode(Position pos, std::string identifier,
-                        std::shared_ptr<ExpressionNode> expression_node)
-        : ASTNode(pos), identifier_(std::move(identifier)), expression_node_(std::move(expression_node)) {
+                        ExpressionNode *expression_node)
+        : ASTNode(ASTKind::StructExprField, pos), identifier_(std::move(identifier)), expression_node_(std::move(expression_node)) {
     }
 
     ~StructExprFieldNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StructExprField; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StructBaseNode : public ASTNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_node_;
+    ExpressionNode *expression_node_ = nullptr;
 
-    StructBaseNode(Position pos, std::shared_ptr<ExpressionNode> expression_node)
-        : ASTNode(pos), expression_node_(std::move(expression_node)) {
+    StructBaseNode(Position pos, ExpressionNode *expression_node)
+        : ASTNode(ASTKind::StructBase, pos), expression_node_(std::move(expression_node)) {
     }
 
     ~StructBaseNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StructBase; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PathExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    explicit PathExpressionNode(Position pos) : ExpressionWithoutBlockNode(pos, true) {
+    PathExpressionNode(ASTKind kind, Position pos) : ExpressionWithoutBlockNode(kind, pos, true) {
     }
 
     ~PathExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::PathExpression && node->kind() <= ASTKind::PathInExpression;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PathInExpressionNode : public PathExpressionNode {
 public:
-    std::vector<std::shared_ptr<PathIndentSegmentNode> > path_indent_segments_;
+    std::vector<PathIndentSegmentNode *> path_indent_segments_;
 
     explicit PathInExpressionNode(Position pos,
-                                  std::vector<std::shared_ptr<PathIndentSegmentNode> > simple_path_segments)
-        : PathExpressionNode(pos), path_indent_segments_(std::move(simple_path_segments)) {
+                                  std::vector<PathIndentSegmentNode *> simple_path_segments)
+        : PathExpressionNode(ASTKind::PathInExpression, pos), path_indent_segments_(std::move(simple_path_segments)) {
     }
 
     ~PathInExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::PathInExpression; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 /****************  Literal Node  ****************/
 class LiteralExpressionNode : public ExpressionWithoutBlockNode {
 public:
-    explicit LiteralExpressionNode(Position pos) : ExpressionWithoutBlockNode(pos, false) {
+    LiteralExpressionNode(ASTKind kind, Position pos) : ExpressionWithoutBlockNode(kind, pos, false) {
     }
 
     ~LiteralExpressionNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::LiteralExpression && node->kind() <= ASTKind::ArrayLiteral;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -985,11 +1239,13 @@ public:
     char char_literal_;
 
     CharLiteralNode(Position pos, const char &char_literal)
-        : LiteralExpressionNode(pos), char_literal_(char_literal) {
+        : LiteralExpressionNode(ASTKind::CharLiteral, pos), char_literal_(char_literal) {
     }
 
     ~CharLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::CharLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -998,11 +1254,13 @@ public:
     std::string string_literal_;
 
     StringLiteralNode(Position pos, std::string string_literal)
-        : LiteralExpressionNode(pos), string_literal_(std::move(string_literal)) {
+        : LiteralExpressionNode(ASTKind::StringLiteral, pos), string_literal_(std::move(string_literal)) {
     }
 
     ~StringLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::StringLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1013,12 +1271,14 @@ public:
 
     IntLiteralNode(Position pos, const int64_t &int_literal,
                    bool is_u32, bool is_i32, bool is_usize, bool is_isize)
-        : LiteralExpressionNode(pos), int_literal_(int_literal), is_u32_(is_u32),
+        : LiteralExpressionNode(ASTKind::IntLiteral, pos), int_literal_(int_literal), is_u32_(is_u32),
           is_i32_(is_i32), is_isize_(is_isize), is_usize_(is_usize) {
     }
 
     ~IntLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::IntLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1027,11 +1287,13 @@ public:
     bool bool_literal_;
 
     BoolLiteralNode(Position pos, const bool &bool_literal)
-        : LiteralExpressionNode(pos), bool_literal_(bool_literal) {
+        : LiteralExpressionNode(ASTKind::BoolLiteral, pos), bool_literal_(bool_literal) {
     }
 
     ~BoolLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::BoolLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1040,44 +1302,50 @@ public:
     std::string c_string_literal_;
 
     CStringLiteralNode(Position pos, std::string c_string_literal)
-        : LiteralExpressionNode(pos), c_string_literal_(std::move(c_string_literal)) {
+        : LiteralExpressionNode(ASTKind::CStringLiteral, pos), c_string_literal_(std::move(c_string_literal)) {
     }
 
     ~CStringLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::CStringLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ArrayLiteralNode : public LiteralExpressionNode {
 public:
-    std::vector<std::shared_ptr<ExpressionNode> > expressions_;
-    std::shared_ptr<ExpressionNode> lhs_;
-    std::shared_ptr<ExpressionNode> rhs_;
+    std::vector<ExpressionNode *> expressions_;
+    ExpressionNode *lhs_ = nullptr;
+    ExpressionNode *rhs_ = nullptr;
 
-    ArrayLiteralNode(Position pos, std::vector<std::shared_ptr<ExpressionNode> > expression_nodes,
-                     std::shared_ptr<ExpressionNode> lhs, std::shared_ptr<ExpressionNode> rhs)
-        : LiteralExpressionNode(pos), expressions_(std::move(expression_nodes)),
+    ArrayLiteralNode(Position pos, std::vector<ExpressionNode *> expression_nodes,
+                     ExpressionNode *lhs, ExpressionNode *rhs)
+        : LiteralExpressionNode(ASTKind::ArrayLiteral, pos), expressions_(std::move(expression_nodes)),
           lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
     }
 
     ~ArrayLiteralNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ArrayLiteral; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 /****************  Support Node for Expression  ****************/
 class ConditionsNode : public ASTNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_;
-    std::shared_ptr<LetChainNode> let_chain_node_;
+    ExpressionNode *expression_ = nullptr;
+    LetChainNode *let_chain_node_ = nullptr;
 
-    ConditionsNode(Position pos, std::shared_ptr<ExpressionNode> expression,
-                   std::shared_ptr<LetChainNode> let_chain_node)
-        : ASTNode(pos), expression_(std::move(expression)), let_chain_node_(std::move(let_chain_node)) {
+    ConditionsNode(Position pos, ExpressionNode *expression,
+                   LetChainNode *let_chain_node)
+        : ASTNode(ASTKind::Conditions, pos), expression_(std::move(expression)), let_chain_node_(std::move(let_chain_node)) {
     }
 
     ~ConditionsNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Conditions; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1085,196 +1353,230 @@ class LetChainConditionNode;
 
 class LetChainNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<LetChainConditionNode> > let_chain_condition_nodes_;
+    std::vector<LetChainConditionNode *> let_chain_condition_nodes_;
 
-    LetChainNode(Position pos, std::vector<std::shared_ptr<LetChainConditionNode> > let_chain_condition_nodes)
-        : ASTNode(pos), let_chain_condition_nodes_(std::move(let_chain_condition_nodes)) {
+    LetChainNode(Position pos, std::vector<LetChainConditionNode *> let_chain_condition_nodes)
+        : ASTNode(ASTKind::LetChain, pos), let_chain_condition_nodes_(std::move(let_chain_condition_nodes)) {
     }
 
     ~LetChainNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LetChain; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LetChainConditionNode : public ASTNode {
 public:
-    std::shared_ptr<PatternNode> pattern_node_;
-    std::shared_ptr<ExpressionNode> expression_node_;
+    PatternNode *pattern_node_ = nullptr;
+    ExpressionNode *expression_node_ = nullptr;
 
-    LetChainConditionNode(Position pos, std::shared_ptr<PatternNode> pattern_node,
-                          std::shared_ptr<ExpressionNode> expression_node)
-        : ASTNode(pos), pattern_node_(std::move(pattern_node)),
+    LetChainConditionNode(Position pos, PatternNode *pattern_node,
+                          ExpressionNode *expression_node)
+        : ASTNode(ASTKind::LetChainCondition, pos), pattern_node_(std::move(pattern_node)),
           expression_node_(std::move(expression_node)) {
     }
 
     ~LetChainConditionNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LetChainCondition; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class StatementsNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<StatementNode> > statements_;
-    std::shared_ptr<ExpressionNode> expression_;
+    std::vector<StatementNode *> statements_;
+    ExpressionNode *expression_ = nullptr;
 
-    StatementsNode(Position pos, std::vector<std::shared_ptr<StatementNode> > statements,
-                   std::shared_ptr<ExpressionNode> expression)
-        : ASTNode(pos), statements_(std::move(statements)), expression_(std::move(expression)) {
+    StatementsNode(Position pos, std::vector<StatementNode *> statements,
+                   ExpressionNode *expression)
+        : ASTNode(ASTKind::Statements, pos), statements_(std::move(statements)), expression_(std::move(expression)) {
     }
 
     ~StatementsNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Statements; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class MatchArmsNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<MatchArmNode> > match_arm_nodes_;
-    std::vector<std::shared_ptr<ExpressionNode> > expression_nodes_;
+    std::vector<MatchArmNode *> match_arm_nodes_;
+    std::vector<ExpressionNode *> expression_nodes_;
 
-    MatchArmsNode(Position pos, std::vector<std::shared_ptr<MatchArmNode> > match_arm_nodes,
-                  std::vector<std::shared_ptr<ExpressionNode> > expression_nodes)
-        : ASTNode(pos), match_arm_nodes_(std::move(match_arm_nodes)),
+    MatchArmsNode(Position pos, std::vector<MatchArmNode *> match_arm_nodes,
+                  std::vector<ExpressionNode *> expression_nodes)
+        : ASTNode(ASTKind::MatchArms, pos), match_arm_nodes_(std::move(match_arm_nodes)),
           expression_nodes_(std::move(expression_nodes)) {
     }
 
     ~MatchArmsNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::MatchArms; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class MatchArmNode : public ASTNode {
 public:
-    std::shared_ptr<PatternNode> pattern_node_;
-    std::shared_ptr<ExpressionNode> match_arm_guard_;
+    PatternNode *pattern_node_ = nullptr;
+    ExpressionNode *match_arm_guard_ = nullptr;
 
-    MatchArmNode(Position pos, std::shared_ptr<PatternNode> pattern_node,
-                 std::shared_ptr<ExpressionNode> match_arm_guard)
-        : ASTNode(pos), pattern_node_(std::move(pattern_node)),
+    MatchArmNode(Position pos, PatternNode *pattern_node,
+                 ExpressionNode *match_arm_guard)
+        : ASTNode(ASTKind::MatchArm, pos), pattern_node_(std::move(pattern_node)),
           match_arm_guard_(std::move(match_arm_guard)) {
     }
 
     ~MatchArmNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::MatchArm; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 /****************  Statement  ****************/
 class StatementNode : public ASTNode {
 public:
-    explicit StatementNode(Position pos) : ASTNode(pos) {
+    StatementNode(ASTKind kind, Position pos) : ASTNode(kind, pos) {
     }
 
     ~StatementNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::Statement && node->kind() <= ASTKind::VisItemStatement;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class EmptyStatementNode : public StatementNode {
 public:
-    explicit EmptyStatementNode(Position pos) : StatementNode(pos) {
+    explicit EmptyStatementNode(Position pos) : StatementNode(ASTKind::EmptyStatement, pos) {
     }
 
     ~EmptyStatementNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::EmptyStatement; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LetStatementNode : public StatementNode {
 public:
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_;
-    std::shared_ptr<TypeNode> type_;
-    std::shared_ptr<ExpressionNode> expression_;
-    std::shared_ptr<BlockExpressionNode> block_expression_;
+    PatternNoTopAltNode *pattern_no_top_alt_ = nullptr;
+    TypeNode *type_ = nullptr;
+    ExpressionNode *expression_ = nullptr;
+    BlockExpressionNode *block_expression_ = nullptr;
 
-    LetStatementNode(Position pos, std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt,
-                     std::shared_ptr<TypeNode> type,
-                     std::shared_ptr<ExpressionNode> expression,
-                     std::shared_ptr<BlockExpressionNode> block_expression)
-        : StatementNode(pos), pattern_no_top_alt_(std::move(pattern_no_top_alt)),
+    LetStatementNode(Position pos, PatternNoTopAltNode *pattern_no_top_alt,
+                     TypeNode *type,
+                     ExpressionNode *expression,
+                     BlockExpressionNode *block_expression)
+        : StatementNode(ASTKind::LetStatement, pos), pattern_no_top_alt_(std::move(pattern_no_top_alt)),
           type_(std::move(type)), expression_(std::move(expression)),
           block_expression_(std::move(block_expression)) {
     }
 
     ~LetStatementNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LetStatement; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ExpressionStatementNode : public StatementNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
     bool has_semicolon_ = true;
 
-    ExpressionStatementNode(Position pos, std::shared_ptr<ExpressionNode> expression,
+    ExpressionStatementNode(Position pos, ExpressionNode *expression,
         bool has_semicolon = true)
-        : StatementNode(pos), expression_(std::move(expression)) {
+        : StatementNode(ASTKind::ExpressionStatement, pos), expression_(std::move(expression)) {
         has_semicolon_ = has_semicolon;
     }
 
     ~ExpressionStatementNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ExpressionStatement; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class VisItemStatementNode : public StatementNode {
 public:
-    std::shared_ptr<VisItemNode> vis_item_node_;
+    VisItemNode *vis_item_node_ = nullptr;
 
-    VisItemStatementNode(Position pos, std::shared_ptr<VisItemNode> vis_item_node)
-        : StatementNode(pos), vis_item_node_(std::move(vis_item_node)) {
+    VisItemStatementNode(Position pos, VisItemNode *vis_item_node)
+        : StatementNode(ASTKind::VisItemStatement, pos), vis_item_node_(std::move(vis_item_node)) {
     }
 
     ~VisItemStatementNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::VisItemStatement; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 /****************  Patterns  ****************/
 class PatternNode : public ASTNode {
 public:
-    std::vector<std::shared_ptr<PatternNoTopAltNode> > pattern_no_top_alts_;
+    std::vector<PatternNoTopAltNode *> pattern_no_top_alts_;
 
-    PatternNode(Position pos, std::vector<std::shared_ptr<PatternNoTopAltNode> > pattern_no_top_alts)
-        : ASTNode(pos), pattern_no_top_alts_(std::move(pattern_no_top_alts)) {
+    PatternNode(Position pos, std::vector<PatternNoTopAltNode *> pattern_no_top_alts)
+        : ASTNode(ASTKind::Pattern, pos), pattern_no_top_alts_(std::move(pattern_no_top_alts)) {
     }
 
     ~PatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::Pattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PatternNoTopAltNode : public ASTNode {
 public:
-    explicit PatternNoTopAltNode(Position pos) : ASTNode(pos) {
+    PatternNoTopAltNode(ASTKind kind, Position pos) : ASTNode(kind, pos) {
     }
 
     ~PatternNoTopAltNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::PatternNoTopAlt && node->kind() <= ASTKind::PathPattern;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PatternWithoutRangeNode : public PatternNoTopAltNode {
 public:
-    explicit PatternWithoutRangeNode(Position pos) : PatternNoTopAltNode(pos) {
+    PatternWithoutRangeNode(ASTKind kind, Position pos) : PatternNoTopAltNode(kind, pos) {
     }
 
     ~PatternWithoutRangeNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::PatternWithoutRange && node->kind() <= ASTKind::PathPattern;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class LiteralPatternNode : public PatternWithoutRangeNode {
 public:
     bool have_minus_;
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
 
-    LiteralPatternNode(Position pos, bool have_minus, std::shared_ptr<ExpressionNode> expression)
-        : PatternWithoutRangeNode(pos), have_minus_(have_minus), expression_(std::move(expression)) {
+    LiteralPatternNode(Position pos, bool have_minus, ExpressionNode *expression)
+        : PatternWithoutRangeNode(ASTKind::LiteralPattern, pos), have_minus_(have_minus), expression_(std::move(expression)) {
     }
 
     ~LiteralPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::LiteralPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1282,75 +1584,87 @@ class IdentifierPatternNode : public PatternWithoutRangeNode {
 public:
     bool is_ref_, is_mut_;
     std::string identifier_;
-    std::shared_ptr<PatternNoTopAltNode> node_;
+    PatternNoTopAltNode *node_ = nullptr;
 
     IdentifierPatternNode(Position pos, bool is_ref, bool is_mut, std::string identifier,
-                          std::shared_ptr<PatternNoTopAltNode> node)
-        : PatternWithoutRangeNode(pos), is_ref_(is_ref), is_mut_(is_mut),
+                          PatternNoTopAltNode *node)
+        : PatternWithoutRangeNode(ASTKind::IdentifierPattern, pos), is_ref_(is_ref), is_mut_(is_mut),
           identifier_(std::move(identifier)), node_(std::move(node)) {
     }
 
     ~IdentifierPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::IdentifierPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class WildcardPatternNode : public PatternWithoutRangeNode {
 public:
-    explicit WildcardPatternNode(Position pos) : PatternWithoutRangeNode(pos) {
+    explicit WildcardPatternNode(Position pos) : PatternWithoutRangeNode(ASTKind::WildcardPattern, pos) {
     }
 
     ~WildcardPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::WildcardPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class RestPatternNode : public PatternWithoutRangeNode {
 public:
-    explicit RestPatternNode(Position pos) : PatternWithoutRangeNode(pos) {
+    explicit RestPatternNode(Position pos) : PatternWithoutRangeNode(ASTKind::RestPattern, pos) {
     }
 
     ~RestPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::RestPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class GroupedPatternNode : public PatternWithoutRangeNode {
 public:
-    std::shared_ptr<PatternNode> pattern_;
+    PatternNode *pattern_ = nullptr;
 
-    GroupedPatternNode(Position pos, std::shared_ptr<PatternNode> pattern)
-        : PatternWithoutRangeNode(pos), pattern_(std::move(pattern)) {
+    GroupedPatternNode(Position pos, PatternNode *pattern)
+        : PatternWithoutRangeNode(ASTKind::GroupedPattern, pos), pattern_(std::move(pattern)) {
     }
 
     ~GroupedPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::GroupedPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class SlicePatternNode : public PatternWithoutRangeNode {
 public:
-    std::vector<std::shared_ptr<PatternNode> > patterns_;
+    std::vector<PatternNode *> patterns_;
 
-    SlicePatternNode(Position pos, std::vector<std::shared_ptr<PatternNode> > patterns)
-        : PatternWithoutRangeNode(pos), patterns_(std::move(patterns)) {
+    SlicePatternNode(Position pos, std::vector<PatternNode *> patterns)
+        : PatternWithoutRangeNode(ASTKind::SlicePattern, pos), patterns_(std::move(patterns)) {
     }
 
     ~SlicePatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::SlicePattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class PathPatternNode : public PatternWithoutRangeNode {
 public:
-    std::shared_ptr<ExpressionNode> expression_;
+    ExpressionNode *expression_ = nullptr;
 
-    PathPatternNode(Position pos, std::shared_ptr<ExpressionNode> expression)
-        : PatternWithoutRangeNode(pos), expression_(std::move(expression)) {
+    PathPatternNode(Position pos, ExpressionNode *expression)
+        : PatternWithoutRangeNode(ASTKind::PathPattern, pos), expression_(std::move(expression)) {
     }
 
     ~PathPatternNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::PathPattern; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
@@ -1359,74 +1673,88 @@ class TypeNode : public ASTNode {
 public:
     std::shared_ptr<Type> type;
 
-    explicit TypeNode(Position pos) : ASTNode(pos) {
+    TypeNode(ASTKind kind, Position pos) : ASTNode(kind, pos) {
     }
 
     ~TypeNode() override = default;
 
     virtual std::string toString() = 0;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::Type && node->kind() <= ASTKind::ReferenceType;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TypeNoBoundsNode : public TypeNode {
 public:
-    explicit TypeNoBoundsNode(Position pos) : TypeNode(pos) {
+    TypeNoBoundsNode(ASTKind kind, Position pos) : TypeNode(kind, pos) {
     }
 
     ~TypeNoBoundsNode() override = default;
 
+    static bool classof(const ASTNode *node) {
+        return node->kind() >= ASTKind::TypeNoBounds && node->kind() <= ASTKind::ReferenceType;
+    }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ParenthesizedTypeNode : public TypeNoBoundsNode {
 public:
-    std::shared_ptr<TypeNode> type_;
+    TypeNode *type_ = nullptr;
 
-    ParenthesizedTypeNode(Position pos, std::shared_ptr<TypeNode> type)
-        : TypeNoBoundsNode(pos), type_(std::move(type)) {
+    ParenthesizedTypeNode(Position pos, TypeNode *type)
+        : TypeNoBoundsNode(ASTKind::ParenthesizedType, pos), type_(std::move(type)) {
     }
 
     ~ParenthesizedTypeNode() override = default;
 
     std::string toString() override { return "( " + type_->toString() + " )"; }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ParenthesizedType; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TypePathSegmentNode : public ASTNode {
 public:
-    std::shared_ptr<PathIndentSegmentNode> path_indent_segment_node_;
+    PathIndentSegmentNode *path_indent_segment_node_ = nullptr;
 
-    TypePathSegmentNode(Position pos, std::shared_ptr<PathIndentSegmentNode> path_indent_segment_node)
-        : ASTNode(pos), path_indent_segment_node_(std::move(path_indent_segment_node)) {
+    TypePathSegmentNode(Position pos, PathIndentSegmentNode *path_indent_segment_node)
+        : ASTNode(ASTKind::TypePathSegment, pos), path_indent_segment_node_(std::move(path_indent_segment_node)) {
     }
 
     ~TypePathSegmentNode() override = default;
 
     [[nodiscard]] std::string toString() const { return path_indent_segment_node_->toString(); }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TypePathSegment; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class TypePathNode : public TypeNoBoundsNode {
 public:
-    std::shared_ptr<TypePathSegmentNode> type_path_segment_node_;
+    TypePathSegmentNode *type_path_segment_node_ = nullptr;
 
-    TypePathNode(Position pos, std::shared_ptr<TypePathSegmentNode> type_path_segment_node)
-        : TypeNoBoundsNode(pos), type_path_segment_node_(std::move(type_path_segment_node)) {
+    TypePathNode(Position pos, TypePathSegmentNode *type_path_segment_node)
+        : TypeNoBoundsNode(ASTKind::TypePath, pos), type_path_segment_node_(std::move(type_path_segment_node)) {
     }
 
     ~TypePathNode() override = default;
 
     std::string toString() override { return type_path_segment_node_->toString(); }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::TypePath; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class UnitTypeNode : public TypeNoBoundsNode {
 public:
-    explicit UnitTypeNode(Position pos): TypeNoBoundsNode(pos) {
+    explicit UnitTypeNode(Position pos): TypeNoBoundsNode(ASTKind::UnitType, pos) {
     }
 
     ~UnitTypeNode() override = default;
@@ -1435,16 +1763,18 @@ public:
         return "()";
     }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::UnitType; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ArrayTypeNode : public TypeNoBoundsNode {
 public:
-    std::shared_ptr<TypeNode> type_;
-    std::shared_ptr<ExpressionNode> expression_node_;
+    TypeNode *type_ = nullptr;
+    ExpressionNode *expression_node_ = nullptr;
 
-    ArrayTypeNode(Position pos, std::shared_ptr<TypeNode> type, std::shared_ptr<ExpressionNode> expression_node)
-        : TypeNoBoundsNode(pos), type_(std::move(type)), expression_node_(std::move(expression_node)) {
+    ArrayTypeNode(Position pos, TypeNode *type, ExpressionNode *expression_node)
+        : TypeNoBoundsNode(ASTKind::ArrayType, pos), type_(std::move(type)), expression_node_(std::move(expression_node)) {
     }
 
     ~ArrayTypeNode() override = default;
@@ -1454,7 +1784,7 @@ public:
         str += type_->toString();
         str += ";";
 
-        auto tmp = std::dynamic_pointer_cast<IntLiteralNode>(expression_node_);
+        auto tmp = dynamic_cast<IntLiteralNode *>(expression_node_);
         if (!tmp) {
             str += "_";
         } else {
@@ -1464,31 +1794,35 @@ public:
         return str;
     }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ArrayType; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class SliceTypeNode : public TypeNoBoundsNode {
 public:
-    std::shared_ptr<TypeNode> type_;
+    TypeNode *type_ = nullptr;
 
-    SliceTypeNode(Position pos, std::shared_ptr<TypeNode> type)
-        : TypeNoBoundsNode(pos), type_(std::move(type)) {
+    SliceTypeNode(Position pos, TypeNode *type)
+        : TypeNoBoundsNode(ASTKind::SliceType, pos), type_(std::move(type)) {
     }
 
     ~SliceTypeNode() override = default;
 
     [[nodiscard]] std::string toString() override { return "[" + type_->toString() + "]"; }
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::SliceType; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
 class ReferenceTypeNode : public TypeNoBoundsNode {
 public:
     bool is_mut_;
-    std::shared_ptr<TypeNode> type_node_;
+    TypeNode *type_node_ = nullptr;
 
-    ReferenceTypeNode(Position pos, bool is_mut, const std::shared_ptr<TypeNode> &type_node)
-        : TypeNoBoundsNode(pos), is_mut_(is_mut), type_node_(type_node) {
+    ReferenceTypeNode(Position pos, bool is_mut, TypeNode *type_node)
+        : TypeNoBoundsNode(ASTKind::ReferenceType, pos), is_mut_(is_mut), type_node_(type_node) {
     }
 
     [[nodiscard]] std::string toString() override {
@@ -1500,7 +1834,40 @@ public:
 
     ~ReferenceTypeNode() override = default;
 
+    static bool classof(const ASTNode *node) { return node->kind() == ASTKind::ReferenceType; }
+
     void accept(ASTVisitor *visitor) override { visitor->visit(this); }
 };
 
+// Visits a left-associative chain of one binary operator class without
+// recursing on its left operands, so `a + b + c + ...` of any length fits in
+// the stack. For a chain n_k(...n_1(x, y_1)..., y_k) the order is the one the
+// recursive visit would give: enter(n_k) ... enter(n_1), then x is visited,
+// then step(n_1) ... step(n_k). enter is for work a visit does before its
+// left operand; step sees the left operand visited and must visit the right
+// one itself.
+template<typename Node, typename Visitor, typename Enter, typename Step>
+void VisitLeftChain(Node *node, Visitor *visitor, Enter enter, Step step) {
+    if (!isa<Node>(node->lhs_)) {
+        enter(node);
+        if (node->lhs_) visitor->Visit(node->lhs_);
+        step(node);
+        return;
+    }
+    std::vector<Node *> links; // outermost first
+    for (Node *link = node; link != nullptr; link = dyn_cast<Node>(link->lhs_)) {
+        enter(link);
+        links.push_back(link);
+    }
+    if (links.back()->lhs_) visitor->Visit(links.back()->lhs_);
+    for (auto link = links.rbegin(); link != links.rend(); ++link) {
+        step(*link);
+    }
+}
+
+template<typename Node, typename Visitor, typename Step>
+void VisitLeftChain(Node *node, Visitor *visitor, Step step) {
+    VisitLeftChain(node, visitor, [](Node *) {}, step);
+}
+
 #endif //ASTNODE_H
@@ -14,6 +14,9 @@ class ConstantItemNode;
 class TraitNode;
 class ImplementationNode;
 class FunctionParametersNode;
+class SelfParamNode;
+class ShortHandSelfNode;
+class TypedSelfNode;
 class FunctionParamNode;
 class TypeNode;
 class FunctionParamPatternNode;
@@ -118,6 +121,9 @@ public:
     virtual void visit(InherentImplNode *node) = 0;
     virtual void visit(TraitImplNode *node) = 0;
     virtual void visit(FunctionParametersNode *node) = 0;
+    virtual void visit(SelfParamNode *node) = 0;
+    virtual void visit(ShortHandSelfNode *node) = 0;
+    virtual void visit(TypedSelfNode *node) = 0;
     virtual void visit(FunctionParamNode *node) = 0;
     virtual void visit(FunctionParamPatternNode *node) = 0;
     virtual void visit(StructFieldNode *node) = 0;
@@ -0,0 +1,35 @@
+#ifndef PARALLELSEMANTICCHECKER_H
+#define PARALLELSEMANTICCHECKER_H
+#include <cstdint>
+#include "Semantic/ASTNode.h"
+#include "Semantic/ScopeManager.h"
+
+// Runs SemanticChecker with the function bodies checked on several threads.
+//
+// The items themselves (constants, impl headers, struct and enum uses) are
+// checked first on the calling thread, with every function body deferred.
+// The bodies are then dealt out in source order to one deque per worker; a
+// worker takes its own bodies from the front and, once it runs out, steals
+// from the back of another worker's deque. Each worker has a SemanticChecker
+// and a view of the scopes of its own, so the only scopes the workers share
+// are those around the bodies, which no body declares into; the scopes a
+// body opens hang below its own and are numbered once all bodies are done.
+// Items declared in a body, impls among them, were collected before any body
+// is checked, so no worker changes a type another worker can see.
+// The interner and the type context lock while the workers run.
+//
+// Every body is checked even after another has failed, and the error
+// reported is the one earliest in the source, so diagnostics do not depend
+// on scheduling. An error raised without a position counts as raised where
+// its function, or for the items its item, begins.
+class ParallelSemanticChecker {
+    ScopeManager &scope_manager_;
+    uint32_t threads_;
+
+public:
+    ParallelSemanticChecker(ScopeManager &scope_manager, uint32_t threads);
+
+    // Throws the earliest error.
+    void Check(CrateNode *crate) const;
+};
+#endif //PARALLELSEMANTICCHECKER_H
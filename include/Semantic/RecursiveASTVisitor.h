@@ -0,0 +1,309 @@
+#ifndef RECURSIVEASTVISITOR_H
+#define RECURSIVEASTVISITOR_H
+#include <vector>
+#include "Casting.h"
+#include "Semantic/ASTNode.h"
+#include "Semantic/ASTVisitor.h"
+
+// Default traversal for the AST passes. A pass derives from
+// RecursiveASTVisitor, pulls the defaults in with
+// `using RecursiveASTVisitor::visit;` and defines visit() only for the node
+// classes it cares about. Visit(node) dispatches through node->accept(), so
+// the pass's visit() for the node's exact class runs: every visit() here
+// overrides ASTVisitor's, and a pass's visit() overrides it in turn.
+//
+// A default visit() visits the node's children in declaration order, null
+// children skipped; left-deep operator chains are walked with VisitLeftChain,
+// so they do not recurse once per link. Abstract classes never reach Visit()
+// and their defaults do nothing. Without the `using` declaration the pass's
+// own overloads would hide the defaults, and a child would bind to the
+// nearest base class the pass handles instead.
+class RecursiveASTVisitor : public ASTVisitor {
+    void VisitChild(ASTNode *child) {
+        if (child) Visit(child);
+    }
+
+    template<typename Node>
+    void VisitChildren(const std::vector<Node *> &children) {
+        for (Node *child: children) {
+            VisitChild(child);
+        }
+    }
+
+public:
+    void Visit(ASTNode *node) {
+        node->accept(this);
+    }
+
+    // Nodes of these classes are never built.
+    void visit(ASTNode *) override {}
+    void visit(TypeParamBoundsNode *) override {}
+    void visit(TypeParamNode *) override {}
+    void visit(ConstParamNode *) override {}
+    void visit(QualifiedPathInExpressionNode *) override {}
+    void visit(MatchArmGuardNode *) override {}
+
+    void visit(PathIndentSegmentNode *) override {}
+    void visit(CrateNode *node) override {
+        VisitChildren(node->items_);
+    }
+    void visit(VisItemNode *) override {}
+    void visit(FunctionNode *node) override {
+        VisitChild(node->function_parameters_);
+        VisitChild(node->type_);
+        VisitChild(node->block_expression_);
+    }
+    void visit(FunctionParametersNode *node) override {
+        VisitChild(node->self_param_node_);
+        VisitChildren(node->function_params_);
+    }
+    void visit(SelfParamNode *) override {}
+    void visit(ShortHandSelfNode *) override {}
+    void visit(TypedSelfNode *node) override {
+        VisitChild(node->type_node_);
+    }
+    void visit(FunctionParamNode *node) override {
+        VisitChild(node->pattern_no_top_alt_node_);
+        VisitChild(node->type_);
+    }
+    void visit(FunctionParamPatternNode *node) override {
+        VisitChild(node->pattern_no_top_alt_);
+        VisitChild(node->type_);
+    }
+    void visit(StructNode *node) override {
+        VisitChildren(node->struct_field_nodes_);
+    }
+    void visit(StructFieldNode *node) override {
+        VisitChild(node->type_node_);
+    }
+    void visit(EnumerationNode *node) override {
+        VisitChildren(node->enum_variant_nodes_);
+    }
+    void visit(EnumVariantNode *node) override {
+        VisitChild(node->enum_variant_struct_node_);
+        VisitChild(node->enum_variant_discriminant_node_);
+    }
+    void visit(EnumVariantStructNode *node) override {
+        VisitChildren(node->struct_field_nodes_);
+    }
+    void visit(EnumVariantDiscriminantNode *node) override {
+        VisitChild(node->expression_node_);
+    }
+    void visit(ConstantItemNode *node) override {
+        VisitChild(node->type_node_);
+        VisitChild(node->expression_node_);
+    }
+    void visit(AssociatedItemNode *node) override {
+        VisitChild(node->constant_item_node_);
+        VisitChild(node->function_node_);
+    }
+    void visit(TraitNode *node) override {
+        VisitChildren(node->associated_item_nodes_);
+    }
+    void visit(ImplementationNode *) override {}
+    void visit(InherentImplNode *node) override {
+        VisitChild(node->type_node_);
+        VisitChildren(node->associated_item_nodes_);
+    }
+    void visit(TraitImplNode *node) override {
+        VisitChild(node->type_node_);
+        VisitChildren(node->associated_item_nodes_);
+    }
+    void visit(ExpressionNode *) override {}
+    void visit(ExpressionWithBlockNode *) override {}
+    void visit(BlockExpressionNode *node) override {
+        VisitChild(node->statements_);
+    }
+    void visit(LoopExpressionNode *) override {}
+    void visit(InfiniteLoopExpressionNode *node) override {
+        VisitChild(node->block_expression_);
+    }
+    void visit(PredicateLoopExpressionNode *node) override {
+        VisitChild(node->conditions_);
+        VisitChild(node->block_expression_);
+    }
+    void visit(IfExpressionNode *node) override {
+        VisitChild(node->conditions_);
+        VisitChild(node->true_block_expression_);
+        VisitChild(node->false_block_expression_);
+        VisitChild(node->if_expression_);
+    }
+    void visit(MatchExpressionNode *node) override {
+        VisitChild(node->expression_);
+        VisitChild(node->match_arms_);
+    }
+    void visit(ExpressionWithoutBlockNode *) override {}
+    void visit(ContinueExpressionNode *) override {}
+    void visit(TupleExpressionNode *node) override {
+        VisitChildren(node->expressions_);
+    }
+    void visit(UnderscoreExpressionNode *) override {}
+    void visit(JumpExpressionNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(AssignmentExpressionNode *node) override {
+        VisitChild(node->lhs_);
+        VisitChild(node->rhs_);
+    }
+    void visit(LogicOrExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](LogicOrExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(LogicAndExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](LogicAndExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(ComparisonExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](ComparisonExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(BitwiseOrExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](BitwiseOrExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(BitwiseXorExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](BitwiseXorExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(BitwiseAndExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](BitwiseAndExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(ShiftExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](ShiftExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(AddMinusExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](AddMinusExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(MulDivModExpressionNode *node) override {
+        VisitLeftChain(node, this, [this](MulDivModExpressionNode *link) { VisitChild(link->rhs_); });
+    }
+    void visit(TypeCastExpressionNode *node) override {
+        VisitChild(node->type_);
+        VisitChild(node->expression_);
+    }
+    void visit(UnaryExpressionNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(FunctionCallExpressionNode *node) override {
+        VisitChild(node->callee_);
+        VisitChildren(node->params_);
+    }
+    void visit(ArrayIndexExpressionNode *node) override {
+        VisitChild(node->base_);
+        VisitChild(node->index_);
+    }
+    void visit(MemberAccessExpressionNode *node) override {
+        VisitChild(node->base_);
+    }
+    void visit(GroupedExpressionNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(StructExpressionNode *node) override {
+        VisitChild(node->path_in_expression_node_);
+        VisitChild(node->struct_expr_fields_node_);
+        VisitChild(node->struct_base_node_);
+    }
+    void visit(StructExprFieldsNode *node) override {
+        VisitChildren(node->struct_expr_field_nodes_);
+        VisitChild(node->struct_base_node_);
+    }
+    void visit(StructExprFieldNode *node) override {
+        VisitChild(node->expression_node_);
+    }
+    void visit(StructBaseNode *node) override {
+        VisitChild(node->expression_node_);
+    }
+    void visit(PathExpressionNode *) override {}
+    void visit(PathInExpressionNode *node) override {
+        VisitChildren(node->path_indent_segments_);
+    }
+    void visit(LiteralExpressionNode *) override {}
+    void visit(CharLiteralNode *) override {}
+    void visit(StringLiteralNode *) override {}
+    void visit(IntLiteralNode *) override {}
+    void visit(BoolLiteralNode *) override {}
+    void visit(CStringLiteralNode *) override {}
+    void visit(ArrayLiteralNode *node) override {
+        VisitChildren(node->expressions_);
+        VisitChild(node->lhs_);
+        VisitChild(node->rhs_);
+    }
+    void visit(ConditionsNode *node) override {
+        VisitChild(node->expression_);
+        VisitChild(node->let_chain_node_);
+    }
+    void visit(LetChainNode *node) override {
+        VisitChildren(node->let_chain_condition_nodes_);
+    }
+    void visit(LetChainConditionNode *node) override {
+        VisitChild(node->pattern_node_);
+        VisitChild(node->expression_node_);
+    }
+    void visit(StatementsNode *node) override {
+        VisitChildren(node->statements_);
+        VisitChild(node->expression_);
+    }
+    void visit(MatchArmsNode *node) override {
+        VisitChildren(node->match_arm_nodes_);
+        VisitChildren(node->expression_nodes_);
+    }
+    void visit(MatchArmNode *node) override {
+        VisitChild(node->pattern_node_);
+        VisitChild(node->match_arm_guard_);
+    }
+    void visit(StatementNode *) override {}
+    void visit(EmptyStatementNode *) override {}
+    void visit(LetStatementNode *node) override {
+        VisitChild(node->pattern_no_top_alt_);
+        VisitChild(node->type_);
+        VisitChild(node->expression_);
+        VisitChild(node->block_expression_);
+    }
+    void visit(ExpressionStatementNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(VisItemStatementNode *node) override {
+        VisitChild(node->vis_item_node_);
+    }
+    void visit(PatternNode *node) override {
+        VisitChildren(node->pattern_no_top_alts_);
+    }
+    void visit(PatternNoTopAltNode *) override {}
+    void visit(PatternWithoutRangeNode *) override {}
+    void visit(LiteralPatternNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(IdentifierPatternNode *node) override {
+        VisitChild(node->node_);
+    }
+    void visit(WildcardPatternNode *) override {}
+    void visit(RestPatternNode *) override {}
+    void visit(GroupedPatternNode *node) override {
+        VisitChild(node->pattern_);
+    }
+    void visit(SlicePatternNode *node) override {
+        VisitChildren(node->patterns_);
+    }
+    void visit(PathPatternNode *node) override {
+        VisitChild(node->expression_);
+    }
+    void visit(TypeNode *) override {}
+    void visit(TypeNoBoundsNode *) override {}
+    void visit(ParenthesizedTypeNode *node) override {
+        VisitChild(node->type_);
+    }
+    void visit(TypePathSegmentNode *node) override {
+        VisitChild(node->path_indent_segment_node_);
+    }
+    void visit(TypePathNode *node) override {
+        VisitChild(node->type_path_segment_node_);
+    }
+    void visit(UnitTypeNode *) override {}
+    void visit(ArrayTypeNode *node) override {
+        VisitChild(node->type_);
+        VisitChild(node->expression_node_);
+    }
+    void visit(SliceTypeNode *node) override {
+        VisitChild(node->type_);
+    }
+    void visit(ReferenceTypeNode *node) override {
+        VisitChild(node->type_node_);
+    }
+};
+
+#endif //RECURSIVEASTVISITOR_H
@@ -11,47 +11,64 @@ using ConstValue = std::variant<int64_t,std::string>;
 
 
 class Scope {
-    std::unordered_map<std::string, Symbol> symbols_;
-    std::unordered_map<std::string, std::shared_ptr<Type> > types_;
+    std::unordered_map<Atom, Symbol> symbols_;
 
 public:
 	uint32_t scope_index{};
+    uint32_t depth = 0; // the root is at depth 0
     std::vector<std::shared_ptr<Scope> > next_level_scopes_;
     std::shared_ptr<Scope> parent_scope_;
-    std::unordered_map<std::string, ConstValue> value_map_;
-    std::unordered_map<std::string, uint32_t> ir_symbols_;
-    uint32_t index = 0;
+    std::unordered_map<Atom, ConstValue> value_map_;
+    std::unordered_map<Atom, uint32_t> ir_symbols_;
+    // Where the node owning the scope begins, and that node's scope_index,
+    // so that ScopeManager::NumberScopes can renumber both.
+    Position owner_pos_;
+    uint32_t *owner_index_ = nullptr;
 
     Scope() = default;
 
-    void declare(const Symbol &symbol, bool multi_name_check = true) {
-        if (symbols_.find(symbol.name_) != symbols_.end() && multi_name_check) {
-            throw SemanticError("Semantic Error: Variable MultiDeclaration", symbol.pos_);
+    // Returns the stored symbol, and whether its name is new to this scope;
+    // a redeclaration replaces the symbol in place.
+    std::pair<const Symbol *, bool> declare(const Symbol &symbol, bool multi_name_check = true) {
+        auto [it, inserted] = symbols_.try_emplace(symbol.atom_, symbol);
+        if (!inserted) {
+            if (multi_name_check) {
+                throw SemanticError("Semantic Error: Variable MultiDeclaration", symbol.pos_);
+            }
+            it->second = symbol;
         }
-        symbols_[symbol.name_] = symbol;
-        types_[symbol.name_] = symbol.type_;
+        return {&it->second, inserted};
     }
 
-    Symbol lookup(const std::string &name) {
-        if (symbols_.find(name) != symbols_.end()) {
-            return symbols_[name];
-        }
-        return Symbol{};
+    // Returns nullptr when `name` is not declared in this scope.
+    [[nodiscard]] const Symbol *find(const Atom name) const {
+        const auto it = symbols_.find(name);
+        return it == symbols_.end() ? nullptr : &it->second;
     }
 
-	void ir_declare(const std::string& name) {
-	    ir_symbols_[name] = scope_index;
+    [[nodiscard]] const std::unordered_map<Atom, Symbol> &symbols() const {
+        return symbols_;
     }
 
-	uint32_t ir_lookup(const std::string& name) {
-	    if (ir_symbols_.find(name) != ir_symbols_.end()) {
-	        return ir_symbols_[name];
-		}
-		return UINT32_MAX;
-	}
+	// True when `name` is new to this scope.
+	bool ir_declare(const Atom name) {
+	    return ir_symbols_.try_emplace(name, scope_index).second;
+    }
 
-    void ModifyType(const std::string &name, const std::shared_ptr<Type> &type) {
-        *types_[name] = *type;
+    // Struct and enumeration types are completed in place, since other types
+    // may already point at them. Every other type is interned and shared, so
+    // the binding is replaced instead.
+    void ModifyType(const Atom name, const std::shared_ptr<Type> &type) {
+        std::shared_ptr<Type> &slot = symbols_[name].type_;
+        if (slot == type) {
+            return;
+        }
+        const TypeKind kind = slot->getKind();
+        if (kind != TypeKind::Struct && kind != TypeKind::Enumeration) {
+            slot = type;
+            return;
+        }
+        *slot = *type;
     }
 
     void AddNextLevelScope(const std::shared_ptr<Scope> &scope) {
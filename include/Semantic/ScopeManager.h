@@ -1,14 +1,84 @@
 #ifndef SCOPEMANAGER_H
 #define SCOPEMANAGER_H
+#include <algorithm>
 #include <vector>
 #include "Scope.h"
+#include "TypeContext.h"
 
 class TypeNode;
 class ReferenceTypeNode;
 class ArrayTypeNode;
 using ConstValue = std::variant<int64_t, std::string>;
 
+// The scopes form a tree that every pass walks again, so they are kept for
+// the whole compilation. Name resolution does not walk that tree: for each
+// name, `bindings_` holds a stack of the declarations visible from the
+// current scope, innermost last. Moving the current scope pushes the
+// symbols of the scopes entered and pops those of the scopes left, so a
+// lookup costs one hash probe however deeply the scopes nest. The IR names
+// of `ir_symbols_` are tracked the same way in `ir_bindings_`.
+//
+// The current scope must therefore only be moved through AddScope,
+// PopScope and SetCurrentScope.
 class ScopeManager {
+    struct Binding {
+        Scope *scope;
+        const Symbol *symbol;
+    };
+
+    std::unordered_map<Atom, std::vector<Binding>> bindings_;
+    std::unordered_map<Atom, std::vector<const Scope *>> ir_bindings_;
+
+    void PushBindings(Scope *scope) {
+        for (const auto &[atom, symbol]: scope->symbols()) {
+            bindings_[atom].push_back(Binding{scope, &symbol});
+        }
+        for (const auto &[atom, index]: scope->ir_symbols_) {
+            ir_bindings_[atom].push_back(scope);
+        }
+    }
+
+    // `scope` is the innermost scope, so its bindings are the tops of their stacks.
+    void PopBindings(const Scope *scope) {
+        for (const auto &[atom, symbol]: scope->symbols()) {
+            bindings_.find(atom)->second.pop_back();
+        }
+        for (const auto &[atom, index]: scope->ir_symbols_) {
+            ir_bindings_.find(atom)->second.pop_back();
+        }
+    }
+
+    // The innermost visible declaration of `name`, or nullptr.
+    [[nodiscard]] const Binding *FindBinding(const Atom name) const {
+        const auto it = bindings_.find(name);
+        if (it == bindings_.end()) {
+            return nullptr;
+        }
+        for (auto binding = it->second.rbegin(); binding != it->second.rend(); ++binding) {
+            if (binding->symbol->symbol_type_ != SymbolType::None) {
+                return &*binding;
+            }
+        }
+        return nullptr;
+    }
+
+    // The innermost visible declaration of `name` that is not a local
+    // variable, or nullptr.
+    [[nodiscard]] const Binding *FindItemBinding(const Atom name) const {
+        const auto it = bindings_.find(name);
+        if (it == bindings_.end()) {
+            return nullptr;
+        }
+        for (auto binding = it->second.rbegin(); binding != it->second.rend(); ++binding) {
+            const Symbol &symbol = *binding->symbol;
+            if (symbol.symbol_type_ != SymbolType::None &&
+                (symbol.symbol_type_ != SymbolType::Variable || symbol.is_const_)) {
+                return &*binding;
+            }
+        }
+        return nullptr;
+    }
+
 public:
 	std::vector<std::shared_ptr<Scope>> scope_set_;
     std::shared_ptr<Scope> root;
@@ -21,18 +91,19 @@ public:
         current_scope = root;
     	scope_set_.push_back(current_scope);
     	current_scope->scope_index = scope_count++;
-        std::shared_ptr<Type> i32_type = std::make_shared<PrimitiveType>("i32");
-        std::shared_ptr<Type> u32_type = std::make_shared<PrimitiveType>("u32");
-        std::shared_ptr<Type> isize_type = std::make_shared<PrimitiveType>("isize");
-        std::shared_ptr<Type> usize_type = std::make_shared<PrimitiveType>("usize");
-        std::shared_ptr<Type> bool_type = std::make_shared<PrimitiveType>("bool");
-        std::shared_ptr<Type> char_type = std::make_shared<PrimitiveType>("char");
-        std::shared_ptr<Type> str_type = std::make_shared<PrimitiveType>("str");
-        std::shared_ptr<Type> andStr_type = std::make_shared<ReferenceType>(str_type);
-        std::shared_ptr<Type> string_type = std::make_shared<PrimitiveType>("String");
-        std::shared_ptr<Type> cstring_type = std::make_shared<PrimitiveType>("cstring");
-        std::shared_ptr<Type> never_type = std::make_shared<PrimitiveType>("never");
-        std::shared_ptr<Type> void_type = std::make_shared<PrimitiveType>("void");
+        TypeContext &types = GlobalTypeContext();
+        std::shared_ptr<Type> i32_type = types.Primitive("i32");
+        std::shared_ptr<Type> u32_type = types.Primitive("u32");
+        std::shared_ptr<Type> isize_type = types.Primitive("isize");
+        std::shared_ptr<Type> usize_type = types.Primitive("usize");
+        std::shared_ptr<Type> bool_type = types.Primitive("bool");
+        std::shared_ptr<Type> char_type = types.Primitive("char");
+        std::shared_ptr<Type> str_type = types.Primitive("str");
+        std::shared_ptr<Type> andStr_type = types.Reference(str_type);
+        std::shared_ptr<Type> string_type = types.Primitive("String");
+        std::shared_ptr<Type> cstring_type = types.Primitive("cstring");
+        std::shared_ptr<Type> never_type = types.Primitive("never");
+        std::shared_ptr<Type> void_type = types.Primitive("void");
         Symbol i32(pos, "i32", i32_type, SymbolType::Type);
         Symbol u32(pos, "u32", u32_type, SymbolType::Type);
         Symbol isize(pos, "isize", isize_type, SymbolType::Type);
@@ -58,31 +129,31 @@ public:
         declare(Void_);
         declare(never_);
 
-        std::shared_ptr<Type> print = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> print = types.Function(
             std::vector{andStr_type},
             void_type
         );
-        std::shared_ptr<Type> println = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> println = types.Function(
             std::vector{andStr_type},
             void_type
         );
-        std::shared_ptr<Type> printInt = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> printInt = types.Function(
             std::vector{i32_type},
             void_type
         );
-        std::shared_ptr<Type> printlnInt = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> printlnInt = types.Function(
             std::vector{i32_type},
             void_type
         );
-        std::shared_ptr<Type> getString = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> getString = types.Function(
             std::vector<std::shared_ptr<Type>>{},
             string_type
         );
-        std::shared_ptr<Type> getInt = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> getInt = types.Function(
             std::vector<std::shared_ptr<Type>>{},
             i32_type
         );
-        std::shared_ptr<Type> exit = std::make_shared<FunctionType>(
+        std::shared_ptr<Type> exit = types.Function(
             std::vector{i32_type},
             void_type
         );
@@ -101,16 +172,78 @@ public:
         declare(getInt_);
         declare(exit_);
 
-        i32_type->methods_.emplace_back(
-            Method{"to_string", std::make_shared<FunctionType>(
-                std::vector<std::shared_ptr<Type>>{}, string_type)});
-        string_type->methods_.emplace_back(
-            Method{"len", std::make_shared<FunctionType>(
-                std::vector<std::shared_ptr<Type>>{}, usize_type)});
+        if (i32_type->methods_.empty()) { // the builtin types are shared with any earlier ScopeManager
+            i32_type->methods_.emplace_back(
+                Method{"to_string", types.Function(
+                    std::vector<std::shared_ptr<Type>>{}, string_type)});
+            string_type->methods_.emplace_back(
+                Method{"len", types.Function(
+                    std::vector<std::shared_ptr<Type>>{}, usize_type)});
+        }
+    }
+
+    struct SharedTree {};
+
+    // Another thread's view of the scopes of `shared`. The tree is shared;
+    // the current scope, starting at the root, and the bindings are the
+    // view's own. No two views may declare into the same scope at once.
+    ScopeManager(const ScopeManager &shared, SharedTree)
+        : scope_set_(shared.scope_set_), root(shared.root), scope_count(shared.scope_count) {
+        SetCurrentScope(root);
     }
 
     ~ScopeManager() = default;
 
+    // Drops every scope. Scopes hold their parent and children by shared_ptr,
+    // so the links are cut first or the tree would keep itself alive.
+    void Clear() {
+        for (const auto &scope: scope_set_) {
+            scope->next_level_scopes_.clear();
+            scope->parent_scope_.reset();
+        }
+        scope_set_.clear();
+        scope_set_.shrink_to_fit();
+        root.reset();
+        current_scope.reset();
+        bindings_.clear();
+        ir_bindings_.clear();
+    }
+
+    // Makes `scope` current, popping the bindings of the scopes left and
+    // pushing those of the scopes entered on the way from the old current
+    // scope through their closest common ancestor.
+    void SetCurrentScope(const std::shared_ptr<Scope> &scope) {
+        Scope *from = current_scope.get();
+        Scope *to = scope.get();
+        std::vector<Scope *> entered;
+        while (from != to) {
+            if (from != nullptr && (to == nullptr || from->depth >= to->depth)) {
+                PopBindings(from);
+                from = from->parent_scope_.get();
+            } else {
+                entered.push_back(to);
+                to = to->parent_scope_.get();
+            }
+        }
+        for (auto it = entered.rbegin(); it != entered.rend(); ++it) {
+            PushBindings(*it);
+        }
+        current_scope = scope;
+    }
+
+    // Rebuilds the bindings after the scopes were replaced wholesale, as the
+    // AST cache does when it loads them. Depths are recomputed too; parents
+    // precede their children in `scope_set_`.
+    void ResetBindings(const std::shared_ptr<Scope> &scope) {
+        for (const auto &it: scope_set_) {
+            it->depth = it->parent_scope_ ? it->parent_scope_->depth + 1 : 0;
+        }
+        bindings_.clear();
+        ir_bindings_.clear();
+        current_scope.reset();
+        SetCurrentScope(scope);
+    }
+
     void AddScope(){
         std::shared_ptr<Scope> new_scope = std::make_shared<Scope>();
     	new_scope->scope_index = scope_count++;
@@ -118,91 +251,153 @@ public:
         if (current_scope) {
             current_scope->AddNextLevelScope(new_scope);
             new_scope->parent_scope_ = current_scope;
-            current_scope = new_scope;
+            new_scope->depth = current_scope->depth + 1;
+            current_scope = new_scope; // a new scope has no bindings yet
         }
     }
 
+    // Opens the scope of the node beginning at `pos`, whose scope_index is
+    // `owner_index`, and makes it current.
+    void AddScope(uint32_t &owner_index, const Position &pos) {
+        AddScope();
+        current_scope->owner_pos_ = pos;
+        current_scope->owner_index_ = &owner_index;
+        owner_index = current_scope->scope_index;
+    }
+
+    // The semantic passes open scopes as they reach them: those around the
+    // function bodies first, the others while the bodies are checked, and on
+    // several threads each into its own `scope_set_`. Numbers the whole tree
+    // again in the order one walk of the source would have opened it, parents
+    // before children and siblings by position, and updates the owners'
+    // scope_index to match. The IR names its variables by these numbers.
+    void NumberScopes() {
+        scope_set_.clear();
+        std::vector<std::shared_ptr<Scope> > pending{root};
+        while (!pending.empty()) {
+            std::shared_ptr<Scope> scope = std::move(pending.back());
+            pending.pop_back();
+            scope->scope_index = scope_set_.size();
+            if (scope->owner_index_) {
+                *scope->owner_index_ = scope->scope_index;
+            }
+            auto &children = scope->next_level_scopes_;
+            std::stable_sort(children.begin(), children.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs->owner_pos_.GetOffset() < rhs->owner_pos_.GetOffset();
+            });
+            pending.insert(pending.end(), children.rbegin(), children.rend());
+            scope_set_.push_back(std::move(scope));
+        }
+        scope_count = scope_set_.size();
+    }
+
     void PopScope() {
         if (current_scope->parent_scope_) {
+            PopBindings(current_scope.get());
             current_scope = current_scope->parent_scope_;
         } else {
             throw SemanticError("Semantic Error: Cannot pop root scope");
         }
     }
 
-    void declare(const Symbol& symbol, bool multi_name_check = true) const {
-        try {
-            current_scope -> declare(symbol, multi_name_check);
-        } catch (std::exception &) {
-            throw;
+    void declare(const Symbol& symbol, bool multi_name_check = true) {
+        const auto [stored, inserted] = current_scope->declare(symbol, multi_name_check);
+        if (inserted) {
+            bindings_[symbol.atom_].push_back(Binding{current_scope.get(), stored});
         }
     }
 
-	void ir_declare(const std::string &name) {
-	    current_scope->ir_declare(name);
+	void ir_declare(const Atom name) {
+	    if (current_scope->ir_declare(name)) {
+	        ir_bindings_[name].push_back(current_scope.get());
+	    }
     }
 
-    [[nodiscard]] Symbol lookup(const std::string& name) const {
-        std::shared_ptr<Scope> cursor = current_scope;
-        while (cursor != nullptr) {
-            Symbol symbol = cursor -> lookup(name);
-            if (symbol.symbol_type_ != SymbolType::None) {
-                return symbol;
-            }
-            cursor = cursor -> parent_scope_;
+	void ir_declare(const std::string_view name) {
+	    ir_declare(GlobalInterner().Intern(name));
+    }
+
+    // The reference stays valid until the scope declaring the symbol is
+    // cleared; a redeclaration in that scope changes what it refers to.
+    [[nodiscard]] const Symbol &lookup(const Atom name) const {
+        if (const Binding *binding = FindBinding(name)) {
+            return *binding->symbol;
+        }
+        throw SemanticError("Semantic Error: Symbol not found - " + std::string(GlobalInterner().Spelling(name)));
+    }
+
+    [[nodiscard]] const Symbol &lookup(const std::string_view name) const {
+        return lookup(GlobalInterner().Intern(name));
+    }
+
+    // Like lookup, but skips the variables a `let` or a parameter declared:
+    // in a constant context, such as the length of an array type, a name
+    // refers to the item it names even where a local shadows it.
+    [[nodiscard]] const Symbol &lookupConst(const Atom name) const {
+        if (const Binding *binding = FindItemBinding(name)) {
+            return *binding->symbol;
         }
-        throw SemanticError("Semantic Error: Symbol not found - " + name);
+        return lookup(name);
     }
 
-	[[nodiscard]] uint32_t ir_lookup(const std::string& name) const {
-    	std::shared_ptr<Scope> cursor = current_scope;
-    	while (cursor != nullptr) {
-    		uint32_t symbol = cursor -> ir_lookup(name);
-    		if (symbol != UINT32_MAX) {
-				return symbol;
-			}
-    		cursor = cursor -> parent_scope_;
+	[[nodiscard]] uint32_t ir_lookup(const Atom name) const {
+    	const auto it = ir_bindings_.find(name);
+    	if (it != ir_bindings_.end() && !it->second.empty()) {
+    		return it->second.back()->scope_index;
     	}
-    	throw SemanticError("Semantic Error: Symbol not found - " + name);
+    	throw SemanticError("Semantic Error: Symbol not found - " + std::string(GlobalInterner().Spelling(name)));
+    }
+
+	[[nodiscard]] uint32_t ir_lookup(const std::string_view name) const {
+    	return ir_lookup(GlobalInterner().Intern(name));
     }
 
-    std::shared_ptr<Type> lookupType(const std::shared_ptr<TypeNode> &type);
+    std::shared_ptr<Type> lookupType(TypeNode *type);
 
-    std::shared_ptr<ArrayType> lookupArray(const std::shared_ptr<ArrayTypeNode> &type);
+    std::shared_ptr<ArrayType> lookupArray(ArrayTypeNode *type);
 
-    std::shared_ptr<ReferenceType> lookupRef(const std::shared_ptr<ReferenceTypeNode> &type);
+    std::shared_ptr<ReferenceType> lookupRef(ReferenceTypeNode *type);
 
-    void AddConstant(const std::string &name, const ConstValue& val) const {
+    void AddConstant(const Atom name, const ConstValue& val) const {
         current_scope->value_map_[name] = val;
     }
 
-    [[nodiscard]] ConstValue SearchValue(const std::string &name) const {
-        std::shared_ptr<Scope> cursor = current_scope;
-        while (cursor != nullptr) {
-            Symbol symbol = cursor -> lookup(name);
-            if (symbol.symbol_type_ != SymbolType::None) {
-                return cursor ->value_map_[name];
-            }
-            cursor = cursor -> parent_scope_;
+    void AddConstant(const std::string_view name, const ConstValue& val) const {
+        AddConstant(GlobalInterner().Intern(name), val);
+    }
+
+    // The value of the constant lookupConst finds, which is the one lookup
+    // finds whenever that is a constant.
+    [[nodiscard]] ConstValue SearchValue(const Atom name) const {
+        if (const Binding *binding = FindItemBinding(name)) {
+            const auto it = binding->scope->value_map_.find(name);
+            return it == binding->scope->value_map_.end() ? ConstValue() : it->second;
         }
         throw SemanticError("This Error should not be occurred, please check your code!!!");
     }
 
-    void ModifyType(const std::string &name, const std::shared_ptr<Type>& type) const {
+    [[nodiscard]] ConstValue SearchValue(const std::string_view name) const {
+        return SearchValue(GlobalInterner().Intern(name));
+    }
+
+    void ModifyType(const Atom name, const std::shared_ptr<Type>& type) const {
         current_scope -> ModifyType(name, type);
     }
 
-    void RemoteModifyType(const std::string &name, const std::shared_ptr<Type>& type) const {
-        std::shared_ptr<Scope> cursor = current_scope;
-        while (cursor != nullptr) {
-            Symbol symbol = cursor -> lookup(name);
-            if (symbol.symbol_type_ != SymbolType::None) {
-                cursor -> ModifyType(name, type);
-                return;
-            }
-            cursor = cursor -> parent_scope_;
+    void ModifyType(const std::string_view name, const std::shared_ptr<Type>& type) const {
+        ModifyType(GlobalInterner().Intern(name), type);
+    }
+
+    void RemoteModifyType(const Atom name, const std::shared_ptr<Type>& type) const {
+        if (const Binding *binding = FindBinding(name)) {
+            binding->scope->ModifyType(name, type);
+            return;
         }
-        throw SemanticError("Semantic Error: Symbol not found - " + name);
+        throw SemanticError("Semantic Error: Symbol not found - " + std::string(GlobalInterner().Spelling(name)));
+    }
+
+    void RemoteModifyType(const std::string_view name, const std::shared_ptr<Type>& type) const {
+        RemoteModifyType(GlobalInterner().Intern(name), type);
     }
 };
 #endif //SCOPEMANAGER_H
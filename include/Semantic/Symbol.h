@@ -4,6 +4,7 @@
 #include <string>
 #include "Type.h"
 #include "Position.h"
+#include "StringInterner.h"
 
 enum class SymbolType {
     Variable, Function, Type, Constant, Enumeration, Struct, None
@@ -11,6 +12,7 @@ enum class SymbolType {
 
 struct Symbol {
     std::string name_;
+    Atom atom_ = StringInterner::InvalidAtom;
     std::shared_ptr<Type> type_ = nullptr;
     SymbolType symbol_type_ = SymbolType::None;
     bool is_mutable_ = false;
@@ -25,6 +27,7 @@ struct Symbol {
            const bool &is_mutable = false) {
         pos_ = pos;
         name_ = name;
+        atom_ = GlobalInterner().Intern(name);
         type_ = type;
         symbol_type_ = symbol_type;
         is_mutable_ = is_mutable;
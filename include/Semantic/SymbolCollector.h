@@ -1,111 +1,49 @@
 #ifndef SYMBOLCOLLECTOR_H
 #define SYMBOLCOLLECTOR_H
-#include "ASTNode.h"
+#include <vector>
+#include "RecursiveASTVisitor.h"
 
+// The item pass: everything about the items that function bodies depend on,
+// done before any body is checked. It declares the items of the crate and
+// opens the scopes of impls and function bodies. A body the parser marked as
+// declaring items is walked too, opening its blocks and declaring their
+// items, so that an impl in one body is known to all of them. Once every list
+// of items is declared, ConstEvaluator evaluates the constants and
+// SymbolManager resolves struct layouts, function signatures and impl
+// methods, list by list. Functions are declared with a placeholder type until
+// then.
+//
+// It runs once on the crate before SemanticChecker. SemanticChecker runs it
+// again only on the items of a block it has to open itself, which is never
+// one inside a function body.
+class SymbolCollector : public RecursiveASTVisitor {
+    // Items and the scope they are declared in.
+    struct ItemList {
+        std::shared_ptr<Scope> scope;
+        std::vector<VisItemNode *> items;
+    };
 
-class SymbolCollector : public ASTVisitor {
     ScopeManager& scope_manager_;
+    std::vector<ItemList> lists_;
+
+    void Declare(const std::vector<VisItemNode *> &items);
+
 public:
+    using RecursiveASTVisitor::visit;
     explicit SymbolCollector(ScopeManager& scope_manager): scope_manager_(scope_manager) {}
 
-    ~SymbolCollector() override = default;
+    // Declares and resolves `items` in the current scope.
+    void Collect(const std::vector<VisItemNode *> &items);
 
-    void visit(ASTNode *node) override;
-    void visit(CrateNode *node) override;
-    void visit(VisItemNode *node) override;
-    void visit(FunctionNode *node) override;
-    void visit(StructNode *node) override;
-    void visit(EnumerationNode *node) override;
-    void visit(ConstantItemNode *node) override;
-    void visit(TraitNode *node) override;
-    void visit(ImplementationNode *node) override;
-    void visit(AssociatedItemNode *node) override;
-    void visit(InherentImplNode *node) override;
-    void visit(TraitImplNode *node) override;
-    void visit(FunctionParametersNode *node) override;
-    void visit(FunctionParamNode *node) override;
-    void visit(FunctionParamPatternNode *node) override;
-    void visit(StructFieldNode *node) override;
-    void visit(EnumVariantNode *node) override;
-    void visit(EnumVariantStructNode *node) override;
-    void visit(EnumVariantDiscriminantNode *node) override;
-    void visit(TypeParamBoundsNode *node) override;
-    void visit(TypeParamNode *node) override;
-    void visit(ConstParamNode *node) override;
-    void visit(StatementNode *node) override;
-    void visit(StatementsNode *node) override;
-    void visit(EmptyStatementNode *node) override;
-    void visit(LetStatementNode *node) override;
-    void visit(VisItemStatementNode *node) override;
-    void visit(ExpressionStatementNode *node) override;
-    void visit(ExpressionNode *node) override;
-    void visit(ExpressionWithoutBlockNode *node) override;
-    void visit(ExpressionWithBlockNode *node) override;
-    void visit(ComparisonExpressionNode *node) override;
-    void visit(TypeCastExpressionNode *node) override;
-    void visit(AssignmentExpressionNode *node) override;
-    void visit(ContinueExpressionNode *node) override;
-    void visit(UnderscoreExpressionNode *node) override;
-    void visit(JumpExpressionNode *node) override;
-    void visit(LogicOrExpressionNode *node) override;
-    void visit(LogicAndExpressionNode *node) override;
-    void visit(BitwiseOrExpressionNode *node) override;
-    void visit(BitwiseXorExpressionNode *node) override;
-    void visit(BitwiseAndExpressionNode *node) override;
-    void visit(ShiftExpressionNode *node) override;
-    void visit(AddMinusExpressionNode *node) override;
-    void visit(MulDivModExpressionNode *node) override;
-    void visit(UnaryExpressionNode *node) override;
-    void visit(FunctionCallExpressionNode *node) override;
-    void visit(ArrayIndexExpressionNode *node) override;
-    void visit(MemberAccessExpressionNode *node) override;
-    void visit(BlockExpressionNode *node) override;
-    void visit(LoopExpressionNode *node) override;
-    void visit(InfiniteLoopExpressionNode *node) override;
-    void visit(PredicateLoopExpressionNode *node) override;
-    void visit(IfExpressionNode *node) override;
-    void visit(MatchExpressionNode *node) override;
-    void visit(LiteralExpressionNode *node) override;
-    void visit(CharLiteralNode *node) override;
-    void visit(StringLiteralNode *node) override;
-    void visit(CStringLiteralNode *node) override;
-    void visit(IntLiteralNode *node) override;
-    void visit(BoolLiteralNode *node) override;
-    void visit(ArrayLiteralNode *node) override;
-    void visit(PathExpressionNode *node) override;
-    void visit(PathInExpressionNode *node) override;
-    void visit(QualifiedPathInExpressionNode *node) override;
-    void visit(PathIndentSegmentNode *node) override;
-    void visit(StructExpressionNode *node) override;
-    void visit(StructExprFieldsNode *node) override;
-    void visit(StructExprFieldNode *node) override;
-    void visit(StructBaseNode *node) override;
-    void visit(GroupedExpressionNode *node) override;
-    void visit(TupleExpressionNode *node) override;
-    void visit(ConditionsNode *node) override;
-    void visit(LetChainNode *node) override;
-    void visit(LetChainConditionNode *node) override;
-    void visit(MatchArmsNode *node) override;
-    void visit(MatchArmNode *node) override;
-    void visit(MatchArmGuardNode *node) override;
-    void visit(PatternNode *node) override;
-    void visit(PatternNoTopAltNode *node) override;
-    void visit(PatternWithoutRangeNode *node) override;
-    void visit(LiteralPatternNode *node) override;
-    void visit(IdentifierPatternNode *node) override;
-    void visit(WildcardPatternNode *node) override;
-    void visit(RestPatternNode *node) override;
-    void visit(GroupedPatternNode *node) override;
-    void visit(SlicePatternNode *node) override;
-    void visit(PathPatternNode *node) override;
-    void visit(TypeNode *node) override;
-    void visit(TypeNoBoundsNode *node) override;
-    void visit(ParenthesizedTypeNode *node) override;
-    void visit(TypePathNode *node) override;
-    void visit(TypePathSegmentNode *node) override;
-    void visit(UnitTypeNode *node) override;
-    void visit(ArrayTypeNode *node) override;
-    void visit(SliceTypeNode *node) override;
-    void visit(ReferenceTypeNode *node) override;
+    void visit(CrateNode *node);
+    void visit(FunctionNode *node);
+    void visit(StructNode *node);
+    void visit(EnumerationNode *node);
+    void visit(ConstantItemNode *node);
+    void visit(TraitNode *node);
+    void visit(InherentImplNode *node);
+    void visit(TraitImplNode *node);
+    void visit(BlockExpressionNode *node);
+    void visit(VisItemStatementNode *node);
 };
 #endif //SYMBOLCOLLECTOR_H
@@ -12,11 +12,12 @@
 class Type;
 class FunctionType;
 class FunctionNode;
+class IRType;
 
 struct Method {
     std::string name_;
     std::shared_ptr<Type> type_;
-	std::shared_ptr<FunctionNode> function_node_;
+	FunctionNode *function_node_ = nullptr;
 };
 
 enum class TypeKind {
@@ -34,6 +35,11 @@ public:
     std::vector<Method> inline_functions_{};
     std::vector<Method> constants_{};
 
+    // What IRManager::GetIRType lowered this type to, valid while
+    // ir_generation_ matches the manager's.
+    std::shared_ptr<IRType> ir_type_;
+    uint64_t ir_generation_ = 0;
+
     Type() = default;
 
     virtual ~Type() = default;
@@ -44,6 +50,8 @@ public:
 
     [[nodiscard]] virtual std::string toString() const = 0;
 
+    // Types built by the TypeContext are interned, so for them this is a
+    // pointer comparison; struct and enumeration types compare structurally.
     [[nodiscard]] virtual bool equal(const std::shared_ptr<Type> &other) const = 0;
 };
 
@@ -72,9 +80,7 @@ public:
     [[nodiscard]] std::string toString() const override { return name_; }
 
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
-        if (!other || other->getKind() != TypeKind::Primitive) return false;
-        auto ptr = std::dynamic_pointer_cast<PrimitiveType>(other);
-        return name_ == ptr->name_;
+        return other.get() == this;
     }
 };
 
@@ -205,21 +211,20 @@ public:
         return str;
     }
 
+    // The self flags are part of the interned identity but not of equality,
+    // so methods that differ only in their receiver still compare equal.
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
+        if (other.get() == this) return true;
         if (!other || other->getKind() != TypeKind::Function) return false;
-        auto ptr = std::dynamic_pointer_cast<FunctionType>(other);
-        if (!ret_->equal(ptr->ret_) || params_.size() != ptr->params_.size()) return false;
-        for (size_t i = 0; i < params_.size(); i++) {
-            if (!params_[i]->equal(ptr->params_[i])) return false;
-        }
-        return true;
+        const auto *ptr = static_cast<const FunctionType *>(other.get());
+        return ret_ == ptr->ret_ && params_ == ptr->params_;
     }
 };
 
 class SliceType : public Type {
+public:
     std::shared_ptr<Type> type_;
 
-public:
     explicit SliceType(std::shared_ptr<Type> type) : type_(std::move(type)) {
     }
 
@@ -244,9 +249,7 @@ public:
     }
 
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
-        if (!other || other->getKind() != TypeKind::Slice) return false;
-        auto ptr = std::dynamic_pointer_cast<SliceType>(other);
-        return type_->equal(ptr->type_);
+        return other.get() == this;
     }
 };
 
@@ -255,7 +258,8 @@ public:
     std::shared_ptr<Type> base_;
     uint32_t length_;
 
-    ArrayType(const std::shared_ptr<Type> &base, uint32_t length);
+    ArrayType(std::shared_ptr<Type> base, uint32_t length) : base_(std::move(base)), length_(length) {
+    }
 
     ArrayType &operator=(const Type &other) override {
         value_map = other.value_map;
@@ -279,9 +283,7 @@ public:
     }
 
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
-        if (!other || other->getKind() != TypeKind::Array) return false;
-        auto ptr = std::dynamic_pointer_cast<ArrayType>(other);
-        return length_ == ptr->length_ && base_->equal(ptr->base_);
+        return other.get() == this;
     }
 };
 
@@ -311,10 +313,7 @@ public:
     }
 
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
-        if (!other || other -> getKind() != TypeKind::Unit) {
-            return false;
-        }
-        return true;
+        return other.get() == this;
     }
 };
 
@@ -351,13 +350,14 @@ public:
         return "&" + type_ -> toString();
     }
 
+    // A shared reference also accepts a mutable one to the same type.
     [[nodiscard]] bool equal(const std::shared_ptr<Type> &other) const override {
-        if (!other || other -> getKind() != TypeKind::Reference) {
+        if (other.get() == this) return true;
+        if (is_mut_ || !other || other -> getKind() != TypeKind::Reference) {
             return false;
         }
-        auto ptr = std::dynamic_pointer_cast<ReferenceType>(other);
-        if (is_mut_ != ptr->is_mut_ && is_mut_) { return false; }
-        return type_->equal(ptr->type_);
+        const auto *ptr = static_cast<const ReferenceType *>(other.get());
+        return ptr->type_ == type_;
     }
 };
 
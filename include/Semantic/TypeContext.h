@@ -0,0 +1,143 @@
+#ifndef TYPECONTEXT_H
+#define TYPECONTEXT_H
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "StringInterner.h"
+#include "Semantic/Type.h"
+
+// The universe of structural semantic types. Every PrimitiveType, UnitType,
+// ArrayType, SliceType, ReferenceType and FunctionType is built here and
+// hash-consed: asking twice for the same structure returns the same object,
+// so two such types are equal exactly when they are the same pointer.
+// Components are keyed by address, which is sound because they are interned
+// themselves or, for structs and enums, unique per declaration.
+//
+// Struct and enumeration types are nominal and filled in after they are
+// declared; they are not built here. Interned types are shared and must not
+// be modified after construction, apart from the methods, constants and
+// inline functions an impl block attaches to its target type.
+class TypeContext {
+    struct ArrayKey {
+        const Type *base;
+        uint32_t length;
+
+        bool operator==(const ArrayKey &other) const {
+            return base == other.base && length == other.length;
+        }
+    };
+
+    struct ReferenceKey {
+        const Type *type;
+        bool is_mut;
+
+        bool operator==(const ReferenceKey &other) const {
+            return type == other.type && is_mut == other.is_mut;
+        }
+    };
+
+    struct FunctionKey {
+        std::vector<const Type *> params;
+        const Type *ret;
+        uint8_t flags; // have_self, have_and, is_mut
+
+        bool operator==(const FunctionKey &other) const {
+            return ret == other.ret && flags == other.flags && params == other.params;
+        }
+    };
+
+    struct KeyHash {
+        static size_t Combine(size_t seed, const size_t value) {
+            return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+        }
+
+        size_t operator()(const ArrayKey &key) const {
+            return Combine(std::hash<const Type *>()(key.base), key.length);
+        }
+
+        size_t operator()(const ReferenceKey &key) const {
+            return Combine(std::hash<const Type *>()(key.type), key.is_mut);
+        }
+
+        size_t operator()(const FunctionKey &key) const {
+            size_t seed = Combine(std::hash<const Type *>()(key.ret), key.flags);
+            for (const Type *param: key.params) {
+                seed = Combine(seed, std::hash<const Type *>()(param));
+            }
+            return seed;
+        }
+    };
+
+    std::unordered_map<Atom, std::shared_ptr<PrimitiveType> > primitives_;
+    std::shared_ptr<UnitType> unit_;
+    std::unordered_map<ArrayKey, std::shared_ptr<ArrayType>, KeyHash> arrays_;
+    std::unordered_map<const Type *, std::shared_ptr<SliceType> > slices_;
+    std::unordered_map<ReferenceKey, std::shared_ptr<ReferenceType>, KeyHash> references_;
+    std::unordered_map<FunctionKey, std::shared_ptr<FunctionType>, KeyHash> functions_;
+    size_t requests_ = 0;
+
+    // Taken by every request while several threads check function bodies at
+    // once. Recursive, since building an array type builds its `len` method.
+    bool concurrent_ = false;
+    std::recursive_mutex mutex_;
+
+    std::unique_lock<std::recursive_mutex> Lock() {
+        return concurrent_ ? std::unique_lock(mutex_) : std::unique_lock<std::recursive_mutex>();
+    }
+
+    static FunctionKey KeyOf(const std::vector<std::shared_ptr<Type> > &params, const std::shared_ptr<Type> &ret,
+                             bool have_self, bool have_and, bool is_mut);
+
+public:
+    std::shared_ptr<PrimitiveType> Primitive(std::string_view name);
+
+    std::shared_ptr<UnitType> Unit();
+
+    // Arrays come with their `len` method.
+    std::shared_ptr<ArrayType> Array(const std::shared_ptr<Type> &base, uint32_t length);
+
+    std::shared_ptr<SliceType> Slice(const std::shared_ptr<Type> &type);
+
+    std::shared_ptr<ReferenceType> Reference(const std::shared_ptr<Type> &type, bool is_mut = false);
+
+    // The self flags are part of a function type's identity.
+    std::shared_ptr<FunctionType> Function(const std::vector<std::shared_ptr<Type> > &params,
+                                           const std::shared_ptr<Type> &ret, bool have_self = false,
+                                           bool have_and = false, bool is_mut = false);
+
+    // Registers a type built outside the context, as the AST cache does when
+    // it reads the type graph back. The graph was written from interned types
+    // and so holds each structure once; if the structure is already known the
+    // existing object wins. Struct and enumeration types are ignored.
+    void Adopt(const std::shared_ptr<Type> &type);
+
+    // Forgets every type. Types handed out before stay alive for as long as
+    // they are referenced but are no longer equal to anything built after.
+    void Clear();
+
+    // Set around phases that request types from several threads. Must itself
+    // be called while no other thread uses the context.
+    void SetConcurrent(const bool concurrent) {
+        concurrent_ = concurrent;
+    }
+
+    // How many types have been asked for, and how many distinct ones exist.
+    [[nodiscard]] size_t requests() const {
+        return requests_;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return primitives_.size() + (unit_ ? 1 : 0) + arrays_.size() + slices_.size() + references_.size() +
+               functions_.size();
+    }
+};
+
+// The process-wide type context shared by the semantic passes and the IR.
+inline TypeContext &GlobalTypeContext() {
+    static TypeContext context;
+    return context;
+}
+#endif //TYPECONTEXT_H
@@ -1,88 +1,217 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <optional>
 #include <string>
+#include "util/Arena.h"
+#include "util/MemoryStats.h"
 #include "util/Position.h"
+#include "util/SourceBuffer.h"
 #include "Error.h"
 #include "InstSelection/ASMModule.h"
 #include "InstSelection/InstSelector.h"
 #include "InstSelection/RegAllocator.h"
 #include "Lexer/Lexer.h"
+#include "Lexer/ParallelLexer.h"
+#include "Parser/ParallelParser.h"
 #include "Parser/Parser.h"
+#include "Semantic/ASTCache.h"
 #include "Semantic/ASTNode.h"
 #include "Semantic/ASTVisitor.h"
-#include "Semantic/ConstEvaluator.h"
+#include "Semantic/ParallelSemanticChecker.h"
 #include "Semantic/SemanticChecker.h"
 #include "Semantic/SymbolCollector.h"
-#include "Semantic/SymbolManager.h"
 #include "IR/IRBuilder.h"
 #include "IR/IRProgram.h"
 
 Lexer lexer;
-std::vector<Token> tokens;
-std::shared_ptr<ASTNode> root = nullptr;
+Arena ast_arena; // owns every AST node of the crate
+ASTNode *root = nullptr;
 ScopeManager scope_manager;
-SymbolCollector *symbol_collector = new SymbolCollector{scope_manager};
-ConstEvaluator *const_evaluator = new ConstEvaluator{scope_manager};
-SemanticChecker *semantic_checker = new SemanticChecker{scope_manager};
-SymbolManager *symbol_manager = new SymbolManager{scope_manager};
 IRManager ir_manager;
-IRBuilder *ir_builder = new IRBuilder{scope_manager, ir_manager};
-InstSelector *inst_selector = new InstSelector{};
 std::shared_ptr<IRProgram> ir_program;
 std::shared_ptr<ASMModule> asm_module;
 RegAllocator reg_allocator;
 
-int main() {
-    std::ios_base::sync_with_stdio(false);
-    std::cin.tie(nullptr);
-    std::string text((std::istreambuf_iterator(std::cin)),
-                     std::istreambuf_iterator<char>());
-    if (text.empty() || text.back() != '\n') {
-        text += '\n';
+namespace {
+    constexpr const char *Usage =
+        "Usage: RCompiler [--stats] [--low-memory] [--stream] [--lex-threads=N] [--parse-threads=N] "
+        "[--sema-threads=N] [--cache-dir=DIR] [input.rx]\n";
+
+    // Thread counts above this are taken for typos rather than for machines.
+    constexpr unsigned long MaxThreads = 1024;
+
+    // Parses the N of a --*-threads=N option into `threads`: a decimal number
+    // from 1 to MaxThreads with nothing after it.
+    bool ParseThreads(const char *text, uint32_t &threads) {
+        if (*text < '0' || *text > '9') {
+            return false;
+        }
+        char *end = nullptr;
+        errno = 0;
+        const unsigned long value = std::strtoul(text, &end, 10);
+        if (errno != 0 || *end != '\0' || value < 1 || value > MaxThreads) {
+            return false;
+        }
+        threads = static_cast<uint32_t>(value);
+        return true;
     }
+}
+
+// A file argument is memory-mapped; without one the source is read from stdin.
+// --stats prints per-phase string interner counters, wall time and peak resident memory to stderr.
+// --low-memory also returns the memory of each released stage to the kernel
+//   (see below); it costs about a tenth of the compile time.
+// --stream lexes on demand while parsing instead of lexing the whole file first.
+// --lex-threads=N lexes the whole file in N chunks in parallel (ignored with --stream).
+// --parse-threads=N parses top-level items on N threads (ignored with --stream).
+// --sema-threads=N checks function bodies on N threads.
+// --cache-dir=DIR reuses the checked crate of an unchanged source from DIR and
+//   stores it there after a successful semantic check.
+// An unknown option, a second input, or a thread count that is not a number
+// from 1 to MaxThreads prints the usage to stderr and exits with 2.
+// Each stage's data is released as soon as no later stage reads it: the tokens
+// once parsed, the AST, scopes and source once lowered to IR, and the IR once
+// instructions are selected. The freed memory stays with the allocator for
+// the next stage unless --low-memory trims it.
+int main(int argc, char *argv[]) {
+    bool print_stats = false;
+    bool low_memory = false;
+    bool stream_tokens = false;
+    uint32_t lex_threads = 1;
+    uint32_t parse_threads = 1;
+    uint32_t sema_threads = 1;
+    const char *input_path = nullptr;
+    const char *cache_dir = nullptr;
+    for (int i = 1; i < argc; i++) {
+        bool valid = true;
+        if (std::strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (std::strcmp(argv[i], "--low-memory") == 0) {
+            low_memory = true;
+        } else if (std::strcmp(argv[i], "--stream") == 0) {
+            stream_tokens = true;
+        } else if (std::strncmp(argv[i], "--lex-threads=", 14) == 0) {
+            valid = ParseThreads(argv[i] + 14, lex_threads);
+        } else if (std::strncmp(argv[i], "--parse-threads=", 16) == 0) {
+            valid = ParseThreads(argv[i] + 16, parse_threads);
+        } else if (std::strncmp(argv[i], "--sema-threads=", 15) == 0) {
+            valid = ParseThreads(argv[i] + 15, sema_threads);
+        } else if (std::strncmp(argv[i], "--cache-dir=", 12) == 0 && argv[i][12] != '\0') {
+            cache_dir = argv[i] + 12;
+        } else if (std::strncmp(argv[i], "--", 2) != 0 && input_path == nullptr) {
+            input_path = argv[i];
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "RCompiler: invalid argument '" << argv[i] << "'\n" << Usage;
+            return 2;
+        }
+    }
+    std::ios_base::sync_with_stdio(false);
+    PhaseMemory memory;
+    auto begin_phase = [&](const char *phase) {
+        if (!print_stats) return;
+        GlobalInterner().BeginPhase(phase);
+        memory.BeginPhase(phase);
+    };
+    auto release_freed_memory = [&] {
+        if (low_memory) ReleaseFreedMemory();
+    };
+    auto print_stats_if_requested = [&] {
+        if (!print_stats) return;
+        GlobalInterner().PrintStats(stderr);
+        memory.PrintStats(stderr);
+    };
     try {
-        std::string current_text = text;
-        uint32_t rowIndex = 1;
-        while (!current_text.empty()) {
-            Token current_token = lexer.GetNextToken(current_text);
-            if (current_token.type != TokenType::WhiteSpace &&
-                current_token.type != TokenType::BlockComment &&
-                current_token.type != TokenType::LineComment) {
-                current_token.putPosValue(Position{rowIndex});
-                tokens.push_back(current_token);
-            }
-            if (current_token.type == TokenType::ReservedIntegerLiteral) {
-                throw LexError("Lex Error: Invalid Integer");
-            }
-            for (auto it: current_token.token) {
-                if (it == '\r') {
-                    rowIndex++;
+        std::optional<SourceBuffer> source;
+        source.emplace(input_path ? SourceBuffer::MapFile(input_path) : SourceBuffer::ReadStream(STDIN_FILENO));
+        const std::string_view text = source->text();
+        std::optional<ASTCache> cache;
+        if (cache_dir) {
+            begin_phase("Cache");
+            cache.emplace(cache_dir);
+            root = cache->Load(text, ast_arena, scope_manager);
+            if (print_stats) std::fprintf(stderr, "ast cache: %s\n", root ? "hit" : "miss");
+        }
+        if (root == nullptr) {
+            std::unique_ptr<Parser> parser;
+            if (stream_tokens) {
+                begin_phase("Lexer+Parser");
+                parser = std::make_unique<Parser>(ast_arena, lexer, text);
+            } else {
+                begin_phase("Lexer");
+                TokenArray tokens;
+                LineTable lines;
+                if (lex_threads > 1) {
+                    tokens = ParallelLexer(lexer, lex_threads).Lex(text, lines);
+                } else {
+                    uint32_t offset = 0;
+                    Token current_token;
+                    while (lexer.NextParserToken(text, offset, lines, current_token)) {
+                        tokens.push_back(current_token);
+                    }
+                } // Lexer
+
+                begin_phase("Parser");
+                if (parse_threads > 1) {
+                    root = ParallelParser(parse_threads).ParseCrate(ast_arena, std::move(tokens), text);
+                } else {
+                    parser = std::make_unique<Parser>(ast_arena, std::move(tokens), text);
                 }
             }
-        } // Lexer
-
-        Parser parser(tokens);
-        root = parser.ParseCrate(); // Parser
+            if (parser) {
+                root = parser->ParseCrate(); // Parser
+                if (print_stats) std::fprintf(stderr, "peak buffered tokens: %u\n", parser->peak_token_window());
+                parser.reset(); // the parser owns the tokens
+            }
+            release_freed_memory();
 
-        root->accept(symbol_collector);
-        root->accept(const_evaluator);
-        root->accept(symbol_manager);
-        root->accept(semantic_checker); // Semantic Check
+            begin_phase("Items");
+            SymbolCollector(scope_manager).Visit(root);
+            begin_phase("Semantic");
+            if (sema_threads > 1) {
+                ParallelSemanticChecker(scope_manager, sema_threads).Check(cast<CrateNode>(root));
+            } else {
+                SemanticChecker(scope_manager).Visit(root); // Semantic Check
+            }
+            if (cache) cache->Store(text, cast<CrateNode>(root), scope_manager);
+        }
+        cache.reset();
 
+        begin_phase("IR");
         try {
             ir_program = std::make_shared<IRProgram>();
-            root->accept(ir_builder);
+            IRBuilder(scope_manager, ir_manager).Visit(root);
             // ir_program->print();
         } catch (...) {} // IR Generation
+        root = nullptr;
+        ast_arena.Reset(); // one destructor call per node, then the chunks
+        scope_manager.Clear();
+        GlobalTypeContext().Clear();
+        ir_manager = IRManager();
+        source.reset();
+        release_freed_memory();
 
+        begin_phase("InstSelection");
     	asm_module = std::make_shared<ASMModule>();
-    	ir_program->accept(inst_selector);
+        {
+            InstSelector inst_selector;
+    	    ir_program->accept(&inst_selector);
+        }
+        ir_program.reset();
+        release_freed_memory();
         reg_allocator.run(asm_module);
 
         asm_module->print();
+        print_stats_if_requested();
 
     	// std::cout << 0 << '\n';
     } catch (std::exception &error) {
         std::cout << error.what() << '\n';
+        print_stats_if_requested();
         exit(1);
     }
-}
\ No newline at end of file
+}
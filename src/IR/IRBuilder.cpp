@@ -1,2042 +1,1847 @@
-#include "IR/IRBuilder.h"
-
-#include "IR/IRBlock.h"
-#include "IR/IRProgram.h"
-#include "IR/IRType.h"
-#include "IR/IRLiteral.h"
-#include "Semantic/ASTNode.h"
-#include "Semantic/SymbolCollector.h"
-#include "Semantic/Type.h"
-#include "Semantic/Symbol.h"
-
-extern SymbolCollector *symbol_collector;
-
-extern std::shared_ptr<IRProgram> ir_program;
-
-void EmitStructCopy(std::shared_ptr<IRBasicBlock>& current_block, std::shared_ptr<IRBasicBlock>& entry_block, std::shared_ptr<IRFunction>& current_function, std::shared_ptr<IRVar> dest, std::shared_ptr<IRVar> src, std::shared_ptr<IRType> type) {
-    if (auto struct_type = std::dynamic_pointer_cast<IRStructType>(type)) {
-        for (size_t i = 0; i < struct_type->members.size(); ++i) {
-            auto member_type = struct_type->members[i];
-            auto index_type = std::make_shared<IRIntegerType>(32);
-            auto index_0 = std::make_shared<LiteralInt>(0);
-            auto index_i = std::make_shared<LiteralInt>(i);
-            
-            auto member_dest = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(member_type));
-            current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(
-                member_dest, struct_type, dest, 
-                std::vector<std::shared_ptr<IRType>>{index_type, index_type}, 
-                std::vector<std::shared_ptr<IRLiteral>>{index_0, index_i}
-            ));
-            
-            auto member_src = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(member_type));
-            current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(
-                member_src, struct_type, src, 
-                std::vector<std::shared_ptr<IRType>>{index_type, index_type}, 
-                std::vector<std::shared_ptr<IRLiteral>>{index_0, index_i}
-            ));
-            
-            EmitStructCopy(current_block, entry_block, current_function, member_dest, member_src, member_type);
-        }
-    } else if (auto array_type = std::dynamic_pointer_cast<IRArrayType>(type)) {
-        auto i32_type = std::make_shared<IRIntegerType>(32);
-        auto i_var = std::make_shared<LocalVar>(".i", i32_type);
-        entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(i_var, i32_type));
-        
-        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, std::make_shared<LiteralInt>(0), i_var));
-        
-        auto cond_block = std::make_shared<IRBasicBlock>("copy_cond");
-        auto body_block = std::make_shared<IRBasicBlock>("copy_body");
-        auto end_block = std::make_shared<IRBasicBlock>("copy_end");
-        
-        current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
-        
-        current_function->blocks.emplace_back(cond_block);
-        current_block = cond_block;
-        auto i_val = std::make_shared<LocalVar>("", i32_type);
-        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val, i32_type, i_var));
-        
-        auto limit_val = std::make_shared<LocalVar>("", i32_type);
-        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(limit_val, i32_type, array_type->length, 0));
-
-        auto cmp_res = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
-        current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(cmp_res, i32_type, i_val, limit_val, ConditionType::slt));
-        current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(cmp_res, body_block->true_label, end_block->true_label));
-        
-        current_function->blocks.emplace_back(body_block);
-        current_block = body_block;
-        
-        auto i_val_body = std::make_shared<LocalVar>("", i32_type);
-        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val_body, i32_type, i_var));
-        
-        auto zero_val = std::make_shared<LocalVar>("", i32_type);
-        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_val, i32_type, 0, 0));
-        
-        std::vector<std::shared_ptr<IRType>> index_types({i32_type, i32_type});
-        std::vector<std::shared_ptr<IRVar>> index_vars({zero_val, i_val_body});
-        
-        auto element_dest = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(array_type->baseType));
-        current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(element_dest, array_type, dest, index_types, index_vars));
-        
-        auto element_src = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(array_type->baseType));
-        current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(element_src, array_type, src, index_types, index_vars));
-        
-        EmitStructCopy(current_block, entry_block, current_function, element_dest, element_src, array_type->baseType);
-        
-        auto i_next = std::make_shared<LocalVar>("", i32_type);
-        auto one_val = std::make_shared<LocalVar>("", i32_type);
-        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(one_val, i32_type, 1, 0));
-        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(i_next, i32_type, i_val_body, one_val));
-        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, i_next, i_var));
-        
-        current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
-        
-        current_function->blocks.emplace_back(end_block);
-        current_block = end_block;
-    } else {
-        auto val = std::make_shared<LocalVar>("", type);
-        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(val, type, src));
-        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(type, val, dest));
-    }
-}
-
-void IRBuilder::visit(ASTNode *node) {
-}
-
-void IRBuilder::visit(CrateNode *node) {
-    scope_manager_.current_scope = scope_manager_.scope_set_[0];
-	auto saved_scope_index = scope_manager_.current_scope->scope_index;
-    for (const auto& item: node->items_) {
-        auto const_item = std::dynamic_pointer_cast<ConstantItemNode>(item);
-        if (const_item) {
-        	auto const_var = std::make_shared<ConstVar>(const_item->identifier_, std::make_shared<IRIntegerType>(32));
-        	auto val = std::get_if<int64_t>(&const_item->expression_node_->value);
-        	if (val) {
-        		auto ir_literal = std::make_shared<LiteralInt>(*val);
-        		ir_program->constants.emplace_back(std::make_shared<ConstVarDefInstruction>(const_var, ir_literal));
-        	}
-        }
-    }
-
-	for (const auto& item: node->items_) {
-		auto struct_item = std::dynamic_pointer_cast<StructNode>(item);
-		if (struct_item) {
-			auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
-			ir_manager_.AddType(struct_type);
-			auto ir_struct_type = std::dynamic_pointer_cast<IRStructType>(ir_manager_.GetIRType(struct_type));
-			ir_program->structs.emplace_back(std::make_shared<StructDefInstruction>(ir_struct_type, ir_struct_type->members));
-
-			for (auto& method : struct_type->methods_) {
-				auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
-				std::vector<IRFunctionParam> ir_function_params;
-				scope_manager_.current_scope = scope_manager_.scope_set_[method.function_node_->block_expression_->scope_index];
-				if (function_type) {
-					std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-					auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
-					if (possible_struct_type) {
-						method.function_node_->is_struct_type = true;
-						auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(function_type->ret_));
-						method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-						ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
-					} else {
-						ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
-					}
-					if (function_type->have_self_) {
-						auto ir_pointer_struct_type = std::make_shared<IRPointerType>(ir_struct_type);
-						auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
-						ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
-					}
-					uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
-					for (auto& param: function_type->params_) {
-						auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
-						auto ir_type = ir_manager_.GetIRType(param);
-						auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
-						if (identifier_pattern) {
-							std::string identifier = identifier_pattern->identifier_;
-							auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
-							ir_function_params.emplace_back(ir_type, ir_var);
-						}
-						++index;
-					}
-					std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
-					auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
-					ir_program->functions.emplace_back(ir_function);
-					ir_manager_.function_map_[ir_identifier] = ir_function;
-					method.function_node_->identifier_ = ir_identifier;
-					method.function_node_->accept(this);
-				}
-				scope_manager_.current_scope = scope_manager_.scope_set_[saved_scope_index];
-			}
-			for (auto& method : struct_type->inline_functions_) {
-				auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
-				std::vector<IRFunctionParam> ir_function_params;
-				scope_manager_.current_scope = scope_manager_.scope_set_[method.function_node_->block_expression_->scope_index];
-				if (function_type) {
-					std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-					if (function_type->ret_) {
-						auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
-						if (possible_struct_type) {
-							method.function_node_->is_struct_type = true;
-							auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(function_type->ret_));
-							method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-							ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
-						} else {
-							ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
-						}
-					}
-					if (function_type->have_self_) {
-						auto ir_pointer_struct_type = std::make_shared<IRPointerType>(ir_struct_type);
-						auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
-						ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
-					}
-					uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
-					for (auto& param: function_type->params_) {
-						auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
-						auto ir_type = ir_manager_.GetIRType(param);
-						auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
-						if (identifier_pattern) {
-							std::string identifier = identifier_pattern->identifier_;
-							auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
-							ir_function_params.emplace_back(ir_type, ir_var);
-						}
-						++index;
-					}
-					std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
-					auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
-					ir_program->functions.emplace_back(ir_function);
-					ir_manager_.function_map_[ir_identifier] = ir_function;
-					method.function_node_->identifier_ = ir_identifier;
-					method.function_node_->accept(this);
-				}
-				scope_manager_.current_scope = scope_manager_.scope_set_[saved_scope_index];
-			}
-		}
-	}
-
-	for (const auto& item: node->items_) {
-		auto func_item = std::dynamic_pointer_cast<FunctionNode>(item);
-		if (func_item) {
-			scope_manager_.current_scope = scope_manager_.scope_set_[func_item->block_expression_->scope_index];
-			std::vector<IRFunctionParam> ir_function_params;
-			std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-			if (func_item->type_) {
-				auto semantic_ret_type = func_item->type_->type;
-				auto possible_struct_type = std::dynamic_pointer_cast<StructType>(semantic_ret_type);
-				if (possible_struct_type) {
-					func_item->is_struct_type = true;
-					auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(semantic_ret_type));
-					func_item->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-					ir_function_params.emplace_back(pointer_type, func_item->struct_ret_var);
-				} else {
-					ir_ret_type = ir_manager_.GetIRType(semantic_ret_type);
-				}
-			}
-			auto parameters = func_item->function_parameters_;
-			if (parameters) {
-				for (auto& param : parameters->function_params_) {
-					auto ir_type = ir_manager_.GetIRType(param->type_->type);
-					auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(param->pattern_no_top_alt_node_);
-					auto ir_var = std::make_shared<LocalVar>(identifier_pattern->identifier_, ir_type);
-					ir_function_params.emplace_back(ir_type, ir_var);
-				}
-			}
-			auto ir_function = std::make_shared<IRFunction>(func_item->identifier_, ir_ret_type, ir_function_params);
-			ir_program->functions.emplace_back(ir_function);
-			ir_manager_.function_map_[func_item->identifier_] = ir_function;
-			scope_manager_.current_scope = scope_manager_.scope_set_[saved_scope_index];
-			item->accept(this);
-		}
-	}
-}
-
-void IRBuilder::visit(VisItemNode *node) {
-}
-
-void IRBuilder::visit(FunctionNode *node) {
-	auto saved_current_function = current_function;
-	auto saved_current_block = current_block;
-	auto saved_entry_block = entry_block;
-	current_function = ir_manager_.function_map_[node->identifier_];
-	current_block = std::make_shared<IRBasicBlock>("entry");
-	entry_block = current_block;
-	current_function->blocks.emplace_back(current_block);
-	uint32_t saved_scope_index = scope_manager_.current_scope->scope_index;
-	scope_manager_.current_scope = scope_manager_.scope_set_[node->block_expression_->scope_index];
-    if (node->function_parameters_) {
-	    node->function_parameters_->accept(this);
-    	for (auto& param: current_function->function_params) {
-    		if (param.var->name != "self" && param.var->name != ".ret") {
-    			auto param_var = std::make_shared<LocalVar>(param.var->name, std::make_shared<IRPointerType>(param.type));
-    			current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(param_var, param.type));
-    			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(param.type, param.var, param_var));
-    		}
-    	}
-    }
-	scope_manager_.current_scope = scope_manager_.scope_set_[saved_scope_index];
-    if (node->type_) node->type_->accept(this);
-    if (node->block_expression_) {
-    	node->block_expression_->is_function_direct_block = true;
-    	current_struct_ret_var = node->struct_ret_var;
-        node->block_expression_->accept(this);
-    	current_struct_ret_var = nullptr;
-    }
-	current_function = saved_current_function;
-	current_block = saved_current_block;
-	entry_block = saved_entry_block;
-}
-
-void IRBuilder::visit(StructNode *node) {
-    for (const auto &field: node->struct_field_nodes_) {
-        if (field) field->accept(this);
-    }
-}
-
-void IRBuilder::visit(EnumerationNode *node) {
-    for (const auto &variant: node->enum_variant_nodes_) {
-        if (variant) variant->accept(this);
-    }
-}
-
-void IRBuilder::visit(ConstantItemNode *node) {
-    if (node->type_node_) node->type_node_->accept(this);
-    if (node->expression_node_) node->expression_node_->accept(this);
-    if (!node->expression_node_->is_compiler_known_) {
-        throw SemanticError("Semantic Error: The RHS is not a Compiler-known expression", node->pos_);
-    }
-    scope_manager_.AddConstant(node->identifier_, node->expression_node_->value);
-}
-
-void IRBuilder::visit(TraitNode *node) {
-}
-
-void IRBuilder::visit(ImplementationNode *node) {
-}
-
-void IRBuilder::visit(AssociatedItemNode *node) {
-    if (node->constant_item_node_) node->constant_item_node_->accept(this);
-    if (node->function_node_) node->function_node_->accept(this);
-}
-
-void IRBuilder::visit(InherentImplNode *node) {
-	scope_manager_.current_scope = scope_manager_.scope_set_[node->scope_index];
-    if (node->type_node_) node->type_node_->accept(this);
-    std::string name = node->type_node_->toString();
-    for (auto& item : node->associated_item_nodes_) {
-        if (item) {
-            if (item->function_node_) {
-            	auto function_node = item->function_node_;
-            	item->function_node_->identifier_ = name + "." + item->function_node_->identifier_;
-            	item->accept(this);
-            }
-        }
-    }
-    scope_manager_.PopScope();
-}
-
-void IRBuilder::visit(TraitImplNode *node) {
-}
-
-void IRBuilder::visit(FunctionParametersNode *node) {
-    for (const auto &param: node->function_params_) {
-        if (param) param->accept(this);
-    }
-}
-
-void IRBuilder::visit(FunctionParamNode *node) {
-    // if (node->pattern_no_top_alt_node_) node->pattern_no_top_alt_node_->accept(this);
-    if (node->type_) node->type_->accept(this);
-}
-
-void IRBuilder::visit(FunctionParamPatternNode *node) {
-    if (node->pattern_no_top_alt_) node->pattern_no_top_alt_->accept(this);
-    if (node->type_) node->type_->accept(this);
-}
-
-void IRBuilder::visit(StructFieldNode *node) {
-    if (node->type_node_) node->type_node_->accept(this);
-}
-
-void IRBuilder::visit(EnumVariantNode *node) {
-    if (node->enum_variant_struct_node_) node->enum_variant_struct_node_->accept(this);
-    if (node->enum_variant_discriminant_node_) node->enum_variant_discriminant_node_->accept(this);
-}
-
-void IRBuilder::visit(EnumVariantStructNode *node) {
-    for (const auto &field: node->struct_field_nodes_) {
-        if (field) field->accept(this);
-    }
-}
-
-void IRBuilder::visit(EnumVariantDiscriminantNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
-}
-
-
-void IRBuilder::visit(StatementNode *node) {
-}
-
-void IRBuilder::visit(StatementsNode *node) {
-    for (const auto &stmt: node->statements_) {
-        if (stmt) {
-        	if (std::dynamic_pointer_cast<VisItemStatementNode>(stmt)) {
-        		continue;
-        	}
-	        stmt->accept(this);
-        	auto expr_stmt = std::dynamic_pointer_cast<ExpressionStatementNode>(stmt);
-        	if (expr_stmt) {
-        		auto jump_expr = std::dynamic_pointer_cast<JumpExpressionNode>(expr_stmt->expression_);
-        		auto continue_expr = std::dynamic_pointer_cast<ContinueExpressionNode>(expr_stmt->expression_);
-        		if (jump_expr || continue_expr) {
-					break;
-				}
-        	}
-        }
-    }
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void IRBuilder::visit(EmptyStatementNode *node) {
-}
-
-void IRBuilder::visit(LetStatementNode *node) {
-	if (node->type_) {
-		node->type_->accept(this);
-	}
-	if (node->expression_) {
-		node->expression_->accept(this);
-	}
-	if (node->block_expression_) {
-		node->block_expression_->accept(this);
-	}
-	std::string identifier;
-	auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(node->pattern_no_top_alt_);
-	if (identifier_pattern) {
-		identifier = identifier_pattern->identifier_;
-	}
-	auto ir_type = ir_manager_.GetIRType(node->type_->type);
-	auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
-	entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(ir_var, ir_type));
-
-	/**** Handle Array Type ****/
-	auto array_type = std::dynamic_pointer_cast<IRArrayType>(ir_type);
-	if (array_type) {
-		if (std::dynamic_pointer_cast<ArrayLiteralNode>(node->expression_)) {
-			StoreArrayLiteral(node->expression_, ir_var, array_type);
-		} else if (node->expression_) {
-			if (node->expression_->is_assignable_) {
-				EmitStructCopy(current_block, entry_block, current_function, ir_var, node->expression_->result_var, array_type);
-			} else {
-				auto value = node->expression_->result_var;
-				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(array_type, value, ir_var));
-			}
-		}
-		return;
-	}
-
-	/**** Handle Basic And Sturct Types ****/
-	auto value = std::make_shared<LocalVar>("", ir_type);
-	if (node->expression_) {
-		if (std::dynamic_pointer_cast<IRStructType>(ir_type) && node->expression_->is_assignable_) {
-			EmitStructCopy(current_block, entry_block, current_function, ir_var, node->expression_->result_var, ir_type);
-		} else {
-			if (node->expression_->is_assignable_) {
-				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, ir_type, node->expression_->result_var));
-			} else {
-				value = node->expression_->result_var;
-			}
-			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, value, ir_var));
-		}
-	}
-}
-
-void IRBuilder::visit(VisItemStatementNode *node) {
-    if (node -> vis_item_node_) {
-        node -> vis_item_node_ -> accept(this);
-    }
-}
-
-void IRBuilder::visit(ExpressionStatementNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void IRBuilder::visit(ExpressionNode *node) {
-}
-
-void IRBuilder::visit(ExpressionWithoutBlockNode *node) {
-}
-
-void IRBuilder::visit(ExpressionWithBlockNode *node) {
-}
-
-void IRBuilder::visit(ComparisonExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-	auto ir_bool_type = std::make_shared<IRIntegerType>(1);
-    auto compare_type = ir_manager_.GetIRType(node->rhs_->types[0]);
-    node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
-    auto lhs_value = std::make_shared<LocalVar>("", compare_type);
-    if (node->lhs_->is_assignable_) {
-    	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_value, compare_type, node->lhs_->result_var));
-    } else {
-    	lhs_value = node->lhs_->result_var;
-    }
-    auto rhs_value = std::make_shared<LocalVar>("", compare_type);
-    if (node->rhs_->is_assignable_) {
-    	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_value, compare_type, node->rhs_->result_var));
-    } else {
-    	rhs_value = node->rhs_->result_var;
-    }
-    if (node->type_ == TokenType::EqEq) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::eq));
-    } else if (node->type_ == TokenType::LEq) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sle));
-    } else if (node->type_ == TokenType::Lt) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::slt));
-    } else if (node->type_ == TokenType::GEq) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sge));
-    } else if (node->type_ == TokenType::Gt) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sgt));
-    } else if (node->type_ == TokenType::NEq) {
-    	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::ne));
-    }
-}
-
-void IRBuilder::visit(TypeCastExpressionNode *node) {
-    if (node->type_) {
-        node->type_->accept(this);
-    }
-	if (node->expression_) {
-		node->expression_->accept(this);
-		auto original_type = ir_manager_.GetIRType(node->expression_->types[0]);
-		auto cast_type = ir_manager_.GetIRType(node->types[0]);
-		node->result_var = std::make_shared<LocalVar>("", cast_type);
-
-		auto original_integer_type = std::dynamic_pointer_cast<IRIntegerType>(original_type);
-		auto cast_integer_type = std::dynamic_pointer_cast<IRIntegerType>(cast_type);
-		// only handle i1 to i32 cast for now
-		if (original_integer_type && cast_integer_type) {
-			if (original_integer_type->length == 1) {
-				auto origin_var = std::make_shared<LocalVar>("", original_type);
-				if (node->expression_->is_assignable_) {
-					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(origin_var, original_type, node->expression_->result_var));
-				} else {
-					origin_var = node->expression_->result_var;
-				}
-				current_block->instructions.emplace_back(std::make_shared<ZextInstruction>(node->result_var, original_type, origin_var, cast_type));
-			} else {
-				if (node->expression_->is_assignable_) {
-					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, original_type, node->expression_->result_var));
-				} else {
-					node->result_var = node->expression_->result_var;
-				}
-			}
-		}
-	}
-}
-
-void IRBuilder::visit(AssignmentExpressionNode *node) {
-    if (node->lhs_) {
-	    node->lhs_->accept(this);
-    }
-    if (node->rhs_) node->rhs_->accept(this);
-	auto ir_type = ir_manager_.GetIRType(node->lhs_->types[0]);
-
-	if (std::dynamic_pointer_cast<IRStructType>(ir_type) || std::dynamic_pointer_cast<IRArrayType>(ir_type)) {
-		if (auto array_literal = std::dynamic_pointer_cast<ArrayLiteralNode>(node->rhs_)) {
-			if (auto array_type = std::dynamic_pointer_cast<IRArrayType>(ir_type)) {
-				StoreArrayLiteral(node->rhs_, node->lhs_->result_var, array_type);
-				return;
-			}
-		}
-		if (node->rhs_->is_assignable_) {
-			EmitStructCopy(current_block, entry_block, current_function, node->lhs_->result_var, node->rhs_->result_var, ir_type);
-		} else {
-			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, node->rhs_->result_var, node->lhs_->result_var));
-		}
-		return;
-	}
-
-	auto ir_var = std::make_shared<LocalVar>("", ir_type);
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(ir_var, ir_type, node->rhs_->result_var));
-	} else {
-		ir_var = node->rhs_->result_var;
-	}
-	if (node->type_ == TokenType::PlusEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<AddInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::MinusEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<SubInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::MulEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<MulInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::DivEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		auto ir_integer_type = std::dynamic_pointer_cast<IRIntegerType>(ir_type);
-		if (ir_integer_type->is_signed) {
-			current_block->instructions.emplace_back(std::make_shared<SDivInstruction>(result_value, ir_type, left_value, ir_var));
-		} else {
-			current_block->instructions.emplace_back(std::make_shared<UDivInstruction>(result_value, ir_type, left_value, ir_var));
-		}
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::ModEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		auto ir_integer_type = std::dynamic_pointer_cast<IRIntegerType>(ir_type);
-		if (ir_integer_type->is_signed) {
-			current_block->instructions.emplace_back(std::make_shared<SremInstruction>(result_value, ir_type, left_value, ir_var));
-		} else {
-			current_block->instructions.emplace_back(std::make_shared<UremInstruction>(result_value, ir_type, left_value, ir_var));
-		}
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::SLEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<ShlInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::SREq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<AShrInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	if (node->type_ == TokenType::XorEq) {
-		auto left_value = std::make_shared<LocalVar>("", ir_type);
-		auto result_value = std::make_shared<LocalVar>("", ir_type);
-		if (node->lhs_->is_assignable_) {
-			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
-		} else {
-			left_value = node->lhs_->result_var;
-		}
-		current_block->instructions.emplace_back(std::make_shared<XorInstruction>(result_value, ir_type, left_value, ir_var));
-		ir_var = result_value;
-	}
-	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, ir_var, node->lhs_->result_var));
-}
-
-void IRBuilder::visit(ContinueExpressionNode *node) {
-	interrupt = true;
-	if (ir_manager_.current_loop_condition) {
-		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(ir_manager_.current_loop_condition->true_label));
-	}
-}
-
-void IRBuilder::visit(UnderscoreExpressionNode *node) {
-}
-
-void IRBuilder::visit(JumpExpressionNode *node) {
-    if (node->expression_) {
-        node->expression_->accept(this);
-    }
-	if (node->type_ == TokenType::Return) {
-		interrupt = true;
-		if (node->expression_) {
-			auto ret_type = ir_manager_.GetIRType(node->expression_->types[0]);
-			auto possible_struct_type = std::dynamic_pointer_cast<StructType>(node->expression_->types[0]);
-			auto value = std::make_shared<LocalVar>("", ret_type);
-			if (node->expression_->is_assignable_) {
-				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, ret_type, node->expression_->result_var));
-			} else {
-				value = node->expression_->result_var;
-			}
-			if (!possible_struct_type) {
-				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ret_type, value));
-			} else {
-				auto ir_ret_void_type = std::make_shared<IRVoidType>();
-				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ret_type, value, current_struct_ret_var));
-				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_ret_void_type, nullptr));
-			}
-		} else {
-			auto ret_type = std::make_shared<IRVoidType>();
-			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ret_type, nullptr));
-		}
-	}
-	if (node->type_ == TokenType::Break) {
-		interrupt = true;
-		if (ir_manager_.current_loop_combine) {
-			current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(ir_manager_.current_loop_combine->true_label));
-		}
-	}
-}
-
-void IRBuilder::visit(LogicOrExpressionNode *node) {
-	auto ir_bool_type = std::make_shared<IRIntegerType>(1);
-	node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
-	
-	std::shared_ptr<IRVar> result_ptr = std::make_shared<LocalVar>(".or_res", std::make_shared<IRPointerType>(ir_bool_type));
-	entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(result_ptr, ir_bool_type));
-
-	if (node->lhs_) node->lhs_->accept(this);
-	
-	std::shared_ptr<IRVar> lhs_val = std::make_shared<LocalVar>("", ir_bool_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_val, ir_bool_type, node->lhs_->result_var));
-	} else {
-		lhs_val = node->lhs_->result_var;
-	}
-	
-	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, lhs_val, result_ptr));
-	
-	auto rhs_block = std::make_shared<IRBasicBlock>("or_rhs");
-	auto end_block = std::make_shared<IRBasicBlock>("or_end");
-	
-	current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(lhs_val, end_block->true_label, rhs_block->true_label));
-	
-	current_function->blocks.emplace_back(rhs_block);
-	current_block = rhs_block;
-	
-	if (node->rhs_) node->rhs_->accept(this);
-	
-	std::shared_ptr<IRVar> rhs_val = std::make_shared<LocalVar>("", ir_bool_type);
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_val, ir_bool_type, node->rhs_->result_var));
-	} else {
-		rhs_val = node->rhs_->result_var;
-	}
-	
-	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, rhs_val, result_ptr));
-	current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(end_block->true_label));
-	
-	current_function->blocks.emplace_back(end_block);
-	current_block = end_block;
-	
-	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_bool_type, result_ptr));
-}
-
-void IRBuilder::visit(LogicAndExpressionNode *node) {
-	auto ir_bool_type = std::make_shared<IRIntegerType>(1);
-	node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
-	
-	std::shared_ptr<IRVar> result_ptr = std::make_shared<LocalVar>(".and_res", std::make_shared<IRPointerType>(ir_bool_type));
-	entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(result_ptr, ir_bool_type));
-
-	if (node->lhs_) node->lhs_->accept(this);
-	
-	std::shared_ptr<IRVar> lhs_val = std::make_shared<LocalVar>("", ir_bool_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_val, ir_bool_type, node->lhs_->result_var));
-	} else {
-		lhs_val = node->lhs_->result_var;
-	}
-	
-	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, lhs_val, result_ptr));
-	
-	auto rhs_block = std::make_shared<IRBasicBlock>("and_rhs");
-	auto end_block = std::make_shared<IRBasicBlock>("and_end");
-	
-	current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(lhs_val, rhs_block->true_label, end_block->true_label));
-	
-	current_function->blocks.emplace_back(rhs_block);
-	current_block = rhs_block;
-	
-	if (node->rhs_) node->rhs_->accept(this);
-	
-	std::shared_ptr<IRVar> rhs_val = std::make_shared<LocalVar>("", ir_bool_type);
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_val, ir_bool_type, node->rhs_->result_var));
-	} else {
-		rhs_val = node->rhs_->result_var;
-	}
-	
-	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, rhs_val, result_ptr));
-	current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(end_block->true_label));
-	
-	current_function->blocks.emplace_back(end_block);
-	current_block = end_block;
-	
-	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_bool_type, result_ptr));
-}
-
-void IRBuilder::visit(BitwiseOrExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
-	auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
-	auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
-	} else {
-		left_value = node->lhs_->result_var;
-	}
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
-	} else {
-		right_value = node->rhs_->result_var;
-	}
-	current_block->instructions.emplace_back(std::make_shared<OrInstruction>(node->result_var, ir_i32_type, left_value, right_value));
-}
-
-void IRBuilder::visit(BitwiseXorExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-	if (node->rhs_) node->rhs_->accept(this);
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
-	auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
-	auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
-	} else {
-		left_value = node->lhs_->result_var;
-	}
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
-	} else {
-		right_value = node->rhs_->result_var;
-	}
-	current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i32_type, left_value, right_value));
-}
-
-void IRBuilder::visit(BitwiseAndExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
-	auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
-	auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
-	} else {
-		left_value = node->lhs_->result_var;
-	}
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
-	} else {
-		right_value = node->rhs_->result_var;
-	}
-	current_block->instructions.emplace_back(std::make_shared<AndInstruction>(node->result_var, ir_i32_type, left_value, right_value));
-}
-
-void IRBuilder::visit(ShiftExpressionNode *node) {
-    if (node->lhs_) { node->lhs_->accept(this); }
-    if (node->rhs_) { node->rhs_->accept(this); }
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
-	auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
-	auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
-	if (node->lhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
-	} else {
-		left_value = node->lhs_->result_var;
-	}
-	if (node->rhs_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
-	} else {
-		right_value = node->rhs_->result_var;
-	}
-	if (node->type_ == TokenType::SL) {
-		current_block->instructions.emplace_back(std::make_shared<ShlInstruction>(node->result_var, ir_i32_type, left_value, right_value));
-	} else if (node->type_ == TokenType::SR) {
-		current_block->instructions.emplace_back(std::make_shared<AShrInstruction>(node->result_var, ir_i32_type, left_value, right_value));
-	}
-}
-
-void IRBuilder::visit(AddMinusExpressionNode *node) {
-	auto ir_type = ir_manager_.GetIRType(node->types[0]);
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-	auto l_value = std::make_shared<LocalVar>("", ir_type);
-	auto r_value = std::make_shared<LocalVar>("", ir_type);
-	node->result_var = std::make_shared<LocalVar>("", ir_type);
-	if (node->type_ == TokenType::Plus) {
-		if (node->lhs_->is_assignable_) {
-			auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_l);
-		} else {
-			l_value = node->lhs_->result_var;
-		}
-		if (node->rhs_->is_assignable_) {
-			auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_r);
-		} else {
-			r_value = node->rhs_->result_var;
-		}
-		auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_type, l_value, r_value);
-		current_block->instructions.emplace_back(add_instruction);
-	} else if (node->type_ == TokenType::Minus) {
-		if (node->lhs_->is_assignable_) {
-			auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_l);
-		} else {
-			l_value = node->lhs_->result_var;
-		}
-		if (node->rhs_->is_assignable_) {
-			auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_r);
-		} else {
-			r_value = node->rhs_->result_var;
-		}
-		auto sub_instruction = std::make_shared<SubInstruction>(node->result_var, ir_type, l_value, r_value);
-		current_block->instructions.emplace_back(sub_instruction);
-	}
-}
-
-void IRBuilder::visit(MulDivModExpressionNode *node) {
-    auto ir_type = ir_manager_.GetIRType(node->types[0]);
-	auto result_value = std::make_shared<LocalVar>("", ir_type);
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-	auto l_value = std::make_shared<LocalVar>("", ir_type);
-	auto r_value = std::make_shared<LocalVar>("", ir_type);
-	node->result_var = std::make_shared<LocalVar>("", ir_type);
-	if (node->type_ == TokenType::Mul) {
-		if (node->lhs_->is_assignable_) {
-			auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_l);
-		} else {
-			l_value = node->lhs_->result_var;
-		}
-		if (node->rhs_->is_assignable_) {
-			auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_r);
-		} else {
-			r_value = node->rhs_->result_var;
-		}
-		auto mul_instruction = std::make_shared<MulInstruction>(node->result_var, ir_type, l_value, r_value);
-		current_block->instructions.emplace_back(mul_instruction);
-	} else if (node->type_ == TokenType::Div) {
-		if (node->lhs_->is_assignable_) {
-			auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_l);
-		} else {
-			l_value = node->lhs_->result_var;
-		}
-		if (node->rhs_->is_assignable_) {
-			auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_r);
-		} else {
-			r_value = node->rhs_->result_var;
-		}
-		auto ir_integer_type = std::dynamic_pointer_cast<IRIntegerType>(ir_type);
-		if (ir_integer_type->is_signed) {
-			auto sdiv_instruction = std::make_shared<SDivInstruction>(node->result_var, ir_type, l_value, r_value);
-			current_block->instructions.emplace_back(sdiv_instruction);
-		} else {
-			auto udiv_instruction = std::make_shared<UDivInstruction>(node->result_var, ir_type, l_value, r_value);
-			current_block->instructions.emplace_back(udiv_instruction);
-		}
-	} else if (node->type_ == TokenType::MOD) {
-		if (node->lhs_->is_assignable_) {
-			auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_l);
-		} else {
-			l_value = node->lhs_->result_var;
-		}
-		if (node->rhs_->is_assignable_) {
-			auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
-			current_block->instructions.emplace_back(load_instruction_r);
-		} else {
-			r_value = node->rhs_->result_var;
-		}
-		auto ir_integer_type = std::dynamic_pointer_cast<IRIntegerType>(ir_type);
-		if (ir_integer_type->is_signed) {
-			auto srem_instruction = std::make_shared<SremInstruction>(node->result_var, ir_type, l_value, r_value);
-			current_block->instructions.emplace_back(srem_instruction);
-		} else {
-			auto urem_instruction = std::make_shared<UremInstruction>(node->result_var, ir_type, l_value, r_value);
-			current_block->instructions.emplace_back(urem_instruction);
-		}
-	}
-}
-
-void IRBuilder::visit(UnaryExpressionNode *node) {
-    if (node->expression_) {
-        node->expression_->accept(this);
-    	auto value_type = ir_manager_.GetIRType(node->expression_->types[0]);
-        if (node->type_ == TokenType::Minus) {
-        	node->result_var = std::make_shared<LocalVar>("", value_type);
-            auto value = std::make_shared<LocalVar>("", value_type);
-        	if (node->expression_->is_assignable_) {
-        		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, value_type, node->expression_->result_var));
-        	} else {
-        		value = node->expression_->result_var;
-        	}
-        	current_block->instructions.emplace_back(std::make_shared<SubInstruction>(node->result_var, value_type, value));
-        }
-    	if (node->type_ == TokenType::Mul) {
-    		node->result_var = std::make_shared<LocalVar>("", value_type);
-    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, value_type, node->expression_->result_var));
-    	}
-    	if (node->type_ == TokenType::And || node->type_ == TokenType::AndMut) {
-    		node->result_var = node->expression_->result_var;
-    	}
-    	if (node->type_ == TokenType::Not) {
-    		node->result_var = std::make_shared<LocalVar>("", value_type);
-    		auto value = std::make_shared<LocalVar>("", value_type);
-    		if (node->expression_->is_assignable_) {
-    			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, value_type, node->expression_->result_var));
-    		} else {
-    			value = node->expression_->result_var;
-    		}
-			auto ir_integer_type = std::dynamic_pointer_cast<IRIntegerType>(value_type);
-			if (ir_integer_type && ir_integer_type->length == 1) {
-				auto ir_i1_type = value_type;
-				auto bool_value = std::make_shared<LocalVar>("", ir_i1_type);
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(bool_value, ir_i1_type, 1, 0));
-				current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i1_type, value, bool_value));
-			} else if (ir_integer_type && ir_integer_type->length == 32) {
-				auto ir_i32_type = value_type;
-				auto all_ones_value = std::make_shared<LocalVar>("", ir_i32_type);
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(all_ones_value, ir_i32_type, 4294967295, 0));
-				current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i32_type, value, all_ones_value));
-			}
-    	}
-    }
-}
-
-void IRBuilder::visit(FunctionCallExpressionNode *node) {
-	std::shared_ptr<FunctionType> function_type = nullptr;
-	std::string function_name; // We now only consider basic function call.
-	std::vector<std::shared_ptr<IRVar>> args;
-	std::vector<std::shared_ptr<IRType>> arg_types;
-    if (node->callee_) {
-        node->callee_->accept(this);
-    	function_type = std::dynamic_pointer_cast<FunctionType>(node->callee_->types[0]);
-        if (auto identifier_pattern = std::dynamic_pointer_cast<PathInExpressionNode>(node->callee_)) {
-        	auto len = identifier_pattern->path_indent_segments_.size();
-        	if (len == 1) {
-        		function_name = identifier_pattern->path_indent_segments_[0]->identifier_;
-        	} else {
-        		function_name = identifier_pattern->path_indent_segments_[0]->identifier_ + "." +
-        			identifier_pattern->path_indent_segments_[1]->identifier_;
-        	}
-    	}
-        if (auto method_expression = std::dynamic_pointer_cast<MemberAccessExpressionNode>(node->callee_)) {
-    		auto semantic_base_type = method_expression->base_->types[0];
-    		auto ir_base_type = ir_manager_.GetIRType(method_expression->base_->types[0]);
-    		if (ir_base_type) {
-    			auto ir_struct_type = std::dynamic_pointer_cast<IRStructType>(ir_base_type);
-    			auto ir_pointer_type = std::dynamic_pointer_cast<IRPointerType>(ir_base_type);
-    			if (ir_pointer_type) {
-    				ir_struct_type = std::dynamic_pointer_cast<IRStructType>(ir_pointer_type->baseType); // auto deref
-    			}
-    			if (ir_struct_type) {
-    				function_name = ir_struct_type->name + "." + method_expression->member_.token;
-    			}
-    		}
-        	if (function_type->have_self_) {
-        		auto ir_pointer_type = std::dynamic_pointer_cast<IRPointerType>(ir_base_type);
-        		std::shared_ptr<IRType> self_type;
-        		if (ir_pointer_type) {
-        			self_type = ir_base_type;
-        		} else {
-        			self_type = std::make_shared<IRPointerType>(ir_base_type);
-        		}
-        		auto self_var = std::make_shared<LocalVar>("", self_type);
-        		if (!method_expression->base_->is_assignable_) {
-        			if (ir_pointer_type) {
-        				self_var = method_expression->base_->result_var;
-        			} else {
-        				current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(self_var, ir_base_type));
-        				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_base_type, method_expression->base_->result_var, self_var));
-        			}
-        		} else {
-        			if (ir_pointer_type) {
-        				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(self_var, self_type, method_expression->base_->result_var));
-        			} else {
-        				self_var = method_expression->base_->result_var;
-        			}
-        		}
-        		args.emplace_back(self_var);
-        		arg_types.emplace_back(self_type);
-        	}
-    	}
-    }
-	uint32_t index = 0;
-    for (const auto &param: node->params_) {
-    	auto ir_type = ir_manager_.GetIRType(function_type->params_[index]);
-        if (param) {
-            param->accept(this);
-        	auto ir_var = std::make_shared<LocalVar>("", ir_type);
-        	if (param->is_assignable_) {
-        		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(ir_var, ir_type, param->result_var));
-        	} else {
-        		ir_var = param->result_var;
-        	}
-        	args.emplace_back(ir_var);
-        	arg_types.emplace_back(ir_type);
-        }
-    	++index;
-    }
-	if (function_type->ret_) {
-		// Check Struct Type
-		bool is_struct_ret_type = false;
-		if (auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_)) {
-			auto ir_struct_type = ir_manager_.GetIRType(function_type->ret_);
-			auto ir_ret_param_type = std::make_shared<IRPointerType>(ir_struct_type);
-			auto ir_ret_param = std::make_shared<LocalVar>(".ret", ir_ret_param_type);
-			current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(ir_ret_param, ir_struct_type));
-			args.insert(args.begin(), ir_ret_param);
-			arg_types.insert(arg_types.begin(), ir_ret_param_type);
-			is_struct_ret_type = true;
-		}
-		auto semantic_void_type = scope_manager_.lookup("void").type_;
-		auto ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
-		if (function_type->ret_->equal(semantic_void_type)) {
-			current_block->instructions.emplace_back(std::make_shared<CallWithoutRetInstruction>(function_name, args, arg_types));
-		} else if (is_struct_ret_type) {
-			node->is_assignable_ = true;
-			node->result_var = std::dynamic_pointer_cast<LocalVar>(args[0]);
-			current_block->instructions.emplace_back(std::make_shared<CallWithoutRetInstruction>(function_name, args, arg_types));
-		} else {
-			node->result_var = std::make_shared<LocalVar>("", ir_ret_type);
-			current_block->instructions.emplace_back(std::make_shared<CallWithRetInstruction>(node->result_var, ir_ret_type, function_name, args, arg_types));
-		}
-	}
-}
-
-void IRBuilder::visit(ArrayIndexExpressionNode *node) {
-	node->is_assignable_ = true;
-	if (node->base_) {
-		node->base_->accept(this);
-	}
-	if (node->index_) {
-		node->index_->accept(this);
-	}
-    std::shared_ptr<IRArrayType> type;
-	auto ir_type = ir_manager_.GetIRType(node->types[0]);
-	auto node_base_type = ir_manager_.GetIRType(node->base_->types[0]);
-
-	// Consider auto_deref
-	std::shared_ptr<LocalVar> prev_var = node->base_->result_var;
-	std::shared_ptr<LocalVar> re_var = prev_var;
-	for (uint32_t i = 0; i < node->auto_deref_count; i++) {
-		auto base_type = std::dynamic_pointer_cast<IRPointerType>(prev_var->type);
-		re_var = std::make_shared<LocalVar>("", base_type->baseType);
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(re_var, base_type, prev_var));
-		prev_var = re_var;
-	}
-
-	node->result_var = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(ir_type));
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-
-	auto index_var = std::make_shared<LocalVar>("", ir_i32_type);
-	if (node->index_->is_assignable_) {
-		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(index_var, ir_i32_type, node->index_->result_var));
-	} else {
-		index_var = node->index_->result_var;
-	}
-
-	// Fix: Check if base type is a pointer to an array
-	// If so, we need a leading 0 index for correct LLVM IR semantics
-	auto ptr_type = std::dynamic_pointer_cast<IRPointerType>(re_var->type);
-	bool need_leading_zero = false;
-	std::shared_ptr<IRType> gep_base_type = ir_type;
-
-	if (ptr_type && std::dynamic_pointer_cast<IRArrayType>(ptr_type->baseType)) {
-		// The base is a pointer to an array, need leading zero
-		need_leading_zero = true;
-		gep_base_type = ptr_type->baseType;
-	}
-
-	if (need_leading_zero) {
-		// Use two indices: [0, index]
-		std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type, ir_i32_type});
-		auto zero_var = std::make_shared<LocalVar>("", ir_i32_type);
-		current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_var, ir_i32_type, 0, 0));
-		std::vector<std::shared_ptr<IRVar>> index_value({zero_var, index_var});
-		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var, gep_base_type, re_var, index_type, index_value));
-	} else {
-		// Use single index
-		std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type});
-		std::vector<std::shared_ptr<IRVar>> index_value({index_var});
-		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var, ir_type, re_var, index_type, index_value));
-	}
-}
-
-void IRBuilder::visit(MemberAccessExpressionNode *node) {
-	node->is_assignable_ = true;
-    if (node->base_) {
-        node->base_->accept(this);
-    }
-	auto type = node->base_->types[0];
-	std::string identifier = node->member_.token;
-	// consider auto-deref
-	auto struct_type = std::dynamic_pointer_cast<StructType>(type);
-	auto pointer_type = std::dynamic_pointer_cast<ReferenceType>(type);
-	if (pointer_type) {
-		struct_type = std::dynamic_pointer_cast<StructType>(pointer_type->type_);
-	}
-	if (struct_type) {
-		for (uint32_t i = 0; i < struct_type->members_.size(); i++) {
-			if (struct_type->members_[i].name_ == identifier) {
-				auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-				auto ir_type = ir_manager_.GetIRType(struct_type->members_[i].type_);
-				// Fix: use two indices [0, field_index] for correct struct field access
-				std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type, ir_i32_type});
-				std::vector<std::shared_ptr<IRLiteral>> index_value({std::make_shared<LiteralInt>(0), std::make_shared<LiteralInt>(i)});
-				node->result_var = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(ir_type));
-				// Fix: use struct type instead of field type as the base type
-				auto ir_struct_type = ir_manager_.GetIRType(struct_type);
-				auto base_val = node->base_->result_var;
-				if (pointer_type && node->base_->is_assignable_) {
-					auto loaded_base = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(ir_struct_type));
-					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(loaded_base, std::make_shared<IRPointerType>(ir_struct_type), node->base_->result_var));
-					base_val = loaded_base;
-				}
-				current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var,
-					ir_struct_type, base_val, index_type, index_value));
-			}
-		}
-	}
-}
-
-void IRBuilder::visit(BlockExpressionNode *node) {
-    scope_manager_.current_scope = scope_manager_.scope_set_[node->scope_index];
-
-	if (node->statements_) {
-		for (const auto& item: node->statements_->statements_) {
-			auto vis_item = std::dynamic_pointer_cast<VisItemStatementNode>(item);
-			if (!vis_item) { continue; }
-			auto const_item = std::dynamic_pointer_cast<ConstantItemNode>(vis_item->vis_item_node_);
-			if (const_item) {
-				auto const_var = std::make_shared<ConstVar>(const_item->identifier_, std::make_shared<IRIntegerType>(32));
-				auto val = std::get_if<int64_t>(&const_item->expression_node_->value);
-				if (val) {
-					auto ir_literal = std::make_shared<LiteralInt>(*val);
-					ir_program->constants.emplace_back(std::make_shared<ConstVarDefInstruction>(const_var, ir_literal));
-				}
-			}
-		}
-
-		for (const auto& item: node->statements_->statements_) {
-			auto vis_item = std::dynamic_pointer_cast<VisItemStatementNode>(item);
-			if (!vis_item) { continue; }
-			auto struct_item = std::dynamic_pointer_cast<StructNode>(vis_item->vis_item_node_);
-			if (struct_item) {
-				auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
-				ir_manager_.AddType(struct_type);
-			}
-		}
-	}
-
-	auto ir_type = ir_manager_.GetIRType(node->types[0]);
-	bool is_aggregate = std::dynamic_pointer_cast<IRStructType>(ir_type) || std::dynamic_pointer_cast<IRArrayType>(ir_type);
-	if (is_aggregate) {
-		node->result_var = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(ir_type));
-		node->is_assignable_ = true;
-	} else {
-		node->result_var = std::make_shared<LocalVar>("", ir_type);
-	}
-
-	if (node->statements_) {
-        node->statements_->accept(this);
-		std::shared_ptr<ExpressionNode> trailing_expression = nullptr;
-		if (node->statements_->expression_) {
-			trailing_expression = node->statements_->expression_;
-		} else if (!node->statements_->statements_.empty()){
-			uint32_t len = node->statements_->statements_.size();
-			auto trailing_statement = std::dynamic_pointer_cast<ExpressionStatementNode>(node->statements_->statements_[len - 1]);
-			if (trailing_statement && !trailing_statement->has_semicolon_) {
-				trailing_expression = trailing_statement->expression_;
-			}
-		}
-		if (trailing_expression) {
-			if (trailing_expression->is_assignable_) {
-				if (is_aggregate) {
-					node->result_var = trailing_expression->result_var;
-				} else {
-					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_type, trailing_expression->result_var));
-				}
-			} else {
-				node->result_var = trailing_expression->result_var;
-			}
-		}
-    }
-	if (node->is_function_direct_block && ir_type) {
-		auto ir_void_type = std::dynamic_pointer_cast<IRVoidType>(ir_type);
-		auto ir_struct_type = std::dynamic_pointer_cast<IRStructType>(ir_type);
-		if (ir_void_type) {
-			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, nullptr));
-		} else if (ir_struct_type) {
-			auto ir_ret_void_type = std::make_shared<IRVoidType>();
-			std::shared_ptr<ExpressionNode> trailing_expression = nullptr;
-			if (node->statements_) {
-				if (node->statements_->expression_) {
-					trailing_expression = node->statements_->expression_;
-				} else if (!node->statements_->statements_.empty()){
-					uint32_t len = node->statements_->statements_.size();
-					auto trailing_statement = std::dynamic_pointer_cast<ExpressionStatementNode>(node->statements_->statements_[len - 1]);
-					if (trailing_statement && !trailing_statement->has_semicolon_) {
-						trailing_expression = trailing_statement->expression_;
-					}
-				}
-			}
-			if (trailing_expression && trailing_expression->is_assignable_) {
-				EmitStructCopy(current_block, entry_block, current_function, current_struct_ret_var, trailing_expression->result_var, ir_struct_type);
-			} else {
-				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, node->result_var, current_struct_ret_var));
-			}
-			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_ret_void_type, nullptr));
-		} else {
-			if (std::dynamic_pointer_cast<IRArrayType>(ir_type) && node->is_assignable_) {
-				auto val = std::make_shared<LocalVar>("", ir_type);
-				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(val, ir_type, node->result_var));
-				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, val));
-			} else {
-				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, node->result_var));
-			}
-		}
-	}
-
-
-	if (node->statements_) {
-		for (const auto& item: node->statements_->statements_) {
-			auto vis_item = std::dynamic_pointer_cast<VisItemStatementNode>(item);
-			if (!vis_item) { continue; }
-			auto struct_item = std::dynamic_pointer_cast<StructNode>(vis_item->vis_item_node_);
-			if (struct_item) {
-				auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
-				ir_manager_.AddType(struct_type);
-				auto ir_struct_type = std::dynamic_pointer_cast<IRStructType>(ir_manager_.GetIRType(struct_type));
-				ir_program->structs.emplace_back(std::make_shared<StructDefInstruction>(ir_struct_type, ir_struct_type->members));
-
-				for (auto& method : struct_type->methods_) {
-					auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
-					std::vector<IRFunctionParam> ir_function_params;
-					if (function_type) {
-						std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-						auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
-						if (possible_struct_type) {
-							method.function_node_->is_struct_type = true;
-							auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(function_type->ret_));
-							method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-							ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
-						} else {
-							ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
-						}
-						if (function_type->have_self_) {
-							auto ir_pointer_struct_type = std::make_shared<IRPointerType>(ir_struct_type);
-							auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
-							ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
-						}
-						uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
-						for (auto& param: function_type->params_) {
-							auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
-							auto param_type = ir_manager_.GetIRType(param);
-							auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
-							if (identifier_pattern) {
-								std::string identifier = identifier_pattern->identifier_;
-								auto ir_var = std::make_shared<LocalVar>(identifier, param_type);
-								ir_function_params.emplace_back(param_type, ir_var);
-							}
-							++index;
-						}
-						std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
-						auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
-						ir_program->functions.emplace_back(ir_function);
-						ir_manager_.function_map_[ir_identifier] = ir_function;
-						method.function_node_->identifier_ = ir_identifier;
-						method.function_node_->accept(this);
-					}
-				}
-				for (auto& method : struct_type->inline_functions_) {
-					auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
-					std::vector<IRFunctionParam> ir_function_params;
-					if (function_type) {
-						std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-						if (function_type->ret_) {
-							auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
-							if (possible_struct_type) {
-								method.function_node_->is_struct_type = true;
-								auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(function_type->ret_));
-								method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-								ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
-							} else {
-								ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
-							}
-						}
-						if (function_type->have_self_) {
-							auto ir_pointer_struct_type = std::make_shared<IRPointerType>(ir_struct_type);
-							auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
-							ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
-						}
-						uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
-						for (auto& param: function_type->params_) {
-							auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
-							auto param_type = ir_manager_.GetIRType(param);
-							auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
-							if (identifier_pattern) {
-								std::string identifier = identifier_pattern->identifier_;
-								auto ir_var = std::make_shared<LocalVar>(identifier, param_type);
-								ir_function_params.emplace_back(param_type, ir_var);
-							}
-							++index;
-						}
-						std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
-						auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
-						ir_program->functions.emplace_back(ir_function);
-						ir_manager_.function_map_[ir_identifier] = ir_function;
-						method.function_node_->identifier_ = ir_identifier;
-						method.function_node_->accept(this);
-					}
-				}
-			}
-		}
-
-		for (const auto& item: node->statements_->statements_) {
-			auto vis_item = std::dynamic_pointer_cast<VisItemStatementNode>(item);
-			if (!vis_item) { continue; }
-			auto func_item = std::dynamic_pointer_cast<FunctionNode>(vis_item->vis_item_node_);
-			if (func_item) {
-				std::vector<IRFunctionParam> ir_function_params;
-				std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
-				if (func_item->type_) {
-					auto semantic_ret_type = func_item->type_->type;
-					auto possible_struct_type = std::dynamic_pointer_cast<StructType>(semantic_ret_type);
-					if (possible_struct_type) {
-						func_item->is_struct_type = true;
-						auto pointer_type = std::make_shared<IRPointerType>(ir_manager_.GetIRType(semantic_ret_type));
-						func_item->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
-						ir_function_params.emplace_back(pointer_type, func_item->struct_ret_var);
-					} else {
-						ir_ret_type = ir_manager_.GetIRType(semantic_ret_type);
-					}
-				}
-				auto parameters = func_item->function_parameters_;
-				if (parameters) {
-					for (auto& param : parameters->function_params_) {
-						auto param_type = ir_manager_.GetIRType(param->type_->type);
-						auto identifier_pattern = std::dynamic_pointer_cast<IdentifierPatternNode>(param->pattern_no_top_alt_node_);
-						auto ir_var = std::make_shared<LocalVar>(identifier_pattern->identifier_, param_type);
-						ir_function_params.emplace_back(param_type, ir_var);
-					}
-				}
-				auto ir_function = std::make_shared<IRFunction>(func_item->identifier_, ir_ret_type, ir_function_params);
-				ir_program->functions.emplace_back(ir_function);
-				ir_manager_.function_map_[func_item->identifier_] = ir_function;
-				item->accept(this);
-			}
-		}
-	}
-
-    scope_manager_.PopScope();
-}
-
-void IRBuilder::visit(LoopExpressionNode *node) {
-}
-
-void IRBuilder::visit(InfiniteLoopExpressionNode *node) {
-    if (node->block_expression_) {
-        node->block_expression_->accept(this);
-    }
-}
-
-void IRBuilder::visit(PredicateLoopExpressionNode *node) {
-	auto condition_block = std::make_shared<IRBasicBlock>("condition");
-	auto body_block = std::make_shared<IRBasicBlock>("body");
-	auto combine_block = std::make_shared<IRBasicBlock>("combine");
-	auto saved_current_loop_condition = ir_manager_.current_loop_condition;
-	auto saved_current_loop_combine = ir_manager_.current_loop_combine;
-	ir_manager_.current_loop_condition = condition_block;
-	ir_manager_.current_loop_combine = combine_block;
-	if (node->conditions_) {
-		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(condition_block->true_label));
-		current_function->blocks.emplace_back(condition_block);
-		current_block = condition_block;
-		node->conditions_->accept(this);
-
-		auto condition_expr = node->conditions_->expression_;
-    	auto condition_var = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
-    	if (condition_expr->is_assignable_) {
-    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(condition_var, std::make_shared<IRIntegerType>(1), condition_expr->result_var));
-    	} else {
-    		condition_var = condition_expr->result_var;
-    	}
-
-		auto long_branch_exit = std::make_shared<IRBasicBlock>("long_branch_exit");
-		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(
-			condition_var, body_block->true_label, long_branch_exit->true_label));
-		current_function->blocks.emplace_back(long_branch_exit);
-		long_branch_exit->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
-	}
-	if (node->block_expression_) {
-		current_function->blocks.emplace_back(body_block);
-		current_block = body_block;
-		node->block_expression_->accept(this);
-		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(condition_block->true_label));
-	}
-	current_function->blocks.emplace_back(combine_block);
-	current_block = combine_block;
-	ir_manager_.current_loop_condition = saved_current_loop_condition;
-	ir_manager_.current_loop_combine = saved_current_loop_combine;
-}
-
-void IRBuilder::visit(IfExpressionNode *node) {
-	auto if_true_block = std::make_shared<IRBasicBlock>("if_true");
-	auto if_false_block = std::make_shared<IRBasicBlock>("if_false");
-	auto combine_block = std::make_shared<IRBasicBlock>("combine");
-	interrupt = false;
-    if (node->conditions_) {
-	    node->conditions_->accept(this);
-    	auto condition_expr = node->conditions_->expression_;
-    	auto condition_var = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
-    	if (condition_expr->is_assignable_) {
-    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(condition_var, std::make_shared<IRIntegerType>(1), condition_expr->result_var));
-    	} else {
-    		condition_var = condition_expr->result_var;
-    	}
-    	if (condition_expr) {
-			auto long_branch_false = std::make_shared<IRBasicBlock>("long_branch_false");
-    		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(condition_var, if_true_block->true_label, long_branch_false->true_label));
-			current_function->blocks.emplace_back(long_branch_false);
-			long_branch_false->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(if_false_block->true_label));
-    	}
-    }
-
-	std::shared_ptr<IRBasicBlock> phi_block_1 = nullptr, phi_block_2 = nullptr;
-	bool true_branch_interrupted = false;
-	bool false_branch_interrupted = false;
-
-	current_function->blocks.emplace_back(if_true_block);
-	current_block = if_true_block;
-    if (node->true_block_expression_) {
-	    node->true_block_expression_->accept(this);
-    	if (!interrupt) {
-    		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
-    	} else {
-    		true_branch_interrupted = true;
-    	}
-    	interrupt = false;
-    	phi_block_1 = current_block;
-    }
-	current_function->blocks.emplace_back(if_false_block);
-	current_block = if_false_block;
-	if (node->false_block_expression_) {
-		node->false_block_expression_->accept(this);
-	}
-    if (node->if_expression_) {
-	    node->if_expression_->accept(this);
-	}
-	if (!interrupt) {
-		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
-	} else {
-		false_branch_interrupted = true;
-		interrupt = false;
-	}
-	phi_block_2 = current_block;
-	current_function->blocks.emplace_back(combine_block);
-	current_block = combine_block;
-
-	if (true_branch_interrupted && false_branch_interrupted) {
-		current_block->instructions.emplace_back(std::make_shared<UnreachableInstruction>());
-		interrupt = true;
-	}
-
-	if (node->false_block_expression_) {
-		if (node->true_block_expression_->result_var && node->false_block_expression_->result_var) {
-			std::shared_ptr<IRVar> true_value = node->true_block_expression_->result_var;
-			std::shared_ptr<IRVar> false_value = node->false_block_expression_->result_var;
-			auto ir_type = ir_manager_.GetIRType(node->types[0]);
-			if (ir_type && !std::dynamic_pointer_cast<IRVoidType>(ir_type)) {
-				if (std::dynamic_pointer_cast<IRStructType>(ir_type) || std::dynamic_pointer_cast<IRArrayType>(ir_type)) {
-					ir_type = std::make_shared<IRPointerType>(ir_type);
-					node->is_assignable_ = true;
-				}
-				node->result_var = std::make_shared<LocalVar>("", ir_type);
-				std::vector value_table{true_value, false_value};
-				current_block->instructions.emplace_back(std::make_shared<PhiInstruction>(node->result_var, ir_type,
-					value_table, std::vector{phi_block_1->true_label, phi_block_2->true_label}));
-			}
-		}
-	}
-	if (node->if_expression_) {
-		if (node->true_block_expression_->result_var && node->if_expression_->result_var) {
-			std::shared_ptr<IRVar> true_value = node->true_block_expression_->result_var;
-			std::shared_ptr<IRVar> false_value = node->if_expression_->result_var;
-			auto ir_type = ir_manager_.GetIRType(node->types[0]);
-			if (ir_type) {
-				if (std::dynamic_pointer_cast<IRStructType>(ir_type) || std::dynamic_pointer_cast<IRArrayType>(ir_type)) {
-					ir_type = std::make_shared<IRPointerType>(ir_type);
-					node->is_assignable_ = true;
-				}
-				node->result_var = std::make_shared<LocalVar>("", ir_type);
-				std::vector value_table{true_value, false_value};
-				current_block->instructions.emplace_back(std::make_shared<PhiInstruction>(node->result_var, ir_type,
-					value_table, std::vector{phi_block_1->true_label, phi_block_2->true_label}));
-			}
-		}
-	}
-}
-
-void IRBuilder::visit(MatchExpressionNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-    if (node->match_arms_) node->match_arms_->accept(this);
-}
-
-void IRBuilder::visit(LiteralExpressionNode *node) {
-}
-
-void IRBuilder::visit(CharLiteralNode *node) {
-    node -> is_compiler_known_ = true;
-}
-
-void IRBuilder::visit(StringLiteralNode *node) {
-    node->is_compiler_known_ = true;
-    node->value = node->string_literal_;
-}
-
-void IRBuilder::visit(CStringLiteralNode *node) {
-    node->is_compiler_known_ = true;
-    node->value = node->c_string_literal_;
-}
-
-void IRBuilder::visit(IntLiteralNode *node) {
-    node->value = node->int_literal_;
-	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
-	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
-	auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_i32_type, node->int_literal_, 0);
-	current_block->instructions.emplace_back(add_instruction);
-}
-
-void IRBuilder::visit(BoolLiteralNode *node) {
-	node->value = node->bool_literal_;
-	auto ir_i1_type = std::make_shared<IRIntegerType>(1);
-	node->result_var = std::make_shared<LocalVar>("", ir_i1_type);
-	auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_i1_type, node->bool_literal_, 0);
-	current_block->instructions.emplace_back(add_instruction);
-}
-
-void IRBuilder::visit(ArrayLiteralNode *node) {
-	node->is_assignable_ = true;
-	for (const auto &expr: node->expressions_) {
-        if (expr) {
-            expr->accept(this);
-        }
-    }
-	if (node->lhs_) {
-		node->lhs_->accept(this);
-	}
-	auto ir_type = ir_manager_.GetIRType(node->types[0]);
-	node->result_var = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(ir_type));
-	current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(node->result_var, ir_type));
-	auto ir_array_type = std::dynamic_pointer_cast<IRArrayType>(ir_type);
-	StoreArrayLiteral(std::make_shared<ArrayLiteralNode>(*node), node->result_var, ir_array_type);
-}
-
-void IRBuilder::visit(PathExpressionNode *node) {
-}
-
-void IRBuilder::visit(PathInExpressionNode *node) {
-    for (const auto &seg: node->path_indent_segments_) {
-        if (seg) seg->accept(this);
-    }
-    uint32_t len = node -> path_indent_segments_.size();
-    if (len == 2) {
-        std::string type_name = node -> path_indent_segments_[0]->identifier_;
-        std::string func_name = node -> path_indent_segments_[1]->identifier_;
-        Symbol symbol = scope_manager_.lookup(type_name);
-        for (auto& it: symbol.type_ -> constants_) {
-            if (it.name_ == func_name) {
-                node -> is_compiler_known_ = true;
-                auto value = symbol.type_->value_map[it.name_];
-                if (auto* tmp = std::get_if<int64_t>(&value)) {
-                    node -> value = *tmp;
-                }
-                return;
-            }
-        }
-    }
-    if (len == 1) {
-    	std::string name = node->path_indent_segments_[0]->identifier_;
-    	Symbol sym = scope_manager_.lookup(name);
-    	if (sym.symbol_type_ == SymbolType::Variable) {
-    		if (!node->types.empty()) {
-    			auto ir_type = ir_manager_.GetIRType(node->types[0]);
-    			if (sym.is_const_) {
-    				node->result_var = std::make_shared<ConstVar>(name, ir_type, false);
-    			} else {
-    				node->result_var = std::make_shared<LocalVar>(name, ir_type, false);
-    			}
-    		}
-    	}
-    }
-}
-
-void IRBuilder::visit(PathIndentSegmentNode *node) {
-}
-
-void IRBuilder::visit(StructExpressionNode *node) {
-	node->is_assignable_ = true;
-    if (node->path_in_expression_node_) {
-        node->path_in_expression_node_->accept(this);
-    }
-	auto struct_type = std::dynamic_pointer_cast<IRStructType>(ir_manager_.GetIRType(node->types[0]));
-	if (!struct_type) return;
-	node->result_var = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(struct_type));
-	current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(node->result_var, struct_type));
-	if (node->struct_expr_fields_node_) {
-	    node->struct_expr_fields_node_->accept(this);
-    	auto struct_expr_field_nodes = node->struct_expr_fields_node_->struct_expr_field_nodes_;
-    	uint32_t index = 0;
-    	for (const auto& field: struct_expr_field_nodes) {
-    		std::shared_ptr<IRType> index_type = std::make_shared<IRIntegerType>(32);
-    		std::shared_ptr<IRLiteral> index_value_0 = std::make_shared<LiteralInt>(0);
-    		std::shared_ptr<IRLiteral> index_value = std::make_shared<LiteralInt>(index);
-    		auto element_type = struct_type->members[index];
-    		auto local_ptr = std::make_shared<LocalVar>("", std::make_shared<IRPointerType>(element_type));
-    		// Fix: use two indices [0, field_index] and struct type for correct field initialization
-    		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>
-    			(local_ptr, struct_type, node->result_var, std::vector{index_type, index_type}, std::vector{index_value_0, index_value}));
-    		if (auto ir_array_type = std::dynamic_pointer_cast<IRArrayType>(struct_type->members[index])) {
-				if (std::dynamic_pointer_cast<ArrayLiteralNode>(field->expression_node_)) {
-	    			StoreArrayLiteral(field->expression_node_, local_ptr, ir_array_type);
-				} else {
-					if (field->expression_node_->is_assignable_) {
-						EmitStructCopy(current_block, entry_block, current_function, local_ptr, field->expression_node_->result_var, ir_array_type);
-					} else {
-						current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, field->expression_node_->result_var, local_ptr));
-					}
-				}
-    			index++;
-    			continue;
-    		}
-			if (auto ir_struct_type = std::dynamic_pointer_cast<IRStructType>(struct_type->members[index])) {
-				if (field->expression_node_->is_assignable_) {
-					EmitStructCopy(current_block, entry_block, current_function, local_ptr, field->expression_node_->result_var, ir_struct_type);
-				} else {
-					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, field->expression_node_->result_var, local_ptr));
-				}
-				index++;
-				continue;
-			}
-    		auto element_value = std::make_shared<LocalVar>("", element_type);
-    		if (field->expression_node_->is_assignable_) {
-    			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(element_value, element_type, field->expression_node_->result_var));
-    		} else {
-    			element_value = field->expression_node_->result_var;
-    		}
-    		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, element_value, local_ptr));
-    		index++;
-    	}
-    }
-    if (node->struct_base_node_) node->struct_base_node_->accept(this);
-}
-
-void IRBuilder::visit(StructExprFieldsNode *node) {
-    for (const auto &field: node->struct_expr_field_nodes_) {
-        if (field) field->accept(this);
-    }
-    if (node->struct_base_node_) node->struct_base_node_->accept(this);
-}
-
-void IRBuilder::visit(StructExprFieldNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
-}
-
-void IRBuilder::visit(StructBaseNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
-}
-
-void IRBuilder::visit(GroupedExpressionNode *node) {
-    if (node->expression_) {
-        node->expression_->accept(this);
-        node->types = node->expression_->types;
-    	auto ir_type = ir_manager_.GetIRType(node->types[0]);
-    	node->result_var = std::make_shared<LocalVar>("", ir_type);
-    	if (node->expression_->is_assignable_) {
-    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_type, node->expression_->result_var));
-    	} else {
-    		node->result_var = node->expression_->result_var;
-    	}
-    }
-}
-
-void IRBuilder::visit(TupleExpressionNode *node) {
-    for (const auto &expr: node->expressions_) {
-        if (expr) expr->accept(this);
-    }
-}
-
-void IRBuilder::visit(ConditionsNode *node) {
-    if (node->expression_) {
-        node->expression_->accept(this);
-    }
-}
-
-void IRBuilder::visit(LetChainNode *node) {
-}
-
-void IRBuilder::visit(LetChainConditionNode *node) {
-}
-
-
-void IRBuilder::visit(MatchArmsNode *node) {
-    for (const auto &arm: node->match_arm_nodes_) {
-        if (arm) arm->accept(this);
-    }
-    for (const auto &expr: node->expression_nodes_) {
-        if (expr) expr->accept(this);
-    }
-}
-
-void IRBuilder::visit(MatchArmNode *node) {
-    if (node->pattern_node_) node->pattern_node_->accept(this);
-    if (node->match_arm_guard_) node->match_arm_guard_->accept(this);
-}
-
-void IRBuilder::visit(MatchArmGuardNode *node) {
-}
-
-void IRBuilder::visit(PatternNode *node) {
-    for (const auto &pat: node->pattern_no_top_alts_) {
-        if (pat) pat->accept(this);
-    }
-}
-
-void IRBuilder::visit(PatternNoTopAltNode *node) {
-}
-
-void IRBuilder::visit(PatternWithoutRangeNode *node) {
-}
-
-void IRBuilder::visit(LiteralPatternNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void IRBuilder::visit(IdentifierPatternNode *node) {
-    if (node->node_) node->node_->accept(this);
-}
-
-void IRBuilder::visit(WildcardPatternNode *node) {
-}
-
-void IRBuilder::visit(RestPatternNode *node) {
-}
-
-void IRBuilder::visit(GroupedPatternNode *node) {
-    if (node->pattern_) node->pattern_->accept(this);
-}
-
-void IRBuilder::visit(SlicePatternNode *node) {
-    for (const auto &pat: node->patterns_) {
-        if (pat) pat->accept(this);
-    }
-}
-
-void IRBuilder::visit(PathPatternNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void IRBuilder::visit(TypeNode *node) {
-}
-
-void IRBuilder::visit(TypeNoBoundsNode *node) {
-}
-
-void IRBuilder::visit(ParenthesizedTypeNode *node) {
-    if (node->type_) node->type_->accept(this);
-}
-
-void IRBuilder::visit(TypePathNode *node) {
-    if (node->type_path_segment_node_) {
-        node->type_path_segment_node_->accept(this);
-    }
-}
-
-void IRBuilder::visit(TypePathSegmentNode *node) {
-    if (node->path_indent_segment_node_) node->path_indent_segment_node_->accept(this);
-}
-
-void IRBuilder::visit(UnitTypeNode *node) {
-}
-
-void IRBuilder::visit(ArrayTypeNode *node) {
-}
-
-void IRBuilder::visit(SliceTypeNode *node) {
-    std::shared_ptr<Type> base_type;
-    if (node->type_) {
-        node->type_->accept(this);
-    }
-}
-
-void IRBuilder::visit(ReferenceTypeNode *node) {
-    if (node->type_node_) {
-        node->type_node_->accept(this);
-    }
-    node -> type = std::make_shared<ReferenceType>(node->type_node_->type, node->is_mut_);
-}
-
-
-void IRBuilder::visit(ConstParamNode *node) {
-}
-
-void IRBuilder::visit(TypeParamNode *node) {
-}
-
-void IRBuilder::visit(TypeParamBoundsNode *node) {
-}
-
-void IRBuilder::visit(QualifiedPathInExpressionNode *node) {
-}
-
-/**************** Supporting Functions ****************/
-void IRBuilder::StoreArrayLiteral(const std::shared_ptr<ExpressionNode>& expr_node, const std::shared_ptr<LocalVar>& array_var,
-                                  const std::shared_ptr<IRArrayType>& array_type) {
-	auto array_literal = std::dynamic_pointer_cast<ArrayLiteralNode>(expr_node);
-	if (array_literal) {
-		if (!array_literal->expressions_.empty()) {
-			uint32_t cnt = 0;
-			for (const auto& expr : array_literal->expressions_) {
-				auto ir_element_type = array_type->baseType;
-				auto element_var = std::make_shared<LocalVar>("", ir_element_type);
-				std::vector index_types({ir_element_type});
-				std::vector<std::shared_ptr<IRLiteral>> index_values({std::make_shared<LiteralInt>(cnt)});
-				auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, ir_element_type, array_var, index_types, index_values);
-				current_block->instructions.emplace_back(get_element_ptr_inst);
-				auto possible_array_type = std::dynamic_pointer_cast<IRArrayType>(ir_element_type);
-				if (possible_array_type) {
-					StoreArrayLiteral(expr, element_var, possible_array_type);
-				} else {
-					auto var = std::make_shared<LocalVar>("", ir_element_type);
-					if (expr->is_assignable_) {
-						current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, expr->result_var));
-					} else {
-						var = expr->result_var;
-					}
-					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
-				}
-				cnt++;
-			}
-		}
-		if (array_literal->lhs_ && array_literal->rhs_) {
-			auto ir_element_type = array_type->baseType;
-			auto value = *std::get_if<int64_t>(&array_literal->rhs_->value);
-			
-			if (value > 8) {
-				auto i32_type = std::make_shared<IRIntegerType>(32);
-				auto i_var = std::make_shared<LocalVar>(".i", i32_type);
-				entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(i_var, i32_type));
-				
-				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, std::make_shared<LiteralInt>(0), i_var));
-				
-				auto cond_block = std::make_shared<IRBasicBlock>("array_init_cond");
-				auto body_block = std::make_shared<IRBasicBlock>("array_init_body");
-				auto end_block = std::make_shared<IRBasicBlock>("array_init_end");
-				
-				current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
-				
-				current_function->blocks.emplace_back(cond_block);
-				current_block = cond_block;
-				auto i_val = std::make_shared<LocalVar>("", i32_type);
-				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val, i32_type, i_var));
-				
-				auto limit_val = std::make_shared<LocalVar>("", i32_type);
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(limit_val, i32_type, (int)value, 0));
-
-				auto cmp_res = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
-				current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(cmp_res, i32_type, i_val, limit_val, ConditionType::slt));
-				current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(cmp_res, body_block->true_label, end_block->true_label));
-				
-				current_function->blocks.emplace_back(body_block);
-				current_block = body_block;
-				
-				auto element_var = std::make_shared<LocalVar>("", ir_element_type);
-				auto i_val_body = std::make_shared<LocalVar>("", i32_type);
-				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val_body, i32_type, i_var));
-				
-				auto zero_val = std::make_shared<LocalVar>("", i32_type);
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_val, i32_type, 0, 0));
-				
-				std::vector<std::shared_ptr<IRType>> index_types({i32_type, i32_type});
-				std::vector<std::shared_ptr<IRVar>> index_vars({zero_val, i_val_body});
-				
-				auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, array_type, array_var, index_types, index_vars);
-				current_block->instructions.emplace_back(get_element_ptr_inst);
-				
-				auto possible_array_type = std::dynamic_pointer_cast<IRArrayType>(ir_element_type);
-				if (possible_array_type) {
-					StoreArrayLiteral(array_literal->lhs_, element_var, possible_array_type);
-				} else {
-					auto var = std::make_shared<LocalVar>("", ir_element_type);
-					if (array_literal->lhs_->is_assignable_) {
-						current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, array_literal->lhs_->result_var));
-					} else {
-						var = array_literal->lhs_->result_var;
-					}
-					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
-				}
-				
-				auto i_next = std::make_shared<LocalVar>("", i32_type);
-				auto one_val = std::make_shared<LocalVar>("", i32_type);
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(one_val, i32_type, 1, 0));
-				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(i_next, i32_type, i_val_body, one_val));
-				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, i_next, i_var));
-				
-				current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
-				
-				current_function->blocks.emplace_back(end_block);
-				current_block = end_block;
-			} else {
-				auto var = std::make_shared<LocalVar>("", ir_element_type);
-				if (array_literal->lhs_->is_assignable_) {
-					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, array_literal->lhs_->result_var));
-				} else {
-					var = array_literal->lhs_->result_var;
-				}
-				for (uint32_t i = 0; i < value; i++) {
-					auto element_var = std::make_shared<LocalVar>("", ir_element_type);
-					std::vector index_types({ir_element_type});
-					std::vector<std::shared_ptr<IRLiteral>> index_values({std::make_shared<LiteralInt>(i)});
-					auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, ir_element_type, array_var, index_types, index_values);
-					current_block->instructions.emplace_back(get_element_ptr_inst);
-					auto possible_array_type = std::dynamic_pointer_cast<IRArrayType>(ir_element_type);
-					if (possible_array_type) {
-						StoreArrayLiteral(array_literal->lhs_, element_var, possible_array_type);
-					} else {
-						current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
-					}
-				}
-			}
-		}
-	}
-}
+#include "IR/IRBuilder.h"
+
+#include "IR/IRBlock.h"
+#include "IR/IRProgram.h"
+#include "IR/IRType.h"
+#include "IR/IRLiteral.h"
+#include "Semantic/ASTNode.h"
+#include "Semantic/Type.h"
+#include "Semantic/Symbol.h"
+
+extern std::shared_ptr<IRProgram> ir_program;
+
+void EmitStructCopy(std::shared_ptr<IRBasicBlock>& current_block, std::shared_ptr<IRBasicBlock>& entry_block, std::shared_ptr<IRFunction>& current_function, std::shared_ptr<IRVar> dest, std::shared_ptr<IRVar> src, std::shared_ptr<IRType> type) {
+    if (auto struct_type = shared_dyn_cast<IRStructType>(type)) {
+        for (size_t i = 0; i < struct_type->members.size(); ++i) {
+            auto member_type = struct_type->members[i];
+            auto index_type = std::make_shared<IRIntegerType>(32);
+            auto index_0 = std::make_shared<LiteralInt>(0);
+            auto index_i = std::make_shared<LiteralInt>(i);
+            
+            auto member_dest = std::make_shared<LocalVar>("", ir_manager.PointerTo(member_type));
+            current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(
+                member_dest, struct_type, dest, 
+                std::vector<std::shared_ptr<IRType>>{index_type, index_type}, 
+                std::vector<std::shared_ptr<IRLiteral>>{index_0, index_i}
+            ));
+            
+            auto member_src = std::make_shared<LocalVar>("", ir_manager.PointerTo(member_type));
+            current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(
+                member_src, struct_type, src, 
+                std::vector<std::shared_ptr<IRType>>{index_type, index_type}, 
+                std::vector<std::shared_ptr<IRLiteral>>{index_0, index_i}
+            ));
+            
+            EmitStructCopy(current_block, entry_block, current_function, member_dest, member_src, member_type);
+        }
+    } else if (auto array_type = shared_dyn_cast<IRArrayType>(type)) {
+        auto i32_type = std::make_shared<IRIntegerType>(32);
+        auto i_var = std::make_shared<LocalVar>(".i", i32_type);
+        entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(i_var, i32_type));
+        
+        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, std::make_shared<LiteralInt>(0), i_var));
+        
+        auto cond_block = std::make_shared<IRBasicBlock>("copy_cond");
+        auto body_block = std::make_shared<IRBasicBlock>("copy_body");
+        auto end_block = std::make_shared<IRBasicBlock>("copy_end");
+        
+        current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
+        
+        current_function->blocks.emplace_back(cond_block);
+        current_block = cond_block;
+        auto i_val = std::make_shared<LocalVar>("", i32_type);
+        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val, i32_type, i_var));
+        
+        auto limit_val = std::make_shared<LocalVar>("", i32_type);
+        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(limit_val, i32_type, array_type->length, 0));
+
+        auto cmp_res = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
+        current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(cmp_res, i32_type, i_val, limit_val, ConditionType::slt));
+        current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(cmp_res, body_block->true_label, end_block->true_label));
+        
+        current_function->blocks.emplace_back(body_block);
+        current_block = body_block;
+        
+        auto i_val_body = std::make_shared<LocalVar>("", i32_type);
+        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val_body, i32_type, i_var));
+        
+        auto zero_val = std::make_shared<LocalVar>("", i32_type);
+        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_val, i32_type, 0, 0));
+        
+        std::vector<std::shared_ptr<IRType>> index_types({i32_type, i32_type});
+        std::vector<std::shared_ptr<IRVar>> index_vars({zero_val, i_val_body});
+        
+        auto element_dest = std::make_shared<LocalVar>("", ir_manager.PointerTo(array_type->baseType));
+        current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(element_dest, array_type, dest, index_types, index_vars));
+        
+        auto element_src = std::make_shared<LocalVar>("", ir_manager.PointerTo(array_type->baseType));
+        current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(element_src, array_type, src, index_types, index_vars));
+        
+        EmitStructCopy(current_block, entry_block, current_function, element_dest, element_src, array_type->baseType);
+        
+        auto i_next = std::make_shared<LocalVar>("", i32_type);
+        auto one_val = std::make_shared<LocalVar>("", i32_type);
+        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(one_val, i32_type, 1, 0));
+        current_block->instructions.emplace_back(std::make_shared<AddInstruction>(i_next, i32_type, i_val_body, one_val));
+        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, i_next, i_var));
+        
+        current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
+        
+        current_function->blocks.emplace_back(end_block);
+        current_block = end_block;
+    } else {
+        auto val = std::make_shared<LocalVar>("", type);
+        current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(val, type, src));
+        current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(type, val, dest));
+    }
+}
+
+void IRBuilder::visit(CrateNode *node) {
+    scope_manager_.SetCurrentScope(scope_manager_.scope_set_[0]);
+	auto saved_scope_index = scope_manager_.current_scope->scope_index;
+    for (const auto& item: node->items_) {
+        auto const_item = dyn_cast<ConstantItemNode>(item);
+        if (const_item) {
+        	auto const_var = std::make_shared<ConstVar>(const_item->identifier_, std::make_shared<IRIntegerType>(32));
+        	auto val = std::get_if<int64_t>(&const_item->expression_node_->value);
+        	if (val) {
+        		auto ir_literal = std::make_shared<LiteralInt>(*val);
+        		ir_program->constants.emplace_back(std::make_shared<ConstVarDefInstruction>(const_var, ir_literal));
+        	}
+        }
+    }
+
+	for (const auto& item: node->items_) {
+		auto struct_item = dyn_cast<StructNode>(item);
+		if (struct_item) {
+			auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
+			ir_manager_.AddType(struct_type);
+			auto ir_struct_type = shared_dyn_cast<IRStructType>(ir_manager_.GetIRType(struct_type));
+			ir_program->structs.emplace_back(std::make_shared<StructDefInstruction>(ir_struct_type, ir_struct_type->members));
+
+			for (auto& method : struct_type->methods_) {
+				auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
+				std::vector<IRFunctionParam> ir_function_params;
+				scope_manager_.SetCurrentScope(scope_manager_.scope_set_[method.function_node_->block_expression_->scope_index]);
+				if (function_type) {
+					std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+					auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
+					if (possible_struct_type) {
+						method.function_node_->is_struct_type = true;
+						auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(function_type->ret_));
+						method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+						ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
+					} else {
+						ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
+					}
+					if (function_type->have_self_) {
+						auto ir_pointer_struct_type = ir_manager_.PointerTo(ir_struct_type);
+						auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
+						ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
+					}
+					uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
+					for (auto& param: function_type->params_) {
+						auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
+						auto ir_type = ir_manager_.GetIRType(param);
+						auto identifier_pattern = dyn_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
+						if (identifier_pattern) {
+							std::string identifier = identifier_pattern->identifier_;
+							auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
+							ir_function_params.emplace_back(ir_type, ir_var);
+						}
+						++index;
+					}
+					std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
+					auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
+					ir_program->functions.emplace_back(ir_function);
+					ir_manager_.function_map_[GlobalInterner().Intern(ir_identifier)] = ir_function;
+					method.function_node_->identifier_ = ir_identifier;
+					Visit(method.function_node_);
+				}
+				scope_manager_.SetCurrentScope(scope_manager_.scope_set_[saved_scope_index]);
+			}
+			for (auto& method : struct_type->inline_functions_) {
+				auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
+				std::vector<IRFunctionParam> ir_function_params;
+				scope_manager_.SetCurrentScope(scope_manager_.scope_set_[method.function_node_->block_expression_->scope_index]);
+				if (function_type) {
+					std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+					if (function_type->ret_) {
+						auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
+						if (possible_struct_type) {
+							method.function_node_->is_struct_type = true;
+							auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(function_type->ret_));
+							method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+							ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
+						} else {
+							ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
+						}
+					}
+					if (function_type->have_self_) {
+						auto ir_pointer_struct_type = ir_manager_.PointerTo(ir_struct_type);
+						auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
+						ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
+					}
+					uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
+					for (auto& param: function_type->params_) {
+						auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
+						auto ir_type = ir_manager_.GetIRType(param);
+						auto identifier_pattern = dyn_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
+						if (identifier_pattern) {
+							std::string identifier = identifier_pattern->identifier_;
+							auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
+							ir_function_params.emplace_back(ir_type, ir_var);
+						}
+						++index;
+					}
+					std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
+					auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
+					ir_program->functions.emplace_back(ir_function);
+					ir_manager_.function_map_[GlobalInterner().Intern(ir_identifier)] = ir_function;
+					method.function_node_->identifier_ = ir_identifier;
+					Visit(method.function_node_);
+				}
+				scope_manager_.SetCurrentScope(scope_manager_.scope_set_[saved_scope_index]);
+			}
+		}
+	}
+
+	for (const auto& item: node->items_) {
+		auto func_item = dyn_cast<FunctionNode>(item);
+		if (func_item) {
+			scope_manager_.SetCurrentScope(scope_manager_.scope_set_[func_item->block_expression_->scope_index]);
+			std::vector<IRFunctionParam> ir_function_params;
+			std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+			if (func_item->type_) {
+				auto semantic_ret_type = func_item->type_->type;
+				auto possible_struct_type = std::dynamic_pointer_cast<StructType>(semantic_ret_type);
+				if (possible_struct_type) {
+					func_item->is_struct_type = true;
+					auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(semantic_ret_type));
+					func_item->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+					ir_function_params.emplace_back(pointer_type, func_item->struct_ret_var);
+				} else {
+					ir_ret_type = ir_manager_.GetIRType(semantic_ret_type);
+				}
+			}
+			auto parameters = func_item->function_parameters_;
+			if (parameters) {
+				for (auto& param : parameters->function_params_) {
+					auto ir_type = ir_manager_.GetIRType(param->type_->type);
+					auto identifier_pattern = dyn_cast<IdentifierPatternNode>(param->pattern_no_top_alt_node_);
+					auto ir_var = std::make_shared<LocalVar>(identifier_pattern->identifier_, ir_type);
+					ir_function_params.emplace_back(ir_type, ir_var);
+				}
+			}
+			auto ir_function = std::make_shared<IRFunction>(func_item->identifier_, ir_ret_type, ir_function_params);
+			ir_program->functions.emplace_back(ir_function);
+			ir_manager_.function_map_[GlobalInterner().Intern(func_item->identifier_)] = ir_function;
+			scope_manager_.SetCurrentScope(scope_manager_.scope_set_[saved_scope_index]);
+			Visit(item);
+		}
+	}
+}
+
+void IRBuilder::visit(FunctionNode *node) {
+	auto saved_current_function = current_function;
+	auto saved_current_block = current_block;
+	auto saved_entry_block = entry_block;
+	current_function = ir_manager_.function_map_[GlobalInterner().Intern(node->identifier_)];
+	current_block = std::make_shared<IRBasicBlock>("entry");
+	entry_block = current_block;
+	current_function->blocks.emplace_back(current_block);
+	uint32_t saved_scope_index = scope_manager_.current_scope->scope_index;
+	scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->block_expression_->scope_index]);
+    if (node->function_parameters_) {
+	    Visit(node->function_parameters_);
+    	for (auto& param: current_function->function_params) {
+    		if (param.var->name != "self" && param.var->name != ".ret") {
+    			auto param_var = std::make_shared<LocalVar>(param.var->name, ir_manager_.PointerTo(param.type));
+    			current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(param_var, param.type));
+    			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(param.type, param.var, param_var));
+    		}
+    	}
+    }
+	scope_manager_.SetCurrentScope(scope_manager_.scope_set_[saved_scope_index]);
+    if (node->type_) Visit(node->type_);
+    if (node->block_expression_) {
+    	node->block_expression_->is_function_direct_block = true;
+    	current_struct_ret_var = node->struct_ret_var;
+        Visit(node->block_expression_);
+    	current_struct_ret_var = nullptr;
+    }
+	current_function = saved_current_function;
+	current_block = saved_current_block;
+	entry_block = saved_entry_block;
+}
+
+void IRBuilder::visit(ConstantItemNode *node) {
+    if (node->type_node_) Visit(node->type_node_);
+    if (node->expression_node_) Visit(node->expression_node_);
+    if (!node->expression_node_->is_compiler_known_) {
+        throw SemanticError("Semantic Error: The RHS is not a Compiler-known expression", node->pos_);
+    }
+    scope_manager_.AddConstant(node->identifier_, node->expression_node_->value);
+}
+
+void IRBuilder::visit(TraitNode *node) {
+}
+
+void IRBuilder::visit(InherentImplNode *node) {
+	scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->scope_index]);
+    if (node->type_node_) Visit(node->type_node_);
+    std::string name = node->type_node_->toString();
+    for (auto& item : node->associated_item_nodes_) {
+        if (item) {
+            if (item->function_node_) {
+            	item->function_node_->identifier_ = name + "." + item->function_node_->identifier_;
+            	Visit(item);
+            }
+        }
+    }
+    scope_manager_.PopScope();
+}
+
+void IRBuilder::visit(TraitImplNode *node) {
+}
+
+void IRBuilder::visit(FunctionParametersNode *node) {
+    for (const auto &param: node->function_params_) {
+        if (param) Visit(param);
+    }
+}
+
+void IRBuilder::visit(FunctionParamNode *node) {
+    // if (node->pattern_no_top_alt_node_) Visit(node->pattern_no_top_alt_node_);
+    if (node->type_) Visit(node->type_);
+}
+
+
+void IRBuilder::visit(StatementsNode *node) {
+    for (const auto &stmt: node->statements_) {
+        if (stmt) {
+        	if (dyn_cast<VisItemStatementNode>(stmt)) {
+        		continue;
+        	}
+	        Visit(stmt);
+        	auto expr_stmt = dyn_cast<ExpressionStatementNode>(stmt);
+        	if (expr_stmt) {
+        		auto jump_expr = dyn_cast<JumpExpressionNode>(expr_stmt->expression_);
+        		auto continue_expr = dyn_cast<ContinueExpressionNode>(expr_stmt->expression_);
+        		if (jump_expr || continue_expr) {
+					break;
+				}
+        	}
+        }
+    }
+    if (node->expression_) Visit(node->expression_);
+}
+
+void IRBuilder::visit(LetStatementNode *node) {
+	if (node->type_) {
+		Visit(node->type_);
+	}
+	if (node->expression_) {
+		Visit(node->expression_);
+	}
+	if (node->block_expression_) {
+		Visit(node->block_expression_);
+	}
+	std::string identifier;
+	auto identifier_pattern = dyn_cast<IdentifierPatternNode>(node->pattern_no_top_alt_);
+	if (identifier_pattern) {
+		identifier = identifier_pattern->identifier_;
+	}
+	auto ir_type = ir_manager_.GetIRType(node->type_->type);
+	auto ir_var = std::make_shared<LocalVar>(identifier, ir_type);
+	entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(ir_var, ir_type));
+
+	/**** Handle Array Type ****/
+	auto array_type = shared_dyn_cast<IRArrayType>(ir_type);
+	if (array_type) {
+		if (dyn_cast<ArrayLiteralNode>(node->expression_)) {
+			StoreArrayLiteral(node->expression_, ir_var, array_type);
+		} else if (node->expression_) {
+			if (node->expression_->is_assignable_) {
+				EmitStructCopy(current_block, entry_block, current_function, ir_var, node->expression_->result_var, array_type);
+			} else {
+				auto value = node->expression_->result_var;
+				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(array_type, value, ir_var));
+			}
+		}
+		return;
+	}
+
+	/**** Handle Basic And Sturct Types ****/
+	auto value = std::make_shared<LocalVar>("", ir_type);
+	if (node->expression_) {
+		if (isa<IRStructType>(ir_type) && node->expression_->is_assignable_) {
+			EmitStructCopy(current_block, entry_block, current_function, ir_var, node->expression_->result_var, ir_type);
+		} else {
+			if (node->expression_->is_assignable_) {
+				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, ir_type, node->expression_->result_var));
+			} else {
+				value = node->expression_->result_var;
+			}
+			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, value, ir_var));
+		}
+	}
+}
+
+void IRBuilder::visit(ComparisonExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](ComparisonExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+		auto ir_bool_type = std::make_shared<IRIntegerType>(1);
+        auto compare_type = ir_manager_.GetIRType(node->rhs_->types[0]);
+        node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
+        auto lhs_value = std::make_shared<LocalVar>("", compare_type);
+        if (node->lhs_->is_assignable_) {
+        	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_value, compare_type, node->lhs_->result_var));
+        } else {
+        	lhs_value = node->lhs_->result_var;
+        }
+        auto rhs_value = std::make_shared<LocalVar>("", compare_type);
+        if (node->rhs_->is_assignable_) {
+        	current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_value, compare_type, node->rhs_->result_var));
+        } else {
+        	rhs_value = node->rhs_->result_var;
+        }
+        if (node->type_ == TokenType::EqEq) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::eq));
+        } else if (node->type_ == TokenType::LEq) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sle));
+        } else if (node->type_ == TokenType::Lt) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::slt));
+        } else if (node->type_ == TokenType::GEq) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sge));
+        } else if (node->type_ == TokenType::Gt) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::sgt));
+        } else if (node->type_ == TokenType::NEq) {
+        	current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(node->result_var, compare_type, lhs_value, rhs_value, ConditionType::ne));
+        }
+    });
+}
+
+void IRBuilder::visit(TypeCastExpressionNode *node) {
+    if (node->type_) {
+        Visit(node->type_);
+    }
+	if (node->expression_) {
+		Visit(node->expression_);
+		auto original_type = ir_manager_.GetIRType(node->expression_->types[0]);
+		auto cast_type = ir_manager_.GetIRType(node->types[0]);
+		node->result_var = std::make_shared<LocalVar>("", cast_type);
+
+		auto original_integer_type = dyn_cast<IRIntegerType>(original_type);
+		auto cast_integer_type = dyn_cast<IRIntegerType>(cast_type);
+		// only handle i1 to i32 cast for now
+		if (original_integer_type && cast_integer_type) {
+			if (original_integer_type->length == 1) {
+				auto origin_var = std::make_shared<LocalVar>("", original_type);
+				if (node->expression_->is_assignable_) {
+					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(origin_var, original_type, node->expression_->result_var));
+				} else {
+					origin_var = node->expression_->result_var;
+				}
+				current_block->instructions.emplace_back(std::make_shared<ZextInstruction>(node->result_var, original_type, origin_var, cast_type));
+			} else {
+				if (node->expression_->is_assignable_) {
+					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, original_type, node->expression_->result_var));
+				} else {
+					node->result_var = node->expression_->result_var;
+				}
+			}
+		}
+	}
+}
+
+void IRBuilder::visit(AssignmentExpressionNode *node) {
+    if (node->lhs_) {
+	    Visit(node->lhs_);
+    }
+    if (node->rhs_) Visit(node->rhs_);
+	auto ir_type = ir_manager_.GetIRType(node->lhs_->types[0]);
+
+	if (isa<IRStructType>(ir_type) || isa<IRArrayType>(ir_type)) {
+		if (isa<ArrayLiteralNode>(node->rhs_)) {
+			if (auto array_type = shared_dyn_cast<IRArrayType>(ir_type)) {
+				StoreArrayLiteral(node->rhs_, node->lhs_->result_var, array_type);
+				return;
+			}
+		}
+		if (node->rhs_->is_assignable_) {
+			EmitStructCopy(current_block, entry_block, current_function, node->lhs_->result_var, node->rhs_->result_var, ir_type);
+		} else {
+			current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, node->rhs_->result_var, node->lhs_->result_var));
+		}
+		return;
+	}
+
+	auto ir_var = std::make_shared<LocalVar>("", ir_type);
+	if (node->rhs_->is_assignable_) {
+		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(ir_var, ir_type, node->rhs_->result_var));
+	} else {
+		ir_var = node->rhs_->result_var;
+	}
+	if (node->type_ == TokenType::PlusEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<AddInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::MinusEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<SubInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::MulEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<MulInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::DivEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		auto ir_integer_type = dyn_cast<IRIntegerType>(ir_type);
+		if (ir_integer_type->is_signed) {
+			current_block->instructions.emplace_back(std::make_shared<SDivInstruction>(result_value, ir_type, left_value, ir_var));
+		} else {
+			current_block->instructions.emplace_back(std::make_shared<UDivInstruction>(result_value, ir_type, left_value, ir_var));
+		}
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::ModEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		auto ir_integer_type = dyn_cast<IRIntegerType>(ir_type);
+		if (ir_integer_type->is_signed) {
+			current_block->instructions.emplace_back(std::make_shared<SremInstruction>(result_value, ir_type, left_value, ir_var));
+		} else {
+			current_block->instructions.emplace_back(std::make_shared<UremInstruction>(result_value, ir_type, left_value, ir_var));
+		}
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::SLEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<ShlInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::SREq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<AShrInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	if (node->type_ == TokenType::XorEq) {
+		auto left_value = std::make_shared<LocalVar>("", ir_type);
+		auto result_value = std::make_shared<LocalVar>("", ir_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<XorInstruction>(result_value, ir_type, left_value, ir_var));
+		ir_var = result_value;
+	}
+	current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, ir_var, node->lhs_->result_var));
+}
+
+void IRBuilder::visit(ContinueExpressionNode *node) {
+	interrupt = true;
+	if (ir_manager_.current_loop_condition) {
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(ir_manager_.current_loop_condition->true_label));
+	}
+}
+
+void IRBuilder::visit(JumpExpressionNode *node) {
+    if (node->expression_) {
+        Visit(node->expression_);
+    }
+	if (node->type_ == TokenType::Return) {
+		interrupt = true;
+		if (node->expression_) {
+			auto ret_type = ir_manager_.GetIRType(node->expression_->types[0]);
+			auto possible_struct_type = std::dynamic_pointer_cast<StructType>(node->expression_->types[0]);
+			auto value = std::make_shared<LocalVar>("", ret_type);
+			if (node->expression_->is_assignable_) {
+				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, ret_type, node->expression_->result_var));
+			} else {
+				value = node->expression_->result_var;
+			}
+			if (!possible_struct_type) {
+				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ret_type, value));
+			} else {
+				auto ir_ret_void_type = std::make_shared<IRVoidType>();
+				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ret_type, value, current_struct_ret_var));
+				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_ret_void_type, nullptr));
+			}
+		} else {
+			auto ret_type = std::make_shared<IRVoidType>();
+			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ret_type, nullptr));
+		}
+	}
+	if (node->type_ == TokenType::Break) {
+		interrupt = true;
+		if (ir_manager_.current_loop_combine) {
+			current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(ir_manager_.current_loop_combine->true_label));
+		}
+	}
+}
+
+void IRBuilder::visit(LogicOrExpressionNode *chain) {
+	// The result slots are allocated outermost first, before the left operand,
+	// and taken back innermost first once it is built.
+	std::vector<std::shared_ptr<IRVar> > result_ptrs;
+	VisitLeftChain(chain, this, [this, &result_ptrs](LogicOrExpressionNode *node) {
+		auto ir_bool_type = std::make_shared<IRIntegerType>(1);
+		node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
+		std::shared_ptr<IRVar> result_ptr = std::make_shared<LocalVar>(".or_res", ir_manager_.PointerTo(ir_bool_type));
+		entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(result_ptr, ir_bool_type));
+		result_ptrs.push_back(result_ptr);
+	}, [this, &result_ptrs](LogicOrExpressionNode *node) {
+		auto ir_bool_type = std::make_shared<IRIntegerType>(1);
+		std::shared_ptr<IRVar> result_ptr = std::move(result_ptrs.back());
+		result_ptrs.pop_back();
+
+		std::shared_ptr<IRVar> lhs_val = std::make_shared<LocalVar>("", ir_bool_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_val, ir_bool_type, node->lhs_->result_var));
+		} else {
+			lhs_val = node->lhs_->result_var;
+		}
+	
+		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, lhs_val, result_ptr));
+	
+		auto rhs_block = std::make_shared<IRBasicBlock>("or_rhs");
+		auto end_block = std::make_shared<IRBasicBlock>("or_end");
+	
+		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(lhs_val, end_block->true_label, rhs_block->true_label));
+	
+		current_function->blocks.emplace_back(rhs_block);
+		current_block = rhs_block;
+	
+		if (node->rhs_) Visit(node->rhs_);
+	
+		std::shared_ptr<IRVar> rhs_val = std::make_shared<LocalVar>("", ir_bool_type);
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_val, ir_bool_type, node->rhs_->result_var));
+		} else {
+			rhs_val = node->rhs_->result_var;
+		}
+	
+		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, rhs_val, result_ptr));
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(end_block->true_label));
+	
+		current_function->blocks.emplace_back(end_block);
+		current_block = end_block;
+	
+		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_bool_type, result_ptr));
+	});
+}
+
+void IRBuilder::visit(LogicAndExpressionNode *chain) {
+	// The result slots are allocated outermost first, before the left operand,
+	// and taken back innermost first once it is built.
+	std::vector<std::shared_ptr<IRVar> > result_ptrs;
+	VisitLeftChain(chain, this, [this, &result_ptrs](LogicAndExpressionNode *node) {
+		auto ir_bool_type = std::make_shared<IRIntegerType>(1);
+		node->result_var = std::make_shared<LocalVar>("", ir_bool_type);
+		std::shared_ptr<IRVar> result_ptr = std::make_shared<LocalVar>(".and_res", ir_manager_.PointerTo(ir_bool_type));
+		entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(result_ptr, ir_bool_type));
+		result_ptrs.push_back(result_ptr);
+	}, [this, &result_ptrs](LogicAndExpressionNode *node) {
+		auto ir_bool_type = std::make_shared<IRIntegerType>(1);
+		std::shared_ptr<IRVar> result_ptr = std::move(result_ptrs.back());
+		result_ptrs.pop_back();
+
+		std::shared_ptr<IRVar> lhs_val = std::make_shared<LocalVar>("", ir_bool_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(lhs_val, ir_bool_type, node->lhs_->result_var));
+		} else {
+			lhs_val = node->lhs_->result_var;
+		}
+	
+		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, lhs_val, result_ptr));
+	
+		auto rhs_block = std::make_shared<IRBasicBlock>("and_rhs");
+		auto end_block = std::make_shared<IRBasicBlock>("and_end");
+	
+		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(lhs_val, rhs_block->true_label, end_block->true_label));
+	
+		current_function->blocks.emplace_back(rhs_block);
+		current_block = rhs_block;
+	
+		if (node->rhs_) Visit(node->rhs_);
+	
+		std::shared_ptr<IRVar> rhs_val = std::make_shared<LocalVar>("", ir_bool_type);
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(rhs_val, ir_bool_type, node->rhs_->result_var));
+		} else {
+			rhs_val = node->rhs_->result_var;
+		}
+	
+		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_bool_type, rhs_val, result_ptr));
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(end_block->true_label));
+	
+		current_function->blocks.emplace_back(end_block);
+		current_block = end_block;
+	
+		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_bool_type, result_ptr));
+	});
+}
+
+void IRBuilder::visit(BitwiseOrExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseOrExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+		auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+		node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
+		auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
+		auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
+		} else {
+			right_value = node->rhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<OrInstruction>(node->result_var, ir_i32_type, left_value, right_value));
+    });
+}
+
+void IRBuilder::visit(BitwiseXorExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseXorExpressionNode *node) {
+		if (node->rhs_) Visit(node->rhs_);
+		auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+		node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
+		auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
+		auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
+		} else {
+			right_value = node->rhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i32_type, left_value, right_value));
+    });
+}
+
+void IRBuilder::visit(BitwiseAndExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseAndExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+		auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+		node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
+		auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
+		auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
+		} else {
+			right_value = node->rhs_->result_var;
+		}
+		current_block->instructions.emplace_back(std::make_shared<AndInstruction>(node->result_var, ir_i32_type, left_value, right_value));
+    });
+}
+
+void IRBuilder::visit(ShiftExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](ShiftExpressionNode *node) {
+        if (node->rhs_) { Visit(node->rhs_); }
+		auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+		node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
+		auto left_value = std::make_shared<LocalVar>("", ir_i32_type);
+		auto right_value = std::make_shared<LocalVar>("", ir_i32_type);
+		if (node->lhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(left_value, ir_i32_type, node->lhs_->result_var));
+		} else {
+			left_value = node->lhs_->result_var;
+		}
+		if (node->rhs_->is_assignable_) {
+			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(right_value, ir_i32_type, node->rhs_->result_var));
+		} else {
+			right_value = node->rhs_->result_var;
+		}
+		if (node->type_ == TokenType::SL) {
+			current_block->instructions.emplace_back(std::make_shared<ShlInstruction>(node->result_var, ir_i32_type, left_value, right_value));
+		} else if (node->type_ == TokenType::SR) {
+			current_block->instructions.emplace_back(std::make_shared<AShrInstruction>(node->result_var, ir_i32_type, left_value, right_value));
+		}
+    });
+}
+
+void IRBuilder::visit(AddMinusExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](AddMinusExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+		auto ir_type = ir_manager_.GetIRType(node->types[0]);
+		auto l_value = std::make_shared<LocalVar>("", ir_type);
+		auto r_value = std::make_shared<LocalVar>("", ir_type);
+		node->result_var = std::make_shared<LocalVar>("", ir_type);
+		if (node->type_ == TokenType::Plus) {
+			if (node->lhs_->is_assignable_) {
+				auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_l);
+			} else {
+				l_value = node->lhs_->result_var;
+			}
+			if (node->rhs_->is_assignable_) {
+				auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_r);
+			} else {
+				r_value = node->rhs_->result_var;
+			}
+			auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_type, l_value, r_value);
+			current_block->instructions.emplace_back(add_instruction);
+		} else if (node->type_ == TokenType::Minus) {
+			if (node->lhs_->is_assignable_) {
+				auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_l);
+			} else {
+				l_value = node->lhs_->result_var;
+			}
+			if (node->rhs_->is_assignable_) {
+				auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_r);
+			} else {
+				r_value = node->rhs_->result_var;
+			}
+			auto sub_instruction = std::make_shared<SubInstruction>(node->result_var, ir_type, l_value, r_value);
+			current_block->instructions.emplace_back(sub_instruction);
+		}
+    });
+}
+
+void IRBuilder::visit(MulDivModExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](MulDivModExpressionNode *node) {
+        // Unused, but it takes a variable number ahead of the operands.
+        std::make_shared<LocalVar>("", ir_manager_.GetIRType(node->types[0]));
+    }, [this](MulDivModExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        auto ir_type = ir_manager_.GetIRType(node->types[0]);
+		auto l_value = std::make_shared<LocalVar>("", ir_type);
+		auto r_value = std::make_shared<LocalVar>("", ir_type);
+		node->result_var = std::make_shared<LocalVar>("", ir_type);
+		if (node->type_ == TokenType::Mul) {
+			if (node->lhs_->is_assignable_) {
+				auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_l);
+			} else {
+				l_value = node->lhs_->result_var;
+			}
+			if (node->rhs_->is_assignable_) {
+				auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_r);
+			} else {
+				r_value = node->rhs_->result_var;
+			}
+			auto mul_instruction = std::make_shared<MulInstruction>(node->result_var, ir_type, l_value, r_value);
+			current_block->instructions.emplace_back(mul_instruction);
+		} else if (node->type_ == TokenType::Div) {
+			if (node->lhs_->is_assignable_) {
+				auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_l);
+			} else {
+				l_value = node->lhs_->result_var;
+			}
+			if (node->rhs_->is_assignable_) {
+				auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_r);
+			} else {
+				r_value = node->rhs_->result_var;
+			}
+			auto ir_integer_type = dyn_cast<IRIntegerType>(ir_type);
+			if (ir_integer_type->is_signed) {
+				auto sdiv_instruction = std::make_shared<SDivInstruction>(node->result_var, ir_type, l_value, r_value);
+				current_block->instructions.emplace_back(sdiv_instruction);
+			} else {
+				auto udiv_instruction = std::make_shared<UDivInstruction>(node->result_var, ir_type, l_value, r_value);
+				current_block->instructions.emplace_back(udiv_instruction);
+			}
+		} else if (node->type_ == TokenType::MOD) {
+			if (node->lhs_->is_assignable_) {
+				auto load_instruction_l = std::make_shared<LoadInstruction>(l_value, ir_type, node->lhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_l);
+			} else {
+				l_value = node->lhs_->result_var;
+			}
+			if (node->rhs_->is_assignable_) {
+				auto load_instruction_r = std::make_shared<LoadInstruction>(r_value, ir_type, node->rhs_->result_var);
+				current_block->instructions.emplace_back(load_instruction_r);
+			} else {
+				r_value = node->rhs_->result_var;
+			}
+			auto ir_integer_type = dyn_cast<IRIntegerType>(ir_type);
+			if (ir_integer_type->is_signed) {
+				auto srem_instruction = std::make_shared<SremInstruction>(node->result_var, ir_type, l_value, r_value);
+				current_block->instructions.emplace_back(srem_instruction);
+			} else {
+				auto urem_instruction = std::make_shared<UremInstruction>(node->result_var, ir_type, l_value, r_value);
+				current_block->instructions.emplace_back(urem_instruction);
+			}
+		}
+    });
+}
+
+void IRBuilder::visit(UnaryExpressionNode *node) {
+    if (node->expression_) {
+        Visit(node->expression_);
+    	auto value_type = ir_manager_.GetIRType(node->expression_->types[0]);
+        if (node->type_ == TokenType::Minus) {
+        	node->result_var = std::make_shared<LocalVar>("", value_type);
+            auto value = std::make_shared<LocalVar>("", value_type);
+        	if (node->expression_->is_assignable_) {
+        		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, value_type, node->expression_->result_var));
+        	} else {
+        		value = node->expression_->result_var;
+        	}
+        	current_block->instructions.emplace_back(std::make_shared<SubInstruction>(node->result_var, value_type, value));
+        }
+    	if (node->type_ == TokenType::Mul) {
+    		node->result_var = std::make_shared<LocalVar>("", value_type);
+    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, value_type, node->expression_->result_var));
+    	}
+    	if (node->type_ == TokenType::And || node->type_ == TokenType::AndMut) {
+    		node->result_var = node->expression_->result_var;
+    	}
+    	if (node->type_ == TokenType::Not) {
+    		node->result_var = std::make_shared<LocalVar>("", value_type);
+    		auto value = std::make_shared<LocalVar>("", value_type);
+    		if (node->expression_->is_assignable_) {
+    			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(value, value_type, node->expression_->result_var));
+    		} else {
+    			value = node->expression_->result_var;
+    		}
+			auto ir_integer_type = dyn_cast<IRIntegerType>(value_type);
+			if (ir_integer_type && ir_integer_type->length == 1) {
+				auto ir_i1_type = value_type;
+				auto bool_value = std::make_shared<LocalVar>("", ir_i1_type);
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(bool_value, ir_i1_type, 1, 0));
+				current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i1_type, value, bool_value));
+			} else if (ir_integer_type && ir_integer_type->length == 32) {
+				auto ir_i32_type = value_type;
+				auto all_ones_value = std::make_shared<LocalVar>("", ir_i32_type);
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(all_ones_value, ir_i32_type, 4294967295, 0));
+				current_block->instructions.emplace_back(std::make_shared<XorInstruction>(node->result_var, ir_i32_type, value, all_ones_value));
+			}
+    	}
+    }
+}
+
+void IRBuilder::visit(FunctionCallExpressionNode *node) {
+	std::shared_ptr<FunctionType> function_type = nullptr;
+	std::string function_name; // We now only consider basic function call.
+	std::vector<std::shared_ptr<IRVar>> args;
+	std::vector<std::shared_ptr<IRType>> arg_types;
+    if (node->callee_) {
+        Visit(node->callee_);
+    	function_type = std::dynamic_pointer_cast<FunctionType>(node->callee_->types[0]);
+        if (auto identifier_pattern = dyn_cast<PathInExpressionNode>(node->callee_)) {
+        	auto len = identifier_pattern->path_indent_segments_.size();
+        	if (len == 1) {
+        		function_name = identifier_pattern->path_indent_segments_[0]->identifier_;
+        	} else {
+        		function_name = identifier_pattern->path_indent_segments_[0]->identifier_ + "." +
+        			identifier_pattern->path_indent_segments_[1]->identifier_;
+        	}
+    	}
+        if (auto method_expression = dyn_cast<MemberAccessExpressionNode>(node->callee_)) {
+    		auto semantic_base_type = method_expression->base_->types[0];
+    		auto ir_base_type = ir_manager_.GetIRType(method_expression->base_->types[0]);
+    		if (ir_base_type) {
+    			auto ir_struct_type = dyn_cast<IRStructType>(ir_base_type);
+    			auto ir_pointer_type = dyn_cast<IRPointerType>(ir_base_type);
+    			if (ir_pointer_type) {
+    				ir_struct_type = dyn_cast<IRStructType>(ir_pointer_type->baseType); // auto deref
+    			}
+    			if (ir_struct_type) {
+    				function_name = ir_struct_type->name + "." + method_expression->member_;
+    			}
+    		}
+        	if (function_type->have_self_) {
+        		auto ir_pointer_type = dyn_cast<IRPointerType>(ir_base_type);
+        		std::shared_ptr<IRType> self_type;
+        		if (ir_pointer_type) {
+        			self_type = ir_base_type;
+        		} else {
+        			self_type = ir_manager_.PointerTo(ir_base_type);
+        		}
+        		auto self_var = std::make_shared<LocalVar>("", self_type);
+        		if (!method_expression->base_->is_assignable_) {
+        			if (ir_pointer_type) {
+        				self_var = method_expression->base_->result_var;
+        			} else {
+        				current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(self_var, ir_base_type));
+        				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_base_type, method_expression->base_->result_var, self_var));
+        			}
+        		} else {
+        			if (ir_pointer_type) {
+        				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(self_var, self_type, method_expression->base_->result_var));
+        			} else {
+        				self_var = method_expression->base_->result_var;
+        			}
+        		}
+        		args.emplace_back(self_var);
+        		arg_types.emplace_back(self_type);
+        	}
+    	}
+    }
+	uint32_t index = 0;
+    for (const auto &param: node->params_) {
+    	auto ir_type = ir_manager_.GetIRType(function_type->params_[index]);
+        if (param) {
+            Visit(param);
+        	auto ir_var = std::make_shared<LocalVar>("", ir_type);
+        	if (param->is_assignable_) {
+        		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(ir_var, ir_type, param->result_var));
+        	} else {
+        		ir_var = param->result_var;
+        	}
+        	args.emplace_back(ir_var);
+        	arg_types.emplace_back(ir_type);
+        }
+    	++index;
+    }
+	if (function_type->ret_) {
+		// Check Struct Type
+		bool is_struct_ret_type = false;
+		if (auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_)) {
+			auto ir_struct_type = ir_manager_.GetIRType(function_type->ret_);
+			auto ir_ret_param_type = ir_manager_.PointerTo(ir_struct_type);
+			auto ir_ret_param = std::make_shared<LocalVar>(".ret", ir_ret_param_type);
+			current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(ir_ret_param, ir_struct_type));
+			args.insert(args.begin(), ir_ret_param);
+			arg_types.insert(arg_types.begin(), ir_ret_param_type);
+			is_struct_ret_type = true;
+		}
+		auto semantic_void_type = scope_manager_.lookup("void").type_;
+		auto ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
+		if (function_type->ret_->equal(semantic_void_type)) {
+			current_block->instructions.emplace_back(std::make_shared<CallWithoutRetInstruction>(function_name, args, arg_types));
+		} else if (is_struct_ret_type) {
+			node->is_assignable_ = true;
+			node->result_var = std::dynamic_pointer_cast<LocalVar>(args[0]);
+			current_block->instructions.emplace_back(std::make_shared<CallWithoutRetInstruction>(function_name, args, arg_types));
+		} else {
+			node->result_var = std::make_shared<LocalVar>("", ir_ret_type);
+			current_block->instructions.emplace_back(std::make_shared<CallWithRetInstruction>(node->result_var, ir_ret_type, function_name, args, arg_types));
+		}
+	}
+}
+
+void IRBuilder::visit(ArrayIndexExpressionNode *node) {
+	node->is_assignable_ = true;
+	if (node->base_) {
+		Visit(node->base_);
+	}
+	if (node->index_) {
+		Visit(node->index_);
+	}
+    std::shared_ptr<IRArrayType> type;
+	auto ir_type = ir_manager_.GetIRType(node->types[0]);
+	auto node_base_type = ir_manager_.GetIRType(node->base_->types[0]);
+
+	// Consider auto_deref
+	std::shared_ptr<LocalVar> prev_var = node->base_->result_var;
+	std::shared_ptr<LocalVar> re_var = prev_var;
+	for (uint32_t i = 0; i < node->auto_deref_count; i++) {
+		auto base_type = shared_dyn_cast<IRPointerType>(prev_var->type);
+		re_var = std::make_shared<LocalVar>("", base_type->baseType);
+		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(re_var, base_type, prev_var));
+		prev_var = re_var;
+	}
+
+	node->result_var = std::make_shared<LocalVar>("", ir_manager_.PointerTo(ir_type));
+	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+
+	auto index_var = std::make_shared<LocalVar>("", ir_i32_type);
+	if (node->index_->is_assignable_) {
+		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(index_var, ir_i32_type, node->index_->result_var));
+	} else {
+		index_var = node->index_->result_var;
+	}
+
+	// Fix: Check if base type is a pointer to an array
+	// If so, we need a leading 0 index for correct LLVM IR semantics
+	auto ptr_type = dyn_cast<IRPointerType>(re_var->type);
+	bool need_leading_zero = false;
+	std::shared_ptr<IRType> gep_base_type = ir_type;
+
+	if (ptr_type && isa<IRArrayType>(ptr_type->baseType)) {
+		// The base is a pointer to an array, need leading zero
+		need_leading_zero = true;
+		gep_base_type = ptr_type->baseType;
+	}
+
+	if (need_leading_zero) {
+		// Use two indices: [0, index]
+		std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type, ir_i32_type});
+		auto zero_var = std::make_shared<LocalVar>("", ir_i32_type);
+		current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_var, ir_i32_type, 0, 0));
+		std::vector<std::shared_ptr<IRVar>> index_value({zero_var, index_var});
+		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var, gep_base_type, re_var, index_type, index_value));
+	} else {
+		// Use single index
+		std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type});
+		std::vector<std::shared_ptr<IRVar>> index_value({index_var});
+		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var, ir_type, re_var, index_type, index_value));
+	}
+}
+
+void IRBuilder::visit(MemberAccessExpressionNode *node) {
+	node->is_assignable_ = true;
+    if (node->base_) {
+        Visit(node->base_);
+    }
+	auto type = node->base_->types[0];
+	std::string identifier = node->member_;
+	// consider auto-deref
+	auto struct_type = std::dynamic_pointer_cast<StructType>(type);
+	auto pointer_type = std::dynamic_pointer_cast<ReferenceType>(type);
+	if (pointer_type) {
+		struct_type = std::dynamic_pointer_cast<StructType>(pointer_type->type_);
+	}
+	if (struct_type) {
+		for (uint32_t i = 0; i < struct_type->members_.size(); i++) {
+			if (struct_type->members_[i].name_ == identifier) {
+				auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+				auto ir_type = ir_manager_.GetIRType(struct_type->members_[i].type_);
+				// Fix: use two indices [0, field_index] for correct struct field access
+				std::vector<std::shared_ptr<IRType>> index_type({ir_i32_type, ir_i32_type});
+				std::vector<std::shared_ptr<IRLiteral>> index_value({std::make_shared<LiteralInt>(0), std::make_shared<LiteralInt>(i)});
+				node->result_var = std::make_shared<LocalVar>("", ir_manager_.PointerTo(ir_type));
+				// Fix: use struct type instead of field type as the base type
+				auto ir_struct_type = ir_manager_.GetIRType(struct_type);
+				auto base_val = node->base_->result_var;
+				if (pointer_type && node->base_->is_assignable_) {
+					auto loaded_base = std::make_shared<LocalVar>("", ir_manager_.PointerTo(ir_struct_type));
+					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(loaded_base, ir_manager_.PointerTo(ir_struct_type), node->base_->result_var));
+					base_val = loaded_base;
+				}
+				current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>(node->result_var,
+					ir_struct_type, base_val, index_type, index_value));
+			}
+		}
+	}
+}
+
+void IRBuilder::visit(BlockExpressionNode *node) {
+    scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->scope_index]);
+
+	if (node->statements_) {
+		for (const auto& item: node->statements_->statements_) {
+			auto vis_item = dyn_cast<VisItemStatementNode>(item);
+			if (!vis_item) { continue; }
+			auto const_item = dyn_cast<ConstantItemNode>(vis_item->vis_item_node_);
+			if (const_item) {
+				auto const_var = std::make_shared<ConstVar>(const_item->identifier_, std::make_shared<IRIntegerType>(32));
+				auto val = std::get_if<int64_t>(&const_item->expression_node_->value);
+				if (val) {
+					auto ir_literal = std::make_shared<LiteralInt>(*val);
+					ir_program->constants.emplace_back(std::make_shared<ConstVarDefInstruction>(const_var, ir_literal));
+				}
+			}
+		}
+
+		for (const auto& item: node->statements_->statements_) {
+			auto vis_item = dyn_cast<VisItemStatementNode>(item);
+			if (!vis_item) { continue; }
+			auto struct_item = dyn_cast<StructNode>(vis_item->vis_item_node_);
+			if (struct_item) {
+				auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
+				ir_manager_.AddType(struct_type);
+			}
+		}
+	}
+
+	auto ir_type = ir_manager_.GetIRType(node->types[0]);
+	bool is_aggregate = isa<IRStructType>(ir_type) || isa<IRArrayType>(ir_type);
+	if (is_aggregate) {
+		node->result_var = std::make_shared<LocalVar>("", ir_manager_.PointerTo(ir_type));
+		node->is_assignable_ = true;
+	} else {
+		node->result_var = std::make_shared<LocalVar>("", ir_type);
+	}
+
+	if (node->statements_) {
+        Visit(node->statements_);
+		ExpressionNode *trailing_expression = nullptr;
+		if (node->statements_->expression_) {
+			trailing_expression = node->statements_->expression_;
+		} else if (!node->statements_->statements_.empty()){
+			uint32_t len = node->statements_->statements_.size();
+			auto trailing_statement = dyn_cast<ExpressionStatementNode>(node->statements_->statements_[len - 1]);
+			if (trailing_statement && !trailing_statement->has_semicolon_) {
+				trailing_expression = trailing_statement->expression_;
+			}
+		}
+		if (trailing_expression) {
+			if (trailing_expression->is_assignable_) {
+				if (is_aggregate) {
+					node->result_var = trailing_expression->result_var;
+				} else {
+					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_type, trailing_expression->result_var));
+				}
+			} else {
+				node->result_var = trailing_expression->result_var;
+			}
+		}
+    }
+	if (node->is_function_direct_block && ir_type) {
+		auto ir_void_type = dyn_cast<IRVoidType>(ir_type);
+		auto ir_struct_type = shared_dyn_cast<IRStructType>(ir_type);
+		if (ir_void_type) {
+			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, nullptr));
+		} else if (ir_struct_type) {
+			auto ir_ret_void_type = std::make_shared<IRVoidType>();
+			ExpressionNode *trailing_expression = nullptr;
+			if (node->statements_) {
+				if (node->statements_->expression_) {
+					trailing_expression = node->statements_->expression_;
+				} else if (!node->statements_->statements_.empty()){
+					uint32_t len = node->statements_->statements_.size();
+					auto trailing_statement = dyn_cast<ExpressionStatementNode>(node->statements_->statements_[len - 1]);
+					if (trailing_statement && !trailing_statement->has_semicolon_) {
+						trailing_expression = trailing_statement->expression_;
+					}
+				}
+			}
+			if (trailing_expression && trailing_expression->is_assignable_) {
+				EmitStructCopy(current_block, entry_block, current_function, current_struct_ret_var, trailing_expression->result_var, ir_struct_type);
+			} else {
+				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_type, node->result_var, current_struct_ret_var));
+			}
+			current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_ret_void_type, nullptr));
+		} else {
+			if (isa<IRArrayType>(ir_type) && node->is_assignable_) {
+				auto val = std::make_shared<LocalVar>("", ir_type);
+				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(val, ir_type, node->result_var));
+				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, val));
+			} else {
+				current_block->instructions.emplace_back(std::make_shared<RetInstruction>(ir_type, node->result_var));
+			}
+		}
+	}
+
+
+	if (node->statements_) {
+		for (const auto& item: node->statements_->statements_) {
+			auto vis_item = dyn_cast<VisItemStatementNode>(item);
+			if (!vis_item) { continue; }
+			auto struct_item = dyn_cast<StructNode>(vis_item->vis_item_node_);
+			if (struct_item) {
+				auto struct_type = scope_manager_.lookup(struct_item->identifier_).type_;
+				ir_manager_.AddType(struct_type);
+				auto ir_struct_type = shared_dyn_cast<IRStructType>(ir_manager_.GetIRType(struct_type));
+				ir_program->structs.emplace_back(std::make_shared<StructDefInstruction>(ir_struct_type, ir_struct_type->members));
+
+				for (auto& method : struct_type->methods_) {
+					auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
+					std::vector<IRFunctionParam> ir_function_params;
+					if (function_type) {
+						std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+						auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
+						if (possible_struct_type) {
+							method.function_node_->is_struct_type = true;
+							auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(function_type->ret_));
+							method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+							ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
+						} else {
+							ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
+						}
+						if (function_type->have_self_) {
+							auto ir_pointer_struct_type = ir_manager_.PointerTo(ir_struct_type);
+							auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
+							ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
+						}
+						uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
+						for (auto& param: function_type->params_) {
+							auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
+							auto param_type = ir_manager_.GetIRType(param);
+							auto identifier_pattern = dyn_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
+							if (identifier_pattern) {
+								std::string identifier = identifier_pattern->identifier_;
+								auto ir_var = std::make_shared<LocalVar>(identifier, param_type);
+								ir_function_params.emplace_back(param_type, ir_var);
+							}
+							++index;
+						}
+						std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
+						auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
+						ir_program->functions.emplace_back(ir_function);
+						ir_manager_.function_map_[GlobalInterner().Intern(ir_identifier)] = ir_function;
+						method.function_node_->identifier_ = ir_identifier;
+						Visit(method.function_node_);
+					}
+				}
+				for (auto& method : struct_type->inline_functions_) {
+					auto function_type = std::dynamic_pointer_cast<FunctionType>(method.type_);
+					std::vector<IRFunctionParam> ir_function_params;
+					if (function_type) {
+						std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+						if (function_type->ret_) {
+							auto possible_struct_type = std::dynamic_pointer_cast<StructType>(function_type->ret_);
+							if (possible_struct_type) {
+								method.function_node_->is_struct_type = true;
+								auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(function_type->ret_));
+								method.function_node_->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+								ir_function_params.emplace_back(pointer_type, method.function_node_->struct_ret_var);
+							} else {
+								ir_ret_type = ir_manager_.GetIRType(function_type->ret_);
+							}
+						}
+						if (function_type->have_self_) {
+							auto ir_pointer_struct_type = ir_manager_.PointerTo(ir_struct_type);
+							auto ir_var = std::make_shared<LocalVar>("self", ir_pointer_struct_type);
+							ir_function_params.emplace_back(ir_pointer_struct_type, ir_var);
+						}
+						uint32_t index = 0; // 开始为 semantic_function_type 没有存 identifier 买单了
+						for (auto& param: function_type->params_) {
+							auto semantic_param = method.function_node_->function_parameters_->function_params_[index];
+							auto param_type = ir_manager_.GetIRType(param);
+							auto identifier_pattern = dyn_cast<IdentifierPatternNode>(semantic_param->pattern_no_top_alt_node_);
+							if (identifier_pattern) {
+								std::string identifier = identifier_pattern->identifier_;
+								auto ir_var = std::make_shared<LocalVar>(identifier, param_type);
+								ir_function_params.emplace_back(param_type, ir_var);
+							}
+							++index;
+						}
+						std::string ir_identifier = struct_item->identifier_ + "." + method.name_;
+						auto ir_function = std::make_shared<IRFunction>(ir_identifier, ir_ret_type, ir_function_params);
+						ir_program->functions.emplace_back(ir_function);
+						ir_manager_.function_map_[GlobalInterner().Intern(ir_identifier)] = ir_function;
+						method.function_node_->identifier_ = ir_identifier;
+						Visit(method.function_node_);
+					}
+				}
+			}
+		}
+
+		for (const auto& item: node->statements_->statements_) {
+			auto vis_item = dyn_cast<VisItemStatementNode>(item);
+			if (!vis_item) { continue; }
+			auto func_item = dyn_cast<FunctionNode>(vis_item->vis_item_node_);
+			if (func_item) {
+				std::vector<IRFunctionParam> ir_function_params;
+				std::shared_ptr<IRType> ir_ret_type = std::make_shared<IRVoidType>();
+				if (func_item->type_) {
+					auto semantic_ret_type = func_item->type_->type;
+					auto possible_struct_type = std::dynamic_pointer_cast<StructType>(semantic_ret_type);
+					if (possible_struct_type) {
+						func_item->is_struct_type = true;
+						auto pointer_type = ir_manager_.PointerTo(ir_manager_.GetIRType(semantic_ret_type));
+						func_item->struct_ret_var = std::make_shared<LocalVar>(".ret", pointer_type);
+						ir_function_params.emplace_back(pointer_type, func_item->struct_ret_var);
+					} else {
+						ir_ret_type = ir_manager_.GetIRType(semantic_ret_type);
+					}
+				}
+				auto parameters = func_item->function_parameters_;
+				if (parameters) {
+					for (auto& param : parameters->function_params_) {
+						auto param_type = ir_manager_.GetIRType(param->type_->type);
+						auto identifier_pattern = dyn_cast<IdentifierPatternNode>(param->pattern_no_top_alt_node_);
+						auto ir_var = std::make_shared<LocalVar>(identifier_pattern->identifier_, param_type);
+						ir_function_params.emplace_back(param_type, ir_var);
+					}
+				}
+				auto ir_function = std::make_shared<IRFunction>(func_item->identifier_, ir_ret_type, ir_function_params);
+				ir_program->functions.emplace_back(ir_function);
+				ir_manager_.function_map_[GlobalInterner().Intern(func_item->identifier_)] = ir_function;
+				Visit(item);
+			}
+		}
+	}
+
+    scope_manager_.PopScope();
+}
+
+void IRBuilder::visit(PredicateLoopExpressionNode *node) {
+	auto condition_block = std::make_shared<IRBasicBlock>("condition");
+	auto body_block = std::make_shared<IRBasicBlock>("body");
+	auto combine_block = std::make_shared<IRBasicBlock>("combine");
+	auto saved_current_loop_condition = ir_manager_.current_loop_condition;
+	auto saved_current_loop_combine = ir_manager_.current_loop_combine;
+	ir_manager_.current_loop_condition = condition_block;
+	ir_manager_.current_loop_combine = combine_block;
+	if (node->conditions_) {
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(condition_block->true_label));
+		current_function->blocks.emplace_back(condition_block);
+		current_block = condition_block;
+		Visit(node->conditions_);
+
+		auto condition_expr = node->conditions_->expression_;
+    	auto condition_var = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
+    	if (condition_expr->is_assignable_) {
+    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(condition_var, std::make_shared<IRIntegerType>(1), condition_expr->result_var));
+    	} else {
+    		condition_var = condition_expr->result_var;
+    	}
+
+		auto long_branch_exit = std::make_shared<IRBasicBlock>("long_branch_exit");
+		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(
+			condition_var, body_block->true_label, long_branch_exit->true_label));
+		current_function->blocks.emplace_back(long_branch_exit);
+		long_branch_exit->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
+	}
+	if (node->block_expression_) {
+		current_function->blocks.emplace_back(body_block);
+		current_block = body_block;
+		Visit(node->block_expression_);
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(condition_block->true_label));
+	}
+	current_function->blocks.emplace_back(combine_block);
+	current_block = combine_block;
+	ir_manager_.current_loop_condition = saved_current_loop_condition;
+	ir_manager_.current_loop_combine = saved_current_loop_combine;
+}
+
+void IRBuilder::visit(IfExpressionNode *node) {
+	auto if_true_block = std::make_shared<IRBasicBlock>("if_true");
+	auto if_false_block = std::make_shared<IRBasicBlock>("if_false");
+	auto combine_block = std::make_shared<IRBasicBlock>("combine");
+	interrupt = false;
+    if (node->conditions_) {
+	    Visit(node->conditions_);
+    	auto condition_expr = node->conditions_->expression_;
+    	auto condition_var = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
+    	if (condition_expr->is_assignable_) {
+    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(condition_var, std::make_shared<IRIntegerType>(1), condition_expr->result_var));
+    	} else {
+    		condition_var = condition_expr->result_var;
+    	}
+    	if (condition_expr) {
+			auto long_branch_false = std::make_shared<IRBasicBlock>("long_branch_false");
+    		current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(condition_var, if_true_block->true_label, long_branch_false->true_label));
+			current_function->blocks.emplace_back(long_branch_false);
+			long_branch_false->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(if_false_block->true_label));
+    	}
+    }
+
+	std::shared_ptr<IRBasicBlock> phi_block_1 = nullptr, phi_block_2 = nullptr;
+	bool true_branch_interrupted = false;
+	bool false_branch_interrupted = false;
+
+	current_function->blocks.emplace_back(if_true_block);
+	current_block = if_true_block;
+    if (node->true_block_expression_) {
+	    Visit(node->true_block_expression_);
+    	if (!interrupt) {
+    		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
+    	} else {
+    		true_branch_interrupted = true;
+    	}
+    	interrupt = false;
+    	phi_block_1 = current_block;
+    }
+	current_function->blocks.emplace_back(if_false_block);
+	current_block = if_false_block;
+	if (node->false_block_expression_) {
+		Visit(node->false_block_expression_);
+	}
+    if (node->if_expression_) {
+	    Visit(node->if_expression_);
+	}
+	if (!interrupt) {
+		current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(combine_block->true_label));
+	} else {
+		false_branch_interrupted = true;
+		interrupt = false;
+	}
+	phi_block_2 = current_block;
+	current_function->blocks.emplace_back(combine_block);
+	current_block = combine_block;
+
+	if (true_branch_interrupted && false_branch_interrupted) {
+		current_block->instructions.emplace_back(std::make_shared<UnreachableInstruction>());
+		interrupt = true;
+	}
+
+	if (node->false_block_expression_) {
+		if (node->true_block_expression_->result_var && node->false_block_expression_->result_var) {
+			std::shared_ptr<IRVar> true_value = node->true_block_expression_->result_var;
+			std::shared_ptr<IRVar> false_value = node->false_block_expression_->result_var;
+			auto ir_type = ir_manager_.GetIRType(node->types[0]);
+			if (ir_type && !isa<IRVoidType>(ir_type)) {
+				if (isa<IRStructType>(ir_type) || isa<IRArrayType>(ir_type)) {
+					ir_type = ir_manager_.PointerTo(ir_type);
+					node->is_assignable_ = true;
+				}
+				node->result_var = std::make_shared<LocalVar>("", ir_type);
+				std::vector value_table{true_value, false_value};
+				current_block->instructions.emplace_back(std::make_shared<PhiInstruction>(node->result_var, ir_type,
+					value_table, std::vector{phi_block_1->true_label, phi_block_2->true_label}));
+			}
+		}
+	}
+	if (node->if_expression_) {
+		if (node->true_block_expression_->result_var && node->if_expression_->result_var) {
+			std::shared_ptr<IRVar> true_value = node->true_block_expression_->result_var;
+			std::shared_ptr<IRVar> false_value = node->if_expression_->result_var;
+			auto ir_type = ir_manager_.GetIRType(node->types[0]);
+			if (ir_type) {
+				if (isa<IRStructType>(ir_type) || isa<IRArrayType>(ir_type)) {
+					ir_type = ir_manager_.PointerTo(ir_type);
+					node->is_assignable_ = true;
+				}
+				node->result_var = std::make_shared<LocalVar>("", ir_type);
+				std::vector value_table{true_value, false_value};
+				current_block->instructions.emplace_back(std::make_shared<PhiInstruction>(node->result_var, ir_type,
+					value_table, std::vector{phi_block_1->true_label, phi_block_2->true_label}));
+			}
+		}
+	}
+}
+
+void IRBuilder::visit(CharLiteralNode *node) {
+    node -> is_compiler_known_ = true;
+}
+
+void IRBuilder::visit(StringLiteralNode *node) {
+    node->is_compiler_known_ = true;
+    node->value = node->string_literal_;
+}
+
+void IRBuilder::visit(CStringLiteralNode *node) {
+    node->is_compiler_known_ = true;
+    node->value = node->c_string_literal_;
+}
+
+void IRBuilder::visit(IntLiteralNode *node) {
+    node->value = node->int_literal_;
+	auto ir_i32_type = std::make_shared<IRIntegerType>(32);
+	node->result_var = std::make_shared<LocalVar>("", ir_i32_type);
+	auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_i32_type, node->int_literal_, 0);
+	current_block->instructions.emplace_back(add_instruction);
+}
+
+void IRBuilder::visit(BoolLiteralNode *node) {
+	node->value = node->bool_literal_;
+	auto ir_i1_type = std::make_shared<IRIntegerType>(1);
+	node->result_var = std::make_shared<LocalVar>("", ir_i1_type);
+	auto add_instruction = std::make_shared<AddInstruction>(node->result_var, ir_i1_type, node->bool_literal_, 0);
+	current_block->instructions.emplace_back(add_instruction);
+}
+
+void IRBuilder::visit(ArrayLiteralNode *node) {
+	node->is_assignable_ = true;
+	for (const auto &expr: node->expressions_) {
+        if (expr) {
+            Visit(expr);
+        }
+    }
+	if (node->lhs_) {
+		Visit(node->lhs_);
+	}
+	auto ir_type = ir_manager_.GetIRType(node->types[0]);
+	node->result_var = std::make_shared<LocalVar>("", ir_manager_.PointerTo(ir_type));
+	current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(node->result_var, ir_type));
+	auto ir_array_type = shared_dyn_cast<IRArrayType>(ir_type);
+	StoreArrayLiteral(node, node->result_var, ir_array_type);
+}
+
+void IRBuilder::visit(PathInExpressionNode *node) {
+    for (const auto &seg: node->path_indent_segments_) {
+        if (seg) Visit(seg);
+    }
+    uint32_t len = node -> path_indent_segments_.size();
+    if (len == 2) {
+        std::string type_name = node -> path_indent_segments_[0]->identifier_;
+        std::string func_name = node -> path_indent_segments_[1]->identifier_;
+        const Symbol &symbol = scope_manager_.lookup(type_name);
+        for (auto& it: symbol.type_ -> constants_) {
+            if (it.name_ == func_name) {
+                node -> is_compiler_known_ = true;
+                auto value = symbol.type_->value_map[it.name_];
+                if (auto* tmp = std::get_if<int64_t>(&value)) {
+                    node -> value = *tmp;
+                }
+                return;
+            }
+        }
+    }
+    if (len == 1) {
+    	std::string name = node->path_indent_segments_[0]->identifier_;
+    	const Symbol &sym = scope_manager_.lookup(node->path_indent_segments_[0]->atom_);
+    	if (sym.symbol_type_ == SymbolType::Variable) {
+    		if (!node->types.empty()) {
+    			auto ir_type = ir_manager_.GetIRType(node->types[0]);
+    			if (sym.is_const_) {
+    				node->result_var = std::make_shared<ConstVar>(name, ir_type, false);
+    			} else {
+    				node->result_var = std::make_shared<LocalVar>(name, ir_type, false);
+    			}
+    		}
+    	}
+    }
+}
+
+void IRBuilder::visit(StructExpressionNode *node) {
+	node->is_assignable_ = true;
+    if (node->path_in_expression_node_) {
+        Visit(node->path_in_expression_node_);
+    }
+	auto struct_type = shared_dyn_cast<IRStructType>(ir_manager_.GetIRType(node->types[0]));
+	if (!struct_type) return;
+	node->result_var = std::make_shared<LocalVar>("", ir_manager_.PointerTo(struct_type));
+	current_block->instructions.emplace_back(std::make_shared<AllocaInstruction>(node->result_var, struct_type));
+	if (node->struct_expr_fields_node_) {
+	    Visit(node->struct_expr_fields_node_);
+    	auto struct_expr_field_nodes = node->struct_expr_fields_node_->struct_expr_field_nodes_;
+    	uint32_t index = 0;
+    	for (const auto& field: struct_expr_field_nodes) {
+    		std::shared_ptr<IRType> index_type = std::make_shared<IRIntegerType>(32);
+    		std::shared_ptr<IRLiteral> index_value_0 = std::make_shared<LiteralInt>(0);
+    		std::shared_ptr<IRLiteral> index_value = std::make_shared<LiteralInt>(index);
+    		auto element_type = struct_type->members[index];
+    		auto local_ptr = std::make_shared<LocalVar>("", ir_manager_.PointerTo(element_type));
+    		// Fix: use two indices [0, field_index] and struct type for correct field initialization
+    		current_block->instructions.emplace_back(std::make_shared<GetElementPtrInstruction>
+    			(local_ptr, struct_type, node->result_var, std::vector{index_type, index_type}, std::vector{index_value_0, index_value}));
+    		if (auto ir_array_type = shared_dyn_cast<IRArrayType>(struct_type->members[index])) {
+				if (dyn_cast<ArrayLiteralNode>(field->expression_node_)) {
+	    			StoreArrayLiteral(field->expression_node_, local_ptr, ir_array_type);
+				} else {
+					if (field->expression_node_->is_assignable_) {
+						EmitStructCopy(current_block, entry_block, current_function, local_ptr, field->expression_node_->result_var, ir_array_type);
+					} else {
+						current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, field->expression_node_->result_var, local_ptr));
+					}
+				}
+    			index++;
+    			continue;
+    		}
+			if (auto ir_struct_type = shared_dyn_cast<IRStructType>(struct_type->members[index])) {
+				if (field->expression_node_->is_assignable_) {
+					EmitStructCopy(current_block, entry_block, current_function, local_ptr, field->expression_node_->result_var, ir_struct_type);
+				} else {
+					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, field->expression_node_->result_var, local_ptr));
+				}
+				index++;
+				continue;
+			}
+    		auto element_value = std::make_shared<LocalVar>("", element_type);
+    		if (field->expression_node_->is_assignable_) {
+    			current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(element_value, element_type, field->expression_node_->result_var));
+    		} else {
+    			element_value = field->expression_node_->result_var;
+    		}
+    		current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(element_type, element_value, local_ptr));
+    		index++;
+    	}
+    }
+    if (node->struct_base_node_) Visit(node->struct_base_node_);
+}
+
+void IRBuilder::visit(GroupedExpressionNode *node) {
+    if (node->expression_) {
+        Visit(node->expression_);
+        node->types = node->expression_->types;
+    	auto ir_type = ir_manager_.GetIRType(node->types[0]);
+    	node->result_var = std::make_shared<LocalVar>("", ir_type);
+    	if (node->expression_->is_assignable_) {
+    		current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(node->result_var, ir_type, node->expression_->result_var));
+    	} else {
+    		node->result_var = node->expression_->result_var;
+    	}
+    }
+}
+
+void IRBuilder::visit(ConditionsNode *node) {
+    if (node->expression_) {
+        Visit(node->expression_);
+    }
+}
+
+void IRBuilder::visit(LetChainNode *node) {
+}
+
+void IRBuilder::visit(LetChainConditionNode *node) {
+}
+
+
+void IRBuilder::visit(ArrayTypeNode *node) {
+}
+
+void IRBuilder::visit(SliceTypeNode *node) {
+    std::shared_ptr<Type> base_type;
+    if (node->type_) {
+        Visit(node->type_);
+    }
+}
+
+void IRBuilder::visit(ReferenceTypeNode *node) {
+    if (node->type_node_) {
+        Visit(node->type_node_);
+    }
+    node -> type = GlobalTypeContext().Reference(node->type_node_->type, node->is_mut_);
+}
+
+
+/**************** Supporting Functions ****************/
+void IRBuilder::StoreArrayLiteral(ExpressionNode *expr_node, const std::shared_ptr<LocalVar>& array_var,
+                                  const std::shared_ptr<IRArrayType>& array_type) {
+	auto array_literal = dyn_cast<ArrayLiteralNode>(expr_node);
+	if (array_literal) {
+		if (!array_literal->expressions_.empty()) {
+			uint32_t cnt = 0;
+			for (const auto& expr : array_literal->expressions_) {
+				auto ir_element_type = array_type->baseType;
+				auto element_var = std::make_shared<LocalVar>("", ir_element_type);
+				std::vector index_types({ir_element_type});
+				std::vector<std::shared_ptr<IRLiteral>> index_values({std::make_shared<LiteralInt>(cnt)});
+				auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, ir_element_type, array_var, index_types, index_values);
+				current_block->instructions.emplace_back(get_element_ptr_inst);
+				auto possible_array_type = shared_dyn_cast<IRArrayType>(ir_element_type);
+				if (possible_array_type) {
+					StoreArrayLiteral(expr, element_var, possible_array_type);
+				} else {
+					auto var = std::make_shared<LocalVar>("", ir_element_type);
+					if (expr->is_assignable_) {
+						current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, expr->result_var));
+					} else {
+						var = expr->result_var;
+					}
+					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
+				}
+				cnt++;
+			}
+		}
+		if (array_literal->lhs_ && array_literal->rhs_) {
+			auto ir_element_type = array_type->baseType;
+			auto value = *std::get_if<int64_t>(&array_literal->rhs_->value);
+			
+			if (value > 8) {
+				auto i32_type = std::make_shared<IRIntegerType>(32);
+				auto i_var = std::make_shared<LocalVar>(".i", i32_type);
+				entry_block->instructions.insert(entry_block->instructions.begin(), std::make_shared<AllocaInstruction>(i_var, i32_type));
+				
+				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, std::make_shared<LiteralInt>(0), i_var));
+				
+				auto cond_block = std::make_shared<IRBasicBlock>("array_init_cond");
+				auto body_block = std::make_shared<IRBasicBlock>("array_init_body");
+				auto end_block = std::make_shared<IRBasicBlock>("array_init_end");
+				
+				current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
+				
+				current_function->blocks.emplace_back(cond_block);
+				current_block = cond_block;
+				auto i_val = std::make_shared<LocalVar>("", i32_type);
+				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val, i32_type, i_var));
+				
+				auto limit_val = std::make_shared<LocalVar>("", i32_type);
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(limit_val, i32_type, (int)value, 0));
+
+				auto cmp_res = std::make_shared<LocalVar>("", std::make_shared<IRIntegerType>(1));
+				current_block->instructions.emplace_back(std::make_shared<ICmpInstruction>(cmp_res, i32_type, i_val, limit_val, ConditionType::slt));
+				current_block->instructions.emplace_back(std::make_shared<ConditionalBrInstruction>(cmp_res, body_block->true_label, end_block->true_label));
+				
+				current_function->blocks.emplace_back(body_block);
+				current_block = body_block;
+				
+				auto element_var = std::make_shared<LocalVar>("", ir_element_type);
+				auto i_val_body = std::make_shared<LocalVar>("", i32_type);
+				current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(i_val_body, i32_type, i_var));
+				
+				auto zero_val = std::make_shared<LocalVar>("", i32_type);
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(zero_val, i32_type, 0, 0));
+				
+				std::vector<std::shared_ptr<IRType>> index_types({i32_type, i32_type});
+				std::vector<std::shared_ptr<IRVar>> index_vars({zero_val, i_val_body});
+				
+				auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, array_type, array_var, index_types, index_vars);
+				current_block->instructions.emplace_back(get_element_ptr_inst);
+				
+				auto possible_array_type = shared_dyn_cast<IRArrayType>(ir_element_type);
+				if (possible_array_type) {
+					StoreArrayLiteral(array_literal->lhs_, element_var, possible_array_type);
+				} else {
+					auto var = std::make_shared<LocalVar>("", ir_element_type);
+					if (array_literal->lhs_->is_assignable_) {
+						current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, array_literal->lhs_->result_var));
+					} else {
+						var = array_literal->lhs_->result_var;
+					}
+					current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
+				}
+				
+				auto i_next = std::make_shared<LocalVar>("", i32_type);
+				auto one_val = std::make_shared<LocalVar>("", i32_type);
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(one_val, i32_type, 1, 0));
+				current_block->instructions.emplace_back(std::make_shared<AddInstruction>(i_next, i32_type, i_val_body, one_val));
+				current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(i32_type, i_next, i_var));
+				
+				current_block->instructions.emplace_back(std::make_shared<UnconditionalBrInstruction>(cond_block->true_label));
+				
+				current_function->blocks.emplace_back(end_block);
+				current_block = end_block;
+			} else {
+				auto var = std::make_shared<LocalVar>("", ir_element_type);
+				if (array_literal->lhs_->is_assignable_) {
+					current_block->instructions.emplace_back(std::make_shared<LoadInstruction>(var, ir_element_type, array_literal->lhs_->result_var));
+				} else {
+					var = array_literal->lhs_->result_var;
+				}
+				for (uint32_t i = 0; i < value; i++) {
+					auto element_var = std::make_shared<LocalVar>("", ir_element_type);
+					std::vector index_types({ir_element_type});
+					std::vector<std::shared_ptr<IRLiteral>> index_values({std::make_shared<LiteralInt>(i)});
+					auto get_element_ptr_inst = std::make_shared<GetElementPtrInstruction>(element_var, ir_element_type, array_var, index_types, index_values);
+					current_block->instructions.emplace_back(get_element_ptr_inst);
+					auto possible_array_type = shared_dyn_cast<IRArrayType>(ir_element_type);
+					if (possible_array_type) {
+						StoreArrayLiteral(array_literal->lhs_, element_var, possible_array_type);
+					} else {
+						current_block->instructions.emplace_back(std::make_shared<StoreInstruction>(ir_element_type, var, element_var));
+					}
+				}
+			}
+		}
+	}
+}
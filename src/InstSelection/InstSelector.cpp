@@ -14,17 +14,18 @@ std::shared_ptr<Register> InstSelector::new_vreg() {
 }
 
 std::shared_ptr<Register> InstSelector::get_operand(const std::shared_ptr<IRVar> &var) {
-    if (var_map.find(var->true_name) == var_map.end()) {
-        var_map[var->true_name] = new_vreg();
+    auto [it, inserted] = var_map.try_emplace(var->true_atom);
+    if (inserted) {
+        it->second = new_vreg();
         if (var->var_type == VarType::Global || std::dynamic_pointer_cast<ConstVar>(var)) {
             if (cur_block) {
                 cur_block->AddInstruction(std::make_shared<ASMLaInstruction>(
-                    var_map[var->true_name], var->true_name
+                    it->second, var->true_name
                 ));
             }
         }
     }
-    return var_map[var->true_name];
+    return it->second;
 }
 
 std::shared_ptr<Register> InstSelector::get_temp_operand() {
@@ -99,7 +100,7 @@ void InstSelector::visit(IRFunctionParam *node) {
 void InstSelector::visit(IRBasicBlock *node) {
     cur_block = std::make_shared<ASMBlock>(node->true_label);
     cur_func->AddBlock(cur_block);
-    block_map[node->true_label] = cur_block;
+    block_map[node->true_atom] = cur_block;
     for (auto &inst : node->instructions) {
         inst->accept(this);
     }
@@ -504,8 +505,9 @@ void InstSelector::visit(PhiInstruction *node) {
     for (size_t i = 0; i < node->values.size(); ++i) {
         auto val = get_operand(node->values[i]);
         auto label = node->labels[i];
-        if (block_map.count(label)) {
-            auto blk = block_map[label];
+        auto blk_it = block_map.find(GlobalInterner().Intern(label));
+        if (blk_it != block_map.end()) {
+            auto blk = blk_it->second;
             if (!blk->instructions.empty()) {
                 auto insert_pos = blk->instructions.end();
                 auto r_it = blk->instructions.rbegin();
@@ -517,7 +519,7 @@ void InstSelector::visit(PhiInstruction *node) {
                        opcode == ASMOpcode::BLTU || opcode == ASMOpcode::BGEU); 
                     
                     if (is_term) {
-                        if (opcode == ASMOpcode::JAL && std::dynamic_pointer_cast<ASMCallInstruction>(*r_it)) {
+                        if (opcode == ASMOpcode::JAL && isa<ASMCallInstruction>(*r_it)) {
                             is_term = false; // Call is not terminator
                         }
                     }
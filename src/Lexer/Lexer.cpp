@@ -1,218 +1,428 @@
+#include <cstring>
 #include "Error.h"
+#include "Lexer/Keyword.h"
 #include "Lexer/Lexer.h"
+#include "Lexer/ScanKernels.h"
 
-Lexer::Lexer() {
-    letter_rules.emplace_back(TokenType::As, std::regex("as"));
-    letter_rules.emplace_back(TokenType::Break, std::regex("break"));
-    letter_rules.emplace_back(TokenType::Const, std::regex("const"));
-    letter_rules.emplace_back(TokenType::Continue, std::regex("continue"));
-    letter_rules.emplace_back(TokenType::Crate, std::regex("crate"));
-    letter_rules.emplace_back(TokenType::Else, std::regex("else"));
-    letter_rules.emplace_back(TokenType::Enum, std::regex("enum"));
-    letter_rules.emplace_back(TokenType::False, std::regex("false"));
-    letter_rules.emplace_back(TokenType::Fn, std::regex("fn"));
-    letter_rules.emplace_back(TokenType::For, std::regex("for"));
-    letter_rules.emplace_back(TokenType::If, std::regex("if"));
-    letter_rules.emplace_back(TokenType::Impl, std::regex("impl"));
-    letter_rules.emplace_back(TokenType::In, std::regex("in"));
-    letter_rules.emplace_back(TokenType::Let, std::regex("let"));
-    letter_rules.emplace_back(TokenType::Loop, std::regex("loop"));
-    letter_rules.emplace_back(TokenType::Match, std::regex("match"));
-    letter_rules.emplace_back(TokenType::Mod, std::regex("mod"));
-    letter_rules.emplace_back(TokenType::Move, std::regex("move"));
-    letter_rules.emplace_back(TokenType::Mut, std::regex("mut"));
-    letter_rules.emplace_back(TokenType::Ref, std::regex("ref"));
-    letter_rules.emplace_back(TokenType::Return, std::regex("return"));
-    letter_rules.emplace_back(TokenType::Self, std::regex("self"));
-    letter_rules.emplace_back(TokenType::SELF, std::regex("Self"));
-    letter_rules.emplace_back(TokenType::Struct, std::regex("struct"));
-    letter_rules.emplace_back(TokenType::Super, std::regex("super"));
-    letter_rules.emplace_back(TokenType::Trait, std::regex("trait"));
-    letter_rules.emplace_back(TokenType::True, std::regex("true"));
-    letter_rules.emplace_back(TokenType::Type, std::regex("type"));
-    letter_rules.emplace_back(TokenType::Unsafe, std::regex("unsafe"));
-    letter_rules.emplace_back(TokenType::Use, std::regex("use"));
-    letter_rules.emplace_back(TokenType::Where, std::regex("where"));
-    letter_rules.emplace_back(TokenType::While, std::regex("while"));
-    letter_rules.emplace_back(TokenType::Dyn, std::regex("dyn"));
-    letter_rules.emplace_back(TokenType::Abstract, std::regex("abstract"));
-    letter_rules.emplace_back(TokenType::Become, std::regex("become"));
-    letter_rules.emplace_back(TokenType::Do, std::regex("do"));
-    letter_rules.emplace_back(TokenType::Final, std::regex("final"));
-    letter_rules.emplace_back(TokenType::Override, std::regex("override"));
-    // Match Keywords
-
-    letter_rules.emplace_back(TokenType::Identifier, std::regex("[a-zA-Z][_a-zA-Z0-9]*"));
-    // Match Identifier
-
-    // non_letter_rules.emplace_back(TokenType::DotDotDot, std::regex(R"(\.\.\.)"));
-    // non_letter_rules.emplace_back(TokenType::DotDotEq, std::regex(R"(\.\.=)"));
-    non_letter_rules.emplace_back(TokenType::SLEq, std::regex(R"(<<=)"));
-    non_letter_rules.emplace_back(TokenType::SREq, std::regex(R"(>>=)"));
-    non_letter_rules.emplace_back(TokenType::LEq, std::regex(R"(<=)"));
-    non_letter_rules.emplace_back(TokenType::EqEq, std::regex(R"(==)"));
-    non_letter_rules.emplace_back(TokenType::NEq, std::regex(R"(!=)"));
-    non_letter_rules.emplace_back(TokenType::GEq, std::regex(R"(>=)"));
-    non_letter_rules.emplace_back(TokenType::AndAnd, std::regex(R"(&&)"));
-    non_letter_rules.emplace_back(TokenType::OrOr, std::regex(R"(\|\|)"));
-    non_letter_rules.emplace_back(TokenType::SL, std::regex(R"(<<)"));
-    non_letter_rules.emplace_back(TokenType::SR, std::regex(R"(>>)"));
-    non_letter_rules.emplace_back(TokenType::PlusEq, std::regex(R"(\+=)"));
-    non_letter_rules.emplace_back(TokenType::MinusEq, std::regex(R"(-=)"));
-    non_letter_rules.emplace_back(TokenType::MulEq, std::regex(R"(\*=)"));
-    non_letter_rules.emplace_back(TokenType::DivEq, std::regex(R"(/=)"));
-    non_letter_rules.emplace_back(TokenType::ModEq, std::regex(R"(%=)"));
-    non_letter_rules.emplace_back(TokenType::XorEq, std::regex(R"(\^=)"));
-    non_letter_rules.emplace_back(TokenType::AndEq, std::regex(R"(&=)"));
-    non_letter_rules.emplace_back(TokenType::OrEq, std::regex(R"(\|=)"));
-    non_letter_rules.emplace_back(TokenType::DotDot, std::regex(R"(\.\.)"));
-    non_letter_rules.emplace_back(TokenType::ColonColon, std::regex(R"(::)"));
-    non_letter_rules.emplace_back(TokenType::RArrow, std::regex(R"(->)"));
-    non_letter_rules.emplace_back(TokenType::LArrow, std::regex(R"(<-)"));
-    // non_letter_rules.emplace_back(TokenType::FatArrow, std::regex(R"(=>)"));
-    non_letter_rules.emplace_back(TokenType::Eq, std::regex(R"(=)"));
-    non_letter_rules.emplace_back(TokenType::Lt, std::regex(R"(<)"));
-    non_letter_rules.emplace_back(TokenType::Gt, std::regex(R"(>)"));
-    non_letter_rules.emplace_back(TokenType::Not, std::regex(R"(!)"));
-    non_letter_rules.emplace_back(TokenType::Tilde, std::regex(R"(~)"));
-    non_letter_rules.emplace_back(TokenType::Plus, std::regex(R"(\+)"));
-    non_letter_rules.emplace_back(TokenType::Minus, std::regex(R"(-)"));
-    non_letter_rules.emplace_back(TokenType::Mul, std::regex(R"(\*)"));
-    non_letter_rules.emplace_back(TokenType::Div, std::regex(R"(/)"));
-    non_letter_rules.emplace_back(TokenType::MOD, std::regex(R"(%)"));
-    non_letter_rules.emplace_back(TokenType::Xor, std::regex(R"(\^)"));
-    non_letter_rules.emplace_back(TokenType::And, std::regex(R"(&)"));
-    non_letter_rules.emplace_back(TokenType::Or, std::regex(R"(\|)"));
-    non_letter_rules.emplace_back(TokenType::At, std::regex(R"(@)"));
-    non_letter_rules.emplace_back(TokenType::Dot, std::regex(R"(\.)"));
-    non_letter_rules.emplace_back(TokenType::Comma, std::regex(R"(,)"));
-    non_letter_rules.emplace_back(TokenType::Semicolon, std::regex(R"(;)"));
-    non_letter_rules.emplace_back(TokenType::Colon, std::regex(R"(:)"));
-    non_letter_rules.emplace_back(TokenType::Pound, std::regex(R"(#)"));
-    non_letter_rules.emplace_back(TokenType::Dollar, std::regex(R"(\$)"));
-    non_letter_rules.emplace_back(TokenType::Question, std::regex(R"(\?)"));
-    non_letter_rules.emplace_back(TokenType::Underscore, std::regex(R"(_)"));
-    non_letter_rules.emplace_back(TokenType::LBrace, std::regex(R"(\{)"));
-    non_letter_rules.emplace_back(TokenType::RBrace, std::regex(R"(\})"));
-    non_letter_rules.emplace_back(TokenType::LBracket, std::regex(R"(\[)"));
-    non_letter_rules.emplace_back(TokenType::RBracket, std::regex(R"(\])"));
-    non_letter_rules.emplace_back(TokenType::LParen, std::regex(R"(\()"));
-    non_letter_rules.emplace_back(TokenType::RParen, std::regex(R"(\))"));
-    // Match Punctuation
+namespace {
+    struct LiteralRule {
+        const char *literal;
+        TokenType type;
+    };
+
+    // "...", "..=" and "=>" are intentionally not recognized.
+    constexpr LiteralRule punctuation_rules[] = {
+        {"<<=", TokenType::SLEq}, {">>=", TokenType::SREq}, {"<=", TokenType::LEq},
+        {"==", TokenType::EqEq}, {"!=", TokenType::NEq}, {">=", TokenType::GEq},
+        {"&&", TokenType::AndAnd}, {"||", TokenType::OrOr}, {"<<", TokenType::SL},
+        {">>", TokenType::SR}, {"+=", TokenType::PlusEq}, {"-=", TokenType::MinusEq},
+        {"*=", TokenType::MulEq}, {"/=", TokenType::DivEq}, {"%=", TokenType::ModEq},
+        {"^=", TokenType::XorEq}, {"&=", TokenType::AndEq}, {"|=", TokenType::OrEq},
+        {"..", TokenType::DotDot}, {"::", TokenType::ColonColon}, {"->", TokenType::RArrow},
+        {"<-", TokenType::LArrow}, {"=", TokenType::Eq}, {"<", TokenType::Lt},
+        {">", TokenType::Gt}, {"!", TokenType::Not}, {"~", TokenType::Tilde},
+        {"+", TokenType::Plus}, {"-", TokenType::Minus}, {"*", TokenType::Mul},
+        {"/", TokenType::Div}, {"%", TokenType::MOD}, {"^", TokenType::Xor},
+        {"&", TokenType::And}, {"|", TokenType::Or}, {"@", TokenType::At},
+        {".", TokenType::Dot}, {",", TokenType::Comma}, {";", TokenType::Semicolon},
+        {":", TokenType::Colon}, {"#", TokenType::Pound}, {"$", TokenType::Dollar},
+        {"?", TokenType::Question}, {"_", TokenType::Underscore}, {"{", TokenType::LBrace},
+        {"}", TokenType::RBrace}, {"[", TokenType::LBracket}, {"]", TokenType::RBracket},
+        {"(", TokenType::LParen}, {")", TokenType::RParen},
+    };
 
-    non_letter_rules.emplace_back(TokenType::IntegerLiteral,
-                                  std::regex(
-                                      R"(((0b[_01]*[01][_01]*)|(0o[_0-7]*[0-7][_0-7]*)|(0x[_0-9a-fA-F]*[0-9a-fA-F][_0-9a-fA-F]*)|([0-9][_0-9]*))(u32|i32|usize|isize)?)"));
-    // Match Integer Literal
+    constexpr const char *integer_suffixes[] = {"u32", "i32", "usize", "isize"};
 
-    non_letter_rules.emplace_back(TokenType::ReservedIntegerLiteral,
-                                  std::regex(
-                                      R"(((0b[_0-9]*[0-9][_0-9]*)|(0o[_0-9]*[0-9][_0-9]*)|(0x[_0-9a-fA-F]*[0-9a-fA-F][_0-9a-fA-F]*)|([0-9][_0-9]*))(u32|i32|usize|isize)?)"));
-    // Match Reserved Integer Literal
+    constexpr bool IsLetter(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
 
-    non_letter_rules.emplace_back(TokenType::CharLiteral,
-                                  std::regex(R"('([^'\\\n\r\t]|\\[nrt'"\\0]|\\x[0-7][0-9a-fA-F])')"));
-    // Match Char Literal
+    constexpr bool IsDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
 
-    string_rules.emplace_back(TokenType::StringLiteral,
-                              std::regex(R"("([^"\\\r]|\\[nrt'"\\0]|\\x[0-9a-fA-F]{2}|\\\r)*")"));
-    // Match String Literal
+    constexpr bool IsHexDigit(const char c) {
+        return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
 
-    string_rules.emplace_back(TokenType::RawStringLiteral,
-                              std::regex(R"(r(#*)\"([^"\\\r]|\\[nrt'"\\0]|\\x[0-9a-fA-F]{2}|\\\r)*\"\1)"));
-    // Match Raw-String Literal
+    // Matches one alternative of the integer-literal grammar. With `reserved`
+    // set, binary and octal literals accept any decimal digit, so that a longer
+    // reserved match can be told apart from a valid literal.
+    uint32_t MatchIntegerRule(const char *begin, const char *end, const bool reserved) {
+        const char *cur = begin;
+        if (end - begin >= 2 && begin[0] == '0' && (begin[1] == 'b' || begin[1] == 'o' || begin[1] == 'x')) {
+            const char radix = begin[1];
+            bool has_digit = false;
+            cur = begin + 2;
+            while (cur < end) {
+                const char c = *cur;
+                bool is_digit;
+                if (radix == 'x') {
+                    is_digit = IsHexDigit(c);
+                } else if (reserved) {
+                    is_digit = IsDigit(c);
+                } else if (radix == 'b') {
+                    is_digit = c == '0' || c == '1';
+                } else {
+                    is_digit = c >= '0' && c <= '7';
+                }
+                if (is_digit) {
+                    has_digit = true;
+                } else if (c != '_') {
+                    break;
+                }
+                cur++;
+            }
+            if (!has_digit) {
+                cur = begin;
+            }
+        }
+        if (cur == begin) {
+            if (!IsDigit(*cur)) {
+                return 0;
+            }
+            cur++;
+            while (cur < end && (IsDigit(*cur) || *cur == '_')) {
+                cur++;
+            }
+        }
+        for (const char *suffix: integer_suffixes) {
+            const size_t len = std::strlen(suffix);
+            if (static_cast<size_t>(end - cur) >= len && std::memcmp(cur, suffix, len) == 0) {
+                cur += len;
+                break;
+            }
+        }
+        return cur - begin;
+    }
+}
 
-    string_rules.emplace_back(TokenType::CStringLiteral,
-                              std::regex(R"(c"([^"\\\r]|\\[nrt'"\\0]|\\x[0-9a-fA-F]{2}|\\\r)*")"));
-    // Match C-String Literal
+Lexer::Lexer() {
+    NewState(); // DeadState
+    NewState(); // StartState
 
-    string_rules.emplace_back(TokenType::CStringLiteral,
-                              std::regex(R"(cr(#*)\"([^"\\\r]|\\[nrt'"\\0]|\\x[0-9a-fA-F]{2}|\\\r)*\"\1)"));
-    // Match C-String Literal
+    for (const auto &it: punctuation_rules) {
+        AddLiteral(it.literal, it.type);
+    }
+    // Match Punctuation
 
-    non_letter_rules.emplace_back(TokenType::WhiteSpace, std::regex("[ \r\t\n]+"));
-    // Match WhiteSpace
 }
 
+Lexer::State Lexer::NewState() {
+    transitions_.emplace_back();
+    transitions_.back().fill(DeadState);
+    accepts_.push_back(TokenType::None);
+    return static_cast<State>(transitions_.size() - 1);
+}
 
-Token Lexer::GetNextToken(std::string &str) const {
-    uint32_t bestMatchLength = 0;
-    TokenType bestMatchType = TokenType::None;
-    uint32_t len = 0;
-    
-    if (str.substr(0, 2) == "//") {
-        uint32_t cur = 0;
-        while (str[cur] != '\n' && str[cur] != '\r') {
-            cur++;
+void Lexer::AddLiteral(const std::string &literal, const TokenType type) {
+    State state = StartState;
+    for (const unsigned char c: literal) {
+        if (transitions_[state][c] == DeadState) {
+            const State next = NewState();
+            transitions_[state][c] = next;
         }
-        bestMatchLength = cur;
-        bestMatchType = TokenType::LineComment;
-        std::string token = str.substr(0, bestMatchLength);
-        str = str.substr(bestMatchLength, str.size() - bestMatchLength);
-        return Token{token, bestMatchType};
-    }
-    if (str.substr(0, 2) == "/*") {
-        uint32_t cur = 2, cnt = 1;
-        while (cnt > 0) {
-            if (str.substr(cur, 2) == "/*") {
-                cnt++;
-            } else if (str.substr(cur, 2) == "*/") {
-                cnt--;
+        state = transitions_[state][c];
+    }
+    if (accepts_[state] == TokenType::None) {
+        accepts_[state] = type;
+    }
+}
+
+// Maximal munch over the DFA; returns the length of the longest accepted prefix.
+uint32_t Lexer::RunDFA(const char *begin, const char *end, TokenType &type) const {
+    State state = StartState;
+    uint32_t length = 0;
+    for (const char *cur = begin; cur < end; cur++) {
+        state = transitions_[state][static_cast<unsigned char>(*cur)];
+        if (state == DeadState) {
+            break;
+        }
+        if (accepts_[state] != TokenType::None) {
+            length = cur - begin + 1;
+            type = accepts_[state];
+        }
+    }
+    return length;
+}
+
+// [a-zA-Z][_a-zA-Z0-9]*; the caller has already checked the first letter.
+uint32_t Lexer::ScanIdentifier(const char *begin, const char *end) {
+    return scan::Active().skip_identifier(begin + 1, end) - begin;
+}
+
+uint32_t Lexer::ScanLineComment(const char *begin, const char *end) {
+    return scan::Active().find_line_end(begin, end) - begin;
+}
+
+uint32_t Lexer::ScanWhiteSpace(const char *begin, const char *end) {
+    return scan::Active().skip_whitespace(begin, end) - begin;
+}
+
+uint32_t Lexer::ScanBlockComment(const char *begin, const char *end) {
+    const auto find_delimiter = scan::Active().find_comment_delimiter;
+    const char *cur = begin + 2;
+    uint32_t depth = 1;
+    while (true) {
+        cur = find_delimiter(cur, end);
+        if (cur + 1 >= end) {
+            break;
+        }
+        if (cur[0] == '/' && cur[1] == '*') {
+            depth++;
+        } else if (cur[0] == '*' && cur[1] == '/') {
+            if (--depth == 0) {
+                return cur + 2 - begin;
             }
+        }
+        cur++;
+    }
+    throw LexError("Lex Error: Unterminated Block Comment");
+}
+
+// Scans the body of a (raw / C) string literal starting right after the opening
+// quote. Returns the length up to and including the closing quote, or 0.
+uint32_t Lexer::ScanStringBody(const char *begin, const char *end) {
+    const char *cur = begin;
+    while (cur < end) {
+        const char c = *cur;
+        if (c == '"') {
+            return cur - begin + 1;
+        }
+        if (c == '\r') {
+            return 0;
+        }
+        if (c != '\\') {
             cur++;
+            continue;
+        }
+        if (cur + 1 >= end) {
+            return 0;
+        }
+        const char escaped = cur[1];
+        if (std::strchr("nrt'\"\\0\r", escaped) != nullptr && escaped != '\0') {
+            cur += 2;
+        } else if (escaped == 'x' && cur + 3 < end && IsHexDigit(cur[2]) && IsHexDigit(cur[3])) {
+            cur += 4;
+        } else {
+            return 0;
         }
-        bestMatchLength = cur + 2;
-        bestMatchType = TokenType::BlockComment;
-        std::string token = str.substr(0, bestMatchLength);
-        str = str.substr(bestMatchLength, str.size() - bestMatchLength);
-        return Token{token, bestMatchType};
     }
-    if (str.substr(0, 2) == "*/") {
+    return 0;
+}
+
+uint32_t Lexer::ScanString(const char *begin, const char *end, TokenType &type) {
+    const char *cur = begin;
+    if (*cur == '"') {
+        const uint32_t body = ScanStringBody(cur + 1, end);
+        type = TokenType::StringLiteral;
+        return body == 0 ? 0 : body + 1;
+    }
+    TokenType string_type = TokenType::RawStringLiteral;
+    if (*cur == 'c') {
+        string_type = TokenType::CStringLiteral;
+        cur++;
+        if (cur < end && *cur == '"') {
+            const uint32_t body = ScanStringBody(cur + 1, end);
+            type = string_type;
+            return body == 0 ? 0 : body + 2;
+        }
+    }
+    if (cur >= end || *cur != 'r') {
+        return 0;
+    }
+    cur++;
+    uint32_t hashes = 0;
+    while (cur < end && *cur == '#') {
+        hashes++;
+        cur++;
+    }
+    if (cur >= end || *cur != '"') {
+        return 0;
+    }
+    const uint32_t body = ScanStringBody(cur + 1, end);
+    if (body == 0) {
+        return 0;
+    }
+    cur += body + 1;
+    for (uint32_t i = 0; i < hashes; i++, cur++) {
+        if (cur >= end || *cur != '#') {
+            return 0;
+        }
+    }
+    type = string_type;
+    return cur - begin;
+}
+
+uint32_t Lexer::ScanChar(const char *begin, const char *end) {
+    const char *cur = begin + 1;
+    if (cur >= end) {
+        return 0;
+    }
+    if (*cur == '\\') {
+        if (cur + 1 >= end) {
+            return 0;
+        }
+        const char escaped = cur[1];
+        if (std::strchr("nrt'\"\\0", escaped) != nullptr && escaped != '\0') {
+            cur += 2;
+        } else if (escaped == 'x' && cur + 3 < end && cur[2] >= '0' && cur[2] <= '7' && IsHexDigit(cur[3])) {
+            cur += 4;
+        } else {
+            return 0;
+        }
+    } else if (*cur == '\'' || *cur == '\n' || *cur == '\r' || *cur == '\t') {
+        return 0;
+    } else {
+        cur++;
+    }
+    if (cur >= end || *cur != '\'') {
+        return 0;
+    }
+    return cur - begin + 1;
+}
+
+uint32_t Lexer::ScanInteger(const char *begin, const char *end, TokenType &type) {
+    const uint32_t valid = MatchIntegerRule(begin, end, false);
+    const uint32_t reserved = MatchIntegerRule(begin, end, true);
+    if (reserved > valid) {
+        type = TokenType::ReservedIntegerLiteral;
+        return reserved;
+    }
+    type = TokenType::IntegerLiteral;
+    return valid;
+}
+
+
+Token Lexer::GetNextToken(const std::string_view source, uint32_t &offset, const bool intern) const {
+    const char *begin = source.data() + offset;
+    const char *end = source.data() + source.size();
+    const char first = *begin;
+    const char second = end - begin > 1 ? begin[1] : '\0';
+    uint32_t length = 0;
+    TokenType type = TokenType::None;
+
+    if (first == '/' && second == '/') {
+        length = ScanLineComment(begin, end);
+        type = TokenType::LineComment;
+    } else if (first == '/' && second == '*') {
+        length = ScanBlockComment(begin, end);
+        type = TokenType::BlockComment;
+    } else if (first == '*' && second == '/') {
         throw LexError("Comments do not match");
-    } // Judge whether it is a comment.
-    for (const auto &it: string_rules) {
-        std::smatch match;
-        if (std::regex_search(str, match, it.second, std::regex_constants::match_continuous)) {
-            len = match.length(0);
-            if (len > bestMatchLength) {
-                bestMatchLength = len;
-                bestMatchType = it.first;
-            }
+    } else if (first == '"' || first == 'r' || first == 'c') {
+        length = ScanString(begin, end, type);
+    } // Judge Comment and String
+
+    if (length == 0) {
+        if (first == '\'') {
+            length = ScanChar(begin, end);
+            type = TokenType::CharLiteral;
+        } else if (IsDigit(first)) {
+            length = ScanInteger(begin, end, type);
+        } else if (first == ' ' || first == '\t' || first == '\r' || first == '\n') {
+            length = ScanWhiteSpace(begin, end);
+            type = TokenType::WhiteSpace;
+        } else if (IsLetter(first)) {
+            length = ScanIdentifier(begin, end);
+            type = keyword::Classify(std::string_view(begin, length));
+        } else {
+            length = RunDFA(begin, end, type);
         }
+    } // Judge Others
+
+    if (length == 0) {
+        throw LexError("Lex Error: Unrecognized Token");
     }
-    if (bestMatchLength > 0) {
-        std::string token = str.substr(0, bestMatchLength);
-        str = str.substr(bestMatchLength, str.size() - bestMatchLength);
-        return Token{token, bestMatchType};
-    } // Judge String
+    Token token{type, length, Position{0, 0, offset}};
+    if (intern && type == TokenType::Identifier) {
+        token.atom = GlobalInterner().Intern(std::string_view(begin, length));
+    }
+    offset += length;
+    return token;
+}
 
-    // Optimization: only use first 128 chars for matching
-    std::string matchStr = (str.length() > 128) ? str.substr(0, 128) : str;
+bool Lexer::NextParserToken(const std::string_view source, uint32_t &offset, LineTable &lines, Token &token,
+                            const bool intern) const {
+    while (offset < source.size()) {
+        const Token current_token = GetNextToken(source, offset, intern);
+        if (current_token.type == TokenType::ReservedIntegerLiteral) {
+            throw LexError("Lex Error: Invalid Integer");
+        }
+        switch (current_token.type) {
+            case TokenType::WhiteSpace:
+            case TokenType::BlockComment:
+                lines.Scan(source, current_token.offset(), current_token.length);
+                continue;
+            case TokenType::LineComment:
+                continue;
+            case TokenType::StringLiteral:
+            case TokenType::RawStringLiteral:
+            case TokenType::CStringLiteral:
+                token = current_token;
+                token.putPosValue(lines.FrontierPosition(current_token.offset()));
+                lines.Scan(source, current_token.offset(), current_token.length);
+                return true;
+            default:
+                token = current_token;
+                token.putPosValue(lines.FrontierPosition(current_token.offset()));
+                return true;
+        }
+    }
+    return false;
+}
 
-    if (str[0] >= 'a' && str[0] <= 'z' || str[0] >= 'A' && str[0] <= 'Z') {
-        for (const auto &it: letter_rules) {
-            std::smatch match;
-            if (std::regex_search(matchStr, match, it.second, std::regex_constants::match_continuous)) {
-                len = match.length(0);
-                if (len > bestMatchLength) {
-                    bestMatchLength = len;
-                    bestMatchType = it.first;
-                }
-            }
+// Length of the next unit for FindSplitPoints. Follows GetNextToken's dispatch
+// for everything that can contain a quote, a newline or a comment opener
+// (comments, strings, chars, integers, identifiers) and steps single bytes
+// otherwise; punctuation and whitespace never span a newline boundary.
+uint32_t Lexer::SkipForSplit(const char *begin, const char *end) {
+    const char first = *begin;
+    const char second = end - begin > 1 ? begin[1] : '\0';
+    TokenType type = TokenType::None;
+    uint32_t length = 0;
+    if (first == '/' && second == '/') {
+        length = ScanLineComment(begin, end);
+    } else if (first == '/' && second == '*') {
+        length = ScanBlockComment(begin, end);
+    } else if (first == '*' && second == '/') {
+        throw LexError("Comments do not match");
+    } else if (first == '"' || first == 'r' || first == 'c') {
+        length = ScanString(begin, end, type);
+    }
+    if (length == 0) {
+        if (first == '\'') {
+            length = ScanChar(begin, end);
+        } else if (IsDigit(first)) {
+            length = ScanInteger(begin, end, type);
+        } else if (IsLetter(first)) {
+            length = ScanIdentifier(begin, end);
         }
-    } else {
-        for (const auto &it: non_letter_rules) {
-            std::smatch match;
-            if (std::regex_search(matchStr, match, it.second, std::regex_constants::match_continuous)) {
-                len = match.length(0);
-                if (len > bestMatchLength) {
-                    bestMatchLength = len;
-                    bestMatchType = it.first;
+    }
+    return length == 0 ? 1 : length;
+}
+
+std::vector<uint32_t> Lexer::FindSplitPoints(const std::string_view source, const uint32_t count) const {
+    std::vector<uint32_t> points;
+    const char *begin = source.data();
+    const char *end = begin + source.size();
+    const size_t stride = source.size() / (count + 1);
+    if (count == 0 || stride == 0) {
+        return points;
+    }
+    size_t target = stride;
+    try {
+        for (const char *cur = begin; cur < end; cur += SkipForSplit(cur, end)) {
+            if (cur > begin && cur[-1] == '\n' && static_cast<size_t>(cur - begin) >= target) {
+                points.push_back(static_cast<uint32_t>(cur - begin));
+                if (points.size() == count) {
+                    break;
                 }
+                target = (points.size() + 1) * stride;
             }
         }
-    } // Judge Others
-    std::string token = str.substr(0, bestMatchLength);
-    str = str.substr(bestMatchLength, str.size() - bestMatchLength);
-    return Token{token, bestMatchType};
+    } catch (const LexError &) {
+        // The chunk that contains the error reports it when it is lexed.
+    }
+    return points;
 }
@@ -0,0 +1,38 @@
+#include <algorithm>
+#include "Lexer/LineTable.h"
+#include "Lexer/ScanKernels.h"
+
+void LineTable::ScanLong(const std::string_view source, const uint32_t offset, const uint32_t length) {
+    const auto find_line_end = scan::Active().find_line_end;
+    const char *base = source.data();
+    const char *end = base + offset + length;
+    for (const char *cur = find_line_end(base + offset, end); cur < end; cur = find_line_end(cur, end)) {
+        if (*cur == '\r' && cur + 1 < source.data() + source.size() && cur[1] == '\n') {
+            cur++;
+        }
+        cur++;
+        starts_.push_back(static_cast<uint32_t>(cur - base));
+    }
+}
+
+Position LineTable::PositionOf(const uint32_t offset) const {
+    const auto it = std::upper_bound(starts_.begin(), starts_.end(), offset);
+    const auto row = static_cast<uint32_t>(it - starts_.begin());
+    return {row, offset - *(it - 1) + 1, offset};
+}
+
+std::string_view LineTable::LineText(const std::string_view source, const uint32_t row) const {
+    const uint32_t begin = starts_[row - 1];
+    uint32_t end = row < starts_.size() ? starts_[row] : static_cast<uint32_t>(source.size());
+    if (end > begin && source[end - 1] == '\n') {
+        end--;
+    }
+    if (end > begin && source[end - 1] == '\r') {
+        end--;
+    }
+    return source.substr(begin, end - begin);
+}
+
+void LineTable::Append(const LineTable &next) {
+    starts_.insert(starts_.end(), next.starts_.begin() + 1, next.starts_.end());
+}
@@ -0,0 +1,73 @@
+#include <exception>
+#include <thread>
+#include "Lexer/ParallelLexer.h"
+
+namespace {
+    struct Chunk {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        TokenArray tokens;
+        LineTable lines;
+        std::exception_ptr error;
+    };
+
+    void LexChunk(const Lexer &lexer, const std::string_view source, Chunk &chunk) {
+        try {
+            const std::string_view bounded = source.substr(0, chunk.end);
+            uint32_t offset = chunk.begin;
+            Token token;
+            while (lexer.NextParserToken(bounded, offset, chunk.lines, token, false)) {
+                chunk.tokens.push_back(token);
+            }
+        } catch (...) {
+            chunk.error = std::current_exception();
+        }
+    }
+}
+
+ParallelLexer::ParallelLexer(const Lexer &lexer, const uint32_t threads)
+    : lexer_(lexer), threads_(threads == 0 ? 1 : threads) {
+}
+
+TokenArray ParallelLexer::Lex(const std::string_view source, LineTable &lines) const {
+    const std::vector<uint32_t> points = lexer_.FindSplitPoints(source, threads_ - 1);
+    std::vector<Chunk> chunks(points.size() + 1);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunks[i].begin = i == 0 ? 0 : points[i - 1];
+        chunks[i].end = i == points.size() ? static_cast<uint32_t>(source.size()) : points[i];
+        chunks[i].lines = LineTable(chunks[i].begin);
+    }
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back(LexChunk, std::cref(lexer_), source, std::ref(chunks[i]));
+    }
+    LexChunk(lexer_, source, chunks[0]);
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    for (const auto &chunk: chunks) {
+        if (chunk.error) {
+            std::rethrow_exception(chunk.error);
+        }
+        total += chunk.tokens.size();
+    }
+    // Reuse the first chunk's arrays. Columns and offsets are already absolute;
+    // rows restart at 1 in every chunk.
+    TokenArray tokens = std::move(chunks[0].tokens);
+    tokens.reserve(total);
+    lines = std::move(chunks[0].lines);
+    for (size_t i = 1; i < chunks.size(); i++) {
+        const uint32_t rows_before = lines.line_count() - 1;
+        for (size_t j = 0; j < chunks[i].tokens.size(); j++) {
+            Token token = chunks[i].tokens[j];
+            const Position &pos = token.pos;
+            token.putPosValue(Position{pos.GetRow() + rows_before, pos.GetColumn(), pos.GetOffset()});
+            tokens.push_back(token);
+        }
+        lines.Append(chunks[i].lines);
+    }
+    return tokens;
+}
@@ -0,0 +1,258 @@
+#include "Lexer/ScanKernels.h"
+
+// SSE2 is part of the x86-64 baseline; AVX2 code is compiled per function
+// with a target attribute and only reached after the CPUID check.
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define RCOMPILER_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace scan {
+    namespace {
+        constexpr bool IsWhiteSpace(const char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        constexpr bool IsIdentifierContinue(const char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }
+
+        const char *SkipWhiteSpaceScalar(const char *cur, const char *end) {
+            while (cur < end && IsWhiteSpace(*cur)) {
+                cur++;
+            }
+            return cur;
+        }
+
+        const char *FindLineEndScalar(const char *cur, const char *end) {
+            while (cur < end && *cur != '\n' && *cur != '\r') {
+                cur++;
+            }
+            return cur;
+        }
+
+        const char *FindCommentDelimiterScalar(const char *cur, const char *end) {
+            while (cur < end && *cur != '/' && *cur != '*') {
+                cur++;
+            }
+            return cur;
+        }
+
+        const char *SkipIdentifierScalar(const char *cur, const char *end) {
+            while (cur < end && IsIdentifierContinue(*cur)) {
+                cur++;
+            }
+            return cur;
+        }
+
+#ifdef RCOMPILER_SCAN_X86
+        // Each vector kernel computes a "stop here" byte mask per block and
+        // returns at its lowest set bit; the tail shorter than one block is
+        // left to the scalar loop.
+
+        inline __m128i InRange128(const __m128i v, const char lo, const char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                                 _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+        }
+
+        inline __m128i IsWhiteSpace128(const __m128i v) {
+            return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+                                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        }
+
+        // Bytes >= 0x80 are negative as signed chars and fall outside every range.
+        inline __m128i IsIdentifierContinue128(const __m128i v) {
+            const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            return _mm_or_si128(_mm_or_si128(InRange128(lower, 'a', 'z'), InRange128(v, '0', '9')),
+                                _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+        }
+
+        template<typename StopMask>
+        const char *Search128(const char *cur, const char *end, StopMask stop) {
+            while (end - cur >= 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cur));
+                const auto mask = static_cast<unsigned>(_mm_movemask_epi8(stop(v)));
+                if (mask != 0) {
+                    return cur + __builtin_ctz(mask);
+                }
+                cur += 16;
+            }
+            return cur;
+        }
+
+        // Most whitespace runs and many identifiers are a single byte or two,
+        // so the skip kernels try the scalar test before loading a vector.
+        const char *SkipWhiteSpaceSSE2(const char *cur, const char *end) {
+            if (cur == end || !IsWhiteSpace(*cur)) {
+                return cur;
+            }
+            cur = Search128(cur, end, [](const __m128i v) {
+                return _mm_xor_si128(IsWhiteSpace128(v), _mm_set1_epi8(-1));
+            });
+            return SkipWhiteSpaceScalar(cur, end);
+        }
+
+        const char *FindLineEndSSE2(const char *cur, const char *end) {
+            cur = Search128(cur, end, [](const __m128i v) {
+                return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+            });
+            return FindLineEndScalar(cur, end);
+        }
+
+        const char *FindCommentDelimiterSSE2(const char *cur, const char *end) {
+            cur = Search128(cur, end, [](const __m128i v) {
+                return _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')), _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+            });
+            return FindCommentDelimiterScalar(cur, end);
+        }
+
+        const char *SkipIdentifierSSE2(const char *cur, const char *end) {
+            if (cur == end || !IsIdentifierContinue(*cur)) {
+                return cur;
+            }
+            cur = Search128(cur, end, [](const __m128i v) {
+                return _mm_xor_si128(IsIdentifierContinue128(v), _mm_set1_epi8(-1));
+            });
+            return SkipIdentifierScalar(cur, end);
+        }
+
+#define RCOMPILER_AVX2 __attribute__((target("avx2")))
+
+        RCOMPILER_AVX2 inline __m256i InRange256(const __m256i v, const char lo, const char hi) {
+            return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                                    _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+        }
+
+        RCOMPILER_AVX2 inline __m256i IsWhiteSpace256(const __m256i v) {
+            return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                   _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                   _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+                                                   _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        }
+
+        RCOMPILER_AVX2 inline __m256i IsIdentifierContinue256(const __m256i v) {
+            const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+            return _mm256_or_si256(_mm256_or_si256(InRange256(lower, 'a', 'z'), InRange256(v, '0', '9')),
+                                   _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+        }
+
+        // Macro rather than a lambda template: lambdas do not inherit the
+        // target attribute, so the intrinsics would not inline into them.
+#define RCOMPILER_SEARCH256(cur, end, STOP)                                                   \
+        while ((end) - (cur) >= 32) {                                                         \
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cur));     \
+            const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(STOP));              \
+            if (mask != 0) {                                                                  \
+                return (cur) + __builtin_ctz(mask);                                           \
+            }                                                                                 \
+            (cur) += 32;                                                                      \
+        }
+
+        RCOMPILER_AVX2 const char *SkipWhiteSpaceAVX2(const char *cur, const char *end) {
+            if (cur == end || !IsWhiteSpace(*cur)) {
+                return cur;
+            }
+            RCOMPILER_SEARCH256(cur, end, _mm256_xor_si256(IsWhiteSpace256(v), _mm256_set1_epi8(-1)))
+            return SkipWhiteSpaceSSE2(cur, end);
+        }
+
+        RCOMPILER_AVX2 const char *FindLineEndAVX2(const char *cur, const char *end) {
+            RCOMPILER_SEARCH256(cur, end, _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))))
+            return FindLineEndSSE2(cur, end);
+        }
+
+        RCOMPILER_AVX2 const char *FindCommentDelimiterAVX2(const char *cur, const char *end) {
+            RCOMPILER_SEARCH256(cur, end, _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')),
+                                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*'))))
+            return FindCommentDelimiterSSE2(cur, end);
+        }
+
+        RCOMPILER_AVX2 const char *SkipIdentifierAVX2(const char *cur, const char *end) {
+            if (cur == end || !IsIdentifierContinue(*cur)) {
+                return cur;
+            }
+            RCOMPILER_SEARCH256(cur, end, _mm256_xor_si256(IsIdentifierContinue256(v), _mm256_set1_epi8(-1)))
+            return SkipIdentifierSSE2(cur, end);
+        }
+
+#undef RCOMPILER_SEARCH256
+#undef RCOMPILER_AVX2
+#endif
+
+        constexpr Kernels scalar_kernels{
+            Isa::Scalar, SkipWhiteSpaceScalar, FindLineEndScalar, FindCommentDelimiterScalar, SkipIdentifierScalar
+        };
+#ifdef RCOMPILER_SCAN_X86
+        constexpr Kernels sse2_kernels{
+            Isa::SSE2, SkipWhiteSpaceSSE2, FindLineEndSSE2, FindCommentDelimiterSSE2, SkipIdentifierSSE2
+        };
+        constexpr Kernels avx2_kernels{
+            Isa::AVX2, SkipWhiteSpaceAVX2, FindLineEndAVX2, FindCommentDelimiterAVX2, SkipIdentifierAVX2
+        };
+#endif
+
+        Isa BestIsa() {
+#ifdef RCOMPILER_SCAN_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return Isa::AVX2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return Isa::SSE2;
+            }
+#endif
+            return Isa::Scalar;
+        }
+
+        const Kernels *active = &Select(BestIsa());
+    }
+
+    bool Supported(const Isa isa) {
+        switch (isa) {
+            case Isa::Scalar:
+                return true;
+#ifdef RCOMPILER_SCAN_X86
+            case Isa::SSE2:
+                return __builtin_cpu_supports("sse2");
+            case Isa::AVX2:
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    const Kernels &Select(const Isa isa) {
+#ifdef RCOMPILER_SCAN_X86
+        if (isa == Isa::AVX2) {
+            return avx2_kernels;
+        }
+        if (isa == Isa::SSE2) {
+            return sse2_kernels;
+        }
+#endif
+        return scalar_kernels;
+    }
+
+    const Kernels &Active() {
+        return *active;
+    }
+
+    void SetActive(const Isa isa) {
+        active = &Select(isa);
+    }
+
+    const char *IsaName(const Isa isa) {
+        switch (isa) {
+            case Isa::SSE2:
+                return "sse2";
+            case Isa::AVX2:
+                return "avx2";
+            default:
+                return "scalar";
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "Parser/ParallelParser.h"
+#include "Parser/Parser.h"
+
+namespace {
+    // Several batches per thread, so one long item does not leave the other
+    // threads idle at the end.
+    constexpr uint32_t BatchesPerThread = 8;
+
+    // A run of consecutive items, parsed by one Parser.
+    struct Batch {
+        uint32_t begin = 0; // token range
+        uint32_t end = 0;
+        std::vector<VisItemNode *> items;
+        std::vector<PathIndentSegmentNode *> deferred_atoms;
+        bool parsed = false;
+    };
+
+    // Groups items into at most `count` batches of roughly equal token counts.
+    std::vector<Batch> MakeBatches(const std::vector<uint32_t> &starts, const uint32_t token_count,
+                                   const uint32_t count) {
+        const uint32_t target = std::max<uint32_t>(1, token_count / count);
+        std::vector<Batch> batches;
+        for (size_t i = 0; i < starts.size(); i++) {
+            const uint32_t end = i + 1 < starts.size() ? starts[i + 1] : token_count;
+            if (batches.empty() || batches.back().end - batches.back().begin >= target) {
+                batches.emplace_back();
+                batches.back().begin = starts[i];
+            }
+            batches.back().end = end;
+        }
+        return batches;
+    }
+}
+
+ParallelParser::ParallelParser(const uint32_t threads) : threads_(threads == 0 ? 1 : threads) {
+}
+
+std::vector<uint32_t> ParallelParser::FindItemStarts(const TokenArray &tokens) {
+    std::vector<uint32_t> starts;
+    const auto count = static_cast<uint32_t>(tokens.size());
+    uint32_t index = 0;
+    while (index < count) {
+        starts.push_back(index);
+        TokenType type = tokens.type(index);
+        if (type == TokenType::Const && index + 1 < count && tokens.type(index + 1) == TokenType::Fn) {
+            type = TokenType::Fn;
+        }
+        // A constant's initializer may hold a block, so only its semicolon
+        // ends it; the other items also end at the brace that closes them.
+        bool brace_ends_item = true;
+        switch (type) {
+            case TokenType::Fn:
+            case TokenType::Struct:
+            case TokenType::Enum:
+            case TokenType::Impl:
+            case TokenType::Trait:
+                break;
+            case TokenType::Const:
+                brace_ends_item = false;
+                break;
+            default:
+                return {};
+        }
+        int32_t depth = 0;
+        bool closed = false;
+        for (; index < count && !closed; index++) {
+            switch (tokens.type(index)) {
+                case TokenType::LParen:
+                case TokenType::LBracket:
+                case TokenType::LBrace:
+                    depth++;
+                    break;
+                case TokenType::RParen:
+                case TokenType::RBracket:
+                    depth--;
+                    break;
+                case TokenType::RBrace:
+                    depth--;
+                    closed = brace_ends_item && depth == 0;
+                    break;
+                case TokenType::Semicolon:
+                    closed = depth == 0;
+                    break;
+                default:
+                    break;
+            }
+            if (depth < 0) {
+                return {};
+            }
+        }
+        if (!closed) {
+            return {};
+        }
+    }
+    return starts;
+}
+
+CrateNode *ParallelParser::ParseCrate(Arena &arena, TokenArray &&tokens, const std::string_view source) const {
+    const std::vector<uint32_t> starts = threads_ > 1 ? FindItemStarts(tokens) : std::vector<uint32_t>{};
+    if (starts.size() < 2) {
+        return Parser(arena, std::move(tokens), source).ParseCrate();
+    }
+
+    const auto token_count = static_cast<uint32_t>(tokens.size());
+    std::vector<Batch> batches = MakeBatches(starts, token_count, threads_ * BatchesPerThread);
+    const auto worker_count = static_cast<uint32_t>(std::min<size_t>(threads_, batches.size()));
+    std::vector<Arena> arenas(worker_count);
+    std::atomic<size_t> next_batch{0};
+    const auto work = [&](Arena &worker_arena) {
+        for (size_t i = next_batch++; i < batches.size(); i = next_batch++) {
+            Batch &batch = batches[i];
+            try {
+                Parser parser(worker_arena, tokens.Slice(batch.begin, batch.end), source);
+                parser.DeferInterning(batch.deferred_atoms);
+                batch.parsed = parser.ParseItems(batch.items);
+            } catch (...) {
+                batch.parsed = false; // the sequential parse below reports it
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < worker_count; i++) {
+        workers.emplace_back(work, std::ref(arenas[i]));
+    }
+    work(arenas[0]);
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    size_t item_count = 0;
+    for (const auto &batch: batches) {
+        if (!batch.parsed) {
+            return Parser(arena, std::move(tokens), source).ParseCrate();
+        }
+        item_count += batch.items.size();
+    }
+    std::vector<VisItemNode *> items;
+    items.reserve(item_count);
+    for (auto &batch: batches) {
+        for (PathIndentSegmentNode *segment: batch.deferred_atoms) {
+            segment->atom_ = GlobalInterner().Intern(segment->identifier_);
+        }
+        items.insert(items.end(), batch.items.begin(), batch.items.end());
+    }
+    for (auto &worker_arena: arenas) {
+        arena.Adopt(worker_arena);
+    }
+    return arena.Make<CrateNode>(tokens.span(0).pos, std::move(items));
+}
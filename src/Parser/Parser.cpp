@@ -3,1594 +3,1729 @@
 #include "Util.h"
 #include <memory>
 
-void Parser::ConsumeString(const std::string &str) {
-    if (parseIndex < tokens.size() && tokens[parseIndex].token == str) {
+bool Parser::ConsumeString(const std::string_view str) {
+    if (!tokens.AtEnd(parseIndex) && TokenText(parseIndex) == str) {
         parseIndex++;
-    } else {
-        throw ParseError("Parse Error: Cannot Match :" + str, tokens[parseIndex].pos);
+        return true;
+    }
+    Fail("Parse Error: Cannot Match :", tokens.pos(parseIndex), str);
+    return false;
+}
+
+namespace {
+    using Precedence = Parser::Precedence;
+
+    // The operator table for ParseOperatorExpression. Tokens that cannot
+    // continue an expression map to Precedence::None.
+    constexpr Precedence BinaryPrecedence(const TokenType type) {
+        switch (type) {
+            case TokenType::Eq:
+            case TokenType::PlusEq:
+            case TokenType::MinusEq:
+            case TokenType::MulEq:
+            case TokenType::DivEq:
+            case TokenType::ModEq:
+            case TokenType::AndEq:
+            case TokenType::OrEq:
+            case TokenType::XorEq:
+            case TokenType::SLEq:
+            case TokenType::SREq:
+                return Precedence::Assignment;
+            case TokenType::OrOr:
+                return Precedence::LogicalOr;
+            case TokenType::AndAnd:
+                return Precedence::LogicalAnd;
+            case TokenType::Lt:
+            case TokenType::Gt:
+            case TokenType::LEq:
+            case TokenType::GEq:
+            case TokenType::EqEq:
+            case TokenType::NEq:
+                return Precedence::Comparison;
+            case TokenType::Or:
+                return Precedence::BitwiseOr;
+            case TokenType::Xor:
+                return Precedence::BitwiseXor;
+            case TokenType::And:
+                return Precedence::BitwiseAnd;
+            case TokenType::SL:
+            case TokenType::SR:
+                return Precedence::Shift;
+            case TokenType::Plus:
+            case TokenType::Minus:
+                return Precedence::AddMinus;
+            case TokenType::Mul:
+            case TokenType::Div:
+            case TokenType::MOD:
+                return Precedence::MulDivMod;
+            case TokenType::As:
+                return Precedence::TypeCast;
+            default:
+                return Precedence::None;
+        }
     }
 }
 
 /****************  Items  ****************/
-std::shared_ptr<CrateNode> Parser::ParseCrate() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<VisItemNode>> items;
-    while (parseIndex != tokens.size()) {
+CrateNode *Parser::ParseCrate() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<VisItemNode *> items;
+    if (!ParseItems(items)) {
+        tokens.Drain(); // a lexer error anywhere in the input takes priority
+        throw ParseError(failure_.message + std::string(failure_.detail), failure_.pos);
+    }
+    return arena_.Make<CrateNode>(pos, std::move(items));
+}
+
+bool Parser::ParseItems(std::vector<VisItemNode *> &items) {
+    while (!tokens.AtEnd(parseIndex)) {
         auto tmp = ParseVisItem();
+        if (tmp == nullptr) {
+            return false;
+        }
         items.emplace_back(tmp);
+        tokens.Release(parseIndex); // items never backtrack into earlier items
     }
-    return std::make_shared<CrateNode>(pos, std::move(items));
+    return true;
 }
 
-std::shared_ptr<VisItemNode> Parser::ParseVisItem() {
-    try {
-        if (tokens[parseIndex].type == TokenType::Fn ||
-            (parseIndex < tokens.size() - 1 && tokens[parseIndex + 1].type == TokenType::Fn)) {
-            return ParseFunction();
-        }
-        if (tokens[parseIndex].type == TokenType::Const) {
-            return ParseConstantItem();
-        }
-        if (tokens[parseIndex].type == TokenType::Struct) {
-            return ParseStruct();
-        }
-        if (tokens[parseIndex].type == TokenType::Enum) {
-            return ParseEnumeration();
-        }
-        if (tokens[parseIndex].type == TokenType::Impl) {
-            return ParseImplementation();
-        }
-        return ParseTrait();
-    } catch (const ParseError &) {
-        throw;
+VisItemNode *Parser::ParseVisItem() {
+    if (tokens.type(parseIndex) == TokenType::Fn ||
+        (!tokens.AtEnd(parseIndex + 1) && tokens.type(parseIndex + 1) == TokenType::Fn)) {
+        return ParseFunction();
+    }
+    if (tokens.type(parseIndex) == TokenType::Const) {
+        return ParseConstantItem();
+    }
+    if (tokens.type(parseIndex) == TokenType::Struct) {
+        return ParseStruct();
     }
+    if (tokens.type(parseIndex) == TokenType::Enum) {
+        return ParseEnumeration();
+    }
+    if (tokens.type(parseIndex) == TokenType::Impl) {
+        return ParseImplementation();
+    }
+    return ParseTrait();
 }
 
-std::shared_ptr<FunctionNode> Parser::ParseFunction() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<FunctionParametersNode> function_parameters_node = nullptr;
-    std::shared_ptr<TypeNode> type_node = nullptr;
-    std::shared_ptr<BlockExpressionNode> block_expression_node = nullptr;
-    try {
-        bool is_const = false;
-        if (tokens[parseIndex].type == TokenType::Const) {
-            is_const = true;
-            parseIndex++;
-        }
-        ConsumeString("fn");
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-        }
-        std::string identifier = tokens[parseIndex].token;
+FunctionNode *Parser::ParseFunction() {
+    Position pos = tokens.pos(parseIndex);
+    FunctionParametersNode *function_parameters_node = nullptr;
+    TypeNode *type_node = nullptr;
+    BlockExpressionNode *block_expression_node = nullptr;
+    bool is_const = false;
+    if (tokens.type(parseIndex) == TokenType::Const) {
+        is_const = true;
         parseIndex++;
-        ConsumeString("(");
-        if (tokens[parseIndex].type != TokenType::RParen) {
-            function_parameters_node = ParseFunctionParameters();
+    }
+    if (!ConsumeString("fn")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex));
+    parseIndex++;
+    if (!ConsumeString("(")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::RParen) {
+        function_parameters_node = ParseFunctionParameters();
+        if (function_parameters_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString(")");
-        if (tokens[parseIndex].type == TokenType::RArrow) {
-            type_node = ParseFunctionReturnType();
+    }
+    if (!ConsumeString(")")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::RArrow) {
+        type_node = ParseFunctionReturnType();
+        if (type_node == nullptr) {
+            return nullptr;
         }
-        if (tokens[parseIndex].type != TokenType::Semicolon) {
-            block_expression_node = ParseBlockExpression();
-        } else {
-            ConsumeString(";");
+    }
+    const uint32_t item_statements = item_statements_;
+    if (tokens.type(parseIndex) != TokenType::Semicolon) {
+        block_expression_node = ParseBlockExpression();
+        if (block_expression_node == nullptr) {
+            return nullptr;
         }
-        return std::make_shared<FunctionNode>(pos, is_const, identifier, function_parameters_node,
-                                type_node, block_expression_node);
-    } catch (const ParseError &) {
-        throw;
+    } else {
+        parseIndex++;
     }
+    auto node = arena_.Make<FunctionNode>(pos, is_const, identifier, function_parameters_node,
+                                          type_node, block_expression_node);
+    node->has_nested_items_ = item_statements_ != item_statements;
+    return node;
 }
 
-std::shared_ptr<TypeNode> Parser::ParseFunctionReturnType() {
-    try {
-        ConsumeString("->");
-        return ParseType();
-    } catch (const ParseError &) {
-        throw;
+TypeNode *Parser::ParseFunctionReturnType() {
+    if (!ConsumeString("->")) {
+        return nullptr;
     }
+    return ParseType();
 }
 
 
-std::shared_ptr<FunctionParametersNode> Parser::ParseFunctionParameters() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<FunctionParamNode>> function_param_nodes;
-    std::shared_ptr<SelfParamNode> self_param_node;
-    try {
-        if (tokens[parseIndex].type == TokenType::Self || tokens[parseIndex + 1].type == TokenType::Self ||
-            tokens[parseIndex + 2].type == TokenType::Self) {
-            self_param_node = ParseSelfParamNode();
-            if (tokens[parseIndex].type == TokenType::RParen) {
-                return std::make_shared<FunctionParametersNode>(pos, self_param_node, function_param_nodes);
-            }
-        } else {
-            function_param_nodes.emplace_back(ParseFunctionParam());
+FunctionParametersNode *Parser::ParseFunctionParameters() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<FunctionParamNode *> function_param_nodes;
+    SelfParamNode *self_param_node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::Self || tokens.type(parseIndex + 1) == TokenType::Self ||
+        tokens.type(parseIndex + 2) == TokenType::Self) {
+        self_param_node = ParseSelfParamNode();
+        if (self_param_node == nullptr) {
+            return nullptr;
         }
-        while (tokens[parseIndex].type == TokenType::Comma) {
-            ConsumeString(",");
-            if (tokens[parseIndex].type == TokenType::RParen) {
-                break;
-            }
-            function_param_nodes.emplace_back(ParseFunctionParam());
+        if (tokens.type(parseIndex) == TokenType::RParen) {
+            return arena_.Make<FunctionParametersNode>(pos, self_param_node, function_param_nodes);
         }
-        return std::make_shared<FunctionParametersNode>(pos, self_param_node, std::move(function_param_nodes));
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<FunctionParamNode> Parser::ParseFunctionParam() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNoTopAltNode> function_param_pattern_node = nullptr;
-    std::shared_ptr<TypeNode> type_node = nullptr;
-    try {
-        if (tokens[parseIndex].type == TokenType::DotDotDot) {
-            ConsumeString("...");
-            return std::make_shared<FunctionParamNode>(pos, function_param_pattern_node, type_node, true);
+    } else {
+        auto function_param_node = ParseFunctionParam();
+        if (function_param_node == nullptr) {
+            return nullptr;
         }
-        function_param_pattern_node = ParsePatternNoTopAlt();
-        ConsumeString(":");
-        type_node = ParseType();
-        return std::make_shared<FunctionParamNode>(pos, function_param_pattern_node, type_node, false);
-    } catch (const ParseError &) {
-        throw ParseError("Parse Error: Failed to Match FunctionParam", pos);
+        function_param_nodes.emplace_back(function_param_node);
     }
-}
-
-std::shared_ptr<SelfParamNode> Parser::ParseSelfParamNode() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        bool is_mut = false;
-        bool have_and = false;
-        if (tokens[parseIndex].type == TokenType::And) {
-            ConsumeString("&");
-            have_and = true;
-        }
-        if (tokens[parseIndex].type == TokenType::Mut) {
-            ConsumeString("mut");
-            is_mut = true;
+    while (tokens.type(parseIndex) == TokenType::Comma) {
+        parseIndex++;
+        if (tokens.type(parseIndex) == TokenType::RParen) {
+            break;
         }
-        ConsumeString("self");
-        if (have_and || tokens[parseIndex].type != TokenType::Colon) {
-            return std::make_shared<ShortHandSelfNode>(pos, have_and, is_mut);
+        auto function_param_node = ParseFunctionParam();
+        if (function_param_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString(":");
-        auto type_node = ParseType();
-        return std::make_shared<TypedSelfNode>(pos, is_mut, type_node);
-    } catch (std::exception&) {
-        throw;
+        function_param_nodes.emplace_back(function_param_node);
     }
+    return arena_.Make<FunctionParametersNode>(pos, self_param_node, std::move(function_param_nodes));
 }
 
-
-std::shared_ptr<FunctionParamPatternNode> Parser::ParseFunctionParamPattern() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_node = nullptr;
-    std::shared_ptr<TypeNode> type_node = nullptr;
-    try {
-        pattern_no_top_alt_node = ParsePatternNoTopAlt();
-        ConsumeString(":");
-        if (tokens[parseIndex].type == TokenType::DotDotDot) {
-            ConsumeString("...");
-            return std::make_shared<FunctionParamPatternNode>(pos, pattern_no_top_alt_node, type_node, true);
-        }
-        type_node = ParseType();
-        return std::make_shared<FunctionParamPatternNode>(pos, pattern_no_top_alt_node, type_node, false);
-    } catch (const ParseError &) {
-        throw;
+FunctionParamNode *Parser::ParseFunctionParam() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNoTopAltNode *function_param_pattern_node = nullptr;
+    TypeNode *type_node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::DotDotDot) {
+        parseIndex++;
+        return arena_.Make<FunctionParamNode>(pos, function_param_pattern_node, type_node, true);
+    }
+    function_param_pattern_node = ParsePatternNoTopAlt();
+    if (function_param_pattern_node == nullptr || !ConsumeString(":")) {
+        return Fail("Parse Error: Failed to Match FunctionParam", pos);
     }
+    type_node = ParseType();
+    if (type_node == nullptr) {
+        return Fail("Parse Error: Failed to Match FunctionParam", pos);
+    }
+    return arena_.Make<FunctionParamNode>(pos, function_param_pattern_node, type_node, false);
 }
 
-std::shared_ptr<StructNode> Parser::ParseStruct() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<StructFieldNode>> struct_field_nodes;
-    try {
-        ConsumeString("struct");
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-        }
-        std::string identifier = tokens[parseIndex].token;
+SelfParamNode *Parser::ParseSelfParamNode() {
+    Position pos = tokens.pos(parseIndex);
+    bool is_mut = false;
+    bool have_and = false;
+    if (tokens.type(parseIndex) == TokenType::And) {
         parseIndex++;
-        if (tokens[parseIndex].type == TokenType::Semicolon) {
-            ConsumeString(";");
-            return std::make_shared<StructNode>(pos, identifier, std::move(struct_field_nodes));
-        }
-        ConsumeString("{");
-        if (tokens[parseIndex].type != TokenType::RBrace) {
-            struct_field_nodes.emplace_back(ParseStructFieldNode());
-            while (tokens[parseIndex].type == TokenType::Comma) {
-                ConsumeString(",");
-                if (tokens[parseIndex].type == TokenType::RBrace) {
-                    break;
-                }
-                struct_field_nodes.emplace_back(ParseStructFieldNode());
-            }
-        }
-        ConsumeString("}");
-        return std::make_shared<StructNode>(pos, identifier, std::move(struct_field_nodes));
-    } catch (const ParseError &) {
-        throw;
+        have_and = true;
+    }
+    if (tokens.type(parseIndex) == TokenType::Mut) {
+        parseIndex++;
+        is_mut = true;
+    }
+    if (!ConsumeString("self")) {
+        return nullptr;
+    }
+    if (have_and || tokens.type(parseIndex) != TokenType::Colon) {
+        return arena_.Make<ShortHandSelfNode>(pos, have_and, is_mut);
+    }
+    if (!ConsumeString(":")) {
+        return nullptr;
     }
+    auto type_node = ParseType();
+    if (type_node == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<TypedSelfNode>(pos, is_mut, type_node);
 }
 
-std::shared_ptr<StructFieldNode> Parser::ParseStructFieldNode() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-        }
-        std::string identifier = tokens[parseIndex++].token;
-        ConsumeString(":");
-        auto type_node = ParseType();
-        return std::make_shared<StructFieldNode>(pos, identifier, type_node);
-    } catch (const ParseError &) {
-        throw;
+
+FunctionParamPatternNode *Parser::ParseFunctionParamPattern() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNoTopAltNode *pattern_no_top_alt_node = nullptr;
+    TypeNode *type_node = nullptr;
+    pattern_no_top_alt_node = ParsePatternNoTopAlt();
+    if (pattern_no_top_alt_node == nullptr || !ConsumeString(":")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::DotDotDot) {
+        parseIndex++;
+        return arena_.Make<FunctionParamPatternNode>(pos, pattern_no_top_alt_node, type_node, true);
+    }
+    type_node = ParseType();
+    if (type_node == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<FunctionParamPatternNode>(pos, pattern_no_top_alt_node, type_node, false);
 }
 
-std::shared_ptr<EnumerationNode> Parser::ParseEnumeration() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<EnumVariantNode>> enum_variant_nodes;
-    try {
-        ConsumeString("enum");
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-        }
-        std::string identifier = tokens[parseIndex++].token;
-        ConsumeString("{");
-        if (tokens[parseIndex].type == TokenType::RBrace) {
-            ConsumeString("}");
-            return std::make_shared<EnumerationNode>(pos, identifier, std::move(enum_variant_nodes));
+StructNode *Parser::ParseStruct() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<StructFieldNode *> struct_field_nodes;
+    if (!ConsumeString("struct")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex));
+    parseIndex++;
+    if (tokens.type(parseIndex) == TokenType::Semicolon) {
+        parseIndex++;
+        return arena_.Make<StructNode>(pos, identifier, std::move(struct_field_nodes));
+    }
+    if (!ConsumeString("{")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::RBrace) {
+        auto struct_field_node = ParseStructFieldNode();
+        if (struct_field_node == nullptr) {
+            return nullptr;
         }
-        enum_variant_nodes.emplace_back(ParseEnumVariant());
-        while (tokens[parseIndex].type == TokenType::Comma) {
-            ConsumeString(",");
-            if (tokens[parseIndex].type == TokenType::RBrace) {
+        struct_field_nodes.emplace_back(struct_field_node);
+        while (tokens.type(parseIndex) == TokenType::Comma) {
+            parseIndex++;
+            if (tokens.type(parseIndex) == TokenType::RBrace) {
                 break;
             }
-            enum_variant_nodes.emplace_back(ParseEnumVariant());
+            struct_field_node = ParseStructFieldNode();
+            if (struct_field_node == nullptr) {
+                return nullptr;
+            }
+            struct_field_nodes.emplace_back(struct_field_node);
         }
-        ConsumeString("}");
-        return std::make_shared<EnumerationNode>(pos, identifier, std::move(enum_variant_nodes));
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("}")) {
+        return nullptr;
+    }
+    return arena_.Make<StructNode>(pos, identifier, std::move(struct_field_nodes));
 }
 
-std::shared_ptr<EnumVariantNode> Parser::ParseEnumVariant() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<EnumVariantStructNode> enum_variant_struct_node = nullptr;
-    std::shared_ptr<EnumVariantDiscriminantNode> enum_variant_discriminant_node = nullptr;
-    try {
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-        }
-        std::string identifier = tokens[parseIndex++].token;
-        if (tokens[parseIndex].type == TokenType::LBrace) {
-            enum_variant_struct_node = ParseEnumVariantStruct();
-        }
-        if (tokens[parseIndex].type == TokenType::Eq) {
-            enum_variant_discriminant_node = ParseEnumVariantDiscriminant();
-        }
-        return std::make_shared<EnumVariantNode>(pos, identifier, enum_variant_struct_node,
-                                   enum_variant_discriminant_node);
-    } catch (const ParseError &) {
-        throw;
+StructFieldNode *Parser::ParseStructFieldNode() {
+    Position pos = tokens.pos(parseIndex);
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex++));
+    if (!ConsumeString(":")) {
+        return nullptr;
     }
+    auto type_node = ParseType();
+    if (type_node == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<StructFieldNode>(pos, identifier, type_node);
 }
 
-std::shared_ptr<EnumVariantStructNode> Parser::ParseEnumVariantStruct() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<StructFieldNode>> struct_field_nodes;
-    try {
-        ConsumeString("{");
-        struct_field_nodes.emplace_back(ParseStructFieldNode());
-        while (tokens[parseIndex].type == TokenType::Comma) {
-            ConsumeString(",");
-            if (tokens[parseIndex].type == TokenType::RBrace) {
-                break;
-            }
-            struct_field_nodes.emplace_back(ParseStructFieldNode());
+EnumerationNode *Parser::ParseEnumeration() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<EnumVariantNode *> enum_variant_nodes;
+    if (!ConsumeString("enum")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex++));
+    if (!ConsumeString("{")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::RBrace) {
+        parseIndex++;
+        return arena_.Make<EnumerationNode>(pos, identifier, std::move(enum_variant_nodes));
+    }
+    auto enum_variant_node = ParseEnumVariant();
+    if (enum_variant_node == nullptr) {
+        return nullptr;
+    }
+    enum_variant_nodes.emplace_back(enum_variant_node);
+    while (tokens.type(parseIndex) == TokenType::Comma) {
+        parseIndex++;
+        if (tokens.type(parseIndex) == TokenType::RBrace) {
+            break;
+        }
+        enum_variant_node = ParseEnumVariant();
+        if (enum_variant_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<EnumVariantStructNode>(pos, std::move(struct_field_nodes));
-    } catch (const ParseError &) {
-        throw;
+        enum_variant_nodes.emplace_back(enum_variant_node);
+    }
+    if (!ConsumeString("}")) {
+        return nullptr;
     }
+    return arena_.Make<EnumerationNode>(pos, identifier, std::move(enum_variant_nodes));
 }
 
-std::shared_ptr<EnumVariantDiscriminantNode> Parser::ParseEnumVariantDiscriminant() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("=");
-        auto expression_node = ParseExpression();
-        return std::make_shared<EnumVariantDiscriminantNode>(pos, expression_node);
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<ConstantItemNode> Parser::ParseConstantItem() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<TypeNode> type_node = nullptr;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    try {
-        bool is_underscore = false;
-        std::string identifier;
-        ConsumeString("const");
-        if (tokens[parseIndex].type == TokenType::Underscore) {
-            is_underscore = true;
-            parseIndex++;
-        } else {
-            if (tokens[parseIndex].type != TokenType::Identifier) {
-                throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
-            }
-            identifier = tokens[parseIndex++].token;
+EnumVariantNode *Parser::ParseEnumVariant() {
+    Position pos = tokens.pos(parseIndex);
+    EnumVariantStructNode *enum_variant_struct_node = nullptr;
+    EnumVariantDiscriminantNode *enum_variant_discriminant_node = nullptr;
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex++));
+    if (tokens.type(parseIndex) == TokenType::LBrace) {
+        enum_variant_struct_node = ParseEnumVariantStruct();
+        if (enum_variant_struct_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString(":");
-        type_node = ParseType();
-        if (tokens[parseIndex].type == TokenType::Eq) {
-            ConsumeString("=");
-            expression_node = ParseExpression();
+    }
+    if (tokens.type(parseIndex) == TokenType::Eq) {
+        enum_variant_discriminant_node = ParseEnumVariantDiscriminant();
+        if (enum_variant_discriminant_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString(";");
-        return std::make_shared<ConstantItemNode>(pos, identifier, is_underscore, type_node, expression_node);
-    } catch (const ParseError &) {
-        throw;
     }
+    return arena_.Make<EnumVariantNode>(pos, identifier, enum_variant_struct_node,
+                               enum_variant_discriminant_node);
 }
 
-std::shared_ptr<AssociatedItemNode> Parser::ParseAssociatedItem() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<ConstantItemNode> constant_item_node = nullptr;
-    std::shared_ptr<FunctionNode> function_node = nullptr;
-    try {
-        if (tokens[parseIndex].type == TokenType::Const) {
-            constant_item_node = ParseConstantItem();
-        } else {
-            function_node = ParseFunction();
+EnumVariantStructNode *Parser::ParseEnumVariantStruct() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<StructFieldNode *> struct_field_nodes;
+    if (!ConsumeString("{")) {
+        return nullptr;
+    }
+    auto struct_field_node = ParseStructFieldNode();
+    if (struct_field_node == nullptr) {
+        return nullptr;
+    }
+    struct_field_nodes.emplace_back(struct_field_node);
+    while (tokens.type(parseIndex) == TokenType::Comma) {
+        parseIndex++;
+        if (tokens.type(parseIndex) == TokenType::RBrace) {
+            break;
         }
-        return std::make_shared<AssociatedItemNode>(pos, constant_item_node, function_node);
-    } catch (const ParseError &) {
-        throw;
+        struct_field_node = ParseStructFieldNode();
+        if (struct_field_node == nullptr) {
+            return nullptr;
+        }
+        struct_field_nodes.emplace_back(struct_field_node);
+    }
+    if (!ConsumeString("}")) {
+        return nullptr;
     }
+    return arena_.Make<EnumVariantStructNode>(pos, std::move(struct_field_nodes));
 }
 
-std::shared_ptr<ImplementationNode> Parser::ParseImplementation() {
-    uint32_t start = parseIndex;
-    try {
-        return ParseInherentImpl();
-    } catch (const ParseError &e) {
-        // std::cout << e.what() << '\n';
-        parseIndex = start;
+EnumVariantDiscriminantNode *Parser::ParseEnumVariantDiscriminant() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("=")) {
+        return nullptr;
     }
-
-    try {
-        return ParseTraitImpl();
-    } catch (const ParseError &) {
-        throw;
+    auto expression_node = ParseExpression();
+    if (expression_node == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<EnumVariantDiscriminantNode>(pos, expression_node);
 }
 
-std::shared_ptr<InherentImplNode> Parser::ParseInherentImpl() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<AssociatedItemNode>> associated_item_nodes;
-    try {
-        ConsumeString("impl");
-        auto type_node = ParseType();
-        ConsumeString("{");
-        while (tokens[parseIndex].type != TokenType::RBrace) {
-            associated_item_nodes.emplace_back(ParseAssociatedItem());
-        }
-        ConsumeString("}");
-        return std::make_shared<InherentImplNode>(pos, type_node, std::move(associated_item_nodes));
-    } catch (const ParseError &) {
-        throw;
+ConstantItemNode *Parser::ParseConstantItem() {
+    Position pos = tokens.pos(parseIndex);
+    TypeNode *type_node = nullptr;
+    ExpressionNode *expression_node = nullptr;
+    bool is_underscore = false;
+    std::string identifier;
+    if (!ConsumeString("const")) {
+        return nullptr;
     }
-}
-
-std::shared_ptr<TraitImplNode> Parser::ParseTraitImpl() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<AssociatedItemNode>> associated_item_nodes;
-    try {
-        ConsumeString("impl");
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", tokens[parseIndex].pos);
+    if (tokens.type(parseIndex) == TokenType::Underscore) {
+        is_underscore = true;
+        parseIndex++;
+    } else {
+        if (tokens.type(parseIndex) != TokenType::Identifier) {
+            return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
         }
-        std::string identifier = tokens[parseIndex++].token;
-        ConsumeString("for");
-        auto type_node = ParseType();
-        ConsumeString("{");
-        while (tokens[parseIndex].type != TokenType::RBrace) {
-            associated_item_nodes.emplace_back(ParseAssociatedItem());
+        identifier = TokenText(parseIndex++);
+    }
+    if (!ConsumeString(":")) {
+        return nullptr;
+    }
+    type_node = ParseType();
+    if (type_node == nullptr) {
+        return nullptr;
+    }
+    const uint32_t item_statements = item_statements_;
+    if (tokens.type(parseIndex) == TokenType::Eq) {
+        parseIndex++;
+        expression_node = ParseExpression();
+        if (expression_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<TraitImplNode>(pos, identifier, type_node, std::move(associated_item_nodes));
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString(";")) {
+        return nullptr;
+    }
+    auto node = arena_.Make<ConstantItemNode>(pos, identifier, is_underscore, type_node, expression_node);
+    node->has_nested_items_ = item_statements_ != item_statements;
+    return node;
 }
 
-std::shared_ptr<TraitNode> Parser::ParseTrait() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<AssociatedItemNode>> associated_item_nodes;
-    try {
-        ConsumeString("trait");
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", pos);
+AssociatedItemNode *Parser::ParseAssociatedItem() {
+    Position pos = tokens.pos(parseIndex);
+    ConstantItemNode *constant_item_node = nullptr;
+    FunctionNode *function_node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::Const) {
+        constant_item_node = ParseConstantItem();
+        if (constant_item_node == nullptr) {
+            return nullptr;
         }
-        std::string identifier = tokens[parseIndex++].token;
-        ConsumeString("{");
-        while (tokens[parseIndex].type != TokenType::RBrace) {
-            associated_item_nodes.emplace_back(ParseAssociatedItem());
+    } else {
+        function_node = ParseFunction();
+        if (function_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<TraitNode>(pos, identifier, std::move(associated_item_nodes));
-    } catch (const ParseError &) {
-        throw;
     }
+    return arena_.Make<AssociatedItemNode>(pos, constant_item_node, function_node);
 }
 
-/****************  Expression  ****************/
-std::shared_ptr<ExpressionNode> Parser::ParseExpression() {
+ImplementationNode *Parser::ParseImplementation() {
     uint32_t start = parseIndex;
-    try {
-        return ParseExpressionWithoutBlock();
-    } catch (const ParseError &) {
-        parseIndex = start;
-    }
-
-    try {
-        return ParseExpressionWithBlock();
-    } catch (const ParseError &) {
-        throw;
+    if (auto node = ParseInherentImpl()) {
+        return node;
     }
+    parseIndex = start;
+    return ParseTraitImpl();
 }
 
-/****************  Expression With Block  ****************/
-std::shared_ptr<ExpressionNode> Parser::ParseExpressionWithBlock() {
-    try {
-        if (tokens[parseIndex].type == TokenType::Const) {
-            return ParseConstBlockExpression();
-        }
-        if (tokens[parseIndex].type == TokenType::Loop) {
-            return ParseInfiniteLoopExpression();
-        }
-        if (tokens[parseIndex].type == TokenType::While) {
-            return ParsePredicateLoopExpression();
-        }
-        if (tokens[parseIndex].type == TokenType::If) {
-            return ParseIfExpression();
-        }
-        if (tokens[parseIndex].type == TokenType::Match) {
-            return ParseMatchExpression();
+InherentImplNode *Parser::ParseInherentImpl() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<AssociatedItemNode *> associated_item_nodes;
+    if (!ConsumeString("impl")) {
+        return nullptr;
+    }
+    auto type_node = ParseType();
+    if (type_node == nullptr || !ConsumeString("{")) {
+        return nullptr;
+    }
+    while (tokens.type(parseIndex) != TokenType::RBrace) {
+        auto associated_item_node = ParseAssociatedItem();
+        if (associated_item_node == nullptr) {
+            return nullptr;
         }
-        return ParseBlockExpression();
-    } catch (const ParseError &) {
-        throw;
+        associated_item_nodes.emplace_back(associated_item_node);
+    }
+    if (!ConsumeString("}")) {
+        return nullptr;
     }
+    return arena_.Make<InherentImplNode>(pos, type_node, std::move(associated_item_nodes));
 }
 
-std::shared_ptr<BlockExpressionNode> Parser::ParseBlockExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        std::shared_ptr<StatementsNode> node = nullptr;
-        ConsumeString("{");
-        if (tokens[parseIndex].type != TokenType::RBrace) {
-            node = ParseStatements();
+TraitImplNode *Parser::ParseTraitImpl() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<AssociatedItemNode *> associated_item_nodes;
+    if (!ConsumeString("impl")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", tokens.pos(parseIndex));
+    }
+    std::string identifier(TokenText(parseIndex++));
+    if (!ConsumeString("for")) {
+        return nullptr;
+    }
+    auto type_node = ParseType();
+    if (type_node == nullptr || !ConsumeString("{")) {
+        return nullptr;
+    }
+    while (tokens.type(parseIndex) != TokenType::RBrace) {
+        auto associated_item_node = ParseAssociatedItem();
+        if (associated_item_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<BlockExpressionNode>(pos, false, node);
-    } catch (const ParseError &) {
-        throw;
+        associated_item_nodes.emplace_back(associated_item_node);
+    }
+    if (!ConsumeString("}")) {
+        return nullptr;
     }
+    return arena_.Make<TraitImplNode>(pos, identifier, type_node, std::move(associated_item_nodes));
 }
 
-std::shared_ptr<BlockExpressionNode> Parser::ParseConstBlockExpression() {
-    Position pos = tokens[parseIndex].pos;
-    ConsumeString("const");
-    try {
-        std::shared_ptr<StatementsNode> node = nullptr;
-        ConsumeString("{");
-        if (tokens[parseIndex].type != TokenType::RBrace) {
-            node = ParseStatements();
+TraitNode *Parser::ParseTrait() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<AssociatedItemNode *> associated_item_nodes;
+    if (!ConsumeString("trait")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", pos);
+    }
+    std::string identifier(TokenText(parseIndex++));
+    if (!ConsumeString("{")) {
+        return nullptr;
+    }
+    while (tokens.type(parseIndex) != TokenType::RBrace) {
+        auto associated_item_node = ParseAssociatedItem();
+        if (associated_item_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<BlockExpressionNode>(pos, true, node);
-    } catch (const ParseError &) {
-        throw;
+        associated_item_nodes.emplace_back(associated_item_node);
+    }
+    if (!ConsumeString("}")) {
+        return nullptr;
     }
+    return arena_.Make<TraitNode>(pos, identifier, std::move(associated_item_nodes));
 }
 
-
-std::shared_ptr<InfiniteLoopExpressionNode> Parser::ParseInfiniteLoopExpression() {
-    Position pos = tokens[parseIndex].pos;
-    ConsumeString("loop");
-    try {
-        auto node = ParseBlockExpression();
-        return std::make_shared<InfiniteLoopExpressionNode>(pos, node);
-    } catch (const ParseError &) {
-        throw;
+/****************  Expression  ****************/
+ExpressionNode *Parser::ParseExpression() {
+    uint32_t start = parseIndex;
+    if (auto node = ParseExpressionWithoutBlock()) {
+        return node;
     }
+    parseIndex = start;
+    return ParseExpressionWithBlock();
 }
 
-std::shared_ptr<PredicateLoopExpressionNode> Parser::ParsePredicateLoopExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("while");
-        auto conditions = ParseConditions();
-        auto node = ParseBlockExpression();
-        return std::make_shared<PredicateLoopExpressionNode>(pos, conditions, node);
-    } catch (const ParseError &) {
-        throw;
+/****************  Expression With Block  ****************/
+ExpressionNode *Parser::ParseExpressionWithBlock() {
+    if (auto node = Recall(with_block_memo_)) {
+        return node;
     }
+    const uint32_t start = parseIndex;
+    return Remember(with_block_memo_, start, ParseExpressionWithBlockUncached());
 }
 
-std::shared_ptr<IfExpressionNode> Parser::ParseIfExpression() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<ConditionsNode> conditions_node = nullptr;
-    std::shared_ptr<BlockExpressionNode> true_block_expression_node = nullptr;
-    std::shared_ptr<BlockExpressionNode> false_block_expression_node = nullptr;
-    std::shared_ptr<IfExpressionNode> if_expression_node = nullptr;
-    try {
-        ConsumeString("if");
-        conditions_node = ParseConditions();
-        true_block_expression_node = ParseBlockExpression();
-        if (tokens[parseIndex].type == TokenType::Else) {
-            ConsumeString("else");
-            if (tokens[parseIndex].type == TokenType::If) {
-                if_expression_node = ParseIfExpression();
-            } else {
-                false_block_expression_node = ParseBlockExpression();
-            }
-        }
-        return std::make_shared<IfExpressionNode>(pos, conditions_node, true_block_expression_node,
-                                    false_block_expression_node, if_expression_node);
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<MatchExpressionNode> Parser::ParseMatchExpression() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    std::shared_ptr<MatchArmsNode> match_arms_node = nullptr;
-    try {
-        ConsumeString("match");
-        expression_node = ParseExpression(); // TODO Check whether it is a StructExpression
-        ConsumeString("{");
-        if (tokens[parseIndex].type != TokenType::RBrace) {
-            match_arms_node = ParseMatchArms();
-        }
-        ConsumeString("}");
-        return std::make_shared<MatchExpressionNode>(pos, expression_node, match_arms_node);
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<MatchArmsNode> Parser::ParseMatchArms() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<MatchArmNode>> match_arms_nodes;
-    std::vector<std::shared_ptr<ExpressionNode>> expression_nodes;
-    try {
-        while (tokens[parseIndex].type != TokenType::RBrace) {
-            match_arms_nodes.emplace_back(ParseMatchArm());
-            ConsumeString("=>");
-            expression_nodes.emplace_back(ParseExpression());
-            if (std::dynamic_pointer_cast<BlockExpressionNode>(expression_nodes.back()) != nullptr) {
-                if (tokens[parseIndex].type == TokenType::Comma) {
-                    ConsumeString(",");
-                }
-            } else {
-                if (tokens[parseIndex].type == TokenType::Comma) {
-                    ConsumeString(",");
-                } else {
-                    break;
-                }
-            }
-        }
-        return std::make_shared<MatchArmsNode>(pos, std::move(match_arms_nodes), std::move(expression_nodes));
-    } catch (const ParseError &) {
-        throw;
+ExpressionNode *Parser::ParseExpressionWithBlockUncached() {
+    if (tokens.type(parseIndex) == TokenType::Const) {
+        return ParseConstBlockExpression();
     }
+    if (tokens.type(parseIndex) == TokenType::Loop) {
+        return ParseInfiniteLoopExpression();
+    }
+    if (tokens.type(parseIndex) == TokenType::While) {
+        return ParsePredicateLoopExpression();
+    }
+    if (tokens.type(parseIndex) == TokenType::If) {
+        return ParseIfExpression();
+    }
+    if (tokens.type(parseIndex) == TokenType::Match) {
+        return ParseMatchExpression();
+    }
+    return ParseBlockExpression();
 }
 
-std::shared_ptr<MatchArmNode> Parser::ParseMatchArm() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNode> pattern_node = nullptr;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    try {
-        pattern_node = ParsePattern();
-        if (tokens[parseIndex].type == TokenType::If) {
-            ConsumeString("if");
-            expression_node = ParseExpression();
+BlockExpressionNode *Parser::ParseBlockExpression() {
+    Position pos = tokens.pos(parseIndex);
+    StatementsNode *node = nullptr;
+    if (!ConsumeString("{")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::RBrace) {
+        node = ParseStatements();
+        if (node == nullptr) {
+            return nullptr;
         }
-        return std::make_shared<MatchArmNode>(pos, pattern_node, expression_node);
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("}")) {
+        return nullptr;
+    }
+    return arena_.Make<BlockExpressionNode>(pos, false, node);
 }
 
-/****************  Expression Without Block  ****************/
-std::shared_ptr<ExpressionNode> Parser::ParseExpressionWithoutBlock() {
-    Position pos = tokens[parseIndex].pos;
-    if (tokens[parseIndex].type == TokenType::Continue) {
-        ConsumeString("continue");
-        return std::make_shared<ContinueExpressionNode>(pos);
+BlockExpressionNode *Parser::ParseConstBlockExpression() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("const")) {
+        return nullptr;
     }
-    try {
-        return ParseJumpExpression();
-    } catch (const ParseError &) {
-        throw;
+    StatementsNode *node = nullptr;
+    if (!ConsumeString("{")) {
+        return nullptr;
     }
-}
-
-std::shared_ptr<ExpressionNode> Parser::ParseTupleExpression() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<ExpressionNode>> expression_nodes;
-    try {
-        ConsumeString("(");
-        while (tokens[parseIndex].token != ")") {
-            expression_nodes.emplace_back(ParseExpression());
+    if (tokens.type(parseIndex) != TokenType::RBrace) {
+        node = ParseStatements();
+        if (node == nullptr) {
+            return nullptr;
         }
-        ConsumeString(")");
-        return std::make_shared<TupleExpressionNode>(pos, std::move(expression_nodes));
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("}")) {
+        return nullptr;
+    }
+    return arena_.Make<BlockExpressionNode>(pos, true, node);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseJumpExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        TokenType type;
-        if (tokens[parseIndex].type == TokenType::Break) {
-            type = TokenType::Break;
-            parseIndex++;
-        } else if (tokens[parseIndex].type == TokenType::Return) {
-            type = TokenType::Return;
-            parseIndex++;
-        } else {
-            return ParseAssignmentExpression();
-        }
 
-        std::shared_ptr<ExpressionNode> tmp = nullptr;
-        try {
-            tmp = ParseAssignmentExpression();
-        } catch (const ParseError &) {
-            tmp = nullptr;
-        }
+InfiniteLoopExpressionNode *Parser::ParseInfiniteLoopExpression() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("loop")) {
+        return nullptr;
+    }
+    auto node = ParseBlockExpression();
+    if (node == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<InfiniteLoopExpressionNode>(pos, node);
+}
 
-        return std::make_shared<JumpExpressionNode>(pos, type, tmp);
-    } catch (const ParseError &) {
-        throw;
+PredicateLoopExpressionNode *Parser::ParsePredicateLoopExpression() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("while")) {
+        return nullptr;
     }
+    auto conditions = ParseConditions();
+    if (conditions == nullptr) {
+        return nullptr;
+    }
+    auto node = ParseBlockExpression();
+    if (node == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<PredicateLoopExpressionNode>(pos, conditions, node);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseAssignmentExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseLogicalOrExpression();
-        if (tokens[parseIndex].type == TokenType::Eq || tokens[parseIndex].type == TokenType::PlusEq ||
-            tokens[parseIndex].type == TokenType::MinusEq || tokens[parseIndex].type == TokenType::MulEq ||
-            tokens[parseIndex].type == TokenType::DivEq || tokens[parseIndex].type == TokenType::ModEq ||
-            tokens[parseIndex].type == TokenType::AndEq || tokens[parseIndex].type == TokenType::OrEq ||
-            tokens[parseIndex].type == TokenType::XorEq || tokens[parseIndex].type == TokenType::SLEq ||
-            tokens[parseIndex].type == TokenType::SREq) {
-            if (!lhs_ -> is_assignable_) {
-                throw ParseError("Semantic Error: Left Value Error", pos);
+IfExpressionNode *Parser::ParseIfExpression() {
+    Position pos = tokens.pos(parseIndex);
+    ConditionsNode *conditions_node = nullptr;
+    BlockExpressionNode *true_block_expression_node = nullptr;
+    BlockExpressionNode *false_block_expression_node = nullptr;
+    IfExpressionNode *if_expression_node = nullptr;
+    if (!ConsumeString("if")) {
+        return nullptr;
+    }
+    conditions_node = ParseConditions();
+    if (conditions_node == nullptr) {
+        return nullptr;
+    }
+    true_block_expression_node = ParseBlockExpression();
+    if (true_block_expression_node == nullptr) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::Else) {
+        parseIndex++;
+        if (tokens.type(parseIndex) == TokenType::If) {
+            if_expression_node = ParseIfExpression();
+            if (if_expression_node == nullptr) {
+                return nullptr;
+            }
+        } else {
+            false_block_expression_node = ParseBlockExpression();
+            if (false_block_expression_node == nullptr) {
+                return nullptr;
             }
-            TokenType type = tokens[parseIndex].type;
-            parseIndex++;
-            auto rhs_ = ParseAssignmentExpression();
-            return std::make_shared<AssignmentExpressionNode>(pos, type, lhs_, rhs_);
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
+    return arena_.Make<IfExpressionNode>(pos, conditions_node, true_block_expression_node,
+                                false_block_expression_node, if_expression_node);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseLogicalOrExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseLogicalAndExpression();
-        while (tokens[parseIndex].type == TokenType::OrOr) {
-            ConsumeString("||");
-            auto rhs_ = ParseLogicalAndExpression();
-            lhs_ = std::make_shared<LogicOrExpressionNode>(pos, lhs_, rhs_);
+MatchExpressionNode *Parser::ParseMatchExpression() {
+    Position pos = tokens.pos(parseIndex);
+    ExpressionNode *expression_node = nullptr;
+    MatchArmsNode *match_arms_node = nullptr;
+    if (!ConsumeString("match")) {
+        return nullptr;
+    }
+    expression_node = ParseExpression(); // TODO Check whether it is a StructExpression
+    if (expression_node == nullptr || !ConsumeString("{")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::RBrace) {
+        match_arms_node = ParseMatchArms();
+        if (match_arms_node == nullptr) {
+            return nullptr;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("}")) {
+        return nullptr;
+    }
+    return arena_.Make<MatchExpressionNode>(pos, expression_node, match_arms_node);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseLogicalAndExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseComparisonExpression();
-        while (tokens[parseIndex].type == TokenType::AndAnd) {
-            ConsumeString("&&");
-            auto rhs_ = ParseComparisonExpression();
-            lhs_ = std::make_shared<LogicAndExpressionNode>(pos, lhs_, rhs_);
+MatchArmsNode *Parser::ParseMatchArms() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<MatchArmNode *> match_arms_nodes;
+    std::vector<ExpressionNode *> expression_nodes;
+    while (tokens.type(parseIndex) != TokenType::RBrace) {
+        auto match_arm_node = ParseMatchArm();
+        if (match_arm_node == nullptr || !ConsumeString("=>")) {
+            return nullptr;
+        }
+        match_arms_nodes.emplace_back(match_arm_node);
+        auto expression_node = ParseExpression();
+        if (expression_node == nullptr) {
+            return nullptr;
+        }
+        expression_nodes.emplace_back(expression_node);
+        if (isa<BlockExpressionNode>(expression_nodes.back())) {
+            if (tokens.type(parseIndex) == TokenType::Comma) {
+                parseIndex++;
+            }
+        } else {
+            if (tokens.type(parseIndex) == TokenType::Comma) {
+                parseIndex++;
+            } else {
+                break;
+            }
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
+    return arena_.Make<MatchArmsNode>(pos, std::move(match_arms_nodes), std::move(expression_nodes));
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseComparisonExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseBitwiseOrExpression();
-        while (tokens[parseIndex].type == TokenType::Lt || tokens[parseIndex].type == TokenType::Gt
-               || tokens[parseIndex].type == TokenType::LEq || tokens[parseIndex].type == TokenType::GEq
-               || tokens[parseIndex].type == TokenType::EqEq || tokens[parseIndex].type == TokenType::NEq) {
-            TokenType type = tokens[parseIndex].type;
-            parseIndex++;
-            auto rhs_ = ParseBitwiseOrExpression();
-            lhs_ = std::make_shared<ComparisonExpressionNode>(pos, type, lhs_, rhs_);
+MatchArmNode *Parser::ParseMatchArm() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNode *pattern_node = nullptr;
+    ExpressionNode *expression_node = nullptr;
+    pattern_node = ParsePattern();
+    if (pattern_node == nullptr) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::If) {
+        parseIndex++;
+        expression_node = ParseExpression();
+        if (expression_node == nullptr) {
+            return nullptr;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
+    return arena_.Make<MatchArmNode>(pos, pattern_node, expression_node);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseBitwiseOrExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseBitwiseXorExpression();
-        while (tokens[parseIndex].type == TokenType::Or) {
-            parseIndex++;
-            auto rhs_ = ParseBitwiseXorExpression();
-            lhs_ = std::make_shared<BitwiseOrExpressionNode>(pos, lhs_, rhs_);
-        }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
+/****************  Expression Without Block  ****************/
+ExpressionNode *Parser::ParseExpressionWithoutBlock() {
+    if (auto node = Recall(without_block_memo_)) {
+        return node;
     }
+    const uint32_t start = parseIndex;
+    return Remember(without_block_memo_, start, ParseExpressionWithoutBlockUncached());
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseBitwiseXorExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseBitwiseAndExpression();
-        while (tokens[parseIndex].type == TokenType::Xor) {
-            parseIndex++;
-            auto rhs_ = ParseBitwiseAndExpression();
-            lhs_ = std::make_shared<BitwiseXorExpressionNode>(pos, lhs_, rhs_);
-        }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
+ExpressionNode *Parser::ParseExpressionWithoutBlockUncached() {
+    Position pos = tokens.pos(parseIndex);
+    if (tokens.type(parseIndex) == TokenType::Continue) {
+        parseIndex++;
+        return arena_.Make<ContinueExpressionNode>(pos);
     }
+    return ParseJumpExpression();
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseBitwiseAndExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseShiftExpression();
-        while (tokens[parseIndex].type == TokenType::And) {
-            parseIndex++;
-            auto rhs_ = ParseShiftExpression();
-            lhs_ = std::make_shared<BitwiseAndExpressionNode>(pos, lhs_, rhs_);
+ExpressionNode *Parser::ParseTupleExpression() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<ExpressionNode *> expression_nodes;
+    if (!ConsumeString("(")) {
+        return nullptr;
+    }
+    while (TokenText(parseIndex) != ")") {
+        auto expression_node = ParseExpression();
+        if (expression_node == nullptr) {
+            return nullptr;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
+        expression_nodes.emplace_back(expression_node);
+    }
+    if (!ConsumeString(")")) {
+        return nullptr;
     }
+    return arena_.Make<TupleExpressionNode>(pos, std::move(expression_nodes));
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseShiftExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseAddMinusExpression();
-        while (tokens[parseIndex].type == TokenType::SL || tokens[parseIndex].type == TokenType::SR) {
-            TokenType type = tokens[parseIndex].type;
-            parseIndex++;
-            auto rhs_ = ParseAddMinusExpression();
-            lhs_ = std::make_shared<ShiftExpressionNode>(pos, type, lhs_, rhs_);
-        }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
+ExpressionNode *Parser::ParseJumpExpression() {
+    Position pos = tokens.pos(parseIndex);
+    TokenType type;
+    if (tokens.type(parseIndex) == TokenType::Break) {
+        type = TokenType::Break;
+        parseIndex++;
+    } else if (tokens.type(parseIndex) == TokenType::Return) {
+        type = TokenType::Return;
+        parseIndex++;
+    } else {
+        return ParseAssignmentExpression();
     }
+
+    // A bare `break` or `return` has no operand; a failed parse leaves tmp null.
+    ExpressionNode *tmp = ParseAssignmentExpression();
+    return arena_.Make<JumpExpressionNode>(pos, type, tmp);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseAddMinusExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseMulDivModExpression();
-        while (tokens[parseIndex].type == TokenType::Plus || tokens[parseIndex].type == TokenType::Minus) {
-            TokenType type = tokens[parseIndex].type;
-            parseIndex++;
-            auto rhs_ = ParseMulDivModExpression();
-            lhs_ = std::make_shared<AddMinusExpressionNode>(pos, type, lhs_, rhs_);
-        }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
-    }
+ExpressionNode *Parser::ParseAssignmentExpression() {
+    return ParseOperatorExpression(Precedence::Assignment);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseMulDivModExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseTypeCastExpression();
-        while (tokens[parseIndex].type == TokenType::Mul || tokens[parseIndex].type == TokenType::Div
-               || tokens[parseIndex].type == TokenType::MOD) {
-            TokenType type = tokens[parseIndex].type;
+// Precedence climbing over the binary operators and `as`. Operands are unary
+// expressions; an operator binding at least as tightly as `min_precedence`
+// extends lhs_, and its right operand is parsed one level tighter, so a chain
+// of equal-precedence operators is built left-associatively in this loop
+// rather than by recursion. Assignment is the exception: it is right
+// associative and ends the expression, as in the grammar.
+ExpressionNode *Parser::ParseOperatorExpression(const Precedence min_precedence) {
+    Position pos = tokens.pos(parseIndex);
+    auto lhs_ = ParseUnaryExpression();
+    if (lhs_ == nullptr) {
+        return nullptr;
+    }
+    while (true) {
+        const TokenType type = tokens.type(parseIndex);
+        const Precedence precedence = BinaryPrecedence(type);
+        if (precedence == Precedence::None || precedence < min_precedence) {
+            return lhs_;
+        }
+        if (precedence == Precedence::Assignment) {
+            if (!lhs_ -> is_assignable_) {
+                return Fail("Semantic Error: Left Value Error", pos);
+            }
             parseIndex++;
-            auto rhs_ = ParseTypeCastExpression();
-            lhs_ = std::make_shared<MulDivModExpressionNode>(pos, type, lhs_, rhs_);
+            auto rhs_ = ParseOperatorExpression(Precedence::Assignment);
+            if (rhs_ == nullptr) {
+                return nullptr;
+            }
+            return arena_.Make<AssignmentExpressionNode>(pos, type, lhs_, rhs_);
+        }
+        parseIndex++;
+        if (precedence == Precedence::TypeCast) {
+            auto rhs_ = ParseType();
+            if (rhs_ == nullptr) {
+                return nullptr;
+            }
+            lhs_ = arena_.Make<TypeCastExpressionNode>(pos, rhs_, lhs_);
+            continue;
+        }
+        auto rhs_ = ParseOperatorExpression(static_cast<Precedence>(static_cast<uint8_t>(precedence) + 1));
+        if (rhs_ == nullptr) {
+            return nullptr;
+        }
+        switch (precedence) {
+            case Precedence::LogicalOr:
+                lhs_ = arena_.Make<LogicOrExpressionNode>(pos, lhs_, rhs_);
+                break;
+            case Precedence::LogicalAnd:
+                lhs_ = arena_.Make<LogicAndExpressionNode>(pos, lhs_, rhs_);
+                break;
+            case Precedence::Comparison:
+                lhs_ = arena_.Make<ComparisonExpressionNode>(pos, type, lhs_, rhs_);
+                break;
+            case Precedence::BitwiseOr:
+                lhs_ = arena_.Make<BitwiseOrExpressionNode>(pos, lhs_, rhs_);
+                break;
+            case Precedence::BitwiseXor:
+                lhs_ = arena_.Make<BitwiseXorExpressionNode>(pos, lhs_, rhs_);
+                break;
+            case Precedence::BitwiseAnd:
+                lhs_ = arena_.Make<BitwiseAndExpressionNode>(pos, lhs_, rhs_);
+                break;
+            case Precedence::Shift:
+                lhs_ = arena_.Make<ShiftExpressionNode>(pos, type, lhs_, rhs_);
+                break;
+            case Precedence::AddMinus:
+                lhs_ = arena_.Make<AddMinusExpressionNode>(pos, type, lhs_, rhs_);
+                break;
+            default:
+                lhs_ = arena_.Make<MulDivModExpressionNode>(pos, type, lhs_, rhs_);
+                break;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseTypeCastExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParseUnaryExpression();
-        while (tokens[parseIndex].type == TokenType::As) {
+// Prefix operators are collected first and applied innermost-first once the
+// operand is parsed, so a long run of them does not recurse either.
+ExpressionNode *Parser::ParseUnaryExpression() {
+    struct Prefix {
+        Position pos;
+        TokenType type;
+    };
+    std::vector<Prefix> prefixes;
+    while (tokens.type(parseIndex) == TokenType::Minus ||
+        tokens.type(parseIndex) == TokenType::Not ||
+        tokens.type(parseIndex) == TokenType::And ||
+        tokens.type(parseIndex) == TokenType::AndAnd ||
+        tokens.type(parseIndex) == TokenType::Mul) {
+        Position pos = tokens.pos(parseIndex);
+        TokenType type = tokens.type(parseIndex++);
+        if (type == TokenType::And && tokens.type(parseIndex) == TokenType::Mut) {
             parseIndex++;
-            auto rhs_ = ParseType();
-            lhs_ = std::make_shared<TypeCastExpressionNode>(pos, rhs_, lhs_);
+            type = TokenType::AndMut;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
+        if (type == TokenType::AndAnd && tokens.type(parseIndex) == TokenType::Mut) {
+            parseIndex++;
+            type = TokenType::AndAndMut;
+        }
+        prefixes.push_back({pos, type});
+    }
+    auto operand = ParseCallExpression();
+    if (operand == nullptr) {
+        return nullptr;
     }
+    for (auto prefix = prefixes.rbegin(); prefix != prefixes.rend(); ++prefix) {
+        // Only a dereference can be assigned through.
+        operand = arena_.Make<UnaryExpressionNode>(prefix->pos, prefix->type, operand,
+                                                        prefix->type == TokenType::Mul);
+    }
+    return operand;
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseUnaryExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        bool is_assignable = false;
-        while (tokens[parseIndex].type == TokenType::Minus ||
-            tokens[parseIndex].type == TokenType::Not ||
-            tokens[parseIndex].type == TokenType::And ||
-            tokens[parseIndex].type == TokenType::AndAnd ||
-            tokens[parseIndex].type == TokenType::Mul) {
-            if (tokens[parseIndex].type == TokenType::Mul) {
-                is_assignable = true;
-            }
-            TokenType type = tokens[parseIndex++].type;
-            if (type == TokenType::And && tokens[parseIndex].type == TokenType::Mut) {
-                ConsumeString("mut");
-                type = TokenType::AndMut;
-            }
-            if (type == TokenType::AndAnd && tokens[parseIndex].type == TokenType::Mut) {
-                ConsumeString("mut");
-                type = TokenType::AndAndMut;
-            }
-            auto rhs_ = ParseUnaryExpression();
-            return std::make_shared<UnaryExpressionNode>(pos, type, rhs_, is_assignable);
-        }
-        return ParseCallExpression();
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<ExpressionNode> Parser::ParseCallExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto lhs_ = ParsePrimaryExpression();
-        while (true) {
-            if (tokens[parseIndex].type == TokenType::LParen) {
-                ConsumeString("(");
-                std::vector<std::shared_ptr<ExpressionNode>> params_;
-                while (tokens[parseIndex].type != TokenType::RParen) {
-                    params_.push_back(ParseExpression());
-                    if (tokens[parseIndex].type == TokenType::Comma) {
-                        ConsumeString(",");
-                    } else if (tokens[parseIndex].type != TokenType::RParen) {
-                        throw ParseError("Parse Error: Lack of , to split two params", pos);
-                    }
+ExpressionNode *Parser::ParseCallExpression() {
+    Position pos = tokens.pos(parseIndex);
+    auto lhs_ = ParsePrimaryExpression();
+    if (lhs_ == nullptr) {
+        return nullptr;
+    }
+    while (true) {
+        if (tokens.type(parseIndex) == TokenType::LParen) {
+            parseIndex++;
+            std::vector<ExpressionNode *> params_;
+            while (tokens.type(parseIndex) != TokenType::RParen) {
+                auto param = ParseExpression();
+                if (param == nullptr) {
+                    return nullptr;
                 }
-                ConsumeString(")");
-                lhs_ = std::make_shared<FunctionCallExpressionNode>(pos, lhs_, std::move(params_));
-            } else if (tokens[parseIndex].type == TokenType::LBracket) {
-                ConsumeString("[");
-                auto expression_node = ParseExpression();
-                ConsumeString("]");
-                lhs_ = std::make_shared<ArrayIndexExpressionNode>(pos, lhs_, expression_node);
-            } else if (tokens[parseIndex].type == TokenType::Dot) {
-                ConsumeString(".");
-                if (tokens[parseIndex].type == TokenType::IntegerLiteral ||
-                    tokens[parseIndex].type == TokenType::Identifier) {
-                    lhs_ = std::make_shared<MemberAccessExpressionNode>(pos, lhs_, tokens[parseIndex]);
+                params_.push_back(param);
+                if (tokens.type(parseIndex) == TokenType::Comma) {
                     parseIndex++;
-                } else {
-                    throw ParseError("Parse Error: Expected an identifier or integer after .", pos);
+                } else if (tokens.type(parseIndex) != TokenType::RParen) {
+                    return Fail("Parse Error: Lack of , to split two params", pos);
                 }
+            }
+            if (!ConsumeString(")")) {
+                return nullptr;
+            }
+            lhs_ = arena_.Make<FunctionCallExpressionNode>(pos, lhs_, std::move(params_));
+        } else if (tokens.type(parseIndex) == TokenType::LBracket) {
+            parseIndex++;
+            auto expression_node = ParseExpression();
+            if (expression_node == nullptr || !ConsumeString("]")) {
+                return nullptr;
+            }
+            lhs_ = arena_.Make<ArrayIndexExpressionNode>(pos, lhs_, expression_node);
+        } else if (tokens.type(parseIndex) == TokenType::Dot) {
+            parseIndex++;
+            if (tokens.type(parseIndex) == TokenType::IntegerLiteral ||
+                tokens.type(parseIndex) == TokenType::Identifier) {
+                lhs_ = arena_.Make<MemberAccessExpressionNode>(pos, lhs_, std::string(TokenText(parseIndex)));
+                parseIndex++;
             } else {
-                break;
+                return Fail("Parse Error: Expected an identifier or integer after .", pos);
             }
+        } else {
+            break;
         }
-        return lhs_;
-    } catch (const ParseError &) {
-        throw;
     }
+    return lhs_;
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParsePrimaryExpression() {
-    Position pos = tokens[parseIndex].pos;
+ExpressionNode *Parser::ParsePrimaryExpression() {
+    Position pos = tokens.pos(parseIndex);
     uint32_t start = parseIndex;
 
-    try {
-        return ParseLiteral();
-    } catch (const ParseError &) {
-        parseIndex = start;
+    if (auto node = ParseLiteral()) {
+        return node;
     }
+    parseIndex = start;
 
-    try {
-        return ParseStructExpression();
-    } catch (const ParseError &) {
-        parseIndex = start;
+    if (auto node = ParseStructExpression()) {
+        return node;
     }
+    parseIndex = start;
 
-    try {
-        if (tokens[parseIndex].type == TokenType::LBrace || tokens[parseIndex].type == TokenType::If ||
-            tokens[parseIndex].type == TokenType::Const || tokens[parseIndex].type == TokenType::Loop ||
-            tokens[parseIndex].type == TokenType::While) {
-            return ParseExpressionWithBlock();
-        }
-        if (tokens[parseIndex].type == TokenType::Identifier ||
-            tokens[parseIndex].type == TokenType::Self ||
-            tokens[parseIndex].type == TokenType::SELF) {
-            return ParsePathExpression();
-        }
-        if (tokens[parseIndex].type == TokenType::LParen) {
-            ConsumeString("(");
-            auto first = ParseExpression();
-            if (tokens[parseIndex].type == TokenType::Comma) {
-                std::vector<std::shared_ptr<ExpressionNode>> expression_nodes;
-                expression_nodes.emplace_back(first);
-                while (tokens[parseIndex].type != TokenType::RParen) {
-                    expression_nodes.push_back(ParseExpression());
-                    if (tokens[parseIndex].type == TokenType::Comma) {
-                        ConsumeString(",");
-                    } else {
-                        break; // Allow trailing comma
-                    }
+    if (tokens.type(parseIndex) == TokenType::LBrace || tokens.type(parseIndex) == TokenType::If ||
+        tokens.type(parseIndex) == TokenType::Const || tokens.type(parseIndex) == TokenType::Loop ||
+        tokens.type(parseIndex) == TokenType::While) {
+        return ParseExpressionWithBlock();
+    }
+    if (tokens.type(parseIndex) == TokenType::Identifier ||
+        tokens.type(parseIndex) == TokenType::Self ||
+        tokens.type(parseIndex) == TokenType::SELF) {
+        return ParsePathExpression();
+    }
+    if (tokens.type(parseIndex) == TokenType::LParen) {
+        parseIndex++;
+        auto first = ParseExpression();
+        if (first == nullptr) {
+            return nullptr;
+        }
+        if (tokens.type(parseIndex) == TokenType::Comma) {
+            std::vector<ExpressionNode *> expression_nodes;
+            expression_nodes.emplace_back(first);
+            while (tokens.type(parseIndex) != TokenType::RParen) {
+                auto expression_node = ParseExpression();
+                if (expression_node == nullptr) {
+                    return nullptr;
+                }
+                expression_nodes.push_back(expression_node);
+                if (tokens.type(parseIndex) == TokenType::Comma) {
+                    parseIndex++;
+                } else {
+                    break; // Allow trailing comma
                 }
-                ConsumeString(")");
-                return std::make_shared<TupleExpressionNode>(pos, std::move(expression_nodes));
             }
-            ConsumeString(")");
-            return std::make_shared<GroupedExpressionNode>(pos, first);
+            if (!ConsumeString(")")) {
+                return nullptr;
+            }
+            return arena_.Make<TupleExpressionNode>(pos, std::move(expression_nodes));
+        }
+        if (!ConsumeString(")")) {
+            return nullptr;
         }
-        throw ParseError("Parse Error: Invalid Primary Expression", pos);
-    } catch (const ParseError &) {
-        throw;
+        return arena_.Make<GroupedExpressionNode>(pos, first);
     }
+    return Fail("Parse Error: Invalid Primary Expression", pos);
 }
 
-std::shared_ptr<StructExpressionNode> Parser::ParseStructExpression() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PathInExpressionNode> path_in_expression_node = nullptr;
-    std::shared_ptr<StructExprFieldsNode> struct_field_node = nullptr;
-    std::shared_ptr<StructBaseNode> struct_base_node = nullptr;
-    try {
-        path_in_expression_node = ParsePathInExpression();
-        ConsumeString("{");
-        if (tokens[parseIndex].type == TokenType::DotDot) {
-            struct_base_node = ParseStructBase();
-        } else if (tokens[parseIndex].type != TokenType::RBrace) {
-            struct_field_node = ParseStructExprFields();
+StructExpressionNode *Parser::ParseStructExpression() {
+    Position pos = tokens.pos(parseIndex);
+    PathInExpressionNode *path_in_expression_node = nullptr;
+    StructExprFieldsNode *struct_field_node = nullptr;
+    StructBaseNode *struct_base_node = nullptr;
+    path_in_expression_node = ParsePathInExpression();
+    if (path_in_expression_node == nullptr || !ConsumeString("{")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::DotDot) {
+        struct_base_node = ParseStructBase();
+        if (struct_base_node == nullptr) {
+            return nullptr;
+        }
+    } else if (tokens.type(parseIndex) != TokenType::RBrace) {
+        struct_field_node = ParseStructExprFields();
+        if (struct_field_node == nullptr) {
+            return nullptr;
         }
-        ConsumeString("}");
-        return std::make_shared<StructExpressionNode>(pos, path_in_expression_node,
-                                        struct_field_node, struct_base_node);
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("}")) {
+        return nullptr;
+    }
+    return arena_.Make<StructExpressionNode>(pos, path_in_expression_node,
+                                    struct_field_node, struct_base_node);
 }
 
-std::shared_ptr<StructExprFieldNode> Parser::ParseStructExprField() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<ExpressionNode> expr = nullptr;
-    try {
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier Not Found", pos);
+StructExprFieldNode *Parser::ParseStructExprField() {
+    Position pos = tokens.pos(parseIndex);
+    ExpressionNode *expr = nullptr;
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier Not Found", pos);
+    }
+    std::string identifier(TokenText(parseIndex));
+    parseIndex++;
+    if (tokens.type(parseIndex) == TokenType::Colon) {
+        parseIndex++;
+        expr = ParseExpression();
+        if (expr == nullptr) {
+            return nullptr;
         }
-        std::string identifier = tokens[parseIndex].token;
+    }
+    return arena_.Make<StructExprFieldNode>(pos, identifier, expr);
+}
+
+StructExprFieldsNode *Parser::ParseStructExprFields() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<StructExprFieldNode *> fields;
+    StructBaseNode *base = nullptr;
+    auto field = ParseStructExprField();
+    if (field == nullptr) {
+        return nullptr;
+    }
+    fields.emplace_back(field);
+    while (tokens.type(parseIndex) == TokenType::Comma) {
         parseIndex++;
-        if (tokens[parseIndex].type == TokenType::Colon) {
-            ConsumeString(":");
-            expr = ParseExpression();
-        }
-        return std::make_shared<StructExprFieldNode>(pos, identifier, expr);
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<StructExprFieldsNode> Parser::ParseStructExprFields() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<StructExprFieldNode>> fields;
-    std::shared_ptr<StructBaseNode> base = nullptr;
-    try {
-        fields.emplace_back(ParseStructExprField());
-        while (tokens[parseIndex].type == TokenType::Comma) {
-            ConsumeString(",");
-            if (tokens[parseIndex].type == TokenType::DotDot) {
-                base = ParseStructBase();
-                break;
+        if (tokens.type(parseIndex) == TokenType::DotDot) {
+            base = ParseStructBase();
+            if (base == nullptr) {
+                return nullptr;
             }
-            if (tokens[parseIndex].type == TokenType::RBrace) {
-                break;
-            }
-            fields.emplace_back(ParseStructExprField());
+            break;
+        }
+        if (tokens.type(parseIndex) == TokenType::RBrace) {
+            break;
         }
-        return std::make_shared<StructExprFieldsNode>(pos, std::move(fields), base);
-    } catch (const ParseError &) {
-        throw;
+        field = ParseStructExprField();
+        if (field == nullptr) {
+            return nullptr;
+        }
+        fields.emplace_back(field);
     }
+    return arena_.Make<StructExprFieldsNode>(pos, std::move(fields), base);
 }
 
-std::shared_ptr<StructBaseNode> Parser::ParseStructBase() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("..");
-        auto expr = ParseExpression();
-        return std::make_shared<StructBaseNode>(pos, expr);
-    } catch (const ParseError &) {
-        throw;
+StructBaseNode *Parser::ParseStructBase() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("..")) {
+        return nullptr;
+    }
+    auto expr = ParseExpression();
+    if (expr == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<StructBaseNode>(pos, expr);
 }
 
-std::shared_ptr<ExpressionNode> Parser::ParseLiteral() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        if (tokens[parseIndex].type == TokenType::IntegerLiteral) {
-            std::string token_ = tokens[parseIndex].token;
-            bool is_u32 = true, is_i32 = true, is_isize = true, is_usize = true;
-            uint32_t len = token_.size();
-            if (len >= 3) {
-                if (token_.substr(len - 3, 3) == "i32") {
-                    is_i32 = true;
-                    is_u32 = is_isize = is_usize = false;
-                }
-                if (token_.substr(len - 3, 3) == "u32") {
-                    is_u32 = true;
-                    is_i32 = is_isize = is_usize = false;
-                }
+ExpressionNode *Parser::ParseLiteral() {
+    Position pos = tokens.pos(parseIndex);
+    if (tokens.type(parseIndex) == TokenType::IntegerLiteral) {
+        std::string_view token_ = TokenText(parseIndex);
+        bool is_u32 = true, is_i32 = true, is_isize = true, is_usize = true;
+        uint32_t len = token_.size();
+        if (len >= 3) {
+            if (token_.substr(len - 3, 3) == "i32") {
+                is_i32 = true;
+                is_u32 = is_isize = is_usize = false;
             }
-            if (len >= 5) {
-                if (token_.substr(len - 5, 5) == "isize") {
-                    is_isize = true;
-                    is_i32 = is_u32 = is_usize = false;
-                }
-                if (token_.substr(len - 5, 5) == "usize") {
-                    is_usize = true;
-                    is_i32 = is_u32 = is_isize = false;
-                }
+            if (token_.substr(len - 3, 3) == "u32") {
+                is_u32 = true;
+                is_i32 = is_isize = is_usize = false;
             }
-            return std::make_shared<IntLiteralNode>(pos, StringToInt(tokens[parseIndex++].token),
-                is_u32, is_i32, is_usize, is_isize);
         }
-        if (tokens[parseIndex].type == TokenType::StringLiteral ||
-            tokens[parseIndex].type == TokenType::RawStringLiteral) {
-            return std::make_shared<StringLiteralNode>(pos, rust_str_to_cpp(tokens[parseIndex++].token));
+        if (len >= 5) {
+            if (token_.substr(len - 5, 5) == "isize") {
+                is_isize = true;
+                is_i32 = is_u32 = is_usize = false;
+            }
+            if (token_.substr(len - 5, 5) == "usize") {
+                is_usize = true;
+                is_i32 = is_u32 = is_isize = false;
+            }
         }
-        if (tokens[parseIndex].type == TokenType::CStringLiteral ||
-            tokens[parseIndex].type == TokenType::RawCStringLiteral) {
-            return std::make_shared<CStringLiteralNode>(pos, rust_str_to_cpp(tokens[parseIndex++].token));
+        return arena_.Make<IntLiteralNode>(pos, StringToInt(TokenText(parseIndex++)),
+            is_u32, is_i32, is_usize, is_isize);
+    }
+    if (tokens.type(parseIndex) == TokenType::StringLiteral ||
+        tokens.type(parseIndex) == TokenType::RawStringLiteral) {
+        return arena_.Make<StringLiteralNode>(pos, rust_str_to_cpp(std::string(TokenText(parseIndex++))));
+    }
+    if (tokens.type(parseIndex) == TokenType::CStringLiteral ||
+        tokens.type(parseIndex) == TokenType::RawCStringLiteral) {
+        return arena_.Make<CStringLiteralNode>(pos, rust_str_to_cpp(std::string(TokenText(parseIndex++))));
+    }
+    if (tokens.type(parseIndex) == TokenType::CharLiteral) {
+        return arena_.Make<CharLiteralNode>(pos, rust_char_to_cpp(std::string(TokenText(parseIndex++))));
+    }
+    if (tokens.type(parseIndex) == TokenType::True) {
+        parseIndex++;
+        return arena_.Make<BoolLiteralNode>(pos, true);
+    }
+    if (tokens.type(parseIndex) == TokenType::False) {
+        parseIndex++;
+        return arena_.Make<BoolLiteralNode>(pos, false);
+    }
+    if (tokens.type(parseIndex) == TokenType::LBracket) {
+        parseIndex++;
+        std::vector<ExpressionNode *> expression_nodes;
+        ExpressionNode *lhs = nullptr;
+        ExpressionNode *rhs = nullptr;
+        if (tokens.type(parseIndex) == TokenType::RBracket) {
+            parseIndex++;
+            return arena_.Make<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
         }
-        if (tokens[parseIndex].type == TokenType::CharLiteral) {
-            return std::make_shared<CharLiteralNode>(pos, rust_char_to_cpp(tokens[parseIndex++].token));
+        auto tmp = ParseExpression();
+        if (tmp == nullptr) {
+            return nullptr;
         }
-        if (tokens[parseIndex].type == TokenType::True) {
-            parseIndex++;
-            return std::make_shared<BoolLiteralNode>(pos, true);
+        if (tokens.type(parseIndex) == TokenType::Semicolon) {
+            lhs = tmp;
+            if (!ConsumeString(";")) {
+                return nullptr;
+            }
+            rhs = ParseExpression();
+            if (rhs == nullptr || !ConsumeString("]")) {
+                return nullptr;
+            }
+            return arena_.Make<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
         }
-        if (tokens[parseIndex].type == TokenType::False) {
+        expression_nodes.emplace_back(tmp);
+        while (tokens.type(parseIndex) == TokenType::Comma) {
             parseIndex++;
-            return std::make_shared<BoolLiteralNode>(pos, false);
-        }
-        if (tokens[parseIndex].type == TokenType::LBracket) {
-            ConsumeString("[");
-            std::vector<std::shared_ptr<ExpressionNode>> expression_nodes;
-            std::shared_ptr<ExpressionNode> lhs = nullptr;
-            std::shared_ptr<ExpressionNode> rhs = nullptr;
-            if (tokens[parseIndex].type == TokenType::RBracket) {
-                ConsumeString("]");
-                return std::make_shared<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
-            }
-            auto tmp = ParseExpression();
-            if (tokens[parseIndex].type == TokenType::Semicolon) {
-                lhs = tmp;
-                ConsumeString(";");
-                rhs = ParseExpression();
-                ConsumeString("]");
-                return std::make_shared<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
+            if (tokens.type(parseIndex) == TokenType::RBracket) {
+                break;
             }
-            expression_nodes.emplace_back(tmp);
-            while (tokens[parseIndex].type == TokenType::Comma) {
-                ConsumeString(",");
-                if (tokens[parseIndex].type == TokenType::RBracket) {
-                    break;
-                }
-                expression_nodes.push_back(ParseExpression());
+            auto expression_node = ParseExpression();
+            if (expression_node == nullptr) {
+                return nullptr;
             }
-            ConsumeString("]");
-            return std::make_shared<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
+            expression_nodes.push_back(expression_node);
+        }
+        if (!ConsumeString("]")) {
+            return nullptr;
         }
-        throw ParseError("Parse Error: Not A Literal", pos);
-    } catch (const ParseError &) {
-        throw;
+        return arena_.Make<ArrayLiteralNode>(pos, std::move(expression_nodes), lhs, rhs);
     }
+    return Fail("Parse Error: Not A Literal", pos);
 }
 
-std::shared_ptr<PathExpressionNode> Parser::ParsePathExpression() {
-    try {
-        return ParsePathInExpression();
-    } catch (const ParseError &) {
-        throw;
-    }
+PathExpressionNode *Parser::ParsePathExpression() {
+    return ParsePathInExpression();
 }
 
 
-std::shared_ptr<PathInExpressionNode> Parser::ParsePathInExpression() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        std::vector<std::shared_ptr<PathIndentSegmentNode>> simple_path_segments;
-        if (tokens[parseIndex].type == TokenType::ColonColon) {
-            ConsumeString("::");
-        }
-        simple_path_segments.emplace_back(ParsePathIndentSegment());
-        while (tokens[parseIndex].type == TokenType::ColonColon) {
-            ConsumeString("::");
-            simple_path_segments.emplace_back(ParsePathIndentSegment());
+PathInExpressionNode *Parser::ParsePathInExpression() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<PathIndentSegmentNode *> simple_path_segments;
+    if (tokens.type(parseIndex) == TokenType::ColonColon) {
+        parseIndex++;
+    }
+    auto segment = ParsePathIndentSegment();
+    if (segment == nullptr) {
+        return nullptr;
+    }
+    simple_path_segments.emplace_back(segment);
+    while (tokens.type(parseIndex) == TokenType::ColonColon) {
+        parseIndex++;
+        segment = ParsePathIndentSegment();
+        if (segment == nullptr) {
+            return nullptr;
         }
-        return std::make_shared<PathInExpressionNode>(pos, std::move(simple_path_segments));
-    } catch (const ParseError &) {
-        throw;
+        simple_path_segments.emplace_back(segment);
     }
+    return arena_.Make<PathInExpressionNode>(pos, std::move(simple_path_segments));
 }
 
-std::shared_ptr<StatementsNode> Parser::ParseStatements() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<StatementNode>> statement_nodes;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    while (tokens[parseIndex].type != TokenType::RBrace) {
+StatementsNode *Parser::ParseStatements() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<StatementNode *> statement_nodes;
+    ExpressionNode *expression_node = nullptr;
+    while (tokens.type(parseIndex) != TokenType::RBrace) {
         uint32_t start = parseIndex;
-        try {
-            statement_nodes.emplace_back(ParseStatement());
+        if (auto statement_node = ParseStatement()) {
+            statement_nodes.emplace_back(statement_node);
             continue;
-        } catch (const ParseError &) {
-            parseIndex = start;
         }
+        parseIndex = start;
 
-        try {
-            expression_node = ParseExpressionWithoutBlock();
-            break;
-        } catch (const ParseError &) {
-            throw;
+        expression_node = ParseExpressionWithoutBlock();
+        if (expression_node == nullptr) {
+            return nullptr;
         }
+        break;
     }
-    return std::make_shared<StatementsNode>(pos, std::move(statement_nodes), expression_node);
+    return arena_.Make<StatementsNode>(pos, std::move(statement_nodes), expression_node);
 }
 
-std::shared_ptr<ConditionsNode> Parser::ParseConditions() {
-    Position pos = tokens[parseIndex].pos;
+ConditionsNode *Parser::ParseConditions() {
+    Position pos = tokens.pos(parseIndex);
     uint32_t start = parseIndex;
-    std::shared_ptr<ExpressionNode> tmp = nullptr;
-    std::shared_ptr<LetChainNode> let_chain_node = nullptr;
-    try {
-        ConsumeString("(");
+    ExpressionNode *tmp = nullptr;
+    LetChainNode *let_chain_node = nullptr;
+    if (ConsumeString("(")) {
         tmp = ParseExpression();
-        ConsumeString(")");
-        return std::make_shared<ConditionsNode>(pos, tmp, let_chain_node);
-    } catch (const ParseError &) {
-        parseIndex = start;
+        if (tmp != nullptr && ConsumeString(")")) {
+            return arena_.Make<ConditionsNode>(pos, tmp, let_chain_node);
+        }
     }
+    parseIndex = start;
 
-    try {
-        ConsumeString("(");
-        let_chain_node = ParseLetChain();
-        ConsumeString(")");
-        return std::make_shared<ConditionsNode>(pos, tmp, let_chain_node);
-    } catch (const ParseError &) {
-        throw;
+    if (!ConsumeString("(")) {
+        return nullptr;
     }
+    let_chain_node = ParseLetChain();
+    if (let_chain_node == nullptr || !ConsumeString(")")) {
+        return nullptr;
+    }
+    return arena_.Make<ConditionsNode>(pos, tmp, let_chain_node);
 }
 
-std::shared_ptr<LetChainNode> Parser::ParseLetChain() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<LetChainConditionNode>> let_chain_condition_nodes;
-    try {
-        let_chain_condition_nodes.emplace_back(ParseLetChainCondition());
-        while (tokens[parseIndex].type == TokenType::AndAnd) {
-            ConsumeString("&&");
-            let_chain_condition_nodes.emplace_back(ParseLetChainCondition());
+LetChainNode *Parser::ParseLetChain() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<LetChainConditionNode *> let_chain_condition_nodes;
+    auto let_chain_condition_node = ParseLetChainCondition();
+    if (let_chain_condition_node == nullptr) {
+        return nullptr;
+    }
+    let_chain_condition_nodes.emplace_back(let_chain_condition_node);
+    while (tokens.type(parseIndex) == TokenType::AndAnd) {
+        parseIndex++;
+        let_chain_condition_node = ParseLetChainCondition();
+        if (let_chain_condition_node == nullptr) {
+            return nullptr;
         }
-        return std::make_shared<LetChainNode>(pos, std::move(let_chain_condition_nodes));
-    } catch (const ParseError &) {
-        throw;
+        let_chain_condition_nodes.emplace_back(let_chain_condition_node);
     }
+    return arena_.Make<LetChainNode>(pos, std::move(let_chain_condition_nodes));
 }
 
-std::shared_ptr<LetChainConditionNode> Parser::ParseLetChainCondition() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNode> pattern_node = nullptr;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    try {
-        if (tokens[parseIndex].type == TokenType::Let) {
-            ConsumeString("let");
-            pattern_node = ParsePattern();
-            ConsumeString("=");
-            expression_node = ParseExpression();
-            return std::make_shared<LetChainConditionNode>(pos, pattern_node, expression_node);
+LetChainConditionNode *Parser::ParseLetChainCondition() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNode *pattern_node = nullptr;
+    ExpressionNode *expression_node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::Let) {
+        parseIndex++;
+        pattern_node = ParsePattern();
+        if (pattern_node == nullptr || !ConsumeString("=")) {
+            return nullptr;
         }
         expression_node = ParseExpression();
-        return std::make_shared<LetChainConditionNode>(pos, pattern_node, expression_node);
-    } catch (const ParseError &) {
-        throw;
+        if (expression_node == nullptr) {
+            return nullptr;
+        }
+        return arena_.Make<LetChainConditionNode>(pos, pattern_node, expression_node);
+    }
+    expression_node = ParseExpression();
+    if (expression_node == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<LetChainConditionNode>(pos, pattern_node, expression_node);
 }
 
 /****************  Statement  ****************/
-std::shared_ptr<StatementNode> Parser::ParseStatement() {
-    Position pos = tokens[parseIndex].pos;
+StatementNode *Parser::ParseStatement() {
+    Position pos = tokens.pos(parseIndex);
     uint32_t start = parseIndex;
-    try {
-        if (tokens[parseIndex].type == TokenType::Semicolon) {
-            ConsumeString(";");
-            return std::make_shared<EmptyStatementNode>(pos);
-        }
-        if (tokens[parseIndex].type == TokenType::Let) {
-            return ParseLetStatement();
-        }
-        return ParseExpressionStatement();
-    } catch (const ParseError &) {
-        parseIndex = start;
+    if (tokens.type(parseIndex) == TokenType::Semicolon) {
+        parseIndex++;
+        return arena_.Make<EmptyStatementNode>(pos);
+    }
+    StatementNode *statement_node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::Let) {
+        statement_node = ParseLetStatement();
+    } else {
+        statement_node = ParseExpressionStatement();
+    }
+    if (statement_node != nullptr) {
+        return statement_node;
     }
+    parseIndex = start;
 
-    try {
-        return std::make_shared<VisItemStatementNode>(pos, ParseVisItem());
-    } catch (const ParseError &) {
-        throw;
+    auto vis_item_node = ParseVisItem();
+    if (vis_item_node == nullptr) {
+        return nullptr;
     }
+    item_statements_++;
+    return arena_.Make<VisItemStatementNode>(pos, vis_item_node);
 }
 
-std::shared_ptr<LetStatementNode> Parser::ParseLetStatement() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_node = nullptr;
-    std::shared_ptr<TypeNode> type_node = nullptr;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    std::shared_ptr<BlockExpressionNode> block_expression_node = nullptr;
-    try {
-        ConsumeString("let");
-        pattern_no_top_alt_node = ParsePatternNoTopAlt();
-        if (tokens[parseIndex].type == TokenType::Colon) {
-            ConsumeString(":");
-            type_node = ParseType();
-        }
-        if (tokens[parseIndex].type == TokenType::Eq) {
-            ConsumeString("=");
-            expression_node = ParseExpression();
-            if (tokens[parseIndex].type == TokenType::Else) {
-                ConsumeString("else");
-                block_expression_node = ParseBlockExpression();
-                // TODO Check Whether the expression node is lazyBooleanExpression Or end with a '}'
+LetStatementNode *Parser::ParseLetStatement() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNoTopAltNode *pattern_no_top_alt_node = nullptr;
+    TypeNode *type_node = nullptr;
+    ExpressionNode *expression_node = nullptr;
+    BlockExpressionNode *block_expression_node = nullptr;
+    if (!ConsumeString("let")) {
+        return nullptr;
+    }
+    pattern_no_top_alt_node = ParsePatternNoTopAlt();
+    if (pattern_no_top_alt_node == nullptr) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) == TokenType::Colon) {
+        parseIndex++;
+        type_node = ParseType();
+        if (type_node == nullptr) {
+            return nullptr;
+        }
+    }
+    if (tokens.type(parseIndex) == TokenType::Eq) {
+        parseIndex++;
+        expression_node = ParseExpression();
+        if (expression_node == nullptr) {
+            return nullptr;
+        }
+        if (tokens.type(parseIndex) == TokenType::Else) {
+            parseIndex++;
+            block_expression_node = ParseBlockExpression();
+            if (block_expression_node == nullptr) {
+                return nullptr;
             }
+            // TODO Check Whether the expression node is lazyBooleanExpression Or end with a '}'
         }
-        ConsumeString(";");
-        return std::make_shared<LetStatementNode>(pos, pattern_no_top_alt_node, type_node,
-                                    expression_node, block_expression_node);
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString(";")) {
+        return nullptr;
+    }
+    return arena_.Make<LetStatementNode>(pos, pattern_no_top_alt_node, type_node,
+                                expression_node, block_expression_node);
 }
 
-std::shared_ptr<ExpressionStatementNode> Parser::ParseExpressionStatement() {
-    Position pos = tokens[parseIndex].pos;
+ExpressionStatementNode *Parser::ParseExpressionStatement() {
+    Position pos = tokens.pos(parseIndex);
     uint32_t start = parseIndex;
-    std::shared_ptr<ExpressionNode> expression_node = nullptr;
-    try {
-        expression_node = ParseExpressionWithoutBlock();
-        ConsumeString(";");
-        return std::make_shared<ExpressionStatementNode>(pos, expression_node);
-    } catch (const ParseError &) {
-        parseIndex = start;
+    ExpressionNode *expression_node = nullptr;
+    expression_node = ParseExpressionWithoutBlock();
+    if (expression_node != nullptr && ConsumeString(";")) {
+        return arena_.Make<ExpressionStatementNode>(pos, expression_node);
     }
+    parseIndex = start;
 
-    try {
-        bool has_semicolon = false;
-        expression_node = ParseExpressionWithBlock();
-        if (tokens[parseIndex].type == TokenType::Semicolon) {
-            ConsumeString(";");
-            has_semicolon = true;
-        }
-        return std::make_shared<ExpressionStatementNode>(pos, expression_node, has_semicolon);
-    } catch (const ParseError &) {
-        throw ParseError("Parse Error: Failed to match ExpressionStatement", pos);
+    bool has_semicolon = false;
+    expression_node = ParseExpressionWithBlock();
+    if (expression_node == nullptr) {
+        return Fail("Parse Error: Failed to match ExpressionStatement", pos);
     }
+    if (tokens.type(parseIndex) == TokenType::Semicolon) {
+        parseIndex++;
+        has_semicolon = true;
+    }
+    return arena_.Make<ExpressionStatementNode>(pos, expression_node, has_semicolon);
 }
 
 
 /****************  Pattern  ****************/
-std::shared_ptr<PatternNode> Parser::ParsePattern() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<PatternNoTopAltNode>> pattern_no_top_alt_nodes;
-    try {
-        if (tokens[parseIndex].type == TokenType::Or) {
-            ConsumeString("|");
-        }
-        pattern_no_top_alt_nodes.emplace_back(ParsePatternNoTopAlt());
-        while (tokens[parseIndex].type == TokenType::Or) {
-            ConsumeString("|");
-            pattern_no_top_alt_nodes.emplace_back(ParsePatternNoTopAlt());
+PatternNode *Parser::ParsePattern() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<PatternNoTopAltNode *> pattern_no_top_alt_nodes;
+    if (tokens.type(parseIndex) == TokenType::Or) {
+        parseIndex++;
+    }
+    auto pattern_no_top_alt_node = ParsePatternNoTopAlt();
+    if (pattern_no_top_alt_node == nullptr) {
+        return nullptr;
+    }
+    pattern_no_top_alt_nodes.emplace_back(pattern_no_top_alt_node);
+    while (tokens.type(parseIndex) == TokenType::Or) {
+        parseIndex++;
+        pattern_no_top_alt_node = ParsePatternNoTopAlt();
+        if (pattern_no_top_alt_node == nullptr) {
+            return nullptr;
         }
-        return std::make_shared<PatternNode>(pos, std::move(pattern_no_top_alt_nodes));
-    } catch (const ParseError &) {
-        throw;
+        pattern_no_top_alt_nodes.emplace_back(pattern_no_top_alt_node);
     }
+    return arena_.Make<PatternNode>(pos, std::move(pattern_no_top_alt_nodes));
 }
 
-std::shared_ptr<PatternNoTopAltNode> Parser::ParsePatternNoTopAlt() {
-    try {
-        return ParsePatternWithoutRange();
-    } catch (const ParseError &) {
-        throw;
-    }
+PatternNoTopAltNode *Parser::ParsePatternNoTopAlt() {
+    return ParsePatternWithoutRange();
 }
 
-std::shared_ptr<PatternWithoutRangeNode> Parser::ParsePatternWithoutRange() {
-    Position pos = tokens[parseIndex].pos;
+PatternWithoutRangeNode *Parser::ParsePatternWithoutRange() {
+    Position pos = tokens.pos(parseIndex);
     uint32_t start = parseIndex;
 
-    try { return ParseLiteralPattern(); } catch (const ParseError &) { parseIndex = start; }
-    // try { return ParsePathPattern(); } catch (const ParseError &) { parseIndex = start; }
-    try { return ParseIdentifierPattern(); } catch (const ParseError &) { parseIndex = start; }
+    if (auto node = ParseLiteralPattern()) { return node; }
+    parseIndex = start;
+    // if (auto node = ParsePathPattern()) { return node; }
+    // parseIndex = start;
+    if (auto node = ParseIdentifierPattern()) { return node; }
+    parseIndex = start;
 
-    try {
-        ConsumeString("_");
-        return std::make_shared<WildcardPatternNode>(pos);
-    } catch (const ParseError &) {
-        parseIndex = start;
+    if (ConsumeString("_")) {
+        return arena_.Make<WildcardPatternNode>(pos);
     }
+    parseIndex = start;
 
-    try {
-        ConsumeString("..");
-        return std::make_shared<RestPatternNode>(pos);
-    } catch (const ParseError &) {
-        parseIndex = start;
+    if (ConsumeString("..")) {
+        return arena_.Make<RestPatternNode>(pos);
     }
+    parseIndex = start;
 
-    try {
-        ConsumeString("(");
+    if (ConsumeString("(")) {
         auto pattern_node = ParsePattern();
-        ConsumeString(")");
-        return std::make_shared<GroupedPatternNode>(pos, pattern_node);
-    } catch (const ParseError &) {
-        parseIndex = start;
+        if (pattern_node != nullptr && ConsumeString(")")) {
+            return arena_.Make<GroupedPatternNode>(pos, pattern_node);
+        }
     }
+    parseIndex = start;
 
-    try {
-        return ParseSlicePattern();
-    } catch (const ParseError &) {
-        parseIndex = start;
-        throw ParseError("Parse Error: Failed to Parse PatternWithoutRange", pos);
+    if (auto node = ParseSlicePattern()) {
+        return node;
     }
+    parseIndex = start;
+    return Fail("Parse Error: Failed to Parse PatternWithoutRange", pos);
 }
 
-std::shared_ptr<LiteralPatternNode> Parser::ParseLiteralPattern() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        bool have_minus = false;
-        if (tokens[parseIndex].type == TokenType::Minus) {
-            have_minus = true;
-            ConsumeString("-");
+LiteralPatternNode *Parser::ParseLiteralPattern() {
+    Position pos = tokens.pos(parseIndex);
+    bool have_minus = false;
+    if (tokens.type(parseIndex) == TokenType::Minus) {
+        have_minus = true;
+        if (!ConsumeString("-")) {
+            return nullptr;
         }
-        auto expression_node = ParseLiteral();
-        return std::make_shared<LiteralPatternNode>(pos, have_minus, expression_node);
-    } catch (const ParseError &) {
-        throw;
     }
+    auto expression_node = ParseLiteral();
+    if (expression_node == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<LiteralPatternNode>(pos, have_minus, expression_node);
 }
 
-std::shared_ptr<IdentifierPatternNode> Parser::ParseIdentifierPattern() {
-    Position pos = tokens[parseIndex].pos;
-    std::shared_ptr<PatternNoTopAltNode> pattern_no_top_alt_node = nullptr;
-    try {
-        bool is_ref = false;
-        bool is_mut = false;
-        if (tokens[parseIndex].type == TokenType::Ref) {
-            ConsumeString("ref");
-            is_ref = true;
-        }
-        if (tokens[parseIndex].type == TokenType::Mut) {
-            ConsumeString("mut");
-            is_mut = true;
+IdentifierPatternNode *Parser::ParseIdentifierPattern() {
+    Position pos = tokens.pos(parseIndex);
+    PatternNoTopAltNode *pattern_no_top_alt_node = nullptr;
+    bool is_ref = false;
+    bool is_mut = false;
+    if (tokens.type(parseIndex) == TokenType::Ref) {
+        parseIndex++;
+        is_ref = true;
+    }
+    if (tokens.type(parseIndex) == TokenType::Mut) {
+        parseIndex++;
+        is_mut = true;
+    }
+    if (tokens.type(parseIndex) != TokenType::Identifier) {
+        return Fail("Parse Error: Identifier is missing", pos);
+    }
+    std::string identifier(TokenText(parseIndex));
+    parseIndex++;
+    if (tokens.type(parseIndex) == TokenType::At) {
+        parseIndex++;
+        pattern_no_top_alt_node = ParsePatternNoTopAlt();
+        if (pattern_no_top_alt_node == nullptr) {
+            return nullptr;
         }
-        if (tokens[parseIndex].type != TokenType::Identifier) {
-            throw ParseError("Parse Error: Identifier is missing", pos);
+    }
+    return arena_.Make<IdentifierPatternNode>(pos, is_ref, is_mut, identifier, pattern_no_top_alt_node);
+}
+
+SlicePatternNode *Parser::ParseSlicePattern() {
+    Position pos = tokens.pos(parseIndex);
+    std::vector<PatternNode *> pattern_nodes;
+    if (!ConsumeString("[")) {
+        return nullptr;
+    }
+    if (tokens.type(parseIndex) != TokenType::RBracket) {
+        auto pattern_node = ParsePattern();
+        if (pattern_node == nullptr) {
+            return nullptr;
         }
-        std::string identifier = tokens[parseIndex].token;
-        parseIndex++;
-        if (tokens[parseIndex].type == TokenType::At) {
-            ConsumeString("@");
-            pattern_no_top_alt_node = ParsePatternNoTopAlt();
-        }
-        return std::make_shared<IdentifierPatternNode>(pos, is_ref, is_mut, identifier, pattern_no_top_alt_node);
-    } catch (const ParseError &) {
-        throw;
-    }
-}
-
-std::shared_ptr<SlicePatternNode> Parser::ParseSlicePattern() {
-    Position pos = tokens[parseIndex].pos;
-    std::vector<std::shared_ptr<PatternNode>> pattern_nodes;
-    try {
-        ConsumeString("[");
-        if (tokens[parseIndex].type != TokenType::RBracket) {
-            pattern_nodes.emplace_back(ParsePattern());
-            while (tokens[parseIndex].type == TokenType::Comma) {
-                ConsumeString(",");
-                if (tokens[parseIndex].type == TokenType::RBracket) {
-                    break;
-                }
-                pattern_nodes.emplace_back(ParsePattern());
+        pattern_nodes.emplace_back(pattern_node);
+        while (tokens.type(parseIndex) == TokenType::Comma) {
+            parseIndex++;
+            if (tokens.type(parseIndex) == TokenType::RBracket) {
+                break;
             }
+            pattern_node = ParsePattern();
+            if (pattern_node == nullptr) {
+                return nullptr;
+            }
+            pattern_nodes.emplace_back(pattern_node);
         }
-        ConsumeString("]");
-        return std::make_shared<SlicePatternNode>(pos, std::move(pattern_nodes));
-    } catch (const ParseError &) {
-        throw;
     }
+    if (!ConsumeString("]")) {
+        return nullptr;
+    }
+    return arena_.Make<SlicePatternNode>(pos, std::move(pattern_nodes));
 }
 
-std::shared_ptr<PathPatternNode> Parser::ParsePathPattern() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto expression_node = ParsePathExpression();
-        return std::make_shared<PathPatternNode>(pos, expression_node);
-    } catch (const ParseError &) {
-        throw;
+PathPatternNode *Parser::ParsePathPattern() {
+    Position pos = tokens.pos(parseIndex);
+    auto expression_node = ParsePathExpression();
+    if (expression_node == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<PathPatternNode>(pos, expression_node);
 }
 
 /****************  Types  ****************/
-std::shared_ptr<TypeNode> Parser::ParseType() {
-    try {
-        return ParseTypeNoBounds();
-    } catch (const ParseError &) {
-        throw;
+TypeNode *Parser::ParseType() {
+    return ParseTypeNoBounds();
+}
+
+TypeNoBoundsNode *Parser::ParseTypeNoBounds() {
+    Position pos = tokens.pos(parseIndex);
+    TypeNoBoundsNode *node = nullptr;
+    if (tokens.type(parseIndex) == TokenType::Identifier || tokens.type(parseIndex) == TokenType::SELF) {
+        node = ParseTypePath();
+    } else if (tokens.type(parseIndex) == TokenType::LParen) {
+        node = ParseUnitType();
+    } else if (tokens.type(parseIndex) == TokenType::LBracket) {
+        node = ParseArrayType();
+    } else {
+        node = ParseReferenceType();
     }
-}
-
-std::shared_ptr<TypeNoBoundsNode> Parser::ParseTypeNoBounds() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        if (tokens[parseIndex].type == TokenType::Identifier || tokens[parseIndex].type == TokenType::SELF) {
-            return ParseTypePath();
-        }
-        if (tokens[parseIndex].type == TokenType::LParen) {
-            return ParseUnitType();
-        }
-        if (tokens[parseIndex].type == TokenType::LBracket) {
-            return ParseArrayType();
-        }
-        return ParseReferenceType();
-    } catch (std::exception&) {
-        throw ParseError("Parse Error: Failed to Parse TypeNoBounds", pos);
+    if (node == nullptr) {
+        return Fail("Parse Error: Failed to Parse TypeNoBounds", pos);
     }
+    return node;
 }
 
-std::shared_ptr<ParenthesizedTypeNode> Parser::ParseParenthesizedType() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("(");
-        auto tmp = ParseType();
-        ConsumeString(")");
-        return std::make_shared<ParenthesizedTypeNode>(pos, tmp);
-    } catch (const ParseError &) {
-        throw;
+ParenthesizedTypeNode *Parser::ParseParenthesizedType() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("(")) {
+        return nullptr;
+    }
+    auto tmp = ParseType();
+    if (tmp == nullptr || !ConsumeString(")")) {
+        return nullptr;
     }
+    return arena_.Make<ParenthesizedTypeNode>(pos, tmp);
 }
 
-std::shared_ptr<TypePathNode> Parser::ParseTypePath() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        if (tokens[parseIndex].type == TokenType::ColonColon) {
-            ConsumeString("::");
-        }
-        auto tmp = ParseTypePathSegment();
-        return std::make_shared<TypePathNode>(pos, tmp);
-    } catch (const ParseError &) {
-        throw;
+TypePathNode *Parser::ParseTypePath() {
+    Position pos = tokens.pos(parseIndex);
+    if (tokens.type(parseIndex) == TokenType::ColonColon) {
+        parseIndex++;
+    }
+    auto tmp = ParseTypePathSegment();
+    if (tmp == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<TypePathNode>(pos, tmp);
 }
 
-std::shared_ptr<TypePathSegmentNode> Parser::ParseTypePathSegment() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        auto tmp = ParsePathIndentSegment();
-        return std::make_shared<TypePathSegmentNode>(pos, tmp);
-    } catch (const ParseError &) {
-        throw;
+TypePathSegmentNode *Parser::ParseTypePathSegment() {
+    Position pos = tokens.pos(parseIndex);
+    auto tmp = ParsePathIndentSegment();
+    if (tmp == nullptr) {
+        return nullptr;
     }
+    return arena_.Make<TypePathSegmentNode>(pos, tmp);
 }
 
-std::shared_ptr<UnitTypeNode> Parser::ParseUnitType() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("(");
-        ConsumeString(")");
-        return std::make_shared<UnitTypeNode>(pos);
-    } catch (const ParseError &) {
-        throw;
+UnitTypeNode *Parser::ParseUnitType() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("(")) {
+        return nullptr;
     }
+    if (!ConsumeString(")")) {
+        return nullptr;
+    }
+    return arena_.Make<UnitTypeNode>(pos);
 }
 
-std::shared_ptr<ArrayTypeNode> Parser::ParseArrayType() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("[");
-        auto type_node = ParseType();
-        ConsumeString(";");
-        auto expression_node = ParseExpression();
-        ConsumeString("]");
-        return std::make_shared<ArrayTypeNode>(pos, type_node, expression_node);
-    } catch (const ParseError &) {
-        throw;
+ArrayTypeNode *Parser::ParseArrayType() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("[")) {
+        return nullptr;
+    }
+    auto type_node = ParseType();
+    if (type_node == nullptr || !ConsumeString(";")) {
+        return nullptr;
     }
+    auto expression_node = ParseExpression();
+    if (expression_node == nullptr || !ConsumeString("]")) {
+        return nullptr;
+    }
+    return arena_.Make<ArrayTypeNode>(pos, type_node, expression_node);
 }
 
-std::shared_ptr<SliceTypeNode> Parser::ParseSliceType() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        ConsumeString("[");
-        auto type_node = ParseType();
-        ConsumeString("]");
-        return std::make_shared<SliceTypeNode>(pos, type_node);
-    } catch (const ParseError &) {
-        throw;
+SliceTypeNode *Parser::ParseSliceType() {
+    Position pos = tokens.pos(parseIndex);
+    if (!ConsumeString("[")) {
+        return nullptr;
+    }
+    auto type_node = ParseType();
+    if (type_node == nullptr || !ConsumeString("]")) {
+        return nullptr;
     }
+    return arena_.Make<SliceTypeNode>(pos, type_node);
 }
 
-std::shared_ptr<ReferenceTypeNode> Parser::ParseReferenceType() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        bool is_mut = false;
-        ConsumeString("&");
-        if (tokens[parseIndex].type == TokenType::Mut) {
-            ConsumeString("mut");
-            is_mut = true;
-        }
-        auto type = ParseType();
-        return std::make_shared<ReferenceTypeNode>(pos, is_mut, type);
-    } catch (std::exception&) {
-        throw;
+ReferenceTypeNode *Parser::ParseReferenceType() {
+    Position pos = tokens.pos(parseIndex);
+    bool is_mut = false;
+    if (!ConsumeString("&")) {
+        return nullptr;
     }
+    if (tokens.type(parseIndex) == TokenType::Mut) {
+        parseIndex++;
+        is_mut = true;
+    }
+    auto type = ParseType();
+    if (type == nullptr) {
+        return nullptr;
+    }
+    return arena_.Make<ReferenceTypeNode>(pos, is_mut, type);
 }
 
 
 /****************  Paths  ****************/
-std::shared_ptr<PathIndentSegmentNode> Parser::ParsePathIndentSegment() {
-    Position pos = tokens[parseIndex].pos;
-    try {
-        if (tokens[parseIndex].type == TokenType::Super || tokens[parseIndex].type == TokenType::Self ||
-            tokens[parseIndex].type == TokenType::SELF || tokens[parseIndex].type == TokenType::Crate ||
-            tokens[parseIndex].type == TokenType::Identifier) {
-            auto node = std::make_shared<PathIndentSegmentNode>(pos, tokens[parseIndex].type, tokens[parseIndex].token);
-            parseIndex++;
-            return node;
+PathIndentSegmentNode *Parser::ParsePathIndentSegment() {
+    Position pos = tokens.pos(parseIndex);
+    if (tokens.type(parseIndex) == TokenType::Super || tokens.type(parseIndex) == TokenType::Self ||
+        tokens.type(parseIndex) == TokenType::SELF || tokens.type(parseIndex) == TokenType::Crate ||
+        tokens.type(parseIndex) == TokenType::Identifier) {
+        Atom atom = tokens.atom(parseIndex);
+        if (atom == StringInterner::InvalidAtom && deferred_atoms_ == nullptr) {
+            atom = GlobalInterner().Intern(TokenText(parseIndex));
+        }
+        auto node = arena_.Make<PathIndentSegmentNode>(pos, tokens.type(parseIndex),
+                                                            std::string(TokenText(parseIndex)), atom);
+        if (atom == StringInterner::InvalidAtom) {
+            deferred_atoms_->push_back(node);
         }
-        throw ParseError("Parse Error: Invalid SimplePathSegment", pos);
-    } catch (const ParseError &) {
-        throw;
+        parseIndex++;
+        return node;
     }
-}
\ No newline at end of file
+    return Fail("Parse Error: Invalid SimplePathSegment", pos);
+}
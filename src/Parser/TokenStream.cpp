@@ -0,0 +1,85 @@
+#include "Parser/TokenStream.h"
+
+namespace {
+    constexpr uint32_t InitialCapacity = 256;
+}
+
+TokenStream::TokenStream(TokenArray &&tokens)
+    : types_(std::move(tokens.types_)), spans_(std::move(tokens.spans_)), atoms_(std::move(tokens.atoms_)) {
+    end_ = static_cast<uint32_t>(types_.size());
+    peak_window_ = end_;
+    if (!spans_.empty()) {
+        sentinel_.pos = spans_.back().pos;
+    }
+    uint32_t capacity = InitialCapacity;
+    while (capacity < end_) {
+        capacity *= 2;
+    }
+    types_.resize(capacity);
+    spans_.resize(capacity);
+    atoms_.resize(capacity);
+    mask_ = capacity - 1;
+}
+
+TokenStream::TokenStream(const Lexer &lexer, const std::string_view source)
+    : lexer_(&lexer), source_(source), types_(InitialCapacity), spans_(InitialCapacity),
+      atoms_(InitialCapacity), mask_(InitialCapacity - 1) {
+}
+
+// Doubles the ring, unrolling the live window [base_, end_) into its new slots.
+void TokenStream::Grow() {
+    std::vector<TokenType> grown_types(types_.size() * 2);
+    std::vector<TokenSpan> grown_spans(spans_.size() * 2);
+    std::vector<Atom> grown_atoms(atoms_.size() * 2);
+    const uint32_t grown_mask = static_cast<uint32_t>(grown_types.size()) - 1;
+    for (uint32_t index = base_; index != end_; index++) {
+        grown_types[index & grown_mask] = types_[index & mask_];
+        grown_spans[index & grown_mask] = spans_[index & mask_];
+        grown_atoms[index & grown_mask] = atoms_[index & mask_];
+    }
+    types_ = std::move(grown_types);
+    spans_ = std::move(grown_spans);
+    atoms_ = std::move(grown_atoms);
+    mask_ = grown_mask;
+}
+
+bool TokenStream::Fill(const uint32_t index) {
+    if (lexer_ == nullptr) {
+        return false;
+    }
+    Token token;
+    while (end_ <= index) {
+        if (!lexer_->NextParserToken(source_, lex_offset_, lines_, token)) {
+            lexer_ = nullptr;
+            return false;
+        }
+        if (end_ - base_ == types_.size()) {
+            Grow();
+        }
+        types_[end_ & mask_] = token.type;
+        spans_[end_ & mask_] = TokenSpan{token.pos, token.length};
+        atoms_[end_ & mask_] = token.atom;
+        sentinel_.pos = token.pos;
+        end_++;
+        if (end_ - base_ > peak_window_) {
+            peak_window_ = end_ - base_;
+        }
+    }
+    return true;
+}
+
+void TokenStream::Drain() {
+    if (lexer_ == nullptr) {
+        return;
+    }
+    Token token;
+    while (lexer_->NextParserToken(source_, lex_offset_, lines_, token)) {
+    }
+    lexer_ = nullptr;
+}
+
+void TokenStream::Release(const uint32_t index) {
+    if (index > base_) {
+        base_ = index < end_ ? index : end_;
+    }
+}
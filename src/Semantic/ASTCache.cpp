@@ -0,0 +1,1451 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Semantic/ASTCache.h"
+#include "SourceBuffer.h"
+#include "StringInterner.h"
+
+// An entry is a fixed Header followed by the payload, whose sections are, in
+// order: the interner's spellings in atom order, the string table, the kind of
+// every cached Type, the crate, the scope tree and finally the Type bodies.
+// Integers are LEB128 varints (zigzag for signed ones); strings are indices
+// into the string table. An AST node is written where it is first reached
+// (tag 1, kind, fields); later references to it are tag 2 + its index, and
+// null is tag 0. Types and scopes are referenced by index + 1, 0 being null.
+// The Type kinds come before the crate so the reader can create every Type
+// up front and resolve references, cyclic ones included, by index.
+
+namespace {
+    constexpr char Magic[4] = {'R', 'X', 'A', 'C'};
+
+    struct Header {
+        char magic[4];
+        uint32_t format_version;
+        uint32_t semantics_version;
+        uint32_t reserved;
+        uint64_t compiler_stamp;
+        uint64_t source_size;
+        uint64_t source_hash;
+        uint64_t payload_size;
+        uint64_t payload_hash;
+    };
+
+    static_assert(sizeof(Header) == 56 && std::is_trivially_copyable_v<Header>);
+
+    // Thrown on a damaged entry or an unexpected node; Load and Store turn it
+    // into a miss or a skipped write.
+    struct FormatError {
+    };
+
+    uint64_t Mix(uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    // Size and modification time of the running executable.
+    uint64_t CompilerStamp() {
+        struct stat info{};
+        if (::stat("/proc/self/exe", &info) != 0) {
+            return 0;
+        }
+        return Mix(static_cast<uint64_t>(info.st_size)) ^ Mix(static_cast<uint64_t>(info.st_mtim.tv_sec) << 30 ^
+                                                              static_cast<uint64_t>(info.st_mtim.tv_nsec));
+    }
+
+    // Index of every object the writer has reached, by address. Open
+    // addressing with linear probing; a crate has millions of nodes, and
+    // std::unordered_map would allocate for each of them.
+    class ObjectIds {
+        std::vector<std::pair<const void *, uint32_t> > slots_{64};
+        size_t size_ = 0;
+
+        void Grow() {
+            std::vector<std::pair<const void *, uint32_t> > slots(slots_.size() * 2);
+            slots.swap(slots_);
+            for (const auto &slot: slots) {
+                if (slot.first != nullptr) {
+                    Slot(slot.first) = slot;
+                }
+            }
+        }
+
+        std::pair<const void *, uint32_t> &Slot(const void *object) {
+            const size_t mask = slots_.size() - 1;
+            size_t index = Mix(reinterpret_cast<uintptr_t>(object)) & mask;
+            while (slots_[index].first != nullptr && slots_[index].first != object) {
+                index = (index + 1) & mask;
+            }
+            return slots_[index];
+        }
+
+    public:
+        // The index of `object`, and whether it was assigned just now.
+        std::pair<uint32_t, bool> Insert(const void *object) {
+            if (2 * (size_ + 1) > slots_.size()) {
+                Grow();
+            }
+            auto &slot = Slot(object);
+            if (slot.first != nullptr) {
+                return {slot.second, false};
+            }
+            slot = {object, static_cast<uint32_t>(size_++)};
+            return {slot.second, true};
+        }
+    };
+
+    template<typename Archive>
+    void TransferNode(Archive &ar, ASTNode *node);
+
+    template<typename Archive>
+    void Transfer(Archive &ar, Method &method) {
+        ar(method.name_, method.type_, method.function_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructMember &member) {
+        ar(member.name_, member.type_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, Symbol &symbol) {
+        ar(symbol.name_, symbol.atom_, symbol.type_, symbol.symbol_type_, symbol.is_mutable_, symbol.is_const_,
+           symbol.is_assigned_, symbol.pos_, symbol.scope_index_);
+    }
+
+    class CacheWriter {
+        std::string *out_ = nullptr;
+        std::deque<std::string> string_storage_; // keys of string_ids_ for strings not owned by the crate
+        std::unordered_map<std::string_view, uint32_t> string_ids_;
+        ObjectIds node_ids_;
+        ObjectIds type_ids_;
+
+    public:
+        std::string strings;
+        std::string type_kinds;
+        std::vector<Type *> types; // by index; bodies are written after the scopes
+
+        // Sends the following fields to `section`.
+        void Into(std::string &section) {
+            out_ = &section;
+        }
+
+        [[nodiscard]] size_t string_count() const {
+            return string_ids_.size();
+        }
+
+        void Varint(uint64_t value) {
+            while (value >= 0x80) {
+                out_->push_back(static_cast<char>(value | 0x80));
+                value >>= 7;
+            }
+            out_->push_back(static_cast<char>(value));
+        }
+
+        void Signed(const int64_t value) {
+            Varint(static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void Bytes(const std::string_view bytes) {
+            Varint(bytes.size());
+            out_->append(bytes);
+        }
+
+        template<typename... Fields>
+        void operator()(Fields &... fields) {
+            (Field(fields), ...);
+        }
+
+        void Field(bool &value) {
+            out_->push_back(value ? 1 : 0);
+        }
+
+        void Field(char &value) {
+            out_->push_back(value);
+        }
+
+        template<typename T>
+        std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> > Field(T &value) {
+            if constexpr (std::is_enum_v<T>) {
+                Varint(static_cast<uint64_t>(value));
+            } else if constexpr (std::is_signed_v<T>) {
+                Signed(value);
+            } else {
+                Varint(value);
+            }
+        }
+
+        void Field(std::string &value) {
+            auto it = string_ids_.find(value);
+            if (it == string_ids_.end()) {
+                it = string_ids_.emplace(string_storage_.emplace_back(value), string_ids_.size()).first;
+                std::string *section = out_;
+                out_ = &strings;
+                Bytes(value);
+                out_ = section;
+            }
+            Varint(it->second);
+        }
+
+        void Field(Position &pos) {
+            Varint(pos.GetRow());
+            Varint(pos.GetColumn());
+            Varint(pos.GetOffset());
+        }
+
+        void Field(ConstValue &value) {
+            Varint(value.index());
+            if (auto *integer = std::get_if<int64_t>(&value)) {
+                Signed(*integer);
+            } else {
+                Field(std::get<std::string>(value));
+            }
+        }
+
+        void Field(std::shared_ptr<Type> &type) {
+            if (type == nullptr) {
+                Varint(0);
+                return;
+            }
+            const auto [id, inserted] = type_ids_.Insert(type.get());
+            if (inserted) {
+                types.push_back(type.get());
+                type_kinds.push_back(static_cast<char>(type->getKind()));
+            }
+            Varint(id + 1);
+        }
+
+        template<typename T>
+        void Field(T *&node) {
+            if (node == nullptr) {
+                Varint(0);
+                return;
+            }
+            const auto [id, inserted] = node_ids_.Insert(node);
+            if (!inserted) {
+                Varint(id + 2);
+                return;
+            }
+            Varint(1);
+            Varint(static_cast<uint64_t>(node->kind()));
+            TransferNode(*this, node);
+        }
+
+        template<typename T>
+        void Field(std::vector<T> &values) {
+            Varint(values.size());
+            for (auto &value: values) {
+                Field(value);
+            }
+        }
+
+        // Extends `links` down the left operands of the same class and writes
+        // how many were added; each counts as written, like a node Field wrote.
+        template<typename Node>
+        void LeftChain(std::vector<Node *> &links) {
+            while (auto *next = dyn_cast<Node>(links.back()->lhs_)) {
+                if (!node_ids_.Insert(next).second) {
+                    break;
+                }
+                links.push_back(next);
+            }
+            Varint(links.size() - 1);
+        }
+
+        // Written in key order, so equal states give equal entries.
+        template<typename V>
+        void Field(std::unordered_map<std::string, V> &map) {
+            std::vector<std::pair<std::string, V> > entries(map.begin(), map.end());
+            std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+            Varint(entries.size());
+            for (auto &[key, value]: entries) {
+                Field(key);
+                Field(value);
+            }
+        }
+
+        void Field(Method &method) {
+            Transfer(*this, method);
+        }
+
+        void Field(StructMember &member) {
+            Transfer(*this, member);
+        }
+
+        void Field(Symbol &symbol) {
+            Transfer(*this, symbol);
+        }
+    };
+
+    class CacheReader {
+        const char *cursor_;
+        const char *end_;
+        Arena &arena_;
+        std::vector<std::string_view> strings_;
+        std::vector<ASTNode *> nodes_;
+
+        ASTNode *NewNode(ASTKind kind);
+
+    public:
+        std::vector<std::shared_ptr<Type> > types;
+
+        CacheReader(const std::string_view payload, Arena &arena)
+            : cursor_(payload.data()), end_(payload.data() + payload.size()), arena_(arena) {
+        }
+
+        [[nodiscard]] bool AtEnd() const {
+            return cursor_ == end_;
+        }
+
+        uint8_t Byte() {
+            if (cursor_ == end_) {
+                throw FormatError{};
+            }
+            return static_cast<uint8_t>(*cursor_++);
+        }
+
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (uint32_t shift = 0; shift < 64; shift += 7) {
+                const uint8_t byte = Byte();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw FormatError{};
+        }
+
+        int64_t Signed() {
+            const uint64_t value = Varint();
+            return static_cast<int64_t>(value >> 1 ^ (~(value & 1) + 1));
+        }
+
+        // A count of elements that take at least one byte each, so a damaged
+        // count cannot make the reader allocate more than the entry holds.
+        size_t Count() {
+            const uint64_t count = Varint();
+            if (count > static_cast<uint64_t>(end_ - cursor_)) {
+                throw FormatError{};
+            }
+            return count;
+        }
+
+        std::string_view Bytes() {
+            const size_t size = Count();
+            const std::string_view bytes(cursor_, size);
+            cursor_ += size;
+            return bytes;
+        }
+
+        void ReadStrings() {
+            strings_.resize(Count());
+            for (auto &string: strings_) {
+                string = Bytes();
+            }
+        }
+
+        void ReadTypeKinds();
+
+        template<typename... Fields>
+        void operator()(Fields &... fields) {
+            (Field(fields), ...);
+        }
+
+        void Field(bool &value) {
+            value = Byte() != 0;
+        }
+
+        void Field(char &value) {
+            value = static_cast<char>(Byte());
+        }
+
+        template<typename T>
+        std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> > Field(T &value) {
+            if constexpr (std::is_enum_v<T>) {
+                value = static_cast<T>(Varint());
+            } else if constexpr (std::is_signed_v<T>) {
+                value = static_cast<T>(Signed());
+            } else {
+                value = static_cast<T>(Varint());
+            }
+        }
+
+        void Field(std::string &value) {
+            const uint64_t id = Varint();
+            if (id >= strings_.size()) {
+                throw FormatError{};
+            }
+            value.assign(strings_[id]);
+        }
+
+        void Field(Position &pos) {
+            const auto row = static_cast<uint32_t>(Varint());
+            const auto column = static_cast<uint32_t>(Varint());
+            const auto offset = static_cast<uint32_t>(Varint());
+            pos = Position(row, column, offset);
+        }
+
+        void Field(ConstValue &value) {
+            if (Varint() == 0) {
+                value = Signed();
+            } else {
+                std::string string;
+                Field(string);
+                value = std::move(string);
+            }
+        }
+
+        void Field(std::shared_ptr<Type> &type) {
+            const uint64_t id = Varint();
+            if (id > types.size()) {
+                throw FormatError{};
+            }
+            type = id == 0 ? nullptr : types[id - 1];
+        }
+
+        template<typename T>
+        void Field(T *&node) {
+            const uint64_t tag = Varint();
+            ASTNode *read = nullptr;
+            if (tag == 1) {
+                read = NewNode(static_cast<ASTKind>(Varint()));
+                nodes_.push_back(read);
+                TransferNode(*this, read);
+            } else if (tag >= 2) {
+                if (tag - 2 >= nodes_.size()) {
+                    throw FormatError{};
+                }
+                read = nodes_[tag - 2];
+            }
+            if (read != nullptr && !isa<T>(read)) {
+                throw FormatError{};
+            }
+            node = static_cast<T *>(read);
+        }
+
+        template<typename T>
+        void Field(std::vector<T> &values) {
+            values.clear();
+            values.resize(Count());
+            for (auto &value: values) {
+                Field(value);
+            }
+        }
+
+        template<typename Node>
+        void LeftChain(std::vector<Node *> &links) {
+            const size_t count = Count();
+            for (size_t i = 0; i < count; i++) {
+                auto *next = static_cast<Node *>(NewNode(links.front()->kind()));
+                nodes_.push_back(next);
+                links.back()->lhs_ = next;
+                links.push_back(next);
+            }
+        }
+
+        template<typename V>
+        void Field(std::unordered_map<std::string, V> &map) {
+            map.clear();
+            const size_t count = Count();
+            map.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                std::string key;
+                V value{};
+                Field(key);
+                Field(value);
+                map.emplace(std::move(key), std::move(value));
+            }
+        }
+
+        void Field(Method &method) {
+            Transfer(*this, method);
+        }
+
+        void Field(StructMember &member) {
+            Transfer(*this, member);
+        }
+
+        void Field(Symbol &symbol) {
+            Transfer(*this, symbol);
+        }
+    };
+
+    void CacheReader::ReadTypeKinds() {
+        types.resize(Count());
+        for (auto &type: types) {
+            switch (static_cast<TypeKind>(Byte())) {
+                case TypeKind::Primitive:
+                    type = std::make_shared<PrimitiveType>(std::string());
+                    break;
+                case TypeKind::Function:
+                    type = std::make_shared<FunctionType>(std::vector<std::shared_ptr<Type> >(), nullptr);
+                    break;
+                case TypeKind::Struct:
+                    type = std::make_shared<StructType>(std::string(), std::vector<StructMember>());
+                    break;
+                case TypeKind::Enumeration:
+                    type = std::make_shared<EnumerationType>(std::string(), std::vector<std::string>());
+                    break;
+                case TypeKind::Slice:
+                    type = std::make_shared<SliceType>(nullptr);
+                    break;
+                case TypeKind::Array:
+                    type = std::make_shared<ArrayType>(nullptr, 0);
+                    break;
+                case TypeKind::Unit:
+                    type = std::make_shared<UnitType>();
+                    break;
+                case TypeKind::Reference:
+                    type = std::make_shared<ReferenceType>(nullptr);
+                    break;
+                default:
+                    throw FormatError{};
+            }
+        }
+    }
+
+    template<typename Archive>
+    void TransferType(Archive &ar, Type &type) {
+        ar(type.name_set, type.value_map, type.methods_, type.inline_functions_, type.constants_);
+        switch (type.getKind()) {
+            case TypeKind::Primitive:
+                ar(static_cast<PrimitiveType &>(type).name_);
+                break;
+            case TypeKind::Function: {
+                auto &function = static_cast<FunctionType &>(type);
+                ar(function.have_self_, function.is_mut_, function.have_and_, function.params_, function.ret_);
+                break;
+            }
+            case TypeKind::Struct: {
+                auto &structure = static_cast<StructType &>(type);
+                ar(structure.name_, structure.members_);
+                break;
+            }
+            case TypeKind::Enumeration: {
+                auto &enumeration = static_cast<EnumerationType &>(type);
+                ar(enumeration.name_, enumeration.variants_);
+                break;
+            }
+            case TypeKind::Slice:
+                ar(static_cast<SliceType &>(type).type_);
+                break;
+            case TypeKind::Array: {
+                auto &array = static_cast<ArrayType &>(type);
+                ar(array.base_, array.length_);
+                break;
+            }
+            case TypeKind::Unit:
+                break;
+            case TypeKind::Reference: {
+                auto &reference = static_cast<ReferenceType &>(type);
+                ar(reference.type_, reference.is_mut_);
+                break;
+            }
+            default:
+                throw FormatError{};
+        }
+    }
+
+    /****************  AST fields  ****************/
+    // Everything the parser and the semantic passes store on a node; the IR
+    // builder's own annotations are left out.
+
+    template<typename Archive>
+    void TransferBase(Archive &ar, ASTNode &node) {
+        ar(node.pos_);
+    }
+
+    template<typename Archive>
+    void TransferBase(Archive &ar, ExpressionNode &node) {
+        ar(node.pos_, node.types, node.is_assignable_, node.is_mutable_, node.is_compiler_known_, node.value);
+    }
+
+    template<typename Archive>
+    void TransferBase(Archive &ar, TypeNode &node) {
+        ar(node.pos_, node.type);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, PathIndentSegmentNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_, node.identifier_, node.atom_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, CrateNode &node) {
+        TransferBase(ar, node);
+        ar(node.scope_index, node.items_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, FunctionNode &node) {
+        TransferBase(ar, node);
+        ar(node.is_const_, node.identifier_, node.function_parameters_, node.type_, node.block_expression_,
+           node.has_nested_items_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.struct_field_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, EnumerationNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.enum_variant_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ConstantItemNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.is_underscore_, node.type_node_, node.expression_node_, node.has_nested_items_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, AssociatedItemNode &node) {
+        TransferBase(ar, node);
+        ar(node.constant_item_node_, node.function_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TraitNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.associated_item_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, InherentImplNode &node) {
+        TransferBase(ar, node);
+        ar(node.scope_index, node.type_node_, node.associated_item_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TraitImplNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.type_node_, node.associated_item_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, FunctionParametersNode &node) {
+        TransferBase(ar, node);
+        ar(node.self_param_node_, node.function_params_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ShortHandSelfNode &node) {
+        TransferBase(ar, node);
+        ar(node.have_and_, node.is_mut_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TypedSelfNode &node) {
+        TransferBase(ar, node);
+        ar(node.is_mut_, node.type_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, FunctionParamNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_no_top_alt_node_, node.type_, node.is_DotDotDot_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, FunctionParamPatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_no_top_alt_, node.type_, node.is_DotDotDot_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructFieldNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.type_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, EnumVariantNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.enum_variant_struct_node_, node.enum_variant_discriminant_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, EnumVariantStructNode &node) {
+        TransferBase(ar, node);
+        ar(node.struct_field_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, EnumVariantDiscriminantNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, BlockExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.scope_index, node.is_const_, node.is_function_direct_block, node.statements_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, InfiniteLoopExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.block_expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, PredicateLoopExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.conditions_, node.block_expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, IfExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.conditions_, node.true_block_expression_, node.false_block_expression_, node.if_expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, MatchExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_, node.match_arms_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TupleExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.expressions_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, JumpExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_, node.expression_);
+    }
+
+    // A left-associative chain of one operator class is written as its length
+    // and then innermost link first, so `a + b + c + ...` does not recurse.
+    template<typename Archive, typename Node, typename Link>
+    void TransferLeftChain(Archive &ar, Node &node, Link link) {
+        std::vector<Node *> links{&node}; // outermost first
+        ar.LeftChain(links);
+        ar(links.back()->lhs_);
+        for (auto it = links.rbegin(); it != links.rend(); ++it) {
+            link(**it);
+        }
+    }
+
+    // The binary operators that carry their operator token.
+    template<typename Archive, typename Node>
+    void TransferOperator(Archive &ar, Node &node) {
+        TransferLeftChain(ar, node, [&ar](Node &link) {
+            TransferBase(ar, link);
+            ar(link.type_, link.rhs_);
+        });
+    }
+
+    // The binary operators whose class already names the operator.
+    template<typename Archive, typename Node>
+    void TransferOperands(Archive &ar, Node &node) {
+        TransferLeftChain(ar, node, [&ar](Node &link) {
+            TransferBase(ar, link);
+            ar(link.rhs_);
+        });
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TypeCastExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_, node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, UnaryExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_, node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, FunctionCallExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.callee_, node.params_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ArrayIndexExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.base_, node.index_, node.auto_deref_count);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, MemberAccessExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.base_, node.member_, node.auto_deref_count);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, GroupedExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.path_in_expression_node_, node.struct_expr_fields_node_, node.struct_base_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructExprFieldsNode &node) {
+        TransferBase(ar, node);
+        ar(node.struct_expr_field_nodes_, node.struct_base_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructExprFieldNode &node) {
+        TransferBase(ar, node);
+        ar(node.identifier_, node.expression_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StructBaseNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, PathInExpressionNode &node) {
+        TransferBase(ar, node);
+        ar(node.path_indent_segments_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, CharLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.char_literal_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StringLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.string_literal_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, IntLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.int_literal_, node.is_u32_, node.is_i32_, node.is_isize_, node.is_usize_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, BoolLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.bool_literal_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, CStringLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.c_string_literal_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ArrayLiteralNode &node) {
+        TransferBase(ar, node);
+        ar(node.expressions_, node.lhs_, node.rhs_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ConditionsNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_, node.let_chain_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, LetChainNode &node) {
+        TransferBase(ar, node);
+        ar(node.let_chain_condition_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, LetChainConditionNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_node_, node.expression_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, StatementsNode &node) {
+        TransferBase(ar, node);
+        ar(node.statements_, node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, MatchArmsNode &node) {
+        TransferBase(ar, node);
+        ar(node.match_arm_nodes_, node.expression_nodes_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, MatchArmNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_node_, node.match_arm_guard_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, LetStatementNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_no_top_alt_, node.type_, node.expression_, node.block_expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ExpressionStatementNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_, node.has_semicolon_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, VisItemStatementNode &node) {
+        TransferBase(ar, node);
+        ar(node.vis_item_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, PatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_no_top_alts_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, LiteralPatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.have_minus_, node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, IdentifierPatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.is_ref_, node.is_mut_, node.identifier_, node.node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, GroupedPatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.pattern_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, SlicePatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.patterns_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, PathPatternNode &node) {
+        TransferBase(ar, node);
+        ar(node.expression_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ParenthesizedTypeNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TypePathSegmentNode &node) {
+        TransferBase(ar, node);
+        ar(node.path_indent_segment_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, TypePathNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_path_segment_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ArrayTypeNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_, node.expression_node_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, SliceTypeNode &node) {
+        TransferBase(ar, node);
+        ar(node.type_);
+    }
+
+    template<typename Archive>
+    void Transfer(Archive &ar, ReferenceTypeNode &node) {
+        TransferBase(ar, node);
+        ar(node.is_mut_, node.type_node_);
+    }
+
+    template<typename Archive>
+    void TransferNode(Archive &ar, ASTNode *node) {
+        switch (node->kind()) {
+            case ASTKind::PathIndentSegment: return Transfer(ar, *cast<PathIndentSegmentNode>(node));
+            case ASTKind::Crate: return Transfer(ar, *cast<CrateNode>(node));
+            case ASTKind::Function: return Transfer(ar, *cast<FunctionNode>(node));
+            case ASTKind::Struct: return Transfer(ar, *cast<StructNode>(node));
+            case ASTKind::Enumeration: return Transfer(ar, *cast<EnumerationNode>(node));
+            case ASTKind::ConstantItem: return Transfer(ar, *cast<ConstantItemNode>(node));
+            case ASTKind::AssociatedItem: return Transfer(ar, *cast<AssociatedItemNode>(node));
+            case ASTKind::Trait: return Transfer(ar, *cast<TraitNode>(node));
+            case ASTKind::InherentImpl: return Transfer(ar, *cast<InherentImplNode>(node));
+            case ASTKind::TraitImpl: return Transfer(ar, *cast<TraitImplNode>(node));
+            case ASTKind::FunctionParameters: return Transfer(ar, *cast<FunctionParametersNode>(node));
+            case ASTKind::ShortHandSelf: return Transfer(ar, *cast<ShortHandSelfNode>(node));
+            case ASTKind::TypedSelf: return Transfer(ar, *cast<TypedSelfNode>(node));
+            case ASTKind::FunctionParam: return Transfer(ar, *cast<FunctionParamNode>(node));
+            case ASTKind::FunctionParamPattern: return Transfer(ar, *cast<FunctionParamPatternNode>(node));
+            case ASTKind::StructField: return Transfer(ar, *cast<StructFieldNode>(node));
+            case ASTKind::EnumVariant: return Transfer(ar, *cast<EnumVariantNode>(node));
+            case ASTKind::EnumVariantStruct: return Transfer(ar, *cast<EnumVariantStructNode>(node));
+            case ASTKind::EnumVariantDiscriminant: return Transfer(ar, *cast<EnumVariantDiscriminantNode>(node));
+            case ASTKind::BlockExpression: return Transfer(ar, *cast<BlockExpressionNode>(node));
+            case ASTKind::InfiniteLoopExpression: return Transfer(ar, *cast<InfiniteLoopExpressionNode>(node));
+            case ASTKind::PredicateLoopExpression: return Transfer(ar, *cast<PredicateLoopExpressionNode>(node));
+            case ASTKind::IfExpression: return Transfer(ar, *cast<IfExpressionNode>(node));
+            case ASTKind::MatchExpression: return Transfer(ar, *cast<MatchExpressionNode>(node));
+            case ASTKind::ContinueExpression: return TransferBase(ar, *cast<ContinueExpressionNode>(node));
+            case ASTKind::TupleExpression: return Transfer(ar, *cast<TupleExpressionNode>(node));
+            case ASTKind::UnderscoreExpression: return TransferBase(ar, *cast<UnderscoreExpressionNode>(node));
+            case ASTKind::JumpExpression: return Transfer(ar, *cast<JumpExpressionNode>(node));
+            case ASTKind::AssignmentExpression: return TransferOperator(ar, *cast<AssignmentExpressionNode>(node));
+            case ASTKind::LogicOrExpression: return TransferOperands(ar, *cast<LogicOrExpressionNode>(node));
+            case ASTKind::LogicAndExpression: return TransferOperands(ar, *cast<LogicAndExpressionNode>(node));
+            case ASTKind::ComparisonExpression: return TransferOperator(ar, *cast<ComparisonExpressionNode>(node));
+            case ASTKind::BitwiseOrExpression: return TransferOperands(ar, *cast<BitwiseOrExpressionNode>(node));
+            case ASTKind::BitwiseXorExpression: return TransferOperands(ar, *cast<BitwiseXorExpressionNode>(node));
+            case ASTKind::BitwiseAndExpression: return TransferOperands(ar, *cast<BitwiseAndExpressionNode>(node));
+            case ASTKind::ShiftExpression: return TransferOperator(ar, *cast<ShiftExpressionNode>(node));
+            case ASTKind::AddMinusExpression: return TransferOperator(ar, *cast<AddMinusExpressionNode>(node));
+            case ASTKind::MulDivModExpression: return TransferOperator(ar, *cast<MulDivModExpressionNode>(node));
+            case ASTKind::TypeCastExpression: return Transfer(ar, *cast<TypeCastExpressionNode>(node));
+            case ASTKind::UnaryExpression: return Transfer(ar, *cast<UnaryExpressionNode>(node));
+            case ASTKind::FunctionCallExpression: return Transfer(ar, *cast<FunctionCallExpressionNode>(node));
+            case ASTKind::ArrayIndexExpression: return Transfer(ar, *cast<ArrayIndexExpressionNode>(node));
+            case ASTKind::MemberAccessExpression: return Transfer(ar, *cast<MemberAccessExpressionNode>(node));
+            case ASTKind::GroupedExpression: return Transfer(ar, *cast<GroupedExpressionNode>(node));
+            case ASTKind::StructExpression: return Transfer(ar, *cast<StructExpressionNode>(node));
+            case ASTKind::PathInExpression: return Transfer(ar, *cast<PathInExpressionNode>(node));
+            case ASTKind::CharLiteral: return Transfer(ar, *cast<CharLiteralNode>(node));
+            case ASTKind::StringLiteral: return Transfer(ar, *cast<StringLiteralNode>(node));
+            case ASTKind::IntLiteral: return Transfer(ar, *cast<IntLiteralNode>(node));
+            case ASTKind::BoolLiteral: return Transfer(ar, *cast<BoolLiteralNode>(node));
+            case ASTKind::CStringLiteral: return Transfer(ar, *cast<CStringLiteralNode>(node));
+            case ASTKind::ArrayLiteral: return Transfer(ar, *cast<ArrayLiteralNode>(node));
+            case ASTKind::StructExprFields: return Transfer(ar, *cast<StructExprFieldsNode>(node));
+            case ASTKind::StructExprField: return Transfer(ar, *cast<StructExprFieldNode>(node));
+            case ASTKind::StructBase: return Transfer(ar, *cast<StructBaseNode>(node));
+            case ASTKind::Conditions: return Transfer(ar, *cast<ConditionsNode>(node));
+            case ASTKind::LetChain: return Transfer(ar, *cast<LetChainNode>(node));
+            case ASTKind::LetChainCondition: return Transfer(ar, *cast<LetChainConditionNode>(node));
+            case ASTKind::Statements: return Transfer(ar, *cast<StatementsNode>(node));
+            case ASTKind::MatchArms: return Transfer(ar, *cast<MatchArmsNode>(node));
+            case ASTKind::MatchArm: return Transfer(ar, *cast<MatchArmNode>(node));
+            case ASTKind::EmptyStatement: return TransferBase(ar, *node);
+            case ASTKind::LetStatement: return Transfer(ar, *cast<LetStatementNode>(node));
+            case ASTKind::ExpressionStatement: return Transfer(ar, *cast<ExpressionStatementNode>(node));
+            case ASTKind::VisItemStatement: return Transfer(ar, *cast<VisItemStatementNode>(node));
+            case ASTKind::Pattern: return Transfer(ar, *cast<PatternNode>(node));
+            case ASTKind::LiteralPattern: return Transfer(ar, *cast<LiteralPatternNode>(node));
+            case ASTKind::IdentifierPattern: return Transfer(ar, *cast<IdentifierPatternNode>(node));
+            case ASTKind::WildcardPattern: return TransferBase(ar, *node);
+            case ASTKind::RestPattern: return TransferBase(ar, *node);
+            case ASTKind::GroupedPattern: return Transfer(ar, *cast<GroupedPatternNode>(node));
+            case ASTKind::SlicePattern: return Transfer(ar, *cast<SlicePatternNode>(node));
+            case ASTKind::PathPattern: return Transfer(ar, *cast<PathPatternNode>(node));
+            case ASTKind::ParenthesizedType: return Transfer(ar, *cast<ParenthesizedTypeNode>(node));
+            case ASTKind::TypePath: return Transfer(ar, *cast<TypePathNode>(node));
+            case ASTKind::UnitType: return TransferBase(ar, *cast<UnitTypeNode>(node));
+            case ASTKind::ArrayType: return Transfer(ar, *cast<ArrayTypeNode>(node));
+            case ASTKind::SliceType: return Transfer(ar, *cast<SliceTypeNode>(node));
+            case ASTKind::ReferenceType: return Transfer(ar, *cast<ReferenceTypeNode>(node));
+            case ASTKind::TypePathSegment: return Transfer(ar, *cast<TypePathSegmentNode>(node));
+            default:
+                throw FormatError{}; // an abstract kind
+        }
+    }
+
+    // A node of `kind` with placeholder fields, which TransferNode then fills.
+    ASTNode *CacheReader::NewNode(const ASTKind kind) {
+        using Expressions = std::vector<ExpressionNode *>;
+        using Items = std::vector<AssociatedItemNode *>;
+        const Position pos;
+        switch (kind) {
+            case ASTKind::PathIndentSegment:
+                return arena_.Make<PathIndentSegmentNode>(pos, TokenType::Identifier, "", StringInterner::InvalidAtom);
+            case ASTKind::Crate: return arena_.Make<CrateNode>(pos, std::vector<VisItemNode *>());
+            case ASTKind::Function: return arena_.Make<FunctionNode>(pos, false, "", nullptr, nullptr, nullptr);
+            case ASTKind::Struct: return arena_.Make<StructNode>(pos, "", std::vector<StructFieldNode *>());
+            case ASTKind::Enumeration: return arena_.Make<EnumerationNode>(pos, "", std::vector<EnumVariantNode *>());
+            case ASTKind::ConstantItem: return arena_.Make<ConstantItemNode>(pos, "", false, nullptr, nullptr);
+            case ASTKind::AssociatedItem: return arena_.Make<AssociatedItemNode>(pos, nullptr, nullptr);
+            case ASTKind::Trait: return arena_.Make<TraitNode>(pos, "", Items());
+            case ASTKind::InherentImpl: return arena_.Make<InherentImplNode>(pos, nullptr, Items());
+            case ASTKind::TraitImpl: return arena_.Make<TraitImplNode>(pos, "", nullptr, Items());
+            case ASTKind::FunctionParameters:
+                return arena_.Make<FunctionParametersNode>(pos, nullptr, std::vector<FunctionParamNode *>());
+            case ASTKind::ShortHandSelf: return arena_.Make<ShortHandSelfNode>(pos, false, false);
+            case ASTKind::TypedSelf: return arena_.Make<TypedSelfNode>(pos, false, nullptr);
+            case ASTKind::FunctionParam: return arena_.Make<FunctionParamNode>(pos, nullptr, nullptr, false);
+            case ASTKind::FunctionParamPattern:
+                return arena_.Make<FunctionParamPatternNode>(pos, nullptr, nullptr, false);
+            case ASTKind::StructField: return arena_.Make<StructFieldNode>(pos, "", nullptr);
+            case ASTKind::EnumVariant: return arena_.Make<EnumVariantNode>(pos, "", nullptr, nullptr);
+            case ASTKind::EnumVariantStruct:
+                return arena_.Make<EnumVariantStructNode>(pos, std::vector<StructFieldNode *>());
+            case ASTKind::EnumVariantDiscriminant: return arena_.Make<EnumVariantDiscriminantNode>(pos, nullptr);
+            case ASTKind::BlockExpression: return arena_.Make<BlockExpressionNode>(pos, false, nullptr);
+            case ASTKind::InfiniteLoopExpression: return arena_.Make<InfiniteLoopExpressionNode>(pos, nullptr);
+            case ASTKind::PredicateLoopExpression:
+                return arena_.Make<PredicateLoopExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::IfExpression: return arena_.Make<IfExpressionNode>(pos, nullptr, nullptr, nullptr, nullptr);
+            case ASTKind::MatchExpression: return arena_.Make<MatchExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::ContinueExpression: return arena_.Make<ContinueExpressionNode>(pos);
+            case ASTKind::TupleExpression: return arena_.Make<TupleExpressionNode>(pos, Expressions());
+            case ASTKind::UnderscoreExpression: return arena_.Make<UnderscoreExpressionNode>(pos);
+            case ASTKind::JumpExpression: return arena_.Make<JumpExpressionNode>(pos, TokenType::Return, nullptr);
+            case ASTKind::AssignmentExpression:
+                return arena_.Make<AssignmentExpressionNode>(pos, TokenType::Eq, nullptr, nullptr);
+            case ASTKind::LogicOrExpression: return arena_.Make<LogicOrExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::LogicAndExpression: return arena_.Make<LogicAndExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::ComparisonExpression:
+                return arena_.Make<ComparisonExpressionNode>(pos, TokenType::EqEq, nullptr, nullptr);
+            case ASTKind::BitwiseOrExpression: return arena_.Make<BitwiseOrExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::BitwiseXorExpression: return arena_.Make<BitwiseXorExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::BitwiseAndExpression: return arena_.Make<BitwiseAndExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::ShiftExpression:
+                return arena_.Make<ShiftExpressionNode>(pos, TokenType::SL, nullptr, nullptr);
+            case ASTKind::AddMinusExpression:
+                return arena_.Make<AddMinusExpressionNode>(pos, TokenType::Plus, nullptr, nullptr);
+            case ASTKind::MulDivModExpression:
+                return arena_.Make<MulDivModExpressionNode>(pos, TokenType::Mul, nullptr, nullptr);
+            case ASTKind::TypeCastExpression: return arena_.Make<TypeCastExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::UnaryExpression:
+                return arena_.Make<UnaryExpressionNode>(pos, TokenType::Minus, nullptr, false);
+            case ASTKind::FunctionCallExpression:
+                return arena_.Make<FunctionCallExpressionNode>(pos, nullptr, Expressions());
+            case ASTKind::ArrayIndexExpression: return arena_.Make<ArrayIndexExpressionNode>(pos, nullptr, nullptr);
+            case ASTKind::MemberAccessExpression: return arena_.Make<MemberAccessExpressionNode>(pos, nullptr, "");
+            case ASTKind::GroupedExpression: return arena_.Make<GroupedExpressionNode>(pos, nullptr);
+            case ASTKind::StructExpression:
+                return arena_.Make<StructExpressionNode>(pos, nullptr, nullptr, nullptr);
+            case ASTKind::PathInExpression:
+                return arena_.Make<PathInExpressionNode>(pos, std::vector<PathIndentSegmentNode *>());
+            case ASTKind::CharLiteral: return arena_.Make<CharLiteralNode>(pos, '\0');
+            case ASTKind::StringLiteral: return arena_.Make<StringLiteralNode>(pos, "");
+            case ASTKind::IntLiteral: return arena_.Make<IntLiteralNode>(pos, 0, false, false, false, false);
+            case ASTKind::BoolLiteral: return arena_.Make<BoolLiteralNode>(pos, false);
+            case ASTKind::CStringLiteral: return arena_.Make<CStringLiteralNode>(pos, "");
+            case ASTKind::ArrayLiteral: return arena_.Make<ArrayLiteralNode>(pos, Expressions(), nullptr, nullptr);
+            case ASTKind::StructExprFields:
+                return arena_.Make<StructExprFieldsNode>(pos, std::vector<StructExprFieldNode *>(), nullptr);
+            case ASTKind::StructExprField: return arena_.Make<StructExprFieldNode>(pos, "", nullptr);
+            case ASTKind::StructBase: return arena_.Make<StructBaseNode>(pos, nullptr);
+            case ASTKind::Conditions: return arena_.Make<ConditionsNode>(pos, nullptr, nullptr);
+            case ASTKind::LetChain: return arena_.Make<LetChainNode>(pos, std::vector<LetChainConditionNode *>());
+            case ASTKind::LetChainCondition: return arena_.Make<LetChainConditionNode>(pos, nullptr, nullptr);
+            case ASTKind::Statements: return arena_.Make<StatementsNode>(pos, std::vector<StatementNode *>(), nullptr);
+            case ASTKind::MatchArms:
+                return arena_.Make<MatchArmsNode>(pos, std::vector<MatchArmNode *>(), Expressions());
+            case ASTKind::MatchArm: return arena_.Make<MatchArmNode>(pos, nullptr, nullptr);
+            case ASTKind::EmptyStatement: return arena_.Make<EmptyStatementNode>(pos);
+            case ASTKind::LetStatement: return arena_.Make<LetStatementNode>(pos, nullptr, nullptr, nullptr, nullptr);
+            case ASTKind::ExpressionStatement: return arena_.Make<ExpressionStatementNode>(pos, nullptr);
+            case ASTKind::VisItemStatement: return arena_.Make<VisItemStatementNode>(pos, nullptr);
+            case ASTKind::Pattern: return arena_.Make<PatternNode>(pos, std::vector<PatternNoTopAltNode *>());
+            case ASTKind::LiteralPattern: return arena_.Make<LiteralPatternNode>(pos, false, nullptr);
+            case ASTKind::IdentifierPattern:
+                return arena_.Make<IdentifierPatternNode>(pos, false, false, "", nullptr);
+            case ASTKind::WildcardPattern: return arena_.Make<WildcardPatternNode>(pos);
+            case ASTKind::RestPattern: return arena_.Make<RestPatternNode>(pos);
+            case ASTKind::GroupedPattern: return arena_.Make<GroupedPatternNode>(pos, nullptr);
+            case ASTKind::SlicePattern: return arena_.Make<SlicePatternNode>(pos, std::vector<PatternNode *>());
+            case ASTKind::PathPattern: return arena_.Make<PathPatternNode>(pos, nullptr);
+            case ASTKind::ParenthesizedType: return arena_.Make<ParenthesizedTypeNode>(pos, nullptr);
+            case ASTKind::TypePath: return arena_.Make<TypePathNode>(pos, nullptr);
+            case ASTKind::UnitType: return arena_.Make<UnitTypeNode>(pos);
+            case ASTKind::ArrayType: return arena_.Make<ArrayTypeNode>(pos, nullptr, nullptr);
+            case ASTKind::SliceType: return arena_.Make<SliceTypeNode>(pos, nullptr);
+            case ASTKind::ReferenceType: return arena_.Make<ReferenceTypeNode>(pos, false, nullptr);
+            case ASTKind::TypePathSegment: return arena_.Make<TypePathSegmentNode>(pos, nullptr);
+            default:
+                throw FormatError{};
+        }
+    }
+
+    template<typename Map>
+    auto SortedEntries(const Map &map) {
+        std::vector<std::pair<typename Map::key_type, typename Map::mapped_type> > entries(map.begin(), map.end());
+        std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        return entries;
+    }
+}
+
+ASTCache::ASTCache(std::string directory) : directory_(std::move(directory)) {
+}
+
+std::string ASTCache::EntryPath(const uint64_t source_hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.rxast", static_cast<unsigned long long>(source_hash));
+    return directory_ + name;
+}
+
+uint64_t ASTCache::HashBytes(const std::string_view bytes) {
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ bytes.size();
+    size_t i = 0;
+    for (; i + 8 <= bytes.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + i, 8);
+        hash = (hash ^ Mix(word)) * 0x9FB21C651E98DF25ull;
+    }
+    uint64_t tail = 0;
+    if (i < bytes.size()) { // data() may be null when empty, even for a zero-length copy
+        std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+    }
+    return Mix((hash ^ Mix(tail)) * 0x9FB21C651E98DF25ull);
+}
+
+bool ASTCache::Store(const std::string_view source, CrateNode *crate, const ScopeManager &scope_manager) const {
+    std::string spellings, ast, scopes, type_bodies;
+    CacheWriter writer;
+    try {
+        writer.Into(spellings);
+        const StringInterner &interner = GlobalInterner();
+        writer.Varint(interner.size());
+        for (Atom atom = 0; atom < interner.size(); atom++) {
+            writer.Bytes(interner.Spelling(atom));
+        }
+
+        writer.Into(ast);
+        writer(crate);
+
+        writer.Into(scopes);
+        std::unordered_map<const Scope *, uint32_t> scope_ids;
+        for (const auto &scope: scope_manager.scope_set_) {
+            scope_ids.emplace(scope.get(), scope_ids.size());
+        }
+        const auto scope_id = [&](const std::shared_ptr<Scope> &scope) {
+            if (scope == nullptr) {
+                return uint64_t{0};
+            }
+            const auto it = scope_ids.find(scope.get());
+            if (it == scope_ids.end()) {
+                throw FormatError{}; // not registered in scope_set_
+            }
+            return uint64_t{it->second} + 1;
+        };
+        writer.Varint(scope_manager.scope_set_.size());
+        for (const auto &scope: scope_manager.scope_set_) {
+            writer.Varint(scope_id(scope->parent_scope_));
+            writer.Varint(scope->next_level_scopes_.size());
+            for (const auto &child: scope->next_level_scopes_) {
+                writer.Varint(scope_id(child));
+            }
+            uint32_t scope_index = scope->scope_index;
+            writer(scope_index);
+            auto symbols = SortedEntries(scope->symbols());
+            writer.Varint(symbols.size());
+            for (auto &[atom, symbol]: symbols) {
+                writer(symbol);
+            }
+            auto values = SortedEntries(scope->value_map_);
+            writer.Varint(values.size());
+            for (auto &[atom, value]: values) {
+                writer(atom, value);
+            }
+            auto ir_symbols = SortedEntries(scope->ir_symbols_);
+            writer.Varint(ir_symbols.size());
+            for (auto &[atom, ir_scope]: ir_symbols) {
+                writer(atom, ir_scope);
+            }
+        }
+        writer.Varint(scope_id(scope_manager.root));
+        writer.Varint(scope_id(scope_manager.current_scope));
+        writer.Varint(scope_manager.scope_count);
+
+        writer.Into(type_bodies);
+        for (size_t i = 0; i < writer.types.size(); i++) { // bodies may reach further types
+            TransferType(writer, *writer.types[i]);
+        }
+    } catch (const FormatError &) {
+        return false;
+    }
+
+    std::string payload;
+    payload.reserve(spellings.size() + writer.strings.size() + writer.type_kinds.size() + ast.size() +
+                    scopes.size() + type_bodies.size() + 16);
+    payload += spellings;
+    writer.Into(payload);
+    writer.Varint(writer.string_count());
+    payload += writer.strings;
+    writer.Varint(writer.types.size());
+    payload += writer.type_kinds;
+    payload += ast;
+    payload += scopes;
+    payload += type_bodies;
+
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.format_version = FormatVersion;
+    header.semantics_version = SemanticsVersion;
+    header.compiler_stamp = CompilerStamp();
+    header.source_size = source.size();
+    header.source_hash = HashBytes(source);
+    header.payload_size = payload.size();
+    header.payload_hash = HashBytes(payload);
+
+    // Written under a temporary name and renamed, so a concurrent Load sees
+    // either the old entry or the complete new one.
+    ::mkdir(directory_.c_str(), 0777);
+    const std::string path = EntryPath(header.source_hash);
+    const std::string temporary = path + ".tmp" + std::to_string(::getpid());
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(payload.data(), payload.size(), 1, file) == 1;
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+CrateNode *ASTCache::Load(const std::string_view source, Arena &arena, ScopeManager &scope_manager) const {
+    const uint64_t source_hash = HashBytes(source);
+    std::optional<SourceBuffer> entry;
+    try {
+        entry.emplace(SourceBuffer::MapFile(EntryPath(source_hash)));
+    } catch (const InputError &) {
+        return nullptr;
+    }
+    const std::string_view bytes = entry->text();
+    Header header{};
+    if (bytes.size() < sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const std::string_view payload = bytes.substr(sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.format_version != FormatVersion ||
+        header.semantics_version != SemanticsVersion ||
+        header.compiler_stamp != CompilerStamp() || header.source_size != source.size() ||
+        header.source_hash != source_hash || header.payload_size != payload.size() ||
+        header.payload_hash != HashBytes(payload)) {
+        return nullptr;
+    }
+
+    Arena entry_arena;
+    CacheReader reader(payload, entry_arena);
+    StringInterner &interner = GlobalInterner();
+    CrateNode *crate = nullptr;
+    std::vector<std::shared_ptr<Scope> > scopes;
+    std::vector<std::string_view> spellings;
+    uint64_t root = 0, current = 0;
+    uint32_t scope_count = 0;
+    try {
+        // The cached atoms are only valid if this process has interned the
+        // same strings in the same order so far; the rest are interned below.
+        spellings.resize(reader.Count());
+        for (auto &spelling: spellings) {
+            spelling = reader.Bytes();
+        }
+        if (interner.size() > spellings.size()) {
+            return nullptr;
+        }
+        for (Atom atom = 0; atom < interner.size(); atom++) {
+            if (interner.Spelling(atom) != spellings[atom]) {
+                return nullptr;
+            }
+        }
+
+        reader.ReadStrings();
+        reader.ReadTypeKinds();
+        reader(crate);
+        if (crate == nullptr) {
+            return nullptr;
+        }
+
+        scopes.resize(reader.Count());
+        for (auto &scope: scopes) {
+            scope = std::make_shared<Scope>();
+        }
+        const auto scope_at = [&](const uint64_t id) {
+            if (id > scopes.size()) {
+                throw FormatError{};
+            }
+            return id == 0 ? nullptr : scopes[id - 1];
+        };
+        for (auto &scope: scopes) {
+            scope->parent_scope_ = scope_at(reader.Varint());
+            scope->next_level_scopes_.resize(reader.Count());
+            for (auto &child: scope->next_level_scopes_) {
+                child = scope_at(reader.Varint());
+            }
+            reader(scope->scope_index);
+            for (size_t i = reader.Count(); i > 0; i--) {
+                Symbol symbol;
+                reader(symbol);
+                scope->declare(symbol, false);
+            }
+            for (size_t i = reader.Count(); i > 0; i--) {
+                Atom atom;
+                ConstValue value;
+                reader(atom, value);
+                scope->value_map_.emplace(atom, std::move(value));
+            }
+            for (size_t i = reader.Count(); i > 0; i--) {
+                Atom atom;
+                uint32_t ir_scope;
+                reader(atom, ir_scope);
+                scope->ir_symbols_.emplace(atom, ir_scope);
+            }
+        }
+        root = reader.Varint();
+        current = reader.Varint();
+        reader(scope_count);
+        if (scope_at(root) == nullptr) {
+            return nullptr;
+        }
+        scope_at(current);
+
+        for (const auto &type: reader.types) {
+            TransferType(reader, *type);
+        }
+        if (!reader.AtEnd()) {
+            return nullptr;
+        }
+    } catch (const FormatError &) {
+        return nullptr;
+    }
+
+    for (size_t atom = interner.size(); atom < spellings.size(); atom++) {
+        interner.Intern(spellings[atom]);
+    }
+    // The type graph was written from interned types; it replaces the
+    // context's so that types built from here on are shared with it.
+    GlobalTypeContext().Clear();
+    for (const auto &type: reader.types) {
+        GlobalTypeContext().Adopt(type);
+    }
+    scope_manager.scope_set_ = std::move(scopes);
+    scope_manager.root = scope_manager.scope_set_[root - 1];
+    scope_manager.scope_count = scope_count;
+    scope_manager.ResetBindings(current == 0 ? nullptr : scope_manager.scope_set_[current - 1]);
+    arena.Adopt(entry_arena);
+    return crate;
+}
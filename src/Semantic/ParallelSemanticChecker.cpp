@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "Semantic/ParallelSemanticChecker.h"
+#include "Semantic/SemanticChecker.h"
+
+namespace {
+    // An error and where it counts as raised.
+    struct Failure {
+        std::exception_ptr error;
+        Position pos;
+    };
+
+    bool Before(const Position &lhs, const Position &rhs) {
+        if (lhs.GetRow() != rhs.GetRow()) {
+            return lhs.GetRow() < rhs.GetRow();
+        }
+        return lhs.GetColumn() < rhs.GetColumn();
+    }
+
+    // Captures the exception being handled.
+    Failure Capture(const Position &fallback) {
+        try {
+            throw;
+        } catch (const SemanticError &error) {
+            return {std::current_exception(), error.position().GetRow() != 0 ? error.position() : fallback};
+        } catch (...) {
+            return {std::current_exception(), fallback};
+        }
+    }
+
+    // The bodies still to be checked, as one deque of indices per worker.
+    // No body is added once the workers run, so a worker that finds every
+    // deque empty is done.
+    class WorkQueues {
+        struct Queue {
+            std::mutex mutex;
+            std::deque<size_t> bodies;
+        };
+
+        std::vector<Queue> queues_;
+
+    public:
+        // Deals out contiguous runs, so each worker starts on neighbouring bodies.
+        WorkQueues(const size_t workers, const size_t bodies) : queues_(workers) {
+            for (size_t i = 0; i < bodies; i++) {
+                queues_[i * workers / bodies].bodies.push_back(i);
+            }
+        }
+
+        bool Next(const size_t worker, size_t &body) {
+            for (size_t k = 0; k < queues_.size(); k++) {
+                Queue &queue = queues_[(worker + k) % queues_.size()];
+                std::lock_guard lock(queue.mutex);
+                if (queue.bodies.empty()) {
+                    continue;
+                }
+                if (k == 0) {
+                    body = queue.bodies.front();
+                    queue.bodies.pop_front();
+                } else {
+                    body = queue.bodies.back();
+                    queue.bodies.pop_back();
+                }
+                return true;
+            }
+            return false;
+        }
+    };
+}
+
+ParallelSemanticChecker::ParallelSemanticChecker(ScopeManager &scope_manager, const uint32_t threads)
+    : scope_manager_(scope_manager), threads_(threads == 0 ? 1 : threads) {
+}
+
+void ParallelSemanticChecker::Check(CrateNode *crate) const {
+    std::vector<SemanticChecker::FunctionBody> bodies;
+    std::optional<Failure> earliest;
+    SemanticChecker item_checker(scope_manager_);
+    item_checker.DeferBodies(&bodies);
+    scope_manager_.SetCurrentScope(scope_manager_.root);
+    for (const auto &item: crate->items_) {
+        if (!item) continue;
+        try {
+            item_checker.Visit(item);
+        } catch (...) {
+            earliest = Capture(item->pos_);
+            break;
+        }
+    }
+
+    std::vector<std::optional<Failure> > failures(bodies.size());
+    std::vector<std::optional<Position> > exits(bodies.size());
+    const auto worker_count = static_cast<uint32_t>(std::max<size_t>(1, std::min<size_t>(threads_, bodies.size())));
+    WorkQueues queues(worker_count, bodies.size());
+    const auto work = [&](const size_t worker) {
+        ScopeManager view(scope_manager_, ScopeManager::SharedTree{});
+        SemanticChecker checker(view);
+        for (size_t i; queues.Next(worker, i);) {
+            try {
+                checker.CheckBody(bodies[i]);
+            } catch (...) {
+                failures[i] = Capture(bodies[i].function->pos_);
+            }
+            exits[i] = checker.ExitPosition();
+        }
+    };
+    GlobalInterner().SetConcurrent(worker_count > 1);
+    GlobalTypeContext().SetConcurrent(worker_count > 1);
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < worker_count; i++) {
+        workers.emplace_back(work, i);
+    }
+    work(0);
+    for (auto &worker: workers) {
+        worker.join();
+    }
+    GlobalInterner().SetConcurrent(false);
+    GlobalTypeContext().SetConcurrent(false);
+    scope_manager_.NumberScopes();
+
+    // A crate may call `exit` once; a sequential check reports the second
+    // call it meets.
+    std::optional<Position> first_exit;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        if (!exits[i]) continue;
+        if (!first_exit) {
+            first_exit = exits[i];
+            continue;
+        }
+        const Position pos = *exits[i];
+        if (!failures[i] || Before(pos, failures[i]->pos)) {
+            failures[i] = Failure{
+                std::make_exception_ptr(SemanticError("Semantic Error: Duplicate exit function in code", pos)), pos
+            };
+        }
+        break;
+    }
+    for (const auto &failure: failures) {
+        if (failure && (!earliest || Before(failure->pos, earliest->pos))) {
+            earliest = failure;
+        }
+    }
+    if (earliest) {
+        std::rethrow_exception(earliest->error);
+    }
+}
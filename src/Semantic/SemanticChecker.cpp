@@ -1,54 +1,90 @@
 #include "Semantic/SemanticChecker.h"
 
 #include "Semantic/ASTNode.h"
+#include "Semantic/SymbolCollector.h"
 #include "Semantic/Type.h"
 #include "Semantic/Symbol.h"
 
-void SemanticChecker::visit(ASTNode *node) {
+namespace {
+    // Opens the scopes of code the checker never reaches, the statements
+    // after a `return` or `break`, so that every block still has one.
+    class ScopeOpener : public RecursiveASTVisitor {
+        ScopeManager &scope_manager_;
+
+        template<typename Node>
+        void Open(Node *node) {
+            if (node->scope_index == 0) {
+                scope_manager_.AddScope(node->scope_index, node->pos_);
+            } else {
+                scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->scope_index]);
+            }
+            RecursiveASTVisitor::visit(node);
+            scope_manager_.PopScope();
+        }
+
+    public:
+        using RecursiveASTVisitor::visit;
+        explicit ScopeOpener(ScopeManager &scope_manager) : scope_manager_(scope_manager) {}
+
+        void visit(BlockExpressionNode *node) { Open(node); }
+        void visit(InherentImplNode *node) { Open(node); }
+    };
 }
 
 void SemanticChecker::visit(CrateNode *node) {
-    scope_manager_.current_scope = scope_manager_.root;
-    scope_manager_.current_scope->index = 0;
+    scope_manager_.SetCurrentScope(scope_manager_.root);
     for (const auto &item: node->items_) {
-        if (item) item->accept(this);
+        if (item) Visit(item);
     }
+    scope_manager_.NumberScopes();
+}
+
+void SemanticChecker::DeferBodies(std::vector<FunctionBody> *bodies) {
+    deferred_ = bodies;
 }
 
-void SemanticChecker::visit(VisItemNode *node) {
+void SemanticChecker::CheckBody(const FunctionBody &body) {
+    has_exit = false;
+    scope_manager_.SetCurrentScope(body.scope);
+    visit(body.function);
 }
 
 void SemanticChecker::visit(FunctionNode *node) {
-    if (node->function_parameters_) node->function_parameters_->accept(this);
+    if (deferred_ && node->block_expression_) {
+        deferred_->push_back(FunctionBody{node, scope_manager_.current_scope});
+        return;
+    }
+    if (node->function_parameters_) Visit(node->function_parameters_);
     std::shared_ptr<Type> ret;
     if (node->type_) {
-        node->type_->accept(this);
+        Visit(node->type_);
         ret = node->type_->type;
     } else {
         ret = scope_manager_.lookup("void").type_;
     }
-    if (node->function_parameters_) {
-        scope_manager_.current_scope = scope_manager_.current_scope
-                ->next_level_scopes_[scope_manager_.current_scope->index];
+    // The parameters live in the scope of the body; without a body nothing
+    // can refer to them.
+    if (node->function_parameters_ && node->block_expression_) {
+        scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->block_expression_->scope_index]);
         for (const auto &it: node->function_parameters_->function_params_) {
-            it->accept(this);
-            auto pattern_node = std::dynamic_pointer_cast<IdentifierPatternNode>(it->pattern_no_top_alt_node_);
+            Visit(it);
+            auto pattern_node = dyn_cast<IdentifierPatternNode>(it->pattern_no_top_alt_node_);
             if (pattern_node) {
                 std::string identifier = pattern_node->identifier_;
                 bool is_mut = pattern_node->is_mut_;
                 std::shared_ptr<Type> type = it->type_->type;
 
-                auto ref_type = std::dynamic_pointer_cast<ReferenceTypeNode>(it->type_);
+                auto ref_type = dyn_cast<ReferenceTypeNode>(it->type_);
                 if (ref_type && ref_type->is_mut_) { is_mut = true; }
 
                 Symbol symbol(node->pos_, identifier, type, SymbolType::Variable, is_mut);
                 scope_manager_.declare(symbol);
                 continue;
             }
-            if (auto path_pattern = std::dynamic_pointer_cast<PathPatternNode>(it->pattern_no_top_alt_node_)) {
+            if (auto path_pattern = dyn_cast<PathPatternNode>(it->pattern_no_top_alt_node_)) {
                 bool is_mut;
                 std::string identifier;
-                if (auto expression = std::dynamic_pointer_cast<PathInExpressionNode>(path_pattern->expression_)) {
+                if (auto expression = dyn_cast<PathInExpressionNode>(path_pattern->expression_)) {
                     uint32_t len = expression->path_indent_segments_.size();
                     if (len == 0) {
                         throw SemanticError("Semantic Error: Path Pattern Error", node->pos_);
@@ -57,7 +93,7 @@ void SemanticChecker::visit(FunctionNode *node) {
                     is_mut = false;
                 }
                 std::shared_ptr<Type> type = it->type_->type;
-                auto ref_type = std::dynamic_pointer_cast<ReferenceTypeNode>(it->type_);
+                auto ref_type = dyn_cast<ReferenceTypeNode>(it->type_);
                 if (ref_type && ref_type->is_mut_) { is_mut = true; }
                 Symbol symbol(node->pos_, identifier, type, SymbolType::Variable, is_mut);
                 scope_manager_.declare(symbol);
@@ -66,7 +102,7 @@ void SemanticChecker::visit(FunctionNode *node) {
         scope_manager_.PopScope();
     }
     if (node->block_expression_) {
-        node->block_expression_->accept(this);
+        Visit(node->block_expression_);
         if (node->block_expression_) {
             if (function_return_type_.empty()) {
                 function_return_type_ = node->block_expression_->types;
@@ -94,18 +130,18 @@ void SemanticChecker::visit(FunctionNode *node) {
             bool valid = false;
             if (len > 0) {
                 auto last = statements->statements_[len - 1];
-                auto exprStmt = std::dynamic_pointer_cast<ExpressionStatementNode>(last);
+                auto exprStmt = dyn_cast<ExpressionStatementNode>(last);
                 if (exprStmt) {
                     auto expr = exprStmt->expression_;
-                    auto func_call = std::dynamic_pointer_cast<FunctionCallExpressionNode>(expr);
-                    auto id = std::dynamic_pointer_cast<PathInExpressionNode>(func_call->callee_);
+                    auto func_call = dyn_cast<FunctionCallExpressionNode>(expr);
+                    auto id = dyn_cast<PathInExpressionNode>(func_call->callee_);
                     if (id && id->path_indent_segments_[0]->identifier_ == "exit") {
                         valid = true;
                     }
                 } else if (statements->expression_) {
-                    auto func_call = std::dynamic_pointer_cast<FunctionCallExpressionNode>(statements->expression_);
+                    auto func_call = dyn_cast<FunctionCallExpressionNode>(statements->expression_);
                     if (func_call) {
-                        auto id = std::dynamic_pointer_cast<PathInExpressionNode>(func_call->callee_);
+                        auto id = dyn_cast<PathInExpressionNode>(func_call->callee_);
                         if (id && id->path_indent_segments_[0]->identifier_ == "exit") {
                             valid = true;
                         }
@@ -119,62 +155,29 @@ void SemanticChecker::visit(FunctionNode *node) {
     }
 }
 
-void SemanticChecker::visit(StructNode *node) {
-    for (const auto &field: node->struct_field_nodes_) {
-        if (field) field->accept(this);
-    }
-}
-
-void SemanticChecker::visit(EnumerationNode *node) {
-    for (const auto &variant: node->enum_variant_nodes_) {
-        if (variant) variant->accept(this);
-    }
-}
-
+// Declared by SymbolCollector, whatever its type.
 void SemanticChecker::visit(ConstantItemNode *node) {
-    std::string type_name;
-    if (node->type_node_) {
-        node->type_node_->accept(this);
-        type_name = node->type_node_->toString();
-    }
-    if (node->expression_node_) node->expression_node_->accept(this);
-    if (type_name != "i32" && type_name != "u32" &&
-        type_name != "isize" && type_name != "usize") {
-        Symbol symbol(node->pos_, node->identifier_, node->type_node_->type,
-                      SymbolType::Variable, false);
-        symbol.SetConst(true);
-        scope_manager_.declare(symbol);
-    }
+    if (node->type_node_) Visit(node->type_node_);
+    if (node->expression_node_) Visit(node->expression_node_);
 }
 
 void SemanticChecker::visit(TraitNode *node) {
 }
 
-void SemanticChecker::visit(ImplementationNode *node) {
-}
-
-void SemanticChecker::visit(AssociatedItemNode *node) {
-    if (node->constant_item_node_) node->constant_item_node_->accept(this);
-    if (node->function_node_) node->function_node_->accept(this);
-}
-
 void SemanticChecker::visit(InherentImplNode *node) {
-    scope_manager_.current_scope = scope_manager_.current_scope
-            ->next_level_scopes_[scope_manager_.current_scope->index++];
-    scope_manager_.current_scope->index = 0;
-    if (node->type_node_) node->type_node_->accept(this);
+    scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->scope_index]);
+    if (node->type_node_) Visit(node->type_node_);
     auto type = scope_manager_.lookup(node->type_node_->toString()).type_;
     for (const auto &item: node->associated_item_nodes_) {
         if (item) {
-            if (item->function_node_) {
+            if (item->function_node_ && item->function_node_->block_expression_) {
                 auto funcNode = item->function_node_;
-                scope_manager_.current_scope = scope_manager_.current_scope
-                        ->next_level_scopes_[scope_manager_.current_scope->index];
+                scope_manager_.SetCurrentScope(scope_manager_.scope_set_[funcNode->block_expression_->scope_index]);
                 if (funcNode->function_parameters_) {
                     auto params = funcNode->function_parameters_;
                     if (params->self_param_node_) {
                         auto self_param = params->self_param_node_;
-                        auto tmp = std::dynamic_pointer_cast<ShortHandSelfNode>(self_param);
+                        auto tmp = dyn_cast<ShortHandSelfNode>(self_param);
                         bool is_mut = false;
                         if (tmp && tmp->is_mut_) {
                             is_mut = true;
@@ -186,7 +189,7 @@ void SemanticChecker::visit(InherentImplNode *node) {
                 }
                 scope_manager_.PopScope();
             }
-            item->accept(this);
+            Visit(item);
         }
     }
     scope_manager_.PopScope();
@@ -197,54 +200,29 @@ void SemanticChecker::visit(TraitImplNode *node) {
 
 void SemanticChecker::visit(FunctionParametersNode *node) {
     for (const auto &param: node->function_params_) {
-        if (param) param->accept(this);
+        if (param) Visit(param);
     }
 }
 
 void SemanticChecker::visit(FunctionParamNode *node) {
-    // if (node->pattern_no_top_alt_node_) node->pattern_no_top_alt_node_->accept(this);
-    if (node->type_) node->type_->accept(this);
-}
-
-void SemanticChecker::visit(FunctionParamPatternNode *node) {
-    if (node->pattern_no_top_alt_) node->pattern_no_top_alt_->accept(this);
-    if (node->type_) node->type_->accept(this);
-}
-
-void SemanticChecker::visit(StructFieldNode *node) {
-    if (node->type_node_) node->type_node_->accept(this);
-}
-
-void SemanticChecker::visit(EnumVariantNode *node) {
-    if (node->enum_variant_struct_node_) node->enum_variant_struct_node_->accept(this);
-    if (node->enum_variant_discriminant_node_) node->enum_variant_discriminant_node_->accept(this);
+    // if (node->pattern_no_top_alt_node_) Visit(node->pattern_no_top_alt_node_);
+    if (node->type_) Visit(node->type_);
 }
 
-void SemanticChecker::visit(EnumVariantStructNode *node) {
-    for (const auto &field: node->struct_field_nodes_) {
-        if (field) field->accept(this);
-    }
-}
-
-void SemanticChecker::visit(EnumVariantDiscriminantNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
-}
-
-
-void SemanticChecker::visit(StatementNode *node) {
-}
 
 void SemanticChecker::visit(StatementsNode *node) {
-    for (const auto &stmt: node->statements_) {
-        if (stmt) stmt->accept(this);
+    for (size_t i = 0; i < node->statements_.size(); i++) {
+        if (node->statements_[i]) Visit(node->statements_[i]);
         if (interrupt) {
+            ScopeOpener opener(scope_manager_);
+            for (i++; i < node->statements_.size(); i++) {
+                if (node->statements_[i]) opener.Visit(node->statements_[i]);
+            }
+            if (node->expression_) opener.Visit(node->expression_);
             return;
         }
     }
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void SemanticChecker::visit(EmptyStatementNode *node) {
+    if (node->expression_) Visit(node->expression_);
 }
 
 void SemanticChecker::visit(LetStatementNode *node) {
@@ -253,15 +231,15 @@ void SemanticChecker::visit(LetStatementNode *node) {
     std::shared_ptr<Type> type;
     std::string identifier;
     if (node->pattern_no_top_alt_) {
-        // node->pattern_no_top_alt_->accept(this);
-        auto tmp = std::dynamic_pointer_cast<IdentifierPatternNode>(node->pattern_no_top_alt_);
+        // Visit(node->pattern_no_top_alt_);
+        auto tmp = dyn_cast<IdentifierPatternNode>(node->pattern_no_top_alt_);
         if (tmp) {
             identifier = tmp->identifier_;
             is_mut = tmp->is_mut_;
         }
-        auto path_pattern = std::dynamic_pointer_cast<PathPatternNode>(node->pattern_no_top_alt_);
+        auto path_pattern = dyn_cast<PathPatternNode>(node->pattern_no_top_alt_);
         if (path_pattern) {
-            auto expression = std::dynamic_pointer_cast<PathInExpressionNode>(path_pattern->expression_);
+            auto expression = dyn_cast<PathInExpressionNode>(path_pattern->expression_);
             if (expression) {
                 uint32_t len = expression->path_indent_segments_.size();
                 if (len == 0) {
@@ -273,13 +251,13 @@ void SemanticChecker::visit(LetStatementNode *node) {
         }
     }
     if (node->type_) {
-        node->type_->accept(this);
+        Visit(node->type_);
         type = node->type_->type;
-        auto ref_type = std::dynamic_pointer_cast<ReferenceTypeNode>(node->type_);
+        auto ref_type = dyn_cast<ReferenceTypeNode>(node->type_);
         if (ref_type && ref_type->is_mut_) { is_mut = true; }
     }
     if (node->expression_) {
-        node->expression_->accept(this);
+        Visit(node->expression_);
         if (type) {
             bool match = false;
             auto never_type = scope_manager_.lookup("never").type_;
@@ -297,7 +275,7 @@ void SemanticChecker::visit(LetStatementNode *node) {
         }
     }
     if (node->block_expression_) {
-        node->block_expression_->accept(this);
+        Visit(node->block_expression_);
         if (type) {
             bool match = false;
             auto never_type = scope_manager_.lookup("never").type_;
@@ -322,61 +300,43 @@ void SemanticChecker::visit(LetStatementNode *node) {
     scope_manager_.declare(symbol, false);
 }
 
-void SemanticChecker::visit(VisItemStatementNode *node) {
-    if (node->vis_item_node_) {
-        node->vis_item_node_->accept(this);
-    }
-}
-
-void SemanticChecker::visit(ExpressionStatementNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void SemanticChecker::visit(ExpressionNode *node) {
-}
-
-void SemanticChecker::visit(ExpressionWithoutBlockNode *node) {
-}
-
-void SemanticChecker::visit(ExpressionWithBlockNode *node) {
-}
-
-void SemanticChecker::visit(ComparisonExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize" ||
-                    tmp->name_ == "char" || tmp->name_ == "string" ||
-                    tmp->name_ == "cstring" || tmp->name_ == "bool") {
+void SemanticChecker::visit(ComparisonExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](ComparisonExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize" ||
+                        tmp->name_ == "char" || tmp->name_ == "string" ||
+                        tmp->name_ == "cstring" || tmp->name_ == "bool") {
+                        valid = true;
+                        break;
+                    }
+                }
+                auto enum_type = std::dynamic_pointer_cast<EnumerationType>(it);
+                if (enum_type && (node->type_ == TokenType::EqEq || node->type_ == TokenType::NEq)) {
                     valid = true;
                     break;
                 }
             }
-            auto enum_type = std::dynamic_pointer_cast<EnumerationType>(it);
-            if (enum_type && (node->type_ == TokenType::EqEq || node->type_ == TokenType::NEq)) {
-                valid = true;
-                break;
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid ComparisonExpressionNode", node->pos_);
             }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid ComparisonExpressionNode", node->pos_);
-        }
-    }
-    node->types.emplace_back(scope_manager_.lookup("bool").type_);
+        node->types.emplace_back(scope_manager_.lookup("bool").type_);
+    });
 }
 
 void SemanticChecker::visit(TypeCastExpressionNode *node) {
     if (node->type_) {
-        node->type_->accept(this);
+        Visit(node->type_);
         node->types.emplace_back(node->type_->type);
     }
-    if (node->expression_) node->expression_->accept(this);
+    if (node->expression_) Visit(node->expression_);
     node->is_compiler_known_ = node->expression_->is_compiler_known_;
     auto* val = std::get_if<int64_t>(&node -> expression_ -> value);
     if (val) {
@@ -386,11 +346,11 @@ void SemanticChecker::visit(TypeCastExpressionNode *node) {
 
 void SemanticChecker::visit(AssignmentExpressionNode *node) {
     if (node->lhs_) {
-        node->lhs_->accept(this);
+        Visit(node->lhs_);
         if (!node->lhs_->is_assignable_) {
             throw SemanticError("Semantic Error: Left Value Error", node->pos_);
         }
-        auto var = std::dynamic_pointer_cast<PathInExpressionNode>(node->lhs_);
+        auto var = dyn_cast<PathInExpressionNode>(node->lhs_);
         bool assigned = true;
         if (var && var->path_indent_segments_.size() == 1) {
             std::string id = var->path_indent_segments_[0]->identifier_;
@@ -400,7 +360,7 @@ void SemanticChecker::visit(AssignmentExpressionNode *node) {
             throw SemanticError("Semantic Error: Left Value is not mutable", node->pos_);
         }
     }
-    if (node->rhs_) node->rhs_->accept(this);
+    if (node->rhs_) Visit(node->rhs_);
     node->types.emplace_back(scope_manager_.lookup("void").type_);
 }
 
@@ -411,13 +371,10 @@ void SemanticChecker::visit(ContinueExpressionNode *node) {
     interrupt = true;
 }
 
-void SemanticChecker::visit(UnderscoreExpressionNode *node) {
-}
-
 void SemanticChecker::visit(JumpExpressionNode *node) {
     node->types.emplace_back(scope_manager_.lookup("never").type_);
     if (node->expression_) {
-        node->expression_->accept(this);
+        Visit(node->expression_);
         interrupt = true;
 
         if (node->type_ == TokenType::Break) {
@@ -476,228 +433,248 @@ void SemanticChecker::visit(JumpExpressionNode *node) {
     }
 }
 
-void SemanticChecker::visit(LogicOrExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "bool") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(LogicOrExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](LogicOrExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "bool") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
-        }
-    }
+    });
 }
 
-void SemanticChecker::visit(LogicAndExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "bool") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(LogicAndExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](LogicAndExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "bool") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
-        }
-    }
+    });
 }
 
-void SemanticChecker::visit(BitwiseOrExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize" ||
-                    tmp->name_ == "bool") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(BitwiseOrExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseOrExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize" ||
+                        tmp->name_ == "bool") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
-        }
-    }
+    });
 }
 
-void SemanticChecker::visit(BitwiseXorExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize" ||
-                    tmp->name_ == "bool") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(BitwiseXorExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseXorExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize" ||
+                        tmp->name_ == "bool") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
-        }
-    }
+    });
 }
 
-void SemanticChecker::visit(BitwiseAndExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize" ||
-                    tmp->name_ == "bool") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(BitwiseAndExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](BitwiseAndExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize" ||
+                        tmp->name_ == "bool") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid BitwiseAndExpressionNode", node->pos_);
-        }
-    }
+    });
 }
 
-void SemanticChecker::visit(ShiftExpressionNode *node) {
-    if (node->lhs_) {
-        node->lhs_->accept(this);
-        bool match = false;
-        for (const auto &it: node->lhs_->types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize") {
-                    match = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(ShiftExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](ShiftExpressionNode *node) {
+        if (node->lhs_) {
+            bool match = false;
+            for (const auto &it: node->lhs_->types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize") {
+                        match = true;
+                        node->types.emplace_back(it);
+                    }
                 }
             }
-        }
-        if (!match) {
-            throw SemanticError("Semantic Error: Invalid ShiftExpressionNode", node->pos_);
-        }
-    }
-    if (node->rhs_) {
-        node->rhs_->accept(this);
-        bool match = false;
-        for (const auto &it: node->rhs_->types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize") {
-                    match = true;
-                }
+            if (!match) {
+                throw SemanticError("Semantic Error: Invalid ShiftExpressionNode", node->pos_);
             }
         }
-        if (!match) {
-            throw SemanticError("Semantic Error: Invalid ShiftExpressionNode", node->pos_);
-        }
-    }
-}
-
-void SemanticChecker::visit(AddMinusExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize") {
-                    valid = true;
-                    node->types.emplace_back(it);
+        if (node->rhs_) {
+            Visit(node->rhs_);
+            bool match = false;
+            for (const auto &it: node->rhs_->types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize") {
+                        match = true;
+                    }
                 }
             }
+            if (!match) {
+                throw SemanticError("Semantic Error: Invalid ShiftExpressionNode", node->pos_);
+            }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid AddMinusExpressionNode", node->pos_);
-        }
-
-        if (node->lhs_->is_compiler_known_ && node->rhs_->is_compiler_known_) {
+        if (node->lhs_ && node->rhs_ && node->lhs_->is_compiler_known_ && node->rhs_->is_compiler_known_) {
             node->is_compiler_known_ = true;
             auto *l = std::get_if<int64_t>(&node->lhs_->value);
             auto *r = std::get_if<int64_t>(&node->rhs_->value);
             if (l && r) {
-                if (node->type_ == TokenType::Plus) {
-                    node->value = *l + *r;
+                if (node->type_ == TokenType::SL) {
+                    node->value = (*l) << (*r);
                 } else {
-                    node->value = *l - *r;
+                    node->value = (*l) >> (*r);
                 }
             }
         }
-    }
+    });
 }
 
-void SemanticChecker::visit(MulDivModExpressionNode *node) {
-    if (node->lhs_) node->lhs_->accept(this);
-    if (node->rhs_) node->rhs_->accept(this);
-    if (node->lhs_ && node->rhs_) {
-        auto cap_types = cap(node->lhs_->types, node->rhs_->types);
-        bool valid = false;
-        for (const auto &it: cap_types) {
-            auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
-            if (tmp) {
-                if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
-                    tmp->name_ == "isize" || tmp->name_ == "usize") {
-                    valid = true;
-                    node->types.emplace_back(it);
+void SemanticChecker::visit(AddMinusExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](AddMinusExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
+                }
+            }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid AddMinusExpressionNode", node->pos_);
+            }
+
+            if (node->lhs_->is_compiler_known_ && node->rhs_->is_compiler_known_) {
+                node->is_compiler_known_ = true;
+                auto *l = std::get_if<int64_t>(&node->lhs_->value);
+                auto *r = std::get_if<int64_t>(&node->rhs_->value);
+                if (l && r) {
+                    if (node->type_ == TokenType::Plus) {
+                        node->value = *l + *r;
+                    } else {
+                        node->value = *l - *r;
+                    }
                 }
             }
         }
-        if (!valid) {
-            throw SemanticError("Semantic Error: Invalid MulDivModExpressionNode", node->pos_);
-        }
+    });
+}
 
-        if (node->lhs_->is_compiler_known_ && node->rhs_->is_compiler_known_) {
-            node->is_compiler_known_ = true;
-            auto *l = std::get_if<int64_t>(&node->lhs_->value);
-            auto *r = std::get_if<int64_t>(&node->rhs_->value);
-            if (l && r) {
-                if (node->type_ == TokenType::Mul) {
-                    node->value = (*l) * (*r);
-                } else if (node->type_ == TokenType::Div) {
-                    node->value = (*l) / (*r);
-                } else {
-                    node->value = (*l) % (*r);
+void SemanticChecker::visit(MulDivModExpressionNode *chain) {
+    VisitLeftChain(chain, this, [this](MulDivModExpressionNode *node) {
+        if (node->rhs_) Visit(node->rhs_);
+        if (node->lhs_ && node->rhs_) {
+            auto cap_types = cap(node->lhs_->types, node->rhs_->types);
+            bool valid = false;
+            for (const auto &it: cap_types) {
+                auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
+                if (tmp) {
+                    if (tmp->name_ == "i32" || tmp->name_ == "u32" ||
+                        tmp->name_ == "isize" || tmp->name_ == "usize") {
+                        valid = true;
+                        node->types.emplace_back(it);
+                    }
+                }
+            }
+            if (!valid) {
+                throw SemanticError("Semantic Error: Invalid MulDivModExpressionNode", node->pos_);
+            }
+
+            if (node->lhs_->is_compiler_known_ && node->rhs_->is_compiler_known_) {
+                node->is_compiler_known_ = true;
+                auto *l = std::get_if<int64_t>(&node->lhs_->value);
+                auto *r = std::get_if<int64_t>(&node->rhs_->value);
+                if (l && r) {
+                    if (node->type_ == TokenType::Mul) {
+                        node->value = (*l) * (*r);
+                    } else if (node->type_ == TokenType::Div) {
+                        node->value = (*l) / (*r);
+                    } else {
+                        node->value = (*l) % (*r);
+                    }
                 }
             }
         }
-    }
+    });
 }
 
 void SemanticChecker::visit(UnaryExpressionNode *node) {
     if (node->expression_) {
-        node->expression_->accept(this);
+        Visit(node->expression_);
         if (node->type_ == TokenType::Minus) {
             bool match = false;
             for (const auto &it: node->expression_->types) {
@@ -711,6 +688,10 @@ void SemanticChecker::visit(UnaryExpressionNode *node) {
                 throw SemanticError("Semantic Error: Invalid UnaryExpressionNode",
                                     node->pos_);
             }
+            node->is_compiler_known_ = node->expression_->is_compiler_known_;
+            if (auto *val = std::get_if<int64_t>(&node->expression_->value)) {
+                node->value = -*val;
+            }
             return;
         }
         if (node->type_ == TokenType::Not) {
@@ -732,13 +713,13 @@ void SemanticChecker::visit(UnaryExpressionNode *node) {
         }
         if (node->type_ == TokenType::And) {
             for (const auto &it: node->expression_->types) {
-                auto type = std::make_shared<ReferenceType>(it);
+                auto type = GlobalTypeContext().Reference(it);
                 node->types.emplace_back(type);
             }
         }
         if (node->type_ == TokenType::AndMut) {
             for (const auto &it: node->expression_->types) {
-                auto type = std::make_shared<ReferenceType>(it, true);
+                auto type = GlobalTypeContext().Reference(it, true);
                 node->types.emplace_back(type);
             }
         }
@@ -764,7 +745,7 @@ void SemanticChecker::visit(UnaryExpressionNode *node) {
 void SemanticChecker::visit(FunctionCallExpressionNode *node) {
     std::shared_ptr<FunctionType> type;
     if (node->callee_) {
-        node->callee_->accept(this);
+        Visit(node->callee_);
         type = std::dynamic_pointer_cast<FunctionType>(node->callee_->types[0]);
         if (!type) {
             throw SemanticError("Semantic Error: Invalid Function Type", node->pos_);
@@ -779,7 +760,7 @@ void SemanticChecker::visit(FunctionCallExpressionNode *node) {
     uint32_t index = 0;
     for (const auto &param: node->params_) {
         if (param) {
-            param->accept(this);
+            Visit(param);
             bool match = false;
             for (const auto &it: param->types) {
                 auto val = std::get_if<int64_t>(&param->value);
@@ -806,7 +787,7 @@ void SemanticChecker::visit(FunctionCallExpressionNode *node) {
 void SemanticChecker::visit(ArrayIndexExpressionNode *node) {
     std::shared_ptr<ArrayType> type;
     if (node->base_) {
-        node->base_->accept(this);
+        Visit(node->base_);
         if (!node->base_->is_assignable_) {
             throw SemanticError("Semantic Error: Left Value Error", node->pos_);
         }
@@ -825,7 +806,7 @@ void SemanticChecker::visit(ArrayIndexExpressionNode *node) {
         }
     }
     if (node->index_) {
-        node->index_->accept(this);
+        Visit(node->index_);
         bool valid = false;
         for (const auto &it: node->index_->types) {
             auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
@@ -843,21 +824,21 @@ void SemanticChecker::visit(ArrayIndexExpressionNode *node) {
 
 void SemanticChecker::visit(MemberAccessExpressionNode *node) {
     if (node->base_) {
-        node->base_->accept(this);
+        Visit(node->base_);
         node->is_mutable_ = node->base_->is_mutable_;
         std::shared_ptr<Type> type = node->base_->types[0];
         while (true) {
             auto tmp = std::dynamic_pointer_cast<StructType>(type);
             if (tmp) {
                 for (const auto &it: tmp->members_) {
-                    if (it.name_ == node->member_.token) {
+                    if (it.name_ == node->member_) {
                         node->types.emplace_back(it.type_);
                         return;
                     }
                 }
             }
             for (const auto &it: type->methods_) {
-                if (it.name_ == node->member_.token) {
+                if (it.name_ == node->member_) {
                     node->types.emplace_back(it.type_);
                     return;
                 }
@@ -872,11 +853,27 @@ void SemanticChecker::visit(MemberAccessExpressionNode *node) {
 }
 
 void SemanticChecker::visit(BlockExpressionNode *node) {
-    scope_manager_.current_scope = scope_manager_.current_scope
-            ->next_level_scopes_[scope_manager_.current_scope->index++];
-    scope_manager_.current_scope->index = 0;
+    if (node->scope_index != 0) { // opened by the item pass, with its items
+        scope_manager_.SetCurrentScope(scope_manager_.scope_set_[node->scope_index]);
+    } else {
+        scope_manager_.AddScope(node->scope_index, node->pos_);
+        // Only outside a function body, say in the length of an array type,
+        // can a block the item pass did not reach declare items.
+        std::vector<VisItemNode *> items;
+        if (node->statements_) {
+            for (const auto &stmt: node->statements_->statements_) {
+                auto item_stmt = dyn_cast<VisItemStatementNode>(stmt);
+                if (item_stmt && item_stmt->vis_item_node_) {
+                    items.push_back(item_stmt->vis_item_node_);
+                }
+            }
+        }
+        if (!items.empty()) {
+            SymbolCollector(scope_manager_).Collect(items);
+        }
+    }
     if (node->statements_) {
-        node->statements_->accept(this);
+        Visit(node->statements_);
         if (interrupt) {
             node->types.emplace_back(scope_manager_.lookup("never").type_);
             scope_manager_.PopScope();
@@ -888,7 +885,7 @@ void SemanticChecker::visit(BlockExpressionNode *node) {
             node->types = node->statements_->expression_->types;
         } else if (!node->statements_->statements_.empty()) {
             auto last_stmt = node->statements_->statements_.back();
-            auto expr_stmt = std::dynamic_pointer_cast<ExpressionStatementNode>(last_stmt);
+            auto expr_stmt = dyn_cast<ExpressionStatementNode>(last_stmt);
             if (expr_stmt && !expr_stmt->has_semicolon_) {
                 node->types = expr_stmt->expression_->types;
             }
@@ -899,9 +896,6 @@ void SemanticChecker::visit(BlockExpressionNode *node) {
     scope_manager_.PopScope();
 }
 
-void SemanticChecker::visit(LoopExpressionNode *node) {
-}
-
 void SemanticChecker::visit(InfiniteLoopExpressionNode *node) {
     if (node->block_expression_) {
         bool prev_in_loop = in_loop_;
@@ -910,7 +904,7 @@ void SemanticChecker::visit(InfiniteLoopExpressionNode *node) {
         in_loop_ = true;
         in_for_loop_ = true;
         in_while_loop_ = false;
-        node->block_expression_->accept(this);
+        Visit(node->block_expression_);
         node->types = loop_return_type_;
         loop_return_type_.clear();
         in_loop_ = prev_in_loop;
@@ -925,7 +919,7 @@ void SemanticChecker::visit(InfiniteLoopExpressionNode *node) {
 }
 
 void SemanticChecker::visit(PredicateLoopExpressionNode *node) {
-    if (node->conditions_) node->conditions_->accept(this);
+    if (node->conditions_) Visit(node->conditions_);
     if (node->block_expression_) {
         bool prev_in_loop = in_loop_;
         bool prev_in_for_loop = in_for_loop_;
@@ -933,7 +927,7 @@ void SemanticChecker::visit(PredicateLoopExpressionNode *node) {
         in_loop_ = true;
         in_for_loop_ = false;
         in_while_loop_ = true;
-        node->block_expression_->accept(this);
+        Visit(node->block_expression_);
         node->types = loop_return_type_;
         loop_return_type_.clear();
         in_loop_ = prev_in_loop;
@@ -944,10 +938,10 @@ void SemanticChecker::visit(PredicateLoopExpressionNode *node) {
 }
 
 void SemanticChecker::visit(IfExpressionNode *node) {
-    if (node->conditions_) node->conditions_->accept(this);
-    if (node->true_block_expression_) node->true_block_expression_->accept(this);
-    if (node->false_block_expression_) node->false_block_expression_->accept(this);
-    if (node->if_expression_) node->if_expression_->accept(this);
+    if (node->conditions_) Visit(node->conditions_);
+    if (node->true_block_expression_) Visit(node->true_block_expression_);
+    if (node->false_block_expression_) Visit(node->false_block_expression_);
+    if (node->if_expression_) Visit(node->if_expression_);
     if (node->true_block_expression_ && node->false_block_expression_) {
         std::vector<std::shared_ptr<Type> > types = cap(node->true_block_expression_->types,
                                                         node->false_block_expression_->types);
@@ -969,14 +963,6 @@ void SemanticChecker::visit(IfExpressionNode *node) {
     node->types.emplace_back(scope_manager_.lookup("void").type_);
 }
 
-void SemanticChecker::visit(MatchExpressionNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-    if (node->match_arms_) node->match_arms_->accept(this);
-}
-
-void SemanticChecker::visit(LiteralExpressionNode *node) {
-}
-
 void SemanticChecker::visit(CharLiteralNode *node) {
     std::shared_ptr<Type> type = scope_manager_.lookup("char").type_;
     node->is_compiler_known_ = true;
@@ -985,7 +971,7 @@ void SemanticChecker::visit(CharLiteralNode *node) {
 
 void SemanticChecker::visit(StringLiteralNode *node) {
     std::shared_ptr<Type> type = scope_manager_.lookup("str").type_;
-    type = std::make_shared<ReferenceType>(type);
+    type = GlobalTypeContext().Reference(type);
     node->is_compiler_known_ = true;
     node->value = node->string_literal_;
     node->types.emplace_back(type);
@@ -1031,7 +1017,7 @@ void SemanticChecker::visit(ArrayLiteralNode *node) {
     node->is_compiler_known_ = true;
     for (const auto &expr: node->expressions_) {
         if (expr) {
-            expr->accept(this);
+            Visit(expr);
             std::vector<std::shared_ptr<Type> > tmp;
             if (init) {
                 element_types = expr->types;
@@ -1047,18 +1033,18 @@ void SemanticChecker::visit(ArrayLiteralNode *node) {
                                 node->pos_);
         }
         for (const auto &it: element_types) {
-            node->types.emplace_back(std::make_shared<ArrayType>(it,
+            node->types.emplace_back(GlobalTypeContext().Array(it,
                                                                  node->expressions_.size()));
         }
         return;
     }
     if (node->lhs_) {
-        node->lhs_->accept(this);
+        Visit(node->lhs_);
         element_types = node->lhs_->types;
     }
     uint32_t size = 0;
     if (node->rhs_) {
-        node->rhs_->accept(this);
+        Visit(node->rhs_);
         if (!node->rhs_->is_compiler_known_) {
             throw SemanticError("Semantic Error: The size of array is not a Compiler-known Constant",
                                 node->pos_);
@@ -1067,22 +1053,19 @@ void SemanticChecker::visit(ArrayLiteralNode *node) {
         size = *tmp;
     }
     for (const auto &it: element_types) {
-        node->types.emplace_back(std::make_shared<ArrayType>(it, size));
+        node->types.emplace_back(GlobalTypeContext().Array(it, size));
     }
 }
 
-void SemanticChecker::visit(PathExpressionNode *node) {
-}
-
 void SemanticChecker::visit(PathInExpressionNode *node) {
     for (const auto &seg: node->path_indent_segments_) {
-        if (seg) seg->accept(this);
+        if (seg) Visit(seg);
     }
     uint32_t len = node->path_indent_segments_.size();
     if (len == 2) {
         std::string type_name = node->path_indent_segments_[0]->identifier_;
         std::string func_name = node->path_indent_segments_[1]->identifier_;
-        Symbol symbol = scope_manager_.lookup(type_name);
+        const Symbol &symbol = scope_manager_.lookup(type_name);
         if (symbol.symbol_type_ == SymbolType::Struct) {
             for (auto &it: symbol.type_->inline_functions_) {
                 if (it.name_ == func_name) {
@@ -1093,9 +1076,11 @@ void SemanticChecker::visit(PathInExpressionNode *node) {
             for (auto &it: symbol.type_->constants_) {
                 if (it.name_ == func_name) {
                     node->is_compiler_known_ = true;
-                    auto value = symbol.type_->value_map[it.name_];
-                    if (auto *tmp = std::get_if<int64_t>(&value)) {
-                        node->value = *tmp;
+                    const auto value = symbol.type_->value_map.find(it.name_);
+                    if (value != symbol.type_->value_map.end()) {
+                        if (auto *tmp = std::get_if<int64_t>(&value->second)) {
+                            node->value = *tmp;
+                        }
                     }
                     node->types.emplace_back(it.type_);
                     return;
@@ -1120,13 +1105,15 @@ void SemanticChecker::visit(PathInExpressionNode *node) {
                 throw SemanticError("Semantic Error: Duplicate exit function in code", node->pos_);
             }
             has_exit = true;
+            exit_pos_ = node->pos_;
         }
-        Symbol symbol = scope_manager_.lookup(node->path_indent_segments_[0]->identifier_);
+        const Atom atom = node->path_indent_segments_[0]->atom_;
+        const Symbol &symbol = in_const_context_ ? scope_manager_.lookupConst(atom) : scope_manager_.lookup(atom);
         node->types.emplace_back(symbol.type_);
         node->is_mutable_ = symbol.is_mutable_;
         if (symbol.is_const_) {
             node->is_compiler_known_ = true;
-            auto value = scope_manager_.SearchValue(symbol.name_);
+            auto value = scope_manager_.SearchValue(symbol.atom_);
             if (auto *tmp = std::get_if<int64_t>(&value)) {
                 node->value = *tmp;
             }
@@ -1134,16 +1121,13 @@ void SemanticChecker::visit(PathInExpressionNode *node) {
     }
 }
 
-void SemanticChecker::visit(PathIndentSegmentNode *node) {
-}
-
 void SemanticChecker::visit(StructExpressionNode *node) {
     if (node->path_in_expression_node_) {
-        node->path_in_expression_node_->accept(this);
+        Visit(node->path_in_expression_node_);
         node->types.emplace_back(node->path_in_expression_node_->types[0]);
     }
     if (node->struct_expr_fields_node_) {
-        node->struct_expr_fields_node_->accept(this);
+        Visit(node->struct_expr_fields_node_);
         auto struct_type = std::dynamic_pointer_cast<StructType>(node->types[0]);
         if (struct_type->members_.size() != node->struct_expr_fields_node_->struct_expr_field_nodes_.size()) {
             throw SemanticError("Semantic Error: Invalid StructExpression", node->pos_);
@@ -1161,40 +1145,21 @@ void SemanticChecker::visit(StructExpressionNode *node) {
             }
         }
     }
-    if (node->struct_base_node_) node->struct_base_node_->accept(this);
-}
-
-void SemanticChecker::visit(StructExprFieldsNode *node) {
-    for (const auto &field: node->struct_expr_field_nodes_) {
-        if (field) field->accept(this);
-    }
-    if (node->struct_base_node_) node->struct_base_node_->accept(this);
-}
-
-void SemanticChecker::visit(StructExprFieldNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
-}
-
-void SemanticChecker::visit(StructBaseNode *node) {
-    if (node->expression_node_) node->expression_node_->accept(this);
+    if (node->struct_base_node_) Visit(node->struct_base_node_);
 }
 
 void SemanticChecker::visit(GroupedExpressionNode *node) {
     if (node->expression_) {
-        node->expression_->accept(this);
+        Visit(node->expression_);
         node->types = node->expression_->types;
-    }
-}
-
-void SemanticChecker::visit(TupleExpressionNode *node) {
-    for (const auto &expr: node->expressions_) {
-        if (expr) expr->accept(this);
+        node->is_compiler_known_ = node->expression_->is_compiler_known_;
+        node->value = node->expression_->value;
     }
 }
 
 void SemanticChecker::visit(ConditionsNode *node) {
     if (node->expression_) {
-        node->expression_->accept(this);
+        Visit(node->expression_);
         bool valid = false;
         for (auto &it: node->expression_->types) {
             auto tmp = std::dynamic_pointer_cast<PrimitiveType>(it);
@@ -1216,86 +1181,15 @@ void SemanticChecker::visit(LetChainConditionNode *node) {
 }
 
 
-void SemanticChecker::visit(MatchArmsNode *node) {
-    for (const auto &arm: node->match_arm_nodes_) {
-        if (arm) arm->accept(this);
-    }
-    for (const auto &expr: node->expression_nodes_) {
-        if (expr) expr->accept(this);
-    }
-}
-
-void SemanticChecker::visit(MatchArmNode *node) {
-    if (node->pattern_node_) node->pattern_node_->accept(this);
-    if (node->match_arm_guard_) node->match_arm_guard_->accept(this);
-}
-
-void SemanticChecker::visit(MatchArmGuardNode *node) {
-}
-
-void SemanticChecker::visit(PatternNode *node) {
-    for (const auto &pat: node->pattern_no_top_alts_) {
-        if (pat) pat->accept(this);
-    }
-}
-
-void SemanticChecker::visit(PatternNoTopAltNode *node) {
-}
-
-void SemanticChecker::visit(PatternWithoutRangeNode *node) {
-}
-
-void SemanticChecker::visit(LiteralPatternNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void SemanticChecker::visit(IdentifierPatternNode *node) {
-    if (node->node_) node->node_->accept(this);
-}
-
-void SemanticChecker::visit(WildcardPatternNode *node) {
-}
-
-void SemanticChecker::visit(RestPatternNode *node) {
-}
-
-void SemanticChecker::visit(GroupedPatternNode *node) {
-    if (node->pattern_) node->pattern_->accept(this);
-}
-
-void SemanticChecker::visit(SlicePatternNode *node) {
-    for (const auto &pat: node->patterns_) {
-        if (pat) pat->accept(this);
-    }
-}
-
-void SemanticChecker::visit(PathPatternNode *node) {
-    if (node->expression_) node->expression_->accept(this);
-}
-
-void SemanticChecker::visit(TypeNode *node) {
-}
-
-void SemanticChecker::visit(TypeNoBoundsNode *node) {
-}
-
-void SemanticChecker::visit(ParenthesizedTypeNode *node) {
-    if (node->type_) node->type_->accept(this);
-}
-
 void SemanticChecker::visit(TypePathNode *node) {
     if (node->type_path_segment_node_) {
-        node->type_path_segment_node_->accept(this);
-        Symbol sym = scope_manager_.lookup(node->type_path_segment_node_->
+        Visit(node->type_path_segment_node_);
+        const Symbol &sym = scope_manager_.lookup(node->type_path_segment_node_->
             path_indent_segment_node_->identifier_);
         node->type = sym.type_;
     }
 }
 
-void SemanticChecker::visit(TypePathSegmentNode *node) {
-    if (node->path_indent_segment_node_) node->path_indent_segment_node_->accept(this);
-}
-
 void SemanticChecker::visit(UnitTypeNode *node) {
     node->type = scope_manager_.lookup("void").type_;
 }
@@ -1304,11 +1198,14 @@ void SemanticChecker::visit(ArrayTypeNode *node) {
     std::shared_ptr<Type> base_type;
     uint32_t size = 0;
     if (node->type_) {
-        node->type_->accept(this);
+        Visit(node->type_);
         base_type = node->type_->type;
     }
     if (node->expression_node_) {
-        node->expression_node_->accept(this);
+        const bool in_const_context = in_const_context_;
+        in_const_context_ = true;
+        Visit(node->expression_node_);
+        in_const_context_ = in_const_context;
         if (!node->expression_node_->is_compiler_known_) {
             throw SemanticError("Semantic Error: The size of array is not a Compiler-known Constant",
                                 node->pos_);
@@ -1316,38 +1213,26 @@ void SemanticChecker::visit(ArrayTypeNode *node) {
         const auto *tmp = std::get_if<int64_t>(&node->expression_node_->value);
         size = *tmp;
     }
-    node->type = std::make_shared<ArrayType>(base_type, size);
+    node->type = GlobalTypeContext().Array(base_type, size);
 }
 
 void SemanticChecker::visit(SliceTypeNode *node) {
     std::shared_ptr<Type> base_type;
     if (node->type_) {
-        node->type_->accept(this);
+        Visit(node->type_);
         base_type = node->type_->type;
     }
-    node->type = std::make_shared<SliceType>(base_type);
+    node->type = GlobalTypeContext().Slice(base_type);
 }
 
 void SemanticChecker::visit(ReferenceTypeNode *node) {
     if (node->type_node_) {
-        node->type_node_->accept(this);
-        node->type = std::make_shared<ReferenceType>(node->type_node_->type, node->is_mut_);
+        Visit(node->type_node_);
+        node->type = GlobalTypeContext().Reference(node->type_node_->type, node->is_mut_);
     }
 }
 
 
-void SemanticChecker::visit(ConstParamNode *node) {
-}
-
-void SemanticChecker::visit(TypeParamNode *node) {
-}
-
-void SemanticChecker::visit(TypeParamBoundsNode *node) {
-}
-
-void SemanticChecker::visit(QualifiedPathInExpressionNode *node) {
-}
-
 /****************  Supportive Function  ****************/
 std::vector<std::shared_ptr<Type> > SemanticChecker::cap(const std::vector<std::shared_ptr<Type> > &a,
                                                          const std::vector<std::shared_ptr<Type> > &b) {
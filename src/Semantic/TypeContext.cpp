@@ -0,0 +1,123 @@
+#include "Semantic/TypeContext.h"
+
+TypeContext::FunctionKey TypeContext::KeyOf(const std::vector<std::shared_ptr<Type> > &params,
+                                            const std::shared_ptr<Type> &ret, const bool have_self,
+                                            const bool have_and, const bool is_mut) {
+    FunctionKey key{{}, ret.get(), static_cast<uint8_t>(have_self | have_and << 1 | is_mut << 2)};
+    key.params.reserve(params.size());
+    for (const auto &param: params) {
+        key.params.push_back(param.get());
+    }
+    return key;
+}
+
+std::shared_ptr<PrimitiveType> TypeContext::Primitive(const std::string_view name) {
+    const auto lock = Lock();
+    requests_++;
+    auto &slot = primitives_[GlobalInterner().Intern(name)];
+    if (!slot) {
+        slot = std::make_shared<PrimitiveType>(std::string(name));
+    }
+    return slot;
+}
+
+std::shared_ptr<UnitType> TypeContext::Unit() {
+    const auto lock = Lock();
+    requests_++;
+    if (!unit_) {
+        unit_ = std::make_shared<UnitType>();
+    }
+    return unit_;
+}
+
+std::shared_ptr<ArrayType> TypeContext::Array(const std::shared_ptr<Type> &base, const uint32_t length) {
+    const auto lock = Lock();
+    requests_++;
+    auto &slot = arrays_[ArrayKey{base.get(), length}];
+    if (!slot) {
+        slot = std::make_shared<ArrayType>(base, length);
+        slot->methods_.emplace_back(Method{"len", Function({}, Primitive("usize"))});
+    }
+    return slot;
+}
+
+std::shared_ptr<SliceType> TypeContext::Slice(const std::shared_ptr<Type> &type) {
+    const auto lock = Lock();
+    requests_++;
+    auto &slot = slices_[type.get()];
+    if (!slot) {
+        slot = std::make_shared<SliceType>(type);
+    }
+    return slot;
+}
+
+std::shared_ptr<ReferenceType> TypeContext::Reference(const std::shared_ptr<Type> &type, const bool is_mut) {
+    const auto lock = Lock();
+    requests_++;
+    auto &slot = references_[ReferenceKey{type.get(), is_mut}];
+    if (!slot) {
+        slot = std::make_shared<ReferenceType>(type, is_mut);
+    }
+    return slot;
+}
+
+std::shared_ptr<FunctionType> TypeContext::Function(const std::vector<std::shared_ptr<Type> > &params,
+                                                    const std::shared_ptr<Type> &ret, const bool have_self,
+                                                    const bool have_and, const bool is_mut) {
+    const auto lock = Lock();
+    requests_++;
+    auto &slot = functions_[KeyOf(params, ret, have_self, have_and, is_mut)];
+    if (!slot) {
+        slot = std::make_shared<FunctionType>(params, ret);
+        slot->SetParam(have_self, have_and, is_mut);
+    }
+    return slot;
+}
+
+void TypeContext::Adopt(const std::shared_ptr<Type> &type) {
+    switch (type->getKind()) {
+        case TypeKind::Primitive: {
+            auto primitive = std::static_pointer_cast<PrimitiveType>(type);
+            primitives_.emplace(GlobalInterner().Intern(primitive->name_), primitive);
+            break;
+        }
+        case TypeKind::Unit:
+            if (!unit_) {
+                unit_ = std::static_pointer_cast<UnitType>(type);
+            }
+            break;
+        case TypeKind::Array: {
+            auto array = std::static_pointer_cast<ArrayType>(type);
+            arrays_.emplace(ArrayKey{array->base_.get(), array->length_}, array);
+            break;
+        }
+        case TypeKind::Slice: {
+            auto slice = std::static_pointer_cast<SliceType>(type);
+            slices_.emplace(slice->type_.get(), slice);
+            break;
+        }
+        case TypeKind::Reference: {
+            auto reference = std::static_pointer_cast<ReferenceType>(type);
+            references_.emplace(ReferenceKey{reference->type_.get(), reference->is_mut_}, reference);
+            break;
+        }
+        case TypeKind::Function: {
+            auto function = std::static_pointer_cast<FunctionType>(type);
+            functions_.emplace(KeyOf(function->params_, function->ret_, function->have_self_, function->have_and_,
+                                     function->is_mut_), function);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void TypeContext::Clear() {
+    primitives_.clear();
+    unit_.reset();
+    arrays_.clear();
+    slices_.clear();
+    references_.clear();
+    functions_.clear();
+    requests_ = 0;
+}
@@ -0,0 +1,154 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator for objects that all die together, such as the AST of a
+// crate. Objects are placed back to back in 64 KiB chunks and referenced by
+// plain pointers; nothing is freed individually. Reset() (or the destructor)
+// runs the destructors of the objects that have one, newest first, and then
+// releases the chunks in one go.
+//
+// Only the release of the chunks is independent of the object count; Reset()
+// as a whole is linear in the objects with a destructor. Every AST node has
+// one (ASTNode's is virtual, and nodes still own strings, vectors and the
+// shared_ptr annotations the passes attach), so tearing down a crate costs a
+// destructor call per node, without the refcount walk of a shared_ptr tree.
+class Arena {
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    // Kept in the arena next to the object it destroys, newest first.
+    struct Destructor {
+        void (*destroy)(void *);
+        void *object;
+        Destructor *next;
+    };
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks_;
+    std::byte *cursor_ = nullptr;
+    std::byte *limit_ = nullptr;
+    Destructor *destructors_ = nullptr;
+    Destructor *oldest_destructor_ = nullptr;
+    size_t object_count_ = 0;
+    size_t destructor_count_ = 0;
+    size_t bytes_allocated_ = 0;
+    size_t bytes_reserved_ = 0;
+
+    void *AllocateSlow(const size_t size) {
+        // Oversized objects get a chunk of their own; the current chunk stays
+        // open for the small objects that follow.
+        if (size > ChunkSize / 4) {
+            chunks_.emplace_back(new std::byte[size]);
+            bytes_reserved_ += size;
+            return chunks_.back().get();
+        }
+        chunks_.emplace_back(new std::byte[ChunkSize]);
+        bytes_reserved_ += ChunkSize;
+        cursor_ = chunks_.back().get();
+        limit_ = cursor_ + ChunkSize;
+        void *memory = cursor_;
+        cursor_ += size;
+        return memory;
+    }
+
+public:
+    Arena() = default;
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() {
+        Reset();
+    }
+
+    void *Allocate(const size_t size, const size_t align) {
+        static_assert(alignof(std::max_align_t) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        bytes_allocated_ += size;
+        const auto address = reinterpret_cast<uintptr_t>(cursor_);
+        const uintptr_t aligned = (address + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        if (cursor_ != nullptr && aligned + size <= reinterpret_cast<uintptr_t>(limit_)) {
+            cursor_ = reinterpret_cast<std::byte *>(aligned + size);
+            return reinterpret_cast<void *>(aligned);
+        }
+        return AllocateSlow(size);
+    }
+
+    template<typename T, typename... Args>
+    T *Make(Args &&... args) {
+        static_assert(alignof(T) <= alignof(std::max_align_t));
+        T *object = new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors_ = new(Allocate(sizeof(Destructor), alignof(Destructor))) Destructor{
+                [](void *pointer) { static_cast<T *>(pointer)->~T(); }, object, destructors_
+            };
+            if (oldest_destructor_ == nullptr) {
+                oldest_destructor_ = destructors_;
+            }
+            destructor_count_++;
+        }
+        object_count_++;
+        return object;
+    }
+
+    // Takes over every object of `other`, which is left empty. Lets threads
+    // build into arenas of their own and hand the result to a single owner.
+    void Adopt(Arena &other) {
+        for (auto &chunk: other.chunks_) {
+            chunks_.push_back(std::move(chunk));
+        }
+        if (other.destructors_ != nullptr) {
+            other.oldest_destructor_->next = destructors_;
+            destructors_ = other.destructors_;
+            if (oldest_destructor_ == nullptr) {
+                oldest_destructor_ = other.oldest_destructor_;
+            }
+        }
+        object_count_ += other.object_count_;
+        destructor_count_ += other.destructor_count_;
+        bytes_allocated_ += other.bytes_allocated_;
+        bytes_reserved_ += other.bytes_reserved_;
+        other.chunks_.clear();
+        other.destructors_ = other.oldest_destructor_ = nullptr;
+        other.cursor_ = other.limit_ = nullptr;
+        other.object_count_ = other.destructor_count_ = other.bytes_allocated_ = other.bytes_reserved_ = 0;
+    }
+
+    // Destroys every object and returns the memory; the arena can be reused.
+    // Takes one destructor call per destructor_count().
+    void Reset() {
+        for (const Destructor *it = destructors_; it != nullptr; it = it->next) {
+            it->destroy(it->object);
+        }
+        destructors_ = oldest_destructor_ = nullptr;
+        chunks_.clear();
+        chunks_.shrink_to_fit();
+        cursor_ = limit_ = nullptr;
+        object_count_ = destructor_count_ = bytes_allocated_ = bytes_reserved_ = 0;
+    }
+
+    [[nodiscard]] size_t object_count() const {
+        return object_count_;
+    }
+
+    // Objects Reset() has to destroy one by one.
+    [[nodiscard]] size_t destructor_count() const {
+        return destructor_count_;
+    }
+
+    // Bytes handed out, destructor records included, alignment padding not.
+    [[nodiscard]] size_t bytes_allocated() const {
+        return bytes_allocated_;
+    }
+
+    // Bytes obtained from the heap for chunks.
+    [[nodiscard]] size_t bytes_reserved() const {
+        return bytes_reserved_;
+    }
+};
+#endif //ARENA_H
@@ -0,0 +1,53 @@
+#ifndef CASTING_H
+#define CASTING_H
+#include <cassert>
+#include <memory>
+#include <type_traits>
+
+// isa<>, cast<> and dyn_cast<> for class hierarchies that store a kind tag in
+// the base class. A class opts in with `static bool classof(const Base *)`,
+// which inspects the tag; a check is then a load and a compare instead of an
+// RTTI walk.
+//
+// Unlike LLVM, isa<> and dyn_cast<> accept null and report no match, because
+// the passes routinely test optional children. The shared_ptr overloads look
+// through the pointer and return a raw one, so the check never touches the
+// reference count; shared_dyn_cast<> is for the callers that keep the result.
+
+template<typename To, typename From>
+[[nodiscard]] bool isa(const From *node) {
+    return node != nullptr && To::classof(node);
+}
+
+template<typename To, typename From>
+[[nodiscard]] bool isa(const std::shared_ptr<From> &node) {
+    return isa<To>(node.get());
+}
+
+template<typename To, typename From>
+[[nodiscard]] std::conditional_t<std::is_const_v<From>, const To, To> *cast(From *node) {
+    assert(isa<To>(node) && "cast<> to an incompatible kind");
+    return static_cast<std::conditional_t<std::is_const_v<From>, const To, To> *>(node);
+}
+
+template<typename To, typename From>
+[[nodiscard]] To *cast(const std::shared_ptr<From> &node) {
+    return cast<To>(node.get());
+}
+
+template<typename To, typename From>
+[[nodiscard]] std::conditional_t<std::is_const_v<From>, const To, To> *dyn_cast(From *node) {
+    return isa<To>(node) ? static_cast<std::conditional_t<std::is_const_v<From>, const To, To> *>(node) : nullptr;
+}
+
+template<typename To, typename From>
+[[nodiscard]] To *dyn_cast(const std::shared_ptr<From> &node) {
+    return dyn_cast<To>(node.get());
+}
+
+// Like std::dynamic_pointer_cast, but decided by classof().
+template<typename To, typename From>
+[[nodiscard]] std::shared_ptr<To> shared_dyn_cast(const std::shared_ptr<From> &node) {
+    return isa<To>(node) ? std::static_pointer_cast<To>(node) : nullptr;
+}
+#endif //CASTING_H
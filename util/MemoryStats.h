@@ -0,0 +1,93 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Resident memory of the process, sampled per compiler phase, and the wall
+// time each phase took. On Linux the kernel's high-water mark (VmHWM) is
+// reset at the start of every phase, so a phase's peak is its own rather than
+// the highest seen since startup; where the reset is not available the column
+// degrades to the running peak.
+class PhaseMemory {
+    struct PhaseStats {
+        std::string phase;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double milliseconds = 0;
+        size_t peak_kib = 0;
+        size_t end_kib = 0;
+    };
+
+    std::vector<PhaseStats> phases_;
+
+    // Reads a "Name:   1234 kB" line of /proc/self/status; 0 when unavailable.
+    static size_t ReadStatusKib(const char *field) {
+        std::FILE *status = std::fopen("/proc/self/status", "r");
+        if (status == nullptr) {
+            return 0;
+        }
+        const size_t field_length = std::strlen(field);
+        char line[256];
+        size_t kib = 0;
+        while (std::fgets(line, sizeof(line), status)) {
+            if (std::strncmp(line, field, field_length) == 0 && line[field_length] == ':') {
+                kib = std::strtoull(line + field_length + 1, nullptr, 10);
+                break;
+            }
+        }
+        std::fclose(status);
+        return kib;
+    }
+
+    static void ResetPeak() {
+        if (std::FILE *clear_refs = std::fopen("/proc/self/clear_refs", "w")) {
+            std::fputs("5", clear_refs);
+            std::fclose(clear_refs);
+        }
+    }
+
+    void EndPhase() {
+        if (phases_.empty()) {
+            return;
+        }
+        PhaseStats &phase = phases_.back();
+        phase.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - phase.start).count();
+        phase.peak_kib = ReadStatusKib("VmHWM");
+        phase.end_kib = ReadStatusKib("VmRSS");
+    }
+
+public:
+    // Closes the running phase and starts attributing memory to `phase`.
+    void BeginPhase(std::string phase) {
+        EndPhase();
+        ResetPeak();
+        phases_.push_back(PhaseStats{std::move(phase)});
+    }
+
+    // The "end" column is sampled when the next phase begins, after the driver
+    // has released whatever the finished phase no longer needs; the time
+    // includes that release.
+    void PrintStats(std::FILE *out) {
+        EndPhase();
+        std::fprintf(out, "%-16s %10s %14s %14s\n", "phase", "ms", "peak RSS MiB", "end RSS MiB");
+        for (const PhaseStats &phase: phases_) {
+            std::fprintf(out, "%-16s %10.3f %14.1f %14.1f\n", phase.phase.c_str(), phase.milliseconds,
+                         phase.peak_kib / 1024.0, phase.end_kib / 1024.0);
+        }
+    }
+};
+
+// Hands memory freed back to the allocator on to the kernel, so dropping a
+// phase's data shows up in the resident set and not only in malloc's free lists.
+inline void ReleaseFreedMemory() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+#endif //MEMORYSTATS_H
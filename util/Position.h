@@ -2,8 +2,12 @@
 #define POSITION_H
 #include <cstdint>
 
+// Where a token starts: 1-based row and column plus the byte offset into the
+// source buffer.
 class Position {
     uint32_t row = 0;
+    uint32_t column = 0;
+    uint32_t offset = 0;
 
 public:
     Position() = default;
@@ -12,8 +16,20 @@ public:
         this->row = row;
     }
 
+    Position(const uint32_t row, const uint32_t column, const uint32_t offset)
+        : row(row), column(column), offset(offset) {
+    }
+
     [[nodiscard]] uint32_t GetRow() const {
         return row;
     }
+
+    [[nodiscard]] uint32_t GetColumn() const {
+        return column;
+    }
+
+    [[nodiscard]] uint32_t GetOffset() const {
+        return offset;
+    }
 };
 #endif //POSITION_H
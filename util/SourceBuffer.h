@@ -0,0 +1,114 @@
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Error.h"
+
+// The immutable bytes of one source file. A file path is mapped read-only so
+// the lexer scans the page cache directly; stdin (which may be a pipe) is read
+// into one buffer that grows geometrically, with no per-character iterator.
+class SourceBuffer {
+    const char *mapped_ = nullptr;
+    size_t mapped_size_ = 0;
+    std::string owned_;
+    std::string_view text_;
+
+    SourceBuffer() = default;
+
+    static std::string ErrnoMessage(const std::string &what) {
+        return "Input Error: " + what + ": " + std::strerror(errno);
+    }
+
+public:
+    static SourceBuffer MapFile(const std::string &path) {
+        SourceBuffer buffer;
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw InputError(ErrnoMessage("cannot open " + path));
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw InputError(ErrnoMessage("cannot stat " + path));
+        }
+        const auto size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            void *address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw InputError(ErrnoMessage("cannot map " + path));
+            }
+            ::madvise(address, size, MADV_SEQUENTIAL);
+            buffer.mapped_ = static_cast<const char *>(address);
+            buffer.mapped_size_ = size;
+            buffer.text_ = std::string_view(buffer.mapped_, size);
+        }
+        ::close(fd);
+        return buffer;
+    }
+
+    static SourceBuffer ReadStream(const int fd) {
+        SourceBuffer buffer;
+        struct stat info{};
+        size_t capacity = 64 * 1024;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            capacity = static_cast<size_t>(info.st_size) + 1;
+        }
+        size_t size = 0;
+        buffer.owned_.resize(capacity);
+        while (true) {
+            if (size == buffer.owned_.size()) {
+                buffer.owned_.resize(buffer.owned_.size() * 2);
+            }
+            const ssize_t count = ::read(fd, buffer.owned_.data() + size, buffer.owned_.size() - size);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0) {
+                throw InputError(ErrnoMessage("cannot read input"));
+            }
+            if (count == 0) {
+                break;
+            }
+            size += static_cast<size_t>(count);
+        }
+        buffer.owned_.resize(size);
+        buffer.text_ = buffer.owned_;
+        return buffer;
+    }
+
+    SourceBuffer(SourceBuffer &&other) noexcept
+        : mapped_(std::exchange(other.mapped_, nullptr)), mapped_size_(std::exchange(other.mapped_size_, 0)),
+          owned_(std::move(other.owned_)) {
+        text_ = mapped_ ? std::string_view(mapped_, mapped_size_) : std::string_view(owned_);
+        other.text_ = {};
+    }
+
+    SourceBuffer(const SourceBuffer &) = delete;
+
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    SourceBuffer &operator=(SourceBuffer &&) = delete;
+
+    ~SourceBuffer() {
+        if (mapped_) {
+            ::munmap(const_cast<char *>(mapped_), mapped_size_);
+        }
+    }
+
+    [[nodiscard]] std::string_view text() const {
+        return text_;
+    }
+
+    [[nodiscard]] bool mapped() const {
+        return mapped_ != nullptr;
+    }
+};
+#endif //SOURCEBUFFER_H
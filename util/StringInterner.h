@@ -0,0 +1,114 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dense 32-bit handle for an interned string. Equal strings get equal atoms,
+// so symbol tables keyed by Atom hash and compare plain integers.
+using Atom = uint32_t;
+
+class StringInterner {
+    struct PhaseStats {
+        std::string phase;
+        size_t interned_before = 0;
+        uint64_t lookups = 0;
+        uint64_t lookup_ns = 0;
+    };
+
+    std::deque<std::string> storage_; // deque never relocates elements, so views stay valid
+    std::unordered_map<std::string_view, Atom> atoms_;
+    std::vector<std::string_view> spellings_;
+
+    bool collect_stats_ = false;
+    std::vector<PhaseStats> phases_;
+
+    // While several threads use the interner at once, every call takes the
+    // mutex; single-threaded phases do not pay for it.
+    bool concurrent_ = false;
+    mutable std::mutex mutex_;
+
+    Atom InternImpl(const std::string_view str) {
+        const auto it = atoms_.find(str);
+        if (it != atoms_.end()) {
+            return it->second;
+        }
+        const std::string_view stored = storage_.emplace_back(str);
+        const auto atom = static_cast<Atom>(spellings_.size());
+        spellings_.push_back(stored);
+        atoms_.emplace(stored, atom);
+        return atom;
+    }
+
+    Atom InternTimed(const std::string_view str) {
+        if (!collect_stats_) {
+            return InternImpl(str);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        const Atom atom = InternImpl(str);
+        PhaseStats &phase = phases_.back();
+        phase.lookups++;
+        phase.lookup_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        return atom;
+    }
+
+public:
+    static constexpr Atom InvalidAtom = UINT32_MAX;
+
+    Atom Intern(const std::string_view str) {
+        if (concurrent_) {
+            std::lock_guard lock(mutex_);
+            return InternTimed(str);
+        }
+        return InternTimed(str);
+    }
+
+    [[nodiscard]] std::string_view Spelling(const Atom atom) const {
+        if (concurrent_) {
+            std::lock_guard lock(mutex_);
+            return spellings_[atom];
+        }
+        return spellings_[atom];
+    }
+
+    [[nodiscard]] size_t size() const {
+        return spellings_.size();
+    }
+
+    // Set around phases that intern from several threads. Must itself be
+    // called while no other thread uses the interner.
+    void SetConcurrent(const bool concurrent) {
+        concurrent_ = concurrent;
+    }
+
+    // Starts attributing interned strings and lookup time to `phase`.
+    void BeginPhase(std::string phase) {
+        collect_stats_ = true;
+        phases_.push_back(PhaseStats{std::move(phase), spellings_.size()});
+    }
+
+    void PrintStats(std::FILE *out) const {
+        std::fprintf(out, "%-16s %10s %10s %12s %12s\n", "phase", "new atoms", "atoms", "lookups", "lookup ms");
+        for (size_t i = 0; i < phases_.size(); i++) {
+            const size_t interned_after = i + 1 < phases_.size() ? phases_[i + 1].interned_before : spellings_.size();
+            std::fprintf(out, "%-16s %10zu %10zu %12llu %12.3f\n", phases_[i].phase.c_str(),
+                         interned_after - phases_[i].interned_before, interned_after,
+                         static_cast<unsigned long long>(phases_[i].lookups),
+                         static_cast<double>(phases_[i].lookup_ns) / 1e6);
+        }
+    }
+};
+
+// The process-wide interner shared by the lexer, the scopes and the IR.
+inline StringInterner &GlobalInterner() {
+    static StringInterner interner;
+    return interner;
+}
+#endif //STRINGINTERNER_H
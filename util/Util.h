@@ -1,10 +1,11 @@
 #ifndef UTIL_H
 #define UTIL_H
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <cctype>
 
-inline int64_t StringToInt(const std::string &literal) {
+inline int64_t StringToInt(const std::string_view literal) {
     uint32_t base = 10;
     uint32_t start_index = 0;
     if (literal.length() >= 2 && literal[0] == '0') {
@@ -22,7 +23,7 @@ inline int64_t StringToInt(const std::string &literal) {
     }
     uint32_t end_index = literal.length();
     uint64_t suffix_pos = literal.find_first_of("ui", start_index);
-    if (suffix_pos != std::string::npos) {
+    if (suffix_pos != std::string_view::npos) {
         end_index = suffix_pos;
     }
     int64_t result = 0;